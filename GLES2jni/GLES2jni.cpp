@@ -21,32 +21,162 @@
 // limitations under the License.
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
 #include "sample_util/SampleApplication.h"
 #include "util/shader_utils.h"
 #include "util/random_utils.h"
 
+#include "util_parallel.hpp"
+
 #include "GLES2jni.hpp"
 
+// Reference implementation, one instance at a time with libm sinf/cosf
+static void updateInstancesScalar(instanceStore &store, float dt, const GLfloat scale[2],
+                                  std::int_fast32_t begin, std::int_fast32_t end)
+{
+    float *angles = store.angles.data();
+    const float *velocity = store.angularVelocity.data();
+    float *scaleRot = store.scaleRot.data();
+
+    for (auto i = begin; i < end; i++) {
+        angles[i] += velocity[i] * dt;
+        if (angles[i] >= TWO_PI) {
+            angles[i] -= TWO_PI;
+        } else if (angles[i] <= -TWO_PI) {
+            angles[i] += TWO_PI;
+        }
+
+        float s = sinf(angles[i]);
+        float c = cosf(angles[i]);
+        scaleRot[4*i + 0] =  c * scale[0];
+        scaleRot[4*i + 1] =  s * scale[1];
+        scaleRot[4*i + 2] = -s * scale[0];
+        scaleRot[4*i + 3] =  c * scale[1];
+    }
+}
+
+// Advance instances [begin, end) SIMD_WIDTH at a time and write their mat2
+// straight into the uniform array. begin and end must be multiples of SIMD_WIDTH.
+static void updateInstancesSIMD(instanceStore &store, float dt, const GLfloat scale[2],
+                                std::int_fast32_t begin, std::int_fast32_t end)
+{
+    float *angles = store.angles.data();
+    const float *velocity = store.angularVelocity.data();
+    float *scaleRot = store.scaleRot.data();
+
+    const simd4f vdt      = simdSet1(dt);
+    const simd4f twoPi    = simdSet1(TWO_PI);
+    const simd4f negTwoPi = simdSet1(-TWO_PI);
+    const simd4f sx       = simdSet1(scale[0]);
+    const simd4f sy       = simdSet1(scale[1]);
+
+    for (auto i = begin; i < end; i += SIMD_WIDTH) {
+        simd4f a = simdMulAdd(simdLoad(velocity + i), vdt, simdLoad(angles + i));
+        a = simdSelect(simdCmpGe(a, twoPi), a - twoPi, a);
+        a = simdSelect(simdCmpLe(a, negTwoPi), a + twoPi, a);
+        simdStore(angles + i, a);
+
+        simd4f s, c;
+        simdSinCos(a, s, c);
+
+        // Rows hold one matrix element for four instances, transpose to
+        // get one matrix per instance.
+        simd4f m0 = c * sx;
+        simd4f m1 = s * sy;
+        simd4f m2 = -s * sx;
+        simd4f m3 = c * sy;
+        simdTranspose4(m0, m1, m2, m3);
+
+        simdStore(scaleRot + 4*i + 0,  m0);
+        simdStore(scaleRot + 4*i + 4,  m1);
+        simdStore(scaleRot + 4*i + 8,  m2);
+        simdStore(scaleRot + 4*i + 12, m3);
+    }
+}
+
+// Split the SIMD kernel over the worker pool in INSTANCE_CHUNK sized jobs
+static void updateInstancesParallel(instanceStore &store, float dt, const GLfloat scale[2])
+{
+    std::int_fast32_t groups = simdPadCount(store.count) / SIMD_WIDTH;
+    parallelFor(groups, INSTANCE_CHUNK / SIMD_WIDTH,
+                [&](std::int_fast32_t begin, std::int_fast32_t end) {
+                    updateInstancesSIMD(store, dt, scale, begin * SIMD_WIDTH, end * SIMD_WIDTH);
+                });
+}
+
+// Microbenchmark of the update kernels over a range of instance counts.
+// Doesn't touch GL, so it can run on a board without a display.
+static int runKernelBenchmark()
+{
+    const std::int_fast32_t counts[] = {1024, 4096, 16384, 65536, 262144, 1048576};
+    const GLfloat scale[2] = {0.01f, 0.02f};
+    const float dt = 1.0f / 60.0f;
+
+    std::unique_ptr<Timer> timer(CreateTimer());
+    angle::RNG rng(1);
+
+    std::cout << "Instance update kernel, ns per instance (threads: "
+              << parallelThreadCount() << ")" << std::endl;
+    std::cout << std::setw(10) << "instances" << std::setw(12) << "scalar"
+              << std::setw(12) << "simd" << std::setw(12) << "simd+mt" << std::endl;
+
+    for (auto count : counts) {
+        instanceStore store;
+        store.resize(count);
+        for (auto i = 0; i < count; i++) {
+            store.angles[i] = rng.randomFloatBetween(0.0f, 1.0f) * TWO_PI;
+            store.angularVelocity[i] = MAX_ROT_SPEED * (2.0 * rng.randomFloatBetween(0.0f, 1.0f) - 1.0);
+        }
+
+        // Roughly the same amount of work per row
+        const int iterations = std::max<int>(8, static_cast<int>(8 * 1048576 / count));
+        const std::int_fast32_t padded = simdPadCount(count);
+        double results[3];
+
+        for (auto kernel = 0; kernel < 3; kernel++) {
+            timer->start();
+            for (auto it = 0; it < iterations; it++) {
+                switch (kernel) {
+                    case 0: updateInstancesScalar(store, dt, scale, 0, count); break;
+                    case 1: updateInstancesSIMD(store, dt, scale, 0, padded); break;
+                    default: updateInstancesParallel(store, dt, scale); break;
+                }
+            }
+            timer->stop();
+            results[kernel] = timer->getElapsedTime() * 1e9 / (double(iterations) * count);
+        }
+
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(3)
+                  << std::setw(12) << results[0] << std::setw(12) << results[1]
+                  << std::setw(12) << results[2] << std::endl;
+    }
+
+    return 0;
+}
+
 class GLES2jni : public SampleApplication
 {
     private:
-        GLuint mProgram;
+        ShaderProgram mProgram;
         GLuint mBufferID;
         GLint aPos;
         GLint aColor;
         GLint uScaleRot;
         GLint uOffset;
 
-        GLfloat mOffsets[2*MAX_INSTANCES];
-        GLfloat mScaleRot[4*MAX_INSTANCES];
-        int mNumInstances = 0;
+        std::vector<GLfloat> mOffsets;
+        instanceStore mInstances;
+        int mInstancesPerSide = MAX_INSTANCES_PER_SIDE;
 
         GLfloat mScale[2] = {0};
-        GLfloat mAngularVelocity[MAX_INSTANCES] ={0};
-        float mLastFrameNs = 0.0f;
-        GLfloat mAngles[MAX_INSTANCES] = {0};
+        double mLastFrameTime = 0.0;
 
         // Platform indipendent timer
         Timer *mTimer;
@@ -63,12 +193,18 @@ class GLES2jni : public SampleApplication
     public:
         GLES2jni(int argc, char **argv)
             : SampleApplication("GLES2jni", argc, argv, 2, 0)
-        {}
+        {
+            for (auto i = 1; i < argc; i++) {
+                if (strncmp(argv[i], "--grid=", 7) == 0) {
+                    mInstancesPerSide = std::max(1, atoi(argv[i] + 7));
+                }
+            }
+        }
 
         void initSceneParams(int w, int h) {
 
             // number of cells along the larger screen dimension
-            const float NCELLS_MAJOR = MAX_INSTANCES_PER_SIDE;
+            const float NCELLS_MAJOR = mInstancesPerSide;
             // cell size in scene space
             const float CELL_SIZE = 2.0f / NCELLS_MAJOR;
 
@@ -82,9 +218,10 @@ class GLES2jni : public SampleApplication
                 (int)floorf(NCELLS_MAJOR * aspect[1])
             };
 
-            float centers[2][MAX_INSTANCES_PER_SIDE];
+            std::vector<float> centers[2];
             for (auto d = 0; d < 2; d++) {
                 int offset = -ncells[d] / NCELLS_MAJOR; // -1.0 for d=0
+                centers[d].resize(ncells[d]);
                 for (auto i = 0; i < ncells[d]; i++) {
                     centers[d][i] = scene2clip[d] * (CELL_SIZE*(i + 0.5f) + offset);
                 }
@@ -92,6 +229,7 @@ class GLES2jni : public SampleApplication
 
             int major = w >= h ? 0 : 1;
             int minor = w >= h ? 1 : 0;
+            mOffsets.resize(2 * ncells[0] * ncells[1]);
             // outer product of centers[0] and centers[1]
             for (auto i = 0; i < ncells[0]; i++) {
                 for (auto j = 0; j < ncells[1]; j++) {
@@ -101,45 +239,27 @@ class GLES2jni : public SampleApplication
                 }
             }
 
-            mNumInstances = ncells[0] * ncells[1];
+            mInstances.resize(ncells[0] * ncells[1]);
             mScale[major] = 0.5f * CELL_SIZE * scene2clip[0];
             mScale[minor] = 0.5f * CELL_SIZE * scene2clip[1];
 
             angle::RNG mRNG;
-            for (auto i = 0; i < mNumInstances; i++) {
-                mAngles[i] = mRNG.randomFloatBetween(0.0f, 1.0f) * TWO_PI;
-                mAngularVelocity[i] = MAX_ROT_SPEED * (2.0 * mRNG.randomFloatBetween(0.0f, 1.0f) - 1.0);
+            for (auto i = 0; i < mInstances.count; i++) {
+                mInstances.angles[i] = mRNG.randomFloatBetween(0.0f, 1.0f) * TWO_PI;
+                mInstances.angularVelocity[i] = MAX_ROT_SPEED * (2.0 * mRNG.randomFloatBetween(0.0f, 1.0f) - 1.0);
             }
 
             return;
         }
 
         void updateSceneParams() {
-            float nowNs = mTimer->getAbsoluteTime();
-
-            if (mLastFrameNs > 0) {
-                float dt = nowNs - mLastFrameNs;
-
-                for (auto i = 0; i < mNumInstances; i++) {
-                    mAngles[i] += mAngularVelocity[i] * dt;
-                    if (mAngles[i] >= TWO_PI) {
-                        mAngles[i] -= TWO_PI;
-                    } else if (mAngles[i] <= -TWO_PI) {
-                        mAngles[i] += TWO_PI;
-                    }
-                }
+            double now = mTimer->getAbsoluteTime();
 
-                for (auto i = 0; i < mNumInstances; i++) {
-                    float s = sinf(mAngles[i]);
-                    float c = cosf(mAngles[i]);
-                    mScaleRot[4*i + 0] =  c * mScale[0];
-                    mScaleRot[4*i + 1] =  s * mScale[1];
-                    mScaleRot[4*i + 2] = -s * mScale[0];
-                    mScaleRot[4*i + 3] =  c * mScale[1];
-                }
-            }
+            // The first frame only builds the matrices
+            float dt = mLastFrameTime > 0 ? static_cast<float>(now - mLastFrameTime) : 0.0f;
+            updateInstancesParallel(mInstances, dt, mScale);
 
-            mLastFrameNs = nowNs;
+            mLastFrameTime = now;
         }
 
         bool initialize() override {
@@ -165,19 +285,18 @@ void main() {
 }
 )";
 
-            mProgram = CompileProgram(kVS, kFS);
-            if (!mProgram) {
+            if (!mProgram.initialize(CompileProgram(kVS, kFS))) {
                 return false;
             }
 
             // Get index for shader variables
-            aPos = glGetAttribLocation(mProgram, "a_pos");
+            aPos = mProgram.getAttribLocation("a_pos");
             glEnableVertexAttribArray(aPos);
-            aColor = glGetAttribLocation(mProgram, "a_color");
+            aColor = mProgram.getAttribLocation("a_color");
             glEnableVertexAttribArray(aColor);
 
-            uScaleRot = glGetUniformLocation(mProgram, "u_scaleRot");
-            uOffset = glGetUniformLocation(mProgram, "u_offset");
+            uScaleRot = mProgram.getUniformLocation("u_scaleRot");
+            uOffset = mProgram.getUniformLocation("u_offset");
 
             // Create buffer object
             glGenBuffers(1, &mBufferID);
@@ -185,10 +304,10 @@ void main() {
             glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD), &QUAD[0], GL_STATIC_DRAW);
 
             // Initialize animation parameters
-            initSceneParams(getWindow()->getWidth(), getWindow()->getHeight());
+            initSceneParams(getWidth(), getHeight());
 
             // Set the viewport
-            glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+            glViewport(0, 0, getWidth(), getHeight());
 
             // Create timer for animation
             mTimer = CreateTimer();
@@ -199,10 +318,10 @@ void main() {
         }
 
         void destroy() override {
-            glDeleteProgram(mProgram);
+            mProgram.destroy();
         }
 
-        void draw() override {
+        void draw(float alpha) override {
             // Update parameters
             updateSceneParams();
 
@@ -211,7 +330,7 @@ void main() {
             glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
 
             // Use the program object
-            glUseProgram(mProgram);
+            mProgram.use();
 
             // Load the vertex and vertex color data
             glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
@@ -226,10 +345,11 @@ void main() {
                     (const GLvoid*)offsetof(packedVertex, rgba)
             );
 
-            // Draw elements
-            for (auto i = 0; i < mNumInstances; i++) {
-                glUniformMatrix2fv(uScaleRot, 1, GL_FALSE, mScaleRot + 4 * i);
-                glUniform2fv(uOffset, 1, mOffsets + 2 * i);
+            // Draw elements, instances that match the previous one skip the uniform calls
+            const GLfloat *scaleRot = mInstances.scaleRot.data();
+            for (auto i = 0; i < mInstances.count; i++) {
+                mProgram.setUniformMatrix2fv(uScaleRot, 1, scaleRot + 4 * i);
+                mProgram.setUniform2fv(uOffset, 1, mOffsets.data() + 2 * i);
                 glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
             }
             glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -237,6 +357,17 @@ void main() {
 };
 
 int main(int argc, char **argv) {
+    for (auto i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--threads=", 10) == 0) {
+            parallelSetThreadCount(atoi(argv[i] + 10));
+        }
+    }
+    for (auto i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) {
+            return runKernelBenchmark();
+        }
+    }
+
     GLES2jni app(argc, argv);
     return app.run();
 }
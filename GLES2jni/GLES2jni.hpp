@@ -22,14 +22,40 @@
 
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "util_simd.hpp"
 
 #define MAX_INSTANCES_PER_SIDE  64
 #define MAX_INSTANCES           (MAX_INSTANCES_PER_SIDE * MAX_INSTANCES_PER_SIDE)
 #define TWO_PI                  (2.0 * M_PI)
 #define MAX_ROT_SPEED           (0.3 * TWO_PI)
 
+// Instances updated per parallel job
+#define INSTANCE_CHUNK          4096
+
 struct packedVertex {
     GLfloat pos[2];
     GLubyte rgba[4];
     GLfloat tex[2];
 };
+
+// Per-instance animation state in structure-of-arrays layout.
+// Arrays are padded to a multiple of SIMD_WIDTH so the update kernel never
+// needs a scalar tail loop.
+struct instanceStore {
+    std::int_fast32_t count = 0;
+    std::vector<float> angles;
+    std::vector<float> angularVelocity;
+    // One column-major mat2 per instance, passed as-is to glUniformMatrix2fv
+    std::vector<float> scaleRot;
+
+    void resize(std::int_fast32_t n) {
+        std::int_fast32_t padded = simdPadCount(n);
+        count = n;
+        angles.assign(padded, 0.0f);
+        angularVelocity.assign(padded, 0.0f);
+        scaleRot.assign(4 * padded, 0.0f);
+    }
+};
@@ -36,7 +36,7 @@
 class GLES2jniTex : public SampleApplication
 {
     private:
-        GLuint mProgram;
+        ShaderProgram mProgram;
         GLuint mBufferID;
         GLuint mTextureID[MAX_TEXTURES];
 
@@ -175,20 +175,19 @@ void main() {
 }
 )";
 
-            mProgram = CompileProgram(kVS, kFS);
-            if (!mProgram) {
+            if (!mProgram.initialize(CompileProgram(kVS, kFS))) {
                 return false;
             }
 
             // Get index for shader variables
-            aPos = glGetAttribLocation(mProgram, "a_pos");
+            aPos = mProgram.getAttribLocation("a_pos");
             glEnableVertexAttribArray(aPos);
-            aTexCoord = glGetAttribLocation(mProgram, "a_texcoord");
+            aTexCoord = mProgram.getAttribLocation("a_texcoord");
             glEnableVertexAttribArray(aTexCoord);
 
-            uSampler = glGetUniformLocation(mProgram, "s_texture");
-            uScaleRot = glGetUniformLocation(mProgram, "u_scaleRot");
-            uOffset = glGetUniformLocation(mProgram, "u_offset");
+            uSampler = mProgram.getUniformLocation("s_texture");
+            uScaleRot = mProgram.getUniformLocation("u_scaleRot");
+            uOffset = mProgram.getUniformLocation("u_offset");
 
             // Create buffer object
             glGenBuffers(1, &mBufferID);
@@ -211,10 +210,10 @@ void main() {
             }
 
             // Initialize animation parameters
-            initSceneParams(getWindow()->getWidth(), getWindow()->getHeight());
+            initSceneParams(getWidth(), getHeight());
 
             // Set the viewport
-            glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+            glViewport(0, 0, getWidth(), getHeight());
 
             // Create timer for animation
             mTimer = CreateTimer();
@@ -225,10 +224,10 @@ void main() {
         }
 
         void destroy() override {
-            glDeleteProgram(mProgram);
+            mProgram.destroy();
         }
 
-        void draw() override
+        void draw(float alpha) override
         {
             // Update parameters
             updateSceneParams();
@@ -238,7 +237,7 @@ void main() {
             glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
 
             // Use the program object
-            glUseProgram(mProgram);
+            mProgram.use();
 
             // Load the vertex data
             glBindBuffer(GL_ARRAY_BUFFER, mBufferID);
@@ -254,12 +253,12 @@ void main() {
             );
 
             glActiveTexture(GL_TEXTURE0);
-            glUniform1i(uSampler, 0);
+            mProgram.setUniform1i(uSampler, 0);
 
             for (auto i = 0; i < mNumInstances; i++) {
                 glBindTexture(GL_TEXTURE_2D, mTextureID[i % (MAX_TEXTURES - 1)]);
-                glUniformMatrix2fv(uScaleRot, 1, GL_FALSE, mScaleRot + 4 * i);
-                glUniform2fv(uOffset, 1, mOffsets + 2 * i);
+                mProgram.setUniformMatrix2fv(uScaleRot, 1, mScaleRot + 4 * i);
+                mProgram.setUniform2fv(uOffset, 1, mOffsets + 2 * i);
                 glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
             }
             glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -51,14 +51,14 @@ void main()
 
     void destroy() override { glDeleteProgram(mProgram); }
 
-    void draw() override
+    void draw(float alpha) override
     {
         GLfloat vertices[] = {
             0.0f, 0.5f, 0.0f, -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f,
         };
 
         // Set the viewport
-        glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+        glViewport(0, 0, getRenderWidth(), getRenderHeight());
 
         // Clear the color buffer
         glClear(GL_COLOR_BUFFER_BIT);
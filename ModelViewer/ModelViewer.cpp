@@ -29,20 +29,37 @@
 //
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstring>
 #include <ctime>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
 
+#include "sample_util/CommandBuffer.h"
+#include "sample_util/FrameCapture.h"
+#include "sample_util/GpuTimer.h"
 #include "sample_util/SampleApplication.h"
+#include "sample_util/StreamingBuffer.h"
+#include "sample_util/Trace.h"
+#include "sample_util/TripleBuffer.h"
+#include "sample_util/UploadQueue.h"
 #include "util/shader_utils.h"
 #include "sample_util/tga_utils.h"
-#include "util/system_utils.h"
 
+#include "util_culling.hpp"
 #include "util_matrix.hpp"
 #include "util_objloader.hpp"
+#include "util_occlusion.hpp"
+#include "util_parallel.hpp"
 #include "util_xloader.hpp"
 
 // 3D model types
@@ -51,25 +68,62 @@ enum class modelFormat {
     MODEL_X,
 };
 
+// Model rotation in radians per second, the former 0.01 per frame at 60 fps
+#define ROTATION_SPEED 0.6f
+
+// Camera orbit in radians per second in scene mode
+#define CAMERA_SPEED 0.15f
+
+// Instances copied to the instance buffer by one parallelFor chunk
+#define INSTANCE_GRAIN 4096
+
+// Software occlusion buffer size, occluders rendered per frame unless --occluders says
+// otherwise, and the default voxel grid of the occluder directive
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 128
+#define OCCLUDER_COUNT 32
+#define OCCLUDER_CELLS 16
+
+// Differing frames --occlusion-check writes images of
+#define OCCLUSION_CHECK_IMAGES 4
+
+// Rotation before and after the latest update, draw() blends between them
+struct animState {
+    float prevAngle = 0.0f;
+    float angle = 0.0f;
+};
+
 class OBJmodelViewer : public SampleApplication
 {
     private:
-        GLuint mProgram;
-        GLuint mVertexBuffer;
-        GLuint mIndexBuffer;
-        GLuint mTexture;
+        ShaderProgram mProgram;
+        GLuint mVertexBuffer = 0;
+        GLuint mIndexBuffer = 0;
+        GLuint mTexture = 0;
+
+        // Pending uploads, reset once their object is usable on this thread
+        UploadTicket mVertexUpload;
+        UploadTicket mIndexUpload;
+        UploadTicket mTextureUpload;
 
         GLint  aPosition;
         GLint  aTexCoord;
         GLint  uSampler;
         GLint  uMatProj;
 
+        // Draws are recorded as packets and issued by the queue
+        CommandQueue mCommands;
+        DrawHandle mDrawProgram;
+        DrawHandle mDrawMaterial;
+        DrawHandle mDrawGeometry;
+        bool mDrawRegistered = false;
+
         // For normalize model
         float scale;
         vec3  trans;
 
         // OBJ model type and file name
-        char* modelName;
+        char* modelName = nullptr;
         modelFormat type;
 
         // transform matrix for static(background) images
@@ -78,13 +132,9 @@ class OBJmodelViewer : public SampleApplication
         // Sphere model parameters
         baseModel* mModel;
 
-        // Animation parameters
-        // std::int_fast32_t   mCount = 0;
+        // Animation parameters, mAngle is owned by update()
         float mAngle = 0.0f;
-
-        // Timer for vsync emulation
-        Timer *mTimer;
-        float  mTime;
+        TripleBuffer<animState> mAnimation;
 
     public:
         // Model Loader
@@ -92,17 +142,23 @@ class OBJmodelViewer : public SampleApplication
 
         void usage()
         {
-            std::cout << "Usage : OBJmodelViewer objfile" << std::endl;
+            std::cout << "Usage : OBJmodelViewer [options] objfile" << std::endl;
             std::exit(EXIT_FAILURE);
         }
 
         OBJmodelViewer(int argc, char **argv)
             : SampleApplication("OBJmodelViewer", argc, argv, 2, 0)
         {
-            if (argc < 2)
+            // The model is the first argument that is not an option
+            for (int i = 1; i < argc; i++) {
+                if (strncmp(argv[i], "--", 2) != 0) {
+                    modelName = argv[i];
+                    break;
+                }
+            }
+            if (modelName == nullptr)
                 usage();
             else {
-                modelName = argv[1];
                 std::string fn(modelName);
                 std::int_fast32_t ext_i = fn.find_last_of(".");
                 std::string extname = fn.substr(ext_i,fn.size()-ext_i);
@@ -123,9 +179,21 @@ class OBJmodelViewer : public SampleApplication
             }
             // Get parameters to adjust model size
             mModel->getNormalizeParams(scale, trans);
+
+            // 60 fps unless --fps says otherwise
+            setTargetFrameRate(60.0);
         }
 
         bool initialize() override {
+            // Check texture format
+            std::string texName = mModel->getTextureFilename();
+            std::cout << "Open texture : " << texName << std::endl;
+            std::string::size_type pos = texName.find(".tga");
+            if (pos == std::string::npos) {
+                std::cout << "Only TGA format texture is supported." << std::endl;
+                return false;
+            }
+
             constexpr char kVS[] = R"(
 #version 100
 uniform mat4 u_m4Proj;
@@ -148,19 +216,8 @@ void main() {
 }
 )";
 
-            mProgram = CompileProgram(kVS, kFS);
-            if (!mProgram) {
-                return false;
-            }
-
-            // Get index for shader variables and enable it
-            aPosition = glGetAttribLocation(mProgram, "a_position");
-            glEnableVertexAttribArray((GLuint)aPosition);
-            aTexCoord = glGetAttribLocation(mProgram, "a_texcoord");
-            glEnableVertexAttribArray((GLuint)aTexCoord);
-
-            uMatProj  = glGetUniformLocation(mProgram, "u_m4Proj");
-            uSampler  = glGetUniformLocation(mProgram, "s_texture");
+            // The program compiles on driver threads while the model is uploaded
+            AsyncProgram program = CompileProgramAsync(kVS, kFS);
 
             // Initialize matrix
             Mat4x4 matProj = perspectiveMatrix(deg_to_rad(45.0f), 1280.0f/720.0f, 0.1f, 100.0f);
@@ -171,47 +228,36 @@ void main() {
 
             matBack = matProj * matView * matTrans * matScale;
 
-            // Create and initialize buffer object
-            glGenBuffers(1, &mVertexBuffer);
-            glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
-            glBufferData(
+            // Create and initialize buffer object, on the loader thread with --async-upload
+            UploadQueue* uploads = getUploadQueue();
+            mVertexUpload = uploads->uploadBuffer(
                     GL_ARRAY_BUFFER,
-                    sizeof(packedVertex)*mModel->getPackedVerticesSize(),
                     mModel->getPackedVertices(),
+                    sizeof(packedVertex)*mModel->getPackedVerticesSize(),
                     GL_STATIC_DRAW
             );
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-            glGenBuffers(1, &mIndexBuffer);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
-            glBufferData(
+            mIndexUpload = uploads->uploadBuffer(
                     GL_ELEMENT_ARRAY_BUFFER,
-                    sizeof(std::int_fast32_t)*mModel->getFaceSize(),
                     mModel->getFaces(),
+                    sizeof(std::int_fast32_t)*mModel->getFaceSize(),
                     GL_STATIC_DRAW
             );
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-            // Check texture format
-            std::string texName = mModel->getTextureFilename();
-            std::cout << "Open texture : " << texName << std::endl;
-            std::string::size_type pos = texName.find(".tga");
-            if (pos == std::string::npos) {
-                std::cout << "Only TGA format texture is supported." << std::endl;
-                return false;
-            }
 
             // Load texture image
-            TGAImage img;
-            if (!LoadTGAImageFromFile(texName, &img)) {
-                return false;
-            }
+            mTextureUpload = uploads->uploadTGATexture(texName);
 
-            mTexture = LoadTextureFromTGAImage(img);
-            if (!mTexture) {
+            if (!mProgram.initialize(ResolveProgram(&program))) {
                 return false;
             }
 
+            // Get index for shader variables, the command queue enables the arrays
+            aPosition = mProgram.getAttribLocation("a_position");
+            aTexCoord = mProgram.getAttribLocation("a_texcoord");
+
+            uMatProj  = mProgram.getUniformLocation("u_m4Proj");
+            uSampler  = mProgram.getUniformLocation("s_texture");
+            mDrawProgram = mCommands.addProgram(&mProgram);
+
             // Set GL states
             glEnable(GL_DEPTH_TEST);
             glCullFace(GL_BACK);
@@ -219,78 +265,840 @@ void main() {
             // Clear buffer
             glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-            // Initialize timer
-            mTimer = CreateTimer();
-            mTime = mTimer->getAbsoluteTime();
-
             return true;
         }
 
         void destroy() override {
+            // Uploads still in flight have to land before their objects can be deleted
+            UploadQueue* uploads = getUploadQueue();
+            if (mVertexUpload)
+                mVertexBuffer = uploads->wait(mVertexUpload);
+            if (mIndexUpload)
+                mIndexBuffer = uploads->wait(mIndexUpload);
+            if (mTextureUpload)
+                mTexture = uploads->wait(mTextureUpload);
+
             glDeleteBuffers(1, &mIndexBuffer);
             glDeleteBuffers(1, &mVertexBuffer);
             glDeleteTextures(1, &mTexture);
-            glDeleteProgram(mProgram);
+            mCommands.clear();
+            mProgram.destroy();
+        }
+
+        void update(float dt, double totalTime) override
+        {
+            animState &state = mAnimation.getWriteBuffer();
+            state.prevAngle = mAngle;
+            mAngle = std::fmod(mAngle + ROTATION_SPEED * dt, 2.0f * (float)M_PI);
+            state.angle = state.prevAngle + ROTATION_SPEED * dt;
+            mAnimation.publish();
+        }
+
+        // Picks up finished uploads, true once the model can be drawn
+        bool pollUploads()
+        {
+            UploadQueue* uploads = getUploadQueue();
+            if (mVertexUpload && uploads->isReady(mVertexUpload, &mVertexBuffer))
+                mVertexUpload.reset();
+            if (mIndexUpload && uploads->isReady(mIndexUpload, &mIndexBuffer))
+                mIndexUpload.reset();
+            if (mTextureUpload && uploads->isReady(mTextureUpload, &mTexture)) {
+                mTextureUpload.reset();
+                if (!mTexture) {
+                    std::cout << "Could not load the model texture." << std::endl;
+                    exit();
+                }
+            }
+            return !mVertexUpload && !mIndexUpload && !mTextureUpload;
+        }
+
+        // Describes the uploaded model to the command queue
+        void registerDrawState()
+        {
+            DrawMaterial material;
+            material.textures[0] = mTexture;
+            material.textureCount = 1;
+            mDrawMaterial = mCommands.addMaterial(material);
+
+            DrawGeometry geometry;
+            geometry.vertexBuffer = mVertexBuffer;
+            geometry.indexBuffer = mIndexBuffer;
+            geometry.indexType = GL_UNSIGNED_INT;
+            geometry.attributeCount = 2;
+            geometry.attributes[0].location = aPosition;
+            geometry.attributes[0].size = 3;
+            geometry.attributes[0].stride = sizeof(packedVertex);
+            geometry.attributes[0].offset = offsetof(packedVertex, vPosition);
+            geometry.attributes[1].location = aTexCoord;
+            geometry.attributes[1].size = 2;
+            geometry.attributes[1].stride = sizeof(packedVertex);
+            geometry.attributes[1].offset = offsetof(packedVertex, vTexCoord);
+            mDrawGeometry = mCommands.addGeometry(geometry);
+
+            mDrawRegistered = true;
         }
 
-        void draw() override
+        void draw(float alpha) override
         {
+            GpuScope gpuScope("draw");
+
             // Clear the color buffer
             glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            // Update angle parameters
-            mAngle = mAngle + 0.01f;
+            // Only the clear until the model has been uploaded
+            if (!pollUploads() || !mTexture) {
+                return;
+            }
+
+            // Interpolate the rotation between the last two updates
+            mAnimation.acquire();
+            const animState& state = mAnimation.getReadBuffer();
+            float angle = state.prevAngle + (state.angle - state.prevAngle) * alpha;
 
             // Create the rotate and translate model view matrix
-            Mat4x4 matRot = rotateYMatrix(mAngle);
+            Mat4x4 matRot = rotateYMatrix(angle);
             Mat4x4 matMVP = matBack * matRot;
 
-            // Set IBO/VBO
-            GLsizei stride = sizeof(packedVertex);
-            glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
-            glVertexAttribPointer(
-                    (GLuint)aPosition, 3, GL_FLOAT, GL_FALSE,
-                    stride, (const GLvoid*)offsetof(packedVertex, vPosition)
-            );
-            glVertexAttribPointer(
-                    (GLuint)aTexCoord, 2, GL_FLOAT, GL_FALSE,
-                    stride, (const GLvoid*)offsetof(packedVertex, vTexCoord)
+            if (!mDrawRegistered)
+                registerDrawState();
+
+            // Record the model, then let the queue bind and draw
+            CommandRecorder* recorder = mCommands.acquireRecorder();
+            recorder->setUniformMatrix4fv(uMatProj, 1, &matMVP(0));
+            recorder->setUniform1i(uSampler, 0);
+            recorder->draw(
+                    mDrawProgram, mDrawMaterial, mDrawGeometry,
+                    GL_TRIANGLES,           // mode
+                    0,                      // first index
+                    mModel->getFaceSize()   // count
             );
+            mCommands.submit();
+        }
+};
 
-            // Use the program object
-            glUseProgram(mProgram);
-            glUniformMatrix4fv(uMatProj,1, 0, &matMVP(0));
+// Scene mode, selected with --scene=<manifest>. One directive per line, '#' starts a comment:
+//   mesh <name> <model.obj|model.x> [texture.tga]
+//   instance <mesh> <x> <y> <z> [yaw in degrees] [scale]
+//   grid <mesh> <nx> <ny> <nz> <spacing>
+//   occluder <mesh> [cells]
+// grid places nx * ny * nz instances with random yaw around the origin. occluder lets the
+// instances of a mesh hide others, through the cells of a cells^3 grid that lie inside it.
+// Relative paths are resolved against the manifest's directory, except texture names that
+// come from a model file, which are relative to the model. Every model is normalized
+// to the same size as in single model mode.
+struct sceneMesh {
+    std::string name;
+    std::string textureName;
 
-            // Select and bind texture
-            glActiveTexture(GL_TEXTURE0);
-            glUniform1i(uSampler, 0);
-            glBindTexture(GL_TEXTURE_2D, mTexture);
+    // Normalized model data, indices packed to 32 bits for GL_UNSIGNED_INT
+    std::vector<packedVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::int_fast32_t indexCount = 0;
+    Mat4x4 normalize;
+    vec3 boundsMin;
+    vec3 boundsMax;
 
-            // Bind index buffer
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    GLuint texture = 0;
+    DrawHandle material = 0;
+    DrawHandle geometry = 0;
 
-            // Draw elements
-            glDrawElements(
-                    GL_TRIANGLES,           // mode
-                    mModel->getFaceSize(),  // count
-                    GL_UNSIGNED_INT,        // type
-                    (const GLvoid *)0       // elemnt array buffer offset
-            );
+    // Empty unless the manifest made the mesh an occluder
+    occluderMesh occluder;
+
+    // Instances of a mesh are consecutive
+    std::int_fast32_t firstInstance = 0;
+    std::int_fast32_t instanceCount = 0;
+};
+
+struct sceneInstance {
+    std::int_fast32_t mesh;
+    Mat4x4 model;
+};
+
+// Copies what the scene needs out of a loaded model
+static bool copyMeshData(baseModel& model, sceneMesh& mesh)
+{
+    if (!model.getStatus() || model.getPackedVerticesSize() == 0 || model.getFaceSize() == 0)
+        return false;
+
+    const packedVertex* vertices = model.getPackedVertices();
+    mesh.vertices.assign(vertices, vertices + model.getPackedVerticesSize());
+    const std::int_fast32_t* faces = model.getFaces();
+    mesh.indices.resize(model.getFaceSize());
+    for (std::int_fast32_t i = 0; i < model.getFaceSize(); i++)
+        mesh.indices[i] = static_cast<std::uint32_t>(faces[i]);
+    mesh.indexCount = model.getFaceSize();
+
+    float scale;
+    vec3 trans;
+    model.getNormalizeParams(scale, trans);
+    mesh.normalize = translateMatrix(trans.x, trans.y, trans.z) * scaleMatrix(scale, scale, scale);
+
+    vec3 vmin = {FLT_MAX, FLT_MAX, FLT_MAX};
+    vec3 vmax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (const packedVertex& v : mesh.vertices) {
+        vmin.x = std::min(vmin.x, v.vPosition.x * scale + trans.x);
+        vmin.y = std::min(vmin.y, v.vPosition.y * scale + trans.y);
+        vmin.z = std::min(vmin.z, v.vPosition.z * scale + trans.z);
+        vmax.x = std::max(vmax.x, v.vPosition.x * scale + trans.x);
+        vmax.y = std::max(vmax.y, v.vPosition.y * scale + trans.y);
+        vmax.z = std::max(vmax.z, v.vPosition.z * scale + trans.z);
+    }
+    mesh.boundsMin = vmin;
+    mesh.boundsMax = vmax;
+
+    if (mesh.textureName.empty())
+        mesh.textureName = model.getTextureFilename();
+    return true;
+}
+
+// Directory part of path including the separator, empty when there is none
+static std::string directoryOf(const std::string& path)
+{
+    std::string::size_type slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+// name relative to directory, absolute names (/x, \\x, C:x) are kept as they are
+static std::string resolvePath(const std::string& directory, const std::string& name)
+{
+    if (name.empty() || name[0] == '/' || name[0] == '\\' ||
+        (name.size() > 1 && name[1] == ':'))
+        return name;
+    return directory + name;
+}
+
+static bool loadMeshData(const std::string& path, sceneMesh& mesh)
+{
+    std::string::size_type ext_i = path.find_last_of(".");
+    std::string extname = ext_i == std::string::npos ? "" : path.substr(ext_i);
+    if (extname == ".obj") {
+        objLoader model;
+        model.loadModel(path.c_str());
+        return copyMeshData(model, mesh);
+    } else if (extname == ".x") {
+        xLoader model;
+        model.loadModel(path.c_str());
+        return copyMeshData(model, mesh);
+    }
+    return false;
+}
+
+class sceneViewer : public SampleApplication
+{
+    private:
+        ShaderProgram mProgram;
+        GLint  aPosition;
+        GLint  aTexCoord;
+        GLint  aModel;
+        GLint  uViewProj;
+        GLint  uSampler;
+
+        std::vector<sceneMesh> mMeshes;
+        std::vector<sceneInstance> mInstances;
+
+        // Bounds of every instance
+        vec3 mSceneMin = {FLT_MAX, FLT_MAX, FLT_MAX};
+        vec3 mSceneMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        // Instance boxes in world space and the model matrices of all instances, in
+        // instance order. Visible matrices are packed into mInstanceStream every frame.
+        frustumCuller mCuller;
+        std::vector<float> mInstanceModels;
+        std::unique_ptr<StreamingBuffer> mInstanceStream;
+
+        // World box of every instance as center and extent, for picking occluders
+        std::vector<float> mInstanceBoxes;
+
+        // Frustum visible occluder instances with their projected size
+        occlusionBuffer mOcclusion{OCCLUSION_WIDTH, OCCLUSION_HEIGHT};
+        std::vector<std::pair<float, std::uint32_t>> mOccluderCandidates;
+        bool mUseOcclusion = true;
+        std::int_fast32_t mMaxOccluders = OCCLUDER_COUNT;
+
+        // --occlusion-check=prefix draws every frame without and then with occlusion culling
+        // and compares the two, the first differing frames are written as TGA images
+        std::string mCheckPrefix;
+        std::vector<std::uint8_t> mCheckFull;
+        std::vector<std::uint8_t> mCheckCulled;
+        std::int_fast64_t mCheckFrames = 0;
+        std::int_fast64_t mCheckFailures = 0;
+        std::int_fast64_t mCheckMaxPixels = 0;
+
+        CommandQueue mCommands;
+        DrawHandle mDrawProgram;
+
+        // Camera orbit, mAngle is owned by update()
+        float mAngle = 0.0f;
+        TripleBuffer<animState> mAnimation;
+
+        // Culling statistics
+        double mCullTime = 0.0;
+        std::int_fast64_t mVisibleTotal = 0;
+        std::int_fast64_t mCullFrames = 0;
+        double mOcclusionTime = 0.0;
+        std::int_fast64_t mOccludedTotal = 0;
+        std::int_fast64_t mOccluderTotal = 0;
+        std::int_fast64_t mOccluderTriangleTotal = 0;
+
+        std::int_fast32_t findMesh(const std::string& name)
+        {
+            for (std::size_t i = 0; i < mMeshes.size(); i++) {
+                if (mMeshes[i].name == name)
+                    return static_cast<std::int_fast32_t>(i);
+            }
+            return -1;
+        }
+
+        void addInstance(std::int_fast32_t mesh, float x, float y, float z, float yaw, float scale)
+        {
+            sceneInstance instance;
+            instance.mesh = mesh;
+            instance.model = translateMatrix(x, y, z) * rotateYMatrix(yaw) *
+                             scaleMatrix(scale, scale, scale) * mMeshes[mesh].normalize;
+            mInstances.push_back(instance);
+        }
+
+        bool loadManifest(const std::string& manifest)
+        {
+            std::ifstream file(manifest);
+            if (!file) {
+                std::cout << "Could not open scene manifest " << manifest << std::endl;
+                return false;
+            }
+            std::string directory = directoryOf(manifest);
+
+            std::uint32_t rngState = 0x9e3779b9u;
+            std::string line;
+            for (int lineNumber = 1; std::getline(file, line); lineNumber++) {
+                std::istringstream in(line.substr(0, line.find('#')));
+                std::string directive;
+                if (!(in >> directive))
+                    continue;
+
+                bool valid = false;
+                if (directive == "mesh") {
+                    sceneMesh mesh;
+                    std::string model;
+                    if (in >> mesh.name >> model) {
+                        // A texture named here is relative to the manifest, one named by the
+                        // model file relative to the model
+                        std::string texture;
+                        in >> texture;
+                        model = resolvePath(directory, model);
+                        std::cout << "Open model : " << model << std::endl;
+                        valid = findMesh(mesh.name) < 0 && loadMeshData(model, mesh);
+                        mesh.textureName = texture.empty()
+                                               ? resolvePath(directoryOf(model), mesh.textureName)
+                                               : resolvePath(directory, texture);
+                        if (valid && mesh.textureName.find(".tga") == std::string::npos) {
+                            std::cout << "Only TGA format texture is supported." << std::endl;
+                            valid = false;
+                        }
+                        if (valid)
+                            mMeshes.push_back(std::move(mesh));
+                    }
+                } else if (directive == "instance") {
+                    std::string name;
+                    float x, y, z, yaw = 0.0f, scale = 1.0f;
+                    if (in >> name >> x >> y >> z) {
+                        in >> yaw >> scale;
+                        std::int_fast32_t mesh = findMesh(name);
+                        valid = mesh >= 0;
+                        if (valid)
+                            addInstance(mesh, x, y, z, yaw * (float)M_PI / 180.0f, scale);
+                    }
+                } else if (directive == "grid") {
+                    std::string name;
+                    int nx, ny, nz;
+                    float spacing;
+                    if (in >> name >> nx >> ny >> nz >> spacing) {
+                        std::int_fast32_t mesh = findMesh(name);
+                        valid = mesh >= 0;
+                        // x runs fastest so consecutive instances are neighbours
+                        for (int k = 0; valid && k < nz; k++) {
+                            for (int j = 0; j < ny; j++) {
+                                for (int i = 0; i < nx; i++) {
+                                    rngState = rngState * 1664525u + 1013904223u;
+                                    float yaw = (rngState >> 8) * (2.0f * (float)M_PI) /
+                                                16777216.0f;
+                                    addInstance(mesh,
+                                                (i - (nx - 1) * 0.5f) * spacing,
+                                                (j - (ny - 1) * 0.5f) * spacing,
+                                                (k - (nz - 1) * 0.5f) * spacing,
+                                                yaw, 1.0f);
+                                }
+                            }
+                        }
+                    }
+                } else if (directive == "occluder") {
+                    std::string name;
+                    int cells = OCCLUDER_CELLS;
+                    if (in >> name) {
+                        in >> cells;
+                        std::int_fast32_t mesh = findMesh(name);
+                        valid = mesh >= 0 && cells > 0;
+                        if (valid) {
+                            sceneMesh& m = mMeshes[mesh];
+                            m.occluder = buildOccluderMesh(m.vertices.data(), m.vertices.size(),
+                                                           m.indices.data(), m.indices.size(),
+                                                           cells);
+                            std::cout << "Occluder : " << m.name << " reduced to "
+                                      << m.occluder.getTriangleCount() << " of "
+                                      << m.indexCount / 3 << " triangles" << std::endl;
+                        }
+                    }
+                }
+
+                if (!valid) {
+                    std::cout << manifest << ":" << lineNumber << ": invalid line \"" << line
+                              << "\"" << std::endl;
+                    return false;
+                }
+            }
+
+            if (mInstances.empty()) {
+                std::cout << "The scene has no instances." << std::endl;
+                return false;
+            }
+
+            // Group the instances by mesh, each group is drawn with one instanced call
+            std::stable_sort(mInstances.begin(), mInstances.end(),
+                             [](const sceneInstance& a, const sceneInstance& b) {
+                                 return a.mesh < b.mesh;
+                             });
+
+            mInstanceModels.resize(mInstances.size() * 16);
+            mInstanceBoxes.resize(mInstances.size() * 6);
+            for (std::size_t n = 0; n < mInstances.size(); n++) {
+                const sceneInstance& instance = mInstances[n];
+                sceneMesh& mesh = mMeshes[instance.mesh];
+                if (mesh.instanceCount++ == 0)
+                    mesh.firstInstance = static_cast<std::int_fast32_t>(n);
+                std::memcpy(&mInstanceModels[n * 16], &instance.model(0), 16 * sizeof(float));
+
+                // World box of the transformed mesh box
+                const Mat4x4& m = instance.model;
+                float local[2][3] = {
+                    {(mesh.boundsMin.x + mesh.boundsMax.x) * 0.5f,
+                     (mesh.boundsMin.y + mesh.boundsMax.y) * 0.5f,
+                     (mesh.boundsMin.z + mesh.boundsMax.z) * 0.5f},
+                    {(mesh.boundsMax.x - mesh.boundsMin.x) * 0.5f,
+                     (mesh.boundsMax.y - mesh.boundsMin.y) * 0.5f,
+                     (mesh.boundsMax.z - mesh.boundsMin.z) * 0.5f},
+                };
+                float world[2][3];
+                for (auto row = 0; row < 3; row++) {
+                    world[0][row] = m(row, 3);
+                    world[1][row] = 0.0f;
+                    for (auto col = 0; col < 3; col++) {
+                        world[0][row] += m(row, col) * local[0][col];
+                        world[1][row] += std::fabs(m(row, col)) * local[1][col];
+                    }
+                }
+                mCuller.addBox(vec3{world[0][0], world[0][1], world[0][2]},
+                               vec3{world[1][0], world[1][1], world[1][2]});
+                std::memcpy(&mInstanceBoxes[n * 6], world, 6 * sizeof(float));
+
+                mSceneMin.x = std::min(mSceneMin.x, world[0][0] - world[1][0]);
+                mSceneMin.y = std::min(mSceneMin.y, world[0][1] - world[1][1]);
+                mSceneMin.z = std::min(mSceneMin.z, world[0][2] - world[1][2]);
+                mSceneMax.x = std::max(mSceneMax.x, world[0][0] + world[1][0]);
+                mSceneMax.y = std::max(mSceneMax.y, world[0][1] + world[1][1]);
+                mSceneMax.z = std::max(mSceneMax.z, world[0][2] + world[1][2]);
+            }
+
+            std::cout << "Scene : " << mMeshes.size() << " meshes, " << mInstances.size()
+                      << " instances" << std::endl;
+            return true;
+        }
+
+        // Packs the model matrices of the first visibleCount visible instances and draws them
+        void drawVisible(const Mat4x4& matViewProj, std::int_fast32_t visibleCount)
+        {
+            // The visible list keeps them grouped by mesh
+            mInstanceStream->beginFrame();
+            StreamSpan<float> span = mInstanceStream->allocate<float>(visibleCount * 16);
+            if (!span.valid()) {
+                mInstanceStream->endFrame();
+                return;
+            }
+            const std::uint32_t* visible = mCuller.getVisible();
+            parallelFor(visibleCount, INSTANCE_GRAIN,
+                        [this, &span, visible](std::int_fast32_t begin, std::int_fast32_t end) {
+                for (std::int_fast32_t i = begin; i < end; i++) {
+                    std::memcpy(&span[i * 16], &mInstanceModels[visible[i] * 16],
+                                16 * sizeof(float));
+                }
+            });
+            mInstanceStream->flush();
+
+            CommandRecorder* recorder = mCommands.acquireRecorder();
+            const std::uint32_t* meshBegin = visible;
+            for (const sceneMesh& mesh : mMeshes) {
+                if (mesh.instanceCount == 0)
+                    continue;
+                const std::uint32_t* meshEnd = std::lower_bound(
+                        meshBegin, visible + visibleCount,
+                        static_cast<std::uint32_t>(mesh.firstInstance + mesh.instanceCount));
+                if (meshEnd != meshBegin) {
+                    recorder->setUniformMatrix4fv(uViewProj, 1, &matViewProj(0));
+                    recorder->setUniform1i(uSampler, 0);
+                    recorder->drawInstanced(
+                            mDrawProgram, mesh.material, mesh.geometry,
+                            GL_TRIANGLES, 0, static_cast<std::uint32_t>(mesh.indexCount),
+                            static_cast<std::uint32_t>(meshEnd - meshBegin), span.buffer,
+                            span.offset + (meshBegin - visible) * 16 * sizeof(float));
+                }
+                meshBegin = meshEnd;
+            }
+            mCommands.submit();
+            mInstanceStream->endFrame();
+        }
+
+        void readFrame(std::vector<std::uint8_t>& pixels)
+        {
+            pixels.resize(getRenderWidth() * getRenderHeight() * 4);
+            glReadPixels(0, 0, static_cast<GLsizei>(getRenderWidth()),
+                         static_cast<GLsizei>(getRenderHeight()), GL_RGBA, GL_UNSIGNED_BYTE,
+                         pixels.data());
+        }
+
+        // Culling only drops hidden instances, so the frame has to match the one drawn
+        // without it pixel for pixel
+        void checkOcclusion()
+        {
+            readFrame(mCheckCulled);
+            const std::size_t width = getRenderWidth();
+            const std::size_t height = getRenderHeight();
+            std::int_fast64_t differing = 0;
+            for (std::size_t i = 0; i < width * height; i++) {
+                if (std::memcmp(&mCheckFull[i * 4], &mCheckCulled[i * 4], 4) != 0)
+                    differing++;
+            }
+            std::int_fast64_t frame = mCheckFrames++;
+            if (differing == 0)
+                return;
+
+            mCheckMaxPixels = std::max(mCheckMaxPixels, differing);
+            std::cout << "Occlusion check : frame " << frame << ", " << differing
+                      << " pixels differ" << std::endl;
+            if (mCheckFailures++ >= OCCLUSION_CHECK_IMAGES)
+                return;
+
+            // Top-down copies of both frames, and the differing pixels in white
+            std::vector<std::uint8_t> images[3];
+            for (std::vector<std::uint8_t>& image : images) {
+                image.resize(width * height * 4);
+            }
+            for (std::size_t y = 0; y < height; y++) {
+                std::size_t src = (height - 1 - y) * width * 4;
+                std::size_t dst = y * width * 4;
+                std::memcpy(&images[0][dst], &mCheckFull[src], width * 4);
+                std::memcpy(&images[1][dst], &mCheckCulled[src], width * 4);
+                for (std::size_t x = 0; x < width * 4; x += 4) {
+                    std::uint8_t value =
+                        std::memcmp(&mCheckFull[src + x], &mCheckCulled[src + x], 4) ? 255 : 0;
+                    std::memset(&images[2][dst + x], value, 3);
+                    images[2][dst + x + 3] = 255;
+                }
+            }
+            const char* suffixes[3] = {"_full.tga", "_culled.tga", "_diff.tga"};
+            for (auto i = 0; i < 3; i++) {
+                std::string path = mCheckPrefix + "_" + std::to_string(frame) + suffixes[i];
+                if (!WriteCaptureImage(path, CaptureFormat::TGA, width, height, images[i].data()))
+                    std::cout << "Could not write " << path << std::endl;
+            }
+        }
+
+        // Renders the largest frustum visible occluders on screen into the occlusion buffer
+        // and culls the visible instances against it. Returns the new visible count, or -1
+        // when no occluder was in view and the visible list was left alone.
+        std::int_fast32_t cullOccluders(const Mat4x4& viewProj, float ex, float ey, float ez,
+                                        std::int_fast32_t visibleCount)
+        {
+            const std::uint32_t* visible = mCuller.getVisible();
+            mOccluderCandidates.clear();
+            for (std::int_fast32_t i = 0; i < visibleCount; i++) {
+                const std::uint32_t n = visible[i];
+                if (mMeshes[mInstances[n].mesh].occluder.indices.empty())
+                    continue;
+
+                // Squared box radius over squared distance is the size on screen
+                const float* box = &mInstanceBoxes[n * 6];
+                float dx = box[0] - ex;
+                float dy = box[1] - ey;
+                float dz = box[2] - ez;
+                float radius = box[3] * box[3] + box[4] * box[4] + box[5] * box[5];
+                mOccluderCandidates.emplace_back(radius / (dx * dx + dy * dy + dz * dz + 1e-6f),
+                                                 n);
+            }
+
+            std::size_t count = std::min<std::size_t>(mOccluderCandidates.size(), mMaxOccluders);
+            if (count == 0)
+                return -1;
+            std::partial_sort(mOccluderCandidates.begin(), mOccluderCandidates.begin() + count,
+                              mOccluderCandidates.end(),
+                              [](const std::pair<float, std::uint32_t>& a,
+                                 const std::pair<float, std::uint32_t>& b) {
+                                  return a.first > b.first;
+                              });
+
+            mOcclusion.begin(viewProj);
+            for (std::size_t i = 0; i < count; i++) {
+                const sceneInstance& instance = mInstances[mOccluderCandidates[i].second];
+                mOcclusion.addOccluder(mMeshes[instance.mesh].occluder, instance.model);
+            }
+            mOcclusion.render();
+            mOccluderTotal += count;
+            mOccluderTriangleTotal += mOcclusion.getTriangleCount();
+
+            return mCuller.cullOccluded(mOcclusion);
+        }
+
+    public:
+        sceneViewer(int argc, char **argv, const std::string& manifest)
+            : SampleApplication("SceneViewer", argc, argv, 3, 0)
+        {
+            for (int i = 1; i < argc; i++) {
+                if (strncmp(argv[i], "--threads=", 10) == 0)
+                    parallelSetThreadCount(atoi(argv[i] + 10));
+                else if (strncmp(argv[i], "--occluders=", 12) == 0)
+                    mMaxOccluders = std::max(atoi(argv[i] + 12), 0);
+                else if (strcmp(argv[i], "--no-occlusion") == 0)
+                    mUseOcclusion = false;
+                else if (strncmp(argv[i], "--occlusion-check=", 18) == 0)
+                    mCheckPrefix = argv[i] + 18;
+            }
+
+            if (!loadManifest(manifest))
+                std::exit(EXIT_FAILURE);
+
+            // 60 fps unless --fps says otherwise
+            setTargetFrameRate(60.0);
+        }
+
+        bool initialize() override {
+            constexpr char kVS[] = R"(
+#version 100
+uniform mat4 u_m4ViewProj;
+attribute vec4 a_position;
+attribute vec2 a_texcoord;
+attribute mat4 a_m4Model;
+varying vec2 v_texcoord;
+void main() {
+    gl_Position = u_m4ViewProj * (a_m4Model * a_position);
+    v_texcoord = a_texcoord;
+}
+)";
+
+            constexpr char kFS[] = R"(
+#version 100
+precision mediump float;
+uniform sampler2D s_texture;
+varying vec2 v_texcoord;
+void main() {
+    gl_FragColor = texture2D(s_texture, v_texcoord);
+}
+)";
 
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            if (!mProgram.initialize(CompileProgram(kVS, kFS))) {
+                return false;
+            }
+            aPosition = mProgram.getAttribLocation("a_position");
+            aTexCoord = mProgram.getAttribLocation("a_texcoord");
+            aModel    = mProgram.getAttribLocation("a_m4Model");
+            uViewProj = mProgram.getUniformLocation("u_m4ViewProj");
+            uSampler  = mProgram.getUniformLocation("s_texture");
+            mDrawProgram = mCommands.addProgram(&mProgram);
+
+            // One matrix per instance is the most a frame can need
+            mInstanceStream.reset(
+                    new StreamingBuffer(GL_ARRAY_BUFFER, mInstanceModels.size() * sizeof(float)));
+            if (!mInstanceStream->initialize()) {
+                return false;
+            }
+
+            for (sceneMesh& mesh : mMeshes) {
+                if (mesh.instanceCount == 0)
+                    continue;
 
-            // Vsync emulation
-            float cTime = mTimer->getAbsoluteTime();
-            float eTime = (cTime - mTime) * 1e3;
-            mTime = cTime;
-            if (eTime < 16.666f) angle::Sleep((std::int_fast32_t)(16.666f - eTime));
+                glGenBuffers(1, &mesh.vertexBuffer);
+                glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+                glBufferData(GL_ARRAY_BUFFER, sizeof(packedVertex) * mesh.vertices.size(),
+                             mesh.vertices.data(), GL_STATIC_DRAW);
+                glGenBuffers(1, &mesh.indexBuffer);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBuffer);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t) * mesh.indices.size(),
+                             mesh.indices.data(), GL_STATIC_DRAW);
+
+                std::cout << "Open texture : " << mesh.textureName << std::endl;
+                TGAImage image;
+                if (!LoadTGAImageFromFile(mesh.textureName, &image)) {
+                    std::cout << "Could not load " << mesh.textureName << std::endl;
+                    return false;
+                }
+                mesh.texture = LoadTextureFromTGAImage(image);
+
+                DrawMaterial material;
+                material.textures[0] = mesh.texture;
+                material.textureCount = 1;
+                mesh.material = mCommands.addMaterial(material);
+
+                // Vertex data from the mesh, one model matrix column per attribute location
+                // from the instance buffer
+                DrawGeometry geometry;
+                geometry.vertexBuffer = mesh.vertexBuffer;
+                geometry.indexBuffer = mesh.indexBuffer;
+                geometry.indexType = GL_UNSIGNED_INT;
+                geometry.attributeCount = 6;
+                geometry.attributes[0].location = aPosition;
+                geometry.attributes[0].size = 3;
+                geometry.attributes[0].stride = sizeof(packedVertex);
+                geometry.attributes[0].offset = offsetof(packedVertex, vPosition);
+                geometry.attributes[1].location = aTexCoord;
+                geometry.attributes[1].size = 2;
+                geometry.attributes[1].stride = sizeof(packedVertex);
+                geometry.attributes[1].offset = offsetof(packedVertex, vTexCoord);
+                for (auto col = 0; col < 4; col++) {
+                    DrawAttribute& attribute = geometry.attributes[2 + col];
+                    attribute.location = aModel < 0 ? -1 : aModel + col;
+                    attribute.stride = 16 * sizeof(float);
+                    attribute.offset = col * 4 * sizeof(float);
+                    attribute.divisor = 1;
+                }
+                mesh.geometry = mCommands.addGeometry(geometry);
+
+                // Only the GL objects are needed from now on
+                std::vector<packedVertex>().swap(mesh.vertices);
+                std::vector<std::uint32_t>().swap(mesh.indices);
+            }
+
+            glEnable(GL_DEPTH_TEST);
+            glEnable(GL_CULL_FACE);
+            glCullFace(GL_BACK);
+
+            return true;
+        }
+
+        void destroy() override {
+            if (mCullFrames > 0) {
+                std::cout << std::fixed << std::setprecision(3)
+                          << "Culling : " << mCullTime / mCullFrames << " ms average, "
+                          << mVisibleTotal / mCullFrames << " of " << mInstances.size()
+                          << " instances visible (threads: " << parallelThreadCount() << ")"
+                          << std::endl;
+                if (!mCheckPrefix.empty()) {
+                    std::cout << "Occlusion check : " << mCheckFailures << " of " << mCheckFrames
+                              << " frames differ";
+                    if (mCheckFailures > 0)
+                        std::cout << ", at most " << mCheckMaxPixels << " pixels";
+                    std::cout << std::endl;
+                }
+                if (mOccluderTotal > 0) {
+                    std::cout << "Occlusion : " << mOccludedTotal / mCullFrames
+                              << " instances culled on average, "
+                              << mOcclusionTime / mCullFrames << " ms average, "
+                              << mOccluderTotal / mCullFrames << " occluders and "
+                              << mOccluderTriangleTotal / mCullFrames << " triangles per frame"
+                              << std::endl;
+                }
+            }
+
+            mCommands.clear();
+            if (mInstanceStream)
+                mInstanceStream->destroy();
+            for (sceneMesh& mesh : mMeshes) {
+                glDeleteBuffers(1, &mesh.vertexBuffer);
+                glDeleteBuffers(1, &mesh.indexBuffer);
+                glDeleteTextures(1, &mesh.texture);
+            }
+            mProgram.destroy();
+        }
+
+        void update(float dt, double totalTime) override
+        {
+            animState &state = mAnimation.getWriteBuffer();
+            state.prevAngle = mAngle;
+            mAngle = std::fmod(mAngle + CAMERA_SPEED * dt, 2.0f * (float)M_PI);
+            state.angle = state.prevAngle + CAMERA_SPEED * dt;
+            mAnimation.publish();
+        }
+
+        void draw(float alpha) override
+        {
+            GpuScope gpuScope("draw");
+
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            mAnimation.acquire();
+            const animState& state = mAnimation.getReadBuffer();
+            float angle = state.prevAngle + (state.angle - state.prevAngle) * alpha;
+
+            // Orbit inside the scene looking along the path, so most of it is behind the camera
+            float cx = (mSceneMin.x + mSceneMax.x) * 0.5f;
+            float cy = (mSceneMin.y + mSceneMax.y) * 0.5f;
+            float cz = (mSceneMin.z + mSceneMax.z) * 0.5f;
+            float radius =
+                std::max(mSceneMax.x - mSceneMin.x, mSceneMax.z - mSceneMin.z) * 0.25f + 1.0f;
+            float ex = cx + radius * std::cos(angle);
+            float ez = cz + radius * std::sin(angle);
+            float ey = cy + (mSceneMax.y - mSceneMin.y) * 0.25f + 0.5f;
+            Mat4x4 matView = lookAtMatrix(ex, ey, ez,
+                                          ex - std::sin(angle), ey, ez + std::cos(angle),
+                                          0.0f, 1.0f, 0.0f);
+            float aspect = static_cast<float>(getWidth()) / static_cast<float>(getHeight());
+            Mat4x4 matProj = perspectiveMatrix(deg_to_rad(45.0f), aspect, 0.1f, radius * 4.0f);
+            Mat4x4 matViewProj = matProj * matView;
+
+            std::int_fast32_t visibleCount;
+            {
+                TraceScope traceScope("cull");
+                auto start = std::chrono::steady_clock::now();
+                visibleCount = mCuller.cull(matViewProj);
+                mCullTime += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+                mCullFrames++;
+            }
+            // The check draws and reads back the frame with frustum culling alone first
+            const bool check = !mCheckPrefix.empty() && visibleCount > 0;
+            if (check) {
+                drawVisible(matViewProj, visibleCount);
+                readFrame(mCheckFull);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
+            if (mUseOcclusion && visibleCount > 0) {
+                TraceScope traceScope("occlusion");
+                auto start = std::chrono::steady_clock::now();
+                std::int_fast32_t occluded = cullOccluders(matViewProj, ex, ey, ez, visibleCount);
+                if (occluded >= 0) {
+                    mOcclusionTime += std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start).count();
+                    mOccludedTotal += visibleCount - occluded;
+                    visibleCount = occluded;
+                }
+            }
+            mVisibleTotal += visibleCount;
+            if (visibleCount > 0)
+                drawVisible(matViewProj, visibleCount);
+            if (check)
+                checkOcclusion();
         }
 };
 
 int main(int argc, char **argv)
 {
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--scene=", 8) == 0) {
+            sceneViewer app(argc, argv, argv[i] + 8);
+            return app.run();
+        }
+    }
+
     OBJmodelViewer app(argc, argv);
     return app.run();
 }
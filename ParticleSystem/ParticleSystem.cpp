@@ -16,168 +16,467 @@
 #include "sample_util/SampleApplication.h"
 
 #include "common/vector_utils.h"
+#include "sample_util/GpuTimer.h"
+#include "sample_util/StreamingBuffer.h"
+#include "sample_util/TripleBuffer.h"
 #include "sample_util/tga_utils.h"
 #include "util/random_utils.h"
 #include "util/shader_utils.h"
 #include "util/system_utils.h"
 
+#include "util_parallel.hpp"
+#include "util_particles.hpp"
+#include "util_sort.hpp"
+
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using namespace angle;
 
-class ParticleSystemSample : public SampleApplication
+namespace
 {
-  public:
-    ParticleSystemSample(int argc, char **argv) : SampleApplication("ParticleSystem", argc, argv) {}
+constexpr size_t kDefaultParticleCount = 16384;
 
-    bool initialize() override
+// Particle start and end positions from the original sample are kept as
+// start offset and per-second velocity.
+constexpr float kMaxStartRadius = 0.25f;
+constexpr float kMaxSpeed       = 2.0f;
+constexpr float kMinLifetime    = 0.2f;
+constexpr float kMaxLifetime    = 1.0f;
+
+// CPU engine emitters, their rates are sized so the pool stays nearly full
+constexpr int kCPUEmitterCount = 3;
+
+// Transform feedback passes queued between two draws before further steps are merged
+constexpr size_t kMaxGpuSteps = 16;
+
+bool HasArg(int argc, char **argv, const char *arg)
+{
+    for (int i = 1; i < argc; i++)
     {
-        constexpr char kVS[] = R"(uniform float u_time;
-uniform vec3 u_centerPosition;
-attribute float a_lifetime;
-attribute vec3 a_startPosition;
-attribute vec3 a_endPosition;
-varying float v_lifetime;
+        if (strcmp(argv[i], arg) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+long GetIntArg(int argc, char **argv, const char *prefix, long defaultValue)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], prefix, strlen(prefix)) == 0)
+        {
+            return atol(argv[i] + strlen(prefix));
+        }
+    }
+    return defaultValue;
+}
+
+// Compare the radix sort against std::sort on random depths, in ms per sort
+int RunSortBenchmark(long threads)
+{
+    const std::int_fast32_t counts[] = {10000, 100000, 1000000};
+
+    std::unique_ptr<Timer> timer(CreateTimer());
+    RNG rng(1);
+    radixSorter sorter;
+
+    parallelSetThreadCount(threads);
+    std::cout << "Depth sort, ms per sort (threads: " << parallelThreadCount() << ")"
+              << std::endl;
+    std::cout << std::setw(10) << "elements" << std::setw(12) << "std::sort" << std::setw(12)
+              << "radix" << std::setw(12) << "radix+mt" << std::endl;
+
+    for (std::int_fast32_t count : counts)
+    {
+        std::vector<std::uint32_t> depthKeys(count);
+        for (std::uint32_t &key : depthKeys)
+        {
+            key = ~sortKeyFromFloat(rng.randomFloatBetween(-1.0f, 1.0f));
+        }
+
+        const int iterations = std::max<int>(4, static_cast<int>(10000000 / count));
+        std::vector<std::uint32_t> keys;
+        std::vector<std::uint32_t> indices;
+        double results[3];
+
+        for (int method = 0; method < 3; method++)
+        {
+            parallelSetThreadCount(method == 1 ? 1 : threads);
+
+            double total = 0.0;
+            for (int it = 0; it < iterations; it++)
+            {
+                keys = depthKeys;
+
+                timer->start();
+                if (method == 0)
+                {
+                    indices.resize(count);
+                    for (std::int_fast32_t i = 0; i < count; i++)
+                    {
+                        indices[i] = static_cast<std::uint32_t>(i);
+                    }
+                    std::sort(indices.begin(), indices.end(),
+                              [&keys](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+                }
+                else
+                {
+                    sorter.sortIndices(keys.data(), count, indices);
+                }
+                timer->stop();
+                total += timer->getElapsedTime();
+            }
+            results[method] = total * 1e3 / iterations;
+        }
+
+        std::cout << std::setw(10) << count << std::fixed << std::setprecision(3)
+                  << std::setw(12) << results[0] << std::setw(12) << results[1] << std::setw(12)
+                  << results[2] << std::endl;
+    }
+
+    return 0;
+}
+
+// Transform feedback simulation pass. Expired particles are respawned at the
+// emitter with a hashed random state, so emission is continuous.
+constexpr char kSimulationVS[] = R"(#version 300 es
+uniform float u_deltaTime;
+uniform uint u_frame;
+uniform vec3 u_emitterPosition;
+in vec3 a_position;
+in vec3 a_velocity;
+in float a_age;
+in float a_lifetime;
+out vec3 v_position;
+out vec3 v_velocity;
+out float v_age;
+out float v_lifetime;
+
+uint hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+float random(inout uint state)
+{
+    state = hash(state);
+    return float(state >> 8) * (1.0 / 16777216.0);
+}
+
 void main()
 {
-    if (u_time <= a_lifetime)
+    float age = a_age + u_deltaTime;
+    if (age >= a_lifetime)
     {
-        gl_Position.xyz = a_startPosition + (u_time * a_endPosition);
-        gl_Position.xyz += u_centerPosition;
-        gl_Position.w = 1.0;
+        uint state = uint(gl_VertexID) * 1664525u + u_frame * 1013904223u;
+        float startAngle  = random(state) * 6.2831853;
+        float startRadius = random(state) * 0.25;
+        float endAngle    = random(state) * 6.2831853;
+        float endRadius   = random(state) * 2.0;
+        v_position = u_emitterPosition + vec3(sin(startAngle), cos(startAngle), 0.0) * startRadius;
+        v_velocity = vec3(sin(endAngle), cos(endAngle), 0.0) * endRadius;
+        v_age      = 0.0;
+        v_lifetime = mix(0.2, 1.0, random(state));
     }
     else
     {
-        gl_Position = vec4(-1000, -1000, 0, 0);
+        v_position = a_position + a_velocity * u_deltaTime;
+        v_velocity = a_velocity;
+        v_age      = age;
+        v_lifetime = a_lifetime;
     }
-    v_lifetime = 1.0 - (u_time / a_lifetime);
-    v_lifetime = clamp(v_lifetime, 0.0, 1.0);
-    gl_PointSize = (v_lifetime * v_lifetime) * 40.0;
 })";
 
-        constexpr char kFS[] = R"(precision mediump float;
+constexpr char kSimulationFS[] = R"(#version 300 es
+void main()
+{
+})";
+
+constexpr char kRenderVS3[] = R"(#version 300 es
+uniform float u_pointScale;
+in vec3 a_position;
+in float a_age;
+in float a_lifetime;
+out float v_life;
+void main()
+{
+    v_life = clamp(1.0 - a_age / a_lifetime, 0.0, 1.0);
+    gl_Position = vec4(a_position, 1.0);
+    gl_PointSize = (v_life * v_life) * u_pointScale;
+})";
+
+constexpr char kRenderFS3[] = R"(#version 300 es
+precision mediump float;
+uniform vec4 u_color;
+uniform sampler2D s_texture;
+in float v_life;
+out vec4 fragColor;
+void main()
+{
+    fragColor = u_color * texture(s_texture, gl_PointCoord);
+    fragColor.a *= v_life;
+})";
+
+constexpr char kRenderVS2[] = R"(uniform float u_pointScale;
+attribute vec3 a_position;
+attribute float a_life;
+varying float v_life;
+void main()
+{
+    v_life = a_life;
+    gl_Position = vec4(a_position, 1.0);
+    gl_PointSize = (v_life * v_life) * u_pointScale;
+})";
+
+constexpr char kRenderFS2[] = R"(precision mediump float;
 uniform vec4 u_color;
-varying float v_lifetime;
 uniform sampler2D s_texture;
+varying float v_life;
 void main()
 {
-    vec4 texColor;
-    texColor = texture2D(s_texture, gl_PointCoord);
-    gl_FragColor = vec4(u_color) * texColor;
-    gl_FragColor.a *= v_lifetime;
+    gl_FragColor = u_color * texture2D(s_texture, gl_PointCoord);
+    gl_FragColor.a *= v_life;
 })";
+}  // anonymous namespace
+
+class ParticleSystemSample : public SampleApplication
+{
+  public:
+    ParticleSystemSample(int argc, char **argv)
+        : SampleApplication("ParticleSystem", argc, argv, HasArg(argc, argv, "--es2") ? 2 : 3, 0),
+          mParticleCount(std::max(1l, GetIntArg(argc, argv, "--particles=",
+                                                  static_cast<long>(kDefaultParticleCount)))),
+          mForceCPU(HasArg(argc, argv, "--cpu") || HasArg(argc, argv, "--sort")),
+          mSortParticles(HasArg(argc, argv, "--sort"))
+    {
+        parallelSetThreadCount(GetIntArg(argc, argv, "--threads=", 0));
+    }
 
-        mProgram = CompileProgram(kVS, kFS);
-        if (!mProgram)
+    bool initialize() override
+    {
+        // Use the transform feedback path whenever the context is ES3
+        mUseTransformFeedback = !mForceCPU && IsGLES3OrLater();
+        std::cout << "ParticleSystem: " << mParticleCount << " particles, "
+                  << (mUseTransformFeedback ? "GPU transform feedback" : "CPU") << " simulation";
+        if (!mUseTransformFeedback)
+        {
+            std::cout << " on " << parallelThreadCount() << " threads";
+            if (isThreaded())
+            {
+                std::cout << ", decoupled from rendering";
+            }
+        }
+        std::cout << std::endl;
+
+        // The programs compile on driver threads while the texture loads
+        AsyncProgram renderProgram = mUseTransformFeedback
+                                         ? CompileProgramAsync(kRenderVS3, kRenderFS3)
+                                         : CompileProgramAsync(kRenderVS2, kRenderFS2);
+        AsyncProgram simulationProgram;
+        if (mUseTransformFeedback)
+        {
+            auto setVaryings = [](GLuint program) {
+                const char *varyings[] = {"v_position", "v_velocity", "v_age", "v_lifetime"};
+                glTransformFeedbackVaryings(program, 4, varyings, GL_INTERLEAVED_ATTRIBS);
+            };
+            simulationProgram = CompileProgramAsync(kSimulationVS, kSimulationFS, setVaryings);
+        }
+
+        std::stringstream smokeStr;
+        smokeStr << angle::GetExecutableDirectory() << "/smoke.tga";
+
+        TGAImage img;
+        if (LoadTGAImageFromFile(smokeStr.str(), &img))
+        {
+            mTextureID = LoadTextureFromTGAImage(img);
+        }
+
+        mRenderProgram     = ResolveProgram(&renderProgram);
+        mSimulationProgram = ResolveProgram(&simulationProgram);
+        if (!mTextureID || !mRenderProgram || (mUseTransformFeedback && !mSimulationProgram))
         {
             return false;
         }
 
         // Get the attribute locations
-        mLifetimeLoc      = glGetAttribLocation(mProgram, "a_lifetime");
-        mStartPositionLoc = glGetAttribLocation(mProgram, "a_startPosition");
-        mEndPositionLoc   = glGetAttribLocation(mProgram, "a_endPosition");
+        mPositionLoc = glGetAttribLocation(mRenderProgram, "a_position");
+        mAgeLoc      = glGetAttribLocation(mRenderProgram, "a_age");
+        mLifetimeLoc = glGetAttribLocation(mRenderProgram, "a_lifetime");
+        mLifeLoc     = glGetAttribLocation(mRenderProgram, "a_life");
 
         // Get the uniform locations
-        mTimeLoc           = glGetUniformLocation(mProgram, "u_time");
-        mCenterPositionLoc = glGetUniformLocation(mProgram, "u_centerPosition");
-        mColorLoc          = glGetUniformLocation(mProgram, "u_color");
-        mSamplerLoc        = glGetUniformLocation(mProgram, "s_texture");
+        mPointScaleLoc = glGetUniformLocation(mRenderProgram, "u_pointScale");
+        mColorLoc      = glGetUniformLocation(mRenderProgram, "u_color");
+        mSamplerLoc    = glGetUniformLocation(mRenderProgram, "s_texture");
 
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-        // Fill in particle data array
-        for (size_t i = 0; i < mParticleCount; i++)
-        {
-            mParticles[i].lifetime = mRNG.randomFloatBetween(0.0f, 1.0f);
-
-            float endAngle                = mRNG.randomFloatBetween(0, 2.0f * float(M_PI));
-            float endRadius               = mRNG.randomFloatBetween(0.0f, 2.0f);
-            mParticles[i].endPosition.x() = sinf(endAngle) * endRadius;
-            mParticles[i].endPosition.y() = cosf(endAngle) * endRadius;
-            mParticles[i].endPosition.z() = 0.0f;
-
-            float startAngle                = mRNG.randomFloatBetween(0, 2.0f * float(M_PI));
-            float startRadius               = mRNG.randomFloatBetween(0.0f, 0.25f);
-            mParticles[i].startPosition.x() = sinf(startAngle) * startRadius;
-            mParticles[i].startPosition.y() = cosf(startAngle) * startRadius;
-            mParticles[i].startPosition.z() = 0.0f;
-        }
+        // Shrink the sprites as the particle count goes up to keep fill rate sane
+        mPointScale = 40.0f * std::min(1.0f, sqrtf(1024.0f / mParticleCount));
 
-        mParticleTime = 1.0f;
+        mEmitterPosition = Vector3(0.0f, 0.0f, 0.0f);
+        mColor           = Vector4(1.0f, 1.0f, 1.0f, 0.5f);
+        mDrawColor       = mColor;
 
-        std::stringstream smokeStr;
-        smokeStr << angle::GetExecutableDirectory() << "/smoke.tga";
-
-        TGAImage img;
-        if (!LoadTGAImageFromFile(smokeStr.str(), &img))
+        if (mUseTransformFeedback)
         {
-            return false;
+            if (!initializeTransformFeedback())
+            {
+                return false;
+            }
         }
-        mTextureID = LoadTextureFromTGAImage(img);
-        if (!mTextureID)
+        else
         {
-            return false;
+            if (!initializeCPU())
+            {
+                return false;
+            }
+            if (mSortParticles && !initializeSorting())
+            {
+                mSortParticles = false;
+            }
         }
 
         return true;
     }
 
-    void destroy() override { glDeleteProgram(mProgram); }
+    void destroy() override
+    {
+        if (mUseTransformFeedback)
+        {
+            glDeleteVertexArrays(2, mSimulationVAOs);
+            glDeleteVertexArrays(2, mRenderVAOs);
+            glDeleteProgram(mSimulationProgram);
+        }
+        else if (mVertexStream)
+        {
+            mVertexStream->destroy();
+            if (mIndexStream)
+            {
+                mIndexStream->destroy();
+            }
+        }
+        glDeleteBuffers(2, mVertexBuffers);
+        glDeleteTextures(1, &mTextureID);
+        glDeleteProgram(mRenderProgram);
+    }
 
-    void step(float dt, double totalTime) override
+    // CPU engine step, on the update thread with --threaded. Only the snapshot is shared
+    // with draw(). The transform feedback path only moves the emitters here and queues the
+    // step, draw() runs one simulation pass per queued step, so --fixed-step and benchmark
+    // runs advance the GPU particles by the same fixed steps as the CPU ones.
+    void update(float dt, double totalTime) override
     {
-        // Use the program object
-        glUseProgram(mProgram);
+        moveEmitters(dt);
 
-        mParticleTime += dt;
-        if (mParticleTime >= 1.0f)
+        if (mUseTransformFeedback)
         {
-            mParticleTime = 0.0f;
+            GpuStep step;
+            step.dt              = dt;
+            step.emitterPosition = mEmitterPosition;
+            step.color           = mColor;
+
+            std::lock_guard<std::mutex> lock(mGpuStepMutex);
+            if (mGpuSteps.size() < kMaxGpuSteps)
+            {
+                mGpuSteps.push_back(step);
+            }
+            else
+            {
+                // The renderer has fallen far behind, fold the time into the last pass
+                step.dt += mGpuSteps.back().dt;
+                mGpuSteps.back() = step;
+            }
+            return;
+        }
 
-            // Pick a new start location and color
-            Vector3 centerPos(mRNG.randomFloatBetween(-0.5f, 0.5f),
-                              mRNG.randomFloatBetween(-0.5f, 0.5f),
-                              mRNG.randomFloatBetween(-0.5f, 0.5f));
-            glUniform3fv(mCenterPositionLoc, 1, centerPos.data());
+        mParticlePool->update(dt);
 
-            // Random color
-            Vector4 color(mRNG.randomFloatBetween(0.0f, 1.0f), mRNG.randomFloatBetween(0.0f, 1.0f),
-                          mRNG.randomFloatBetween(0.0f, 1.0f), 0.5f);
-            glUniform4fv(mColorLoc, 1, color.data());
+        ParticleSnapshot &snapshot = mSnapshots.getWriteBuffer();
+        const particleVertex *vertices = mParticlePool->getVertices();
+        snapshot.vertices.assign(vertices, vertices + mParticlePool->getVertexCount());
+        if (mSortParticles)
+        {
+            sortParticles(&snapshot);
         }
-
-        // Load uniform time variable
-        glUniform1f(mTimeLoc, mParticleTime);
+        snapshot.color = mColor;
+        mSnapshots.publish();
     }
 
-    void draw() override
+    void draw(float alpha) override
     {
+        if (mUseTransformFeedback)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mGpuStepMutex);
+                mDrawGpuSteps.swap(mGpuSteps);
+            }
+            for (const GpuStep &step : mDrawGpuSteps)
+            {
+                simulateGPU(step);
+            }
+            if (!mDrawGpuSteps.empty())
+            {
+                mDrawColor = mDrawGpuSteps.back().color;
+            }
+            mDrawGpuSteps.clear();
+        }
+
+        GpuScope gpuScope("draw");
+
         // Set the viewport
-        glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+        glViewport(0, 0, getRenderWidth(), getRenderHeight());
 
         // Clear the color buffer
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // Use the program object
-        glUseProgram(mProgram);
+        // Latest CPU simulation result, the previous one is drawn again when nothing new
+        // was published
+        mSnapshots.acquire();
+        const ParticleSnapshot &snapshot = mSnapshots.getReadBuffer();
 
-        // Load the vertex attributes
-        glVertexAttribPointer(mLifetimeLoc, 1, GL_FLOAT, GL_FALSE, sizeof(Particle),
-                              &mParticles[0].lifetime);
-        glVertexAttribPointer(mEndPositionLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Particle),
-                              &mParticles[0].endPosition);
-        glVertexAttribPointer(mStartPositionLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Particle),
-                              &mParticles[0].startPosition);
+        // Use the program object
+        glUseProgram(mRenderProgram);
+        glUniform1f(mPointScaleLoc, mPointScale);
+        glUniform4fv(mColorLoc, 1,
+                     mUseTransformFeedback ? mDrawColor.data() : snapshot.color.data());
 
-        glEnableVertexAttribArray(mLifetimeLoc);
-        glEnableVertexAttribArray(mEndPositionLoc);
-        glEnableVertexAttribArray(mStartPositionLoc);
+        if (mUseTransformFeedback)
+        {
+            // The simulation wrote into the other buffer
+            glBindVertexArray(mRenderVAOs[mCurrentBuffer]);
+        }
+        else
+        {
+            uploadCPUVertices(snapshot);
+        }
 
-        // Blend particles
+        // Blend particles, sorted ones can use regular alpha blending
         glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        if (mSortParticles)
+        {
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        else
+        {
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        }
 
         // Bind the texture
         glActiveTexture(GL_TEXTURE0);
@@ -186,42 +485,390 @@ void main()
         // Set the sampler texture unit to 0
         glUniform1i(mSamplerLoc, 0);
 
-        glDrawArrays(GL_POINTS, 0, mParticleCount);
+        const GLsizei drawCount = mUseTransformFeedback
+                                      ? static_cast<GLsizei>(mParticleCount)
+                                      : static_cast<GLsizei>(snapshot.vertices.size());
+        if (mSortParticles)
+        {
+            glDrawElements(GL_POINTS, drawCount, mIndexType, mIndexOffset);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        else
+        {
+            glDrawArrays(GL_POINTS, 0, drawCount);
+        }
+
+        if (mUseTransformFeedback)
+        {
+            glBindVertexArray(0);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            mVertexStream->endFrame();
+            if (mSortParticles)
+            {
+                mIndexStream->endFrame();
+            }
+        }
     }
 
   private:
-    // Handle to a program object
-    GLuint mProgram;
+    // Particle vertex data, the layout matches the transform feedback varyings
+    struct Particle
+    {
+        Vector3 position;
+        Vector3 velocity;
+        float age;
+        float lifetime;
+    };
+    static_assert(sizeof(Particle) == 8 * sizeof(float), "Unexpected particle layout");
+
+    // One transform feedback pass queued by update()
+    struct GpuStep
+    {
+        float dt;
+        Vector3 emitterPosition;
+        Vector4 color;
+    };
+
+    // Everything draw() needs from one CPU simulation step
+    struct ParticleSnapshot
+    {
+        std::vector<particleVertex> vertices;
+        std::vector<std::uint32_t> sortedIndices;
+        Vector4 color;
+    };
+
+    // Pick a new emitter location and color once a second
+    void moveEmitters(float dt)
+    {
+        mEmitterTime += dt;
+        if (mEmitterTime < 1.0f)
+        {
+            return;
+        }
+        mEmitterTime = 0.0f;
+
+        mEmitterPosition = Vector3(mRNG.randomFloatBetween(-0.5f, 0.5f),
+                                   mRNG.randomFloatBetween(-0.5f, 0.5f),
+                                   mRNG.randomFloatBetween(-0.5f, 0.5f));
+        mColor           = Vector4(mRNG.randomFloatBetween(0.0f, 1.0f),
+                                   mRNG.randomFloatBetween(0.0f, 1.0f),
+                                   mRNG.randomFloatBetween(0.0f, 1.0f), 0.5f);
+
+        if (!mUseTransformFeedback)
+        {
+            for (int i = 0; i < mParticlePool->getEmitterCount(); i++)
+            {
+                particleEmitter *emitter = mParticlePool->getEmitter(i);
+                emitter->position.x      = mRNG.randomFloatBetween(-0.6f, 0.6f);
+                emitter->position.y      = mRNG.randomFloatBetween(-0.2f, 0.6f);
+                emitter->position.z      = mRNG.randomFloatBetween(-0.5f, 0.5f);
+            }
+        }
+    }
+
+    void spawnParticle(Particle *particle)
+    {
+        float startAngle   = mRNG.randomFloatBetween(0, 2.0f * float(M_PI));
+        float startRadius  = mRNG.randomFloatBetween(0.0f, kMaxStartRadius);
+        particle->position = Vector3(mEmitterPosition.x() + sinf(startAngle) * startRadius,
+                                     mEmitterPosition.y() + cosf(startAngle) * startRadius,
+                                     mEmitterPosition.z());
+
+        float endAngle     = mRNG.randomFloatBetween(0, 2.0f * float(M_PI));
+        float endRadius    = mRNG.randomFloatBetween(0.0f, kMaxSpeed);
+        particle->velocity = Vector3(sinf(endAngle) * endRadius, cosf(endAngle) * endRadius, 0.0f);
+
+        particle->age      = 0.0f;
+        particle->lifetime = mRNG.randomFloatBetween(kMinLifetime, kMaxLifetime);
+    }
+
+    // SoA engine on the worker pool, streamed through a ring buffer
+    bool initializeCPU()
+    {
+        mParticlePool.reset(new particlePool(static_cast<std::int_fast32_t>(mParticleCount)));
+
+        // Steady state population is rate * mean lifetime
+        const float meanLifetime = 0.5f * (kMinLifetime + kMaxLifetime) + 0.5f;
+        for (int i = 0; i < kCPUEmitterCount; i++)
+        {
+            particleEmitter emitter;
+            emitter.position    = {0.0f, 0.0f, 0.0f};
+            emitter.rate        = 0.95f * mParticleCount / (kCPUEmitterCount * meanLifetime);
+            emitter.radius      = kMaxStartRadius * 0.25f;
+            emitter.speed       = kMaxSpeed * 0.5f;
+            emitter.minLifetime = kMinLifetime + 0.5f;
+            emitter.maxLifetime = kMaxLifetime + 0.5f;
+            emitter.accumulator = 0.0f;
+            mParticlePool->addEmitter(emitter);
+        }
+
+        particleForces &forces = mParticlePool->getForces();
+        forces.gravity         = {0.0f, -1.5f, 0.0f};
+        forces.drag            = 0.5f;
+        forces.floor           = true;
+        forces.floorY          = -0.9f;
+        forces.restitution     = 0.6f;
+        mParticlePool->addAttractor({{0.0f, 0.2f, 0.0f}, 0.05f});
+
+        mVertexStream.reset(new StreamingBuffer(
+            GL_ARRAY_BUFFER, sizeof(particleVertex) * mParticlePool->getCapacity()));
+        return mVertexStream->initialize();
+    }
+
+    // The ring never hands out memory the GPU may still be reading
+    void uploadCPUVertices(const ParticleSnapshot &snapshot)
+    {
+        const size_t count = snapshot.vertices.size();
+
+        mVertexStream->beginFrame();
+        StreamSpan<particleVertex> vertices = mVertexStream->allocate<particleVertex>(count);
+        if (vertices.valid())
+        {
+            memcpy(vertices.data, snapshot.vertices.data(), vertices.byteSize());
+        }
+        mVertexStream->flush();
+
+        const uint8_t *base = reinterpret_cast<const uint8_t *>(vertices.offsetPointer());
+        glVertexAttribPointer(mPositionLoc, 3, GL_FLOAT, GL_FALSE, sizeof(particleVertex),
+                              base + offsetof(particleVertex, x));
+        glEnableVertexAttribArray(mPositionLoc);
+        glVertexAttribPointer(mLifeLoc, 1, GL_FLOAT, GL_FALSE, sizeof(particleVertex),
+                              base + offsetof(particleVertex, life));
+        glEnableVertexAttribArray(mLifeLoc);
+
+        if (mSortParticles)
+        {
+            mIndexStream->beginFrame();
+            if (mIndexType == GL_UNSIGNED_INT)
+            {
+                StreamSpan<GLuint> indices = mIndexStream->allocate<GLuint>(count);
+                if (indices.valid())
+                {
+                    std::copy(snapshot.sortedIndices.begin(), snapshot.sortedIndices.end(),
+                              indices.begin());
+                }
+                mIndexOffset = indices.offsetPointer();
+            }
+            else
+            {
+                StreamSpan<GLushort> indices = mIndexStream->allocate<GLushort>(count);
+                if (indices.valid())
+                {
+                    std::copy(snapshot.sortedIndices.begin(), snapshot.sortedIndices.end(),
+                              indices.begin());
+                }
+                mIndexOffset = indices.offsetPointer();
+            }
+            mIndexStream->flush();
+        }
+    }
+
+    // 32-bit indices need ES3 or OES_element_index_uint, otherwise the pool must fit in 16 bits
+    bool initializeSorting()
+    {
+        const bool uintIndices = IsGLES3OrLater() || HasGLExtension("GL_OES_element_index_uint");
+
+        if (uintIndices)
+        {
+            mIndexType = GL_UNSIGNED_INT;
+        }
+        else if (mParticlePool->getCapacity() <= 65536)
+        {
+            mIndexType = GL_UNSIGNED_SHORT;
+        }
+        else
+        {
+            std::cout << "ParticleSystem: no 32-bit index support, depth sorting disabled"
+                      << std::endl;
+            return false;
+        }
+
+        mSortKeys.resize(mParticlePool->getCapacity());
+        mIndexStream.reset(new StreamingBuffer(
+            GL_ELEMENT_ARRAY_BUFFER,
+            (mIndexType == GL_UNSIGNED_INT ? sizeof(GLuint) : sizeof(GLushort)) *
+                mParticlePool->getCapacity()));
+        return mIndexStream->initialize();
+    }
+
+    // Back-to-front order: larger NDC z is farther away, so sort on descending z
+    void sortParticles(ParticleSnapshot *snapshot)
+    {
+        const std::int_fast32_t count  = static_cast<std::int_fast32_t>(snapshot->vertices.size());
+        const particleVertex *vertices = snapshot->vertices.data();
+        std::uint32_t *keys            = mSortKeys.data();
+        parallelFor(count, 16384, [=](std::int_fast32_t begin, std::int_fast32_t end) {
+            for (std::int_fast32_t i = begin; i < end; i++)
+            {
+                keys[i] = ~sortKeyFromFloat(vertices[i].z);
+            }
+        });
+        mSorter.sortIndices(keys, count, snapshot->sortedIndices);
+    }
+
+    bool initializeTransformFeedback()
+    {
+        // Ages are spread over the lifetimes so particles expire continuously
+        std::vector<Particle> particles(mParticleCount);
+        for (Particle &particle : particles)
+        {
+            spawnParticle(&particle);
+            particle.age = mRNG.randomFloatBetween(0.0f, particle.lifetime);
+        }
+
+        mDeltaTimeLoc       = glGetUniformLocation(mSimulationProgram, "u_deltaTime");
+        mFrameLoc           = glGetUniformLocation(mSimulationProgram, "u_frame");
+        mEmitterPositionLoc = glGetUniformLocation(mSimulationProgram, "u_emitterPosition");
+
+        // Both buffers start with the same state, the first pass overwrites one of them
+        glGenBuffers(2, mVertexBuffers);
+        glGenVertexArrays(2, mSimulationVAOs);
+        glGenVertexArrays(2, mRenderVAOs);
+
+        const GLint simPositionLoc = glGetAttribLocation(mSimulationProgram, "a_position");
+        const GLint simVelocityLoc = glGetAttribLocation(mSimulationProgram, "a_velocity");
+        const GLint simAgeLoc      = glGetAttribLocation(mSimulationProgram, "a_age");
+        const GLint simLifetimeLoc = glGetAttribLocation(mSimulationProgram, "a_lifetime");
+
+        for (int i = 0; i < 2; i++)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffers[i]);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(Particle) * mParticleCount, particles.data(),
+                         GL_DYNAMIC_COPY);
+
+            glBindVertexArray(mSimulationVAOs[i]);
+            setAttribute(simPositionLoc, 3, offsetof(Particle, position));
+            setAttribute(simVelocityLoc, 3, offsetof(Particle, velocity));
+            setAttribute(simAgeLoc, 1, offsetof(Particle, age));
+            setAttribute(simLifetimeLoc, 1, offsetof(Particle, lifetime));
+
+            glBindVertexArray(mRenderVAOs[i]);
+            setRenderAttributes();
+        }
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        return glGetError() == GL_NO_ERROR;
+    }
+
+    // Run one simulation step from the current buffer into the other one
+    void simulateGPU(const GpuStep &step)
+    {
+        GpuScope gpuScope("simulate");
+        const int dst = mCurrentBuffer ^ 1;
+
+        glUseProgram(mSimulationProgram);
+        glUniform1f(mDeltaTimeLoc, step.dt);
+        glUniform1ui(mFrameLoc, mFrame++);
+        glUniform3fv(mEmitterPositionLoc, 1, step.emitterPosition.data());
+
+        glBindVertexArray(mSimulationVAOs[mCurrentBuffer]);
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, mVertexBuffers[dst]);
+
+        glEnable(GL_RASTERIZER_DISCARD);
+        glBeginTransformFeedback(GL_POINTS);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mParticleCount));
+        glEndTransformFeedback();
+        glDisable(GL_RASTERIZER_DISCARD);
+
+        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+        glBindVertexArray(0);
+
+        mCurrentBuffer = dst;
+    }
+
+    static void setAttribute(GLint location, GLint size, size_t offset)
+    {
+        if (location < 0)
+        {
+            return;
+        }
+        glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, sizeof(Particle),
+                              reinterpret_cast<const void *>(offset));
+        glEnableVertexAttribArray(location);
+    }
+
+    // Render attributes from the buffer bound to GL_ARRAY_BUFFER
+    void setRenderAttributes()
+    {
+        setAttribute(mPositionLoc, 3, offsetof(Particle, position));
+        setAttribute(mAgeLoc, 1, offsetof(Particle, age));
+        setAttribute(mLifetimeLoc, 1, offsetof(Particle, lifetime));
+    }
+
+    // Handle to the program objects
+    GLuint mRenderProgram     = 0;
+    GLuint mSimulationProgram = 0;
 
     // Attribute locations
+    GLint mPositionLoc;
+    GLint mAgeLoc;
     GLint mLifetimeLoc;
-    GLint mStartPositionLoc;
-    GLint mEndPositionLoc;
+    GLint mLifeLoc;
 
-    // Uniform location
-    GLint mTimeLoc;
+    // Uniform locations
+    GLint mPointScaleLoc;
     GLint mColorLoc;
-    GLint mCenterPositionLoc;
     GLint mSamplerLoc;
+    GLint mDeltaTimeLoc;
+    GLint mFrameLoc;
+    GLint mEmitterPositionLoc;
 
     // Texture handle
-    GLuint mTextureID;
-
-    // Particle vertex data
-    struct Particle
-    {
-        float lifetime;
-        Vector3 startPosition;
-        Vector3 endPosition;
-    };
-    static const size_t mParticleCount = 1024;
-    std::array<Particle, mParticleCount> mParticles;
-    float mParticleTime;
+    GLuint mTextureID = 0;
+
+    // Particle state, ping-ponged between the two buffers on the GPU path
+    GLuint mVertexBuffers[2]  = {0, 0};
+    GLuint mSimulationVAOs[2] = {0, 0};
+    GLuint mRenderVAOs[2]     = {0, 0};
+    int mCurrentBuffer        = 0;
+    GLuint mFrame             = 0;
+
+    bool mUseTransformFeedback = false;
+    const size_t mParticleCount;
+    const bool mForceCPU;
+    std::unique_ptr<particlePool> mParticlePool;
+
+    // Depth sorting of the CPU particles
+    bool mSortParticles;
+    radixSorter mSorter;
+    std::vector<std::uint32_t> mSortKeys;
+    GLenum mIndexType        = GL_UNSIGNED_INT;
+    const void *mIndexOffset = nullptr;
+
+    // CPU simulation results handed from update() to draw()
+    TripleBuffer<ParticleSnapshot> mSnapshots;
+
+    // Per-frame dynamic data of the CPU path
+    std::unique_ptr<StreamingBuffer> mVertexStream;
+    std::unique_ptr<StreamingBuffer> mIndexStream;
+    float mPointScale;
+
+    // Emitter state, owned by update()
+    Vector3 mEmitterPosition;
+    Vector4 mColor;
+    float mEmitterTime = 0.0f;
     RNG mRNG;
+
+    // Transform feedback passes update() queued for the next draw(), and the color of the
+    // last one drawn
+    std::mutex mGpuStepMutex;
+    std::vector<GpuStep> mGpuSteps;
+    std::vector<GpuStep> mDrawGpuSteps;
+    Vector4 mDrawColor;
 };
 
 int main(int argc, char **argv)
 {
+    if (HasArg(argc, argv, "--bench-sort"))
+    {
+        return RunSortBenchmark(GetIntArg(argc, argv, "--threads=", 0));
+    }
+
     ParticleSystemSample app(argc, argv);
     return app.run();
 }
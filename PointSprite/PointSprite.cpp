@@ -29,18 +29,71 @@
 //
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "sample_util/GpuTimer.h"
 #include "sample_util/SampleApplication.h"
+#include "sample_util/StreamingBuffer.h"
+#include "sample_util/TripleBuffer.h"
 #include "util/shader_utils.h"
 #include "sample_util/tga_utils.h"
-#include "util/system_utils.h"
 
 #include "util_matrix.hpp"
 #include "util_modelgen.hpp"
+#include "util_parallel.hpp"
+#include "util_simd.hpp"
+#include "util_sort.hpp"
+
+// Sphere animation backends
+enum class animMode {
+    CPU = 0,    // Per-vertex scalar loop, the original implementation
+    SIMD,       // 4-wide batch kernel into an orphaned stream buffer
+    SHADER      // Static buffer, scale applied in the vertex shader
+};
+
+// Frames averaged per frame-time report
+#define REPORT_FRAMES 300
+
+// Frames each --sweep run draws before and while measuring
+#define SWEEP_WARMUP_FRAMES 60
+#define SWEEP_FRAMES 300
+
+// Rotation and pulse speeds in radians per second, the former 0.01 and 3 degrees per
+// frame at 60 fps
+#define ROTATION_SPEED 0.6f
+#define PULSE_SPEED ((float)M_PI)
+
+// Rotation and pulse phase before and after the latest update, draw() blends between them
+struct animState {
+    float prevAngle = 0.0f;
+    float angle = 0.0f;
+    float prevPulse = 0.0f;
+    float pulse = 0.0f;
+};
+
+// Scale count floats from src into dst, 3 components per vertex share one factor
+static void scaleVerticesSIMD(float* dst, const float* src, std::int_fast32_t count, float scale)
+{
+    const simd4f s = simdSet1(scale);
+    parallelFor(count, 65536, [=](std::int_fast32_t begin, std::int_fast32_t end) {
+        auto i = begin;
+        for (; i + SIMD_WIDTH <= end; i += SIMD_WIDTH) {
+            simdStore(&dst[i], simdLoad(&src[i]) * s);
+        }
+        for (; i < end; i++) {
+            dst[i] = src[i] * scale;
+        }
+    });
+}
 
 class PointSprite : public SampleApplication
 {
@@ -54,43 +107,97 @@ class PointSprite : public SampleApplication
         GLint  aColor;
         GLint  uSampler;
         GLint  uMatProj;
+        GLint  uScale;
 
         // transform matrix for static(background) images
         Mat4x4 matBack;
 
         // Sphere model parameters
-        modelSphere*            mdlSphere;
-        static const int        mSphereRow  = 64;
-        static const int        mSphereCol  = 64;
+        std::unique_ptr<modelSphere> mdlSphere;
+        int                     mSphereRow  = 64;
+        int                     mSphereCol  = 64;
         static constexpr float  mSphereRad  = 0.5f;
 
-        // Sphere coordinates
-        static const int spherePosSize = mSphereRow * mSphereCol;
-        std::array<vec3, spherePosSize>  mPosition;
+        // Sphere coordinates, streamed per frame on the CPU paths
+        int spherePosSize;
+        std::unique_ptr<StreamingBuffer> mVertexStream;
+        std::unique_ptr<StreamingBuffer> mIndexStream;
+
+        // Back-to-front ordering for alpha blending
+        bool mSortSprites = false;
+        radixSorter mSorter;
+        std::vector<std::uint32_t> mSortKeys;
+        std::vector<std::uint32_t> mSortedIndices;
 
         // Animation parameters
-        int   mCount = 0;
+        animMode mAnimMode = animMode::SHADER;
+
+        // Owned by update(), draw() reads the published snapshots
         float mAngle = 0.0f;
+        float mPulse = 0.0f;
+        TripleBuffer<animState> mAnimation;
 
-        // Timer for vsync emulation
+        // Timer for the frame time statistics
         Timer *mTimer;
-        float  mTime;
+
+        // Frame time statistics, measured before the frame pacer wait
+        double mUpdateTime = 0.0;
+        double mLastUpdateTime = 0.0;
+        double mFrameTime = 0.0;
+        int    mReportFrames = 0;
+
+        // --sweep waits for the GPU in draw() and keeps totals over the measured frames
+        bool   mSweep = false;
+        double mSweepFrameTime = 0.0;
+        double mSweepUpdateTime = 0.0;
+        int    mSweepFrames = 0;
+        int    mDrawnFrames = 0;
 
     public:
         PointSprite(int argc, char **argv)
             : SampleApplication("PointSprite", argc, argv, 2, 0)
         {
+            // 60 fps unless --fps says otherwise
+            setTargetFrameRate(60.0);
+
+            for (int i = 1; i < argc; i++) {
+                if (strcmp(argv[i], "--sort") == 0) {
+                    mSortSprites = true;
+                } else if (strcmp(argv[i], "--anim=cpu") == 0) {
+                    mAnimMode = animMode::CPU;
+                } else if (strcmp(argv[i], "--anim=simd") == 0) {
+                    mAnimMode = animMode::SIMD;
+                } else if (strcmp(argv[i], "--anim=shader") == 0) {
+                    mAnimMode = animMode::SHADER;
+                } else if (strncmp(argv[i], "--sphere=", 9) == 0) {
+                    mSphereRow = mSphereCol = std::max(2, std::min(1024, atoi(argv[i] + 9)));
+                } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+                    parallelSetThreadCount(atoi(argv[i] + 10));
+                } else if (strcmp(argv[i], "--sweep") == 0) {
+                    mSweep = true;
+                }
+            }
+            spherePosSize = mSphereRow * mSphereCol;
+        }
+
+        // Mean frame and update time in ms over the frames measured with --sweep
+        double getSweepFrameTime() const {
+            return mSweepFrames > 0 ? mSweepFrameTime * 1e3 / mSweepFrames : 0.0;
+        }
+        double getSweepUpdateTime() const {
+            return mSweepFrames > 0 ? mSweepUpdateTime * 1e3 / mSweepFrames : 0.0;
         }
 
         bool initialize() override {
             constexpr char kVS[] = R"(
 #version 100
 uniform mat4 u_m4Proj;
+uniform float u_fScale;
 attribute vec4 a_v4Position;
 attribute vec4 a_v4Color;
 varying   vec4 v_v4Color;
 void main() {
-    gl_Position = u_m4Proj * a_v4Position;
+    gl_Position = u_m4Proj * vec4(a_v4Position.xyz * u_fScale, 1.0);
     gl_PointSize = 16.0;
     v_v4Color = a_v4Color;
 }
@@ -124,6 +231,7 @@ void main() {
 
             uMatProj  = glGetUniformLocation(mProgram, "u_m4Proj");
             uSampler  = glGetUniformLocation(mProgram, "s_texture");
+            uScale    = glGetUniformLocation(mProgram, "u_fScale");
 
             // Initialize matrix
             Mat4x4 matProj = orthogonalMatrix(-1.7f, 1.7f, -1.0f, 1.0f, 0.0f, 20.0f);
@@ -131,17 +239,24 @@ void main() {
             matBack = matProj * matView;
 
             // Initialize model
-            mdlSphere = new modelSphere(vboFormat::SEPARATE, mSphereRow, mSphereCol, mSphereRad);
+            mdlSphere.reset(new modelSphere(vboFormat::SEPARATE, mSphereRow, mSphereCol, mSphereRad));
 
             // Create and initialize buffer object
-            glGenBuffers(1, &mVertBuffer);
-            glBindBuffer(GL_ARRAY_BUFFER, mVertBuffer);
-            glBufferData(
-                    GL_ARRAY_BUFFER,
-                    sizeof(vec3) * mdlSphere->getVerticesSize(),
-                    mdlSphere->getVertices(),
-                    GL_STREAM_DRAW
-            );
+            if (mAnimMode == animMode::SHADER) {
+                glGenBuffers(1, &mVertBuffer);
+                glBindBuffer(GL_ARRAY_BUFFER, mVertBuffer);
+                glBufferData(
+                        GL_ARRAY_BUFFER,
+                        sizeof(vec3) * mdlSphere->getVerticesSize(),
+                        mdlSphere->getVertices(),
+                        GL_STATIC_DRAW
+                );
+            } else {
+                mVertexStream.reset(new StreamingBuffer(GL_ARRAY_BUFFER, sizeof(vec3) * spherePosSize));
+                if (!mVertexStream->initialize()) {
+                    return false;
+                }
+            }
 
             glGenBuffers(1, &mColorBuffer);
             glBindBuffer(GL_ARRAY_BUFFER, mColorBuffer);
@@ -152,6 +267,19 @@ void main() {
                     GL_STATIC_DRAW
             );
 
+            // ES2 only guarantees 16-bit indices
+            if (mSortSprites && spherePosSize > 65536) {
+                std::cout << "PointSprite: sphere too large for 16-bit indices, sorting disabled" << std::endl;
+                mSortSprites = false;
+            }
+            if (mSortSprites) {
+                mIndexStream.reset(new StreamingBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * spherePosSize));
+                if (!mIndexStream->initialize()) {
+                    return false;
+                }
+                mSortKeys.resize(spherePosSize);
+            }
+
             // Load texture image
             TGAImage img;
             if (!LoadTGAImageFromFile("smoke_64x64.tga", &img)) {
@@ -165,7 +293,11 @@ void main() {
             // Set GL states
             glEnable(GL_DEPTH_TEST);
             glCullFace(GL_BACK);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+            if (mSortSprites) {
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            } else {
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+            }
             glEnable(GL_BLEND);
 
             // Clear buffer
@@ -173,7 +305,10 @@ void main() {
 
             // Initialize timer
             mTimer = CreateTimer();
-            mTime = mTimer->getAbsoluteTime();
+
+            const char* modeName[] = {"cpu", "simd", "shader"};
+            std::cout << "PointSprite: " << mSphereRow << "x" << mSphereCol << " sphere, anim="
+                      << modeName[static_cast<int>(mAnimMode)] << std::endl;
 
             return true;
         }
@@ -181,49 +316,132 @@ void main() {
         void destroy() override {
             // glDeleteTextures(1, mTexture);
             // glDeleteBuffers(1, mVertBuffer);
+            if (mVertexStream) {
+                mVertexStream->destroy();
+            }
+            if (mIndexStream) {
+                mIndexStream->destroy();
+            }
             glDeleteProgram(mProgram);
         }
 
-        void draw() override
+        // Order sprites far to near by clip space z, which grows with distance.
+        // The animation is a uniform positive scale about the origin, so the
+        // base vertices give the same order.
+        void sortSprites(const Mat4x4& matMVP) {
+            const float zx = matMVP(2, 0);
+            const float zy = matMVP(2, 1);
+            const float zz = matMVP(2, 2);
+            const vec3* v = mdlSphere->getVertices();
+            for (int i = 0; i < spherePosSize; ++i) {
+                float z = zx * v[i].x + zy * v[i].y + zz * v[i].z;
+                mSortKeys[i] = ~sortKeyFromFloat(z);
+            }
+            mSorter.sortIndices(&mSortKeys[0], spherePosSize, mSortedIndices);
+        }
+
+        // Animate sphere vertices on the CPU straight into the stream buffer,
+        // returns the attribute offset
+        const void* updateVertices(float scale) {
+            mVertexStream->beginFrame();
+            StreamSpan<vec3> position = mVertexStream->allocate<vec3>(spherePosSize);
+            if (position.valid()) {
+                if (mAnimMode == animMode::CPU) {
+                    for (int i = 0; i < spherePosSize; ++i) {
+                         position[i].x = (mdlSphere->getVertices(i))->x * scale;
+                         position[i].y = (mdlSphere->getVertices(i))->y * scale;
+                         position[i].z = (mdlSphere->getVertices(i))->z * scale;
+                    }
+                } else {
+                    scaleVerticesSIMD(&position[0].x, &mdlSphere->getVertices()->x, spherePosSize * 3, scale);
+                }
+            }
+            mVertexStream->flush();
+            return position.offsetPointer();
+        }
+
+        void update(float dt, double totalTime) override
+        {
+            animState &state = mAnimation.getWriteBuffer();
+            state.prevAngle = mAngle;
+            state.prevPulse = mPulse;
+            state.angle = mAngle + ROTATION_SPEED * dt;
+            state.pulse = mPulse + PULSE_SPEED * dt;
+            mAngle = std::fmod(state.angle, 2.0f * (float)M_PI);
+            mPulse = std::fmod(state.pulse, 2.0f * (float)M_PI);
+            mAnimation.publish();
+        }
+
+        void draw(float alpha) override
+        {
+            double frameStart = mTimer->getAbsoluteTime();
+            {
+                GpuScope gpuScope("draw");
+                renderSprites(alpha);
+            }
+
+            // The shader backend moves the work to the GPU, so the sweep counts it too
+            if (mSweep) {
+                glFinish();
+            }
+
+            // Frame time report
+            double frameTime = mTimer->getAbsoluteTime() - frameStart;
+            mFrameTime += frameTime;
+            if (mSweep && ++mDrawnFrames > SWEEP_WARMUP_FRAMES) {
+                mSweepFrameTime += frameTime;
+                mSweepUpdateTime += mLastUpdateTime;
+                mSweepFrames++;
+            }
+            if (++mReportFrames == REPORT_FRAMES) {
+                std::cout << "PointSprite: " << spherePosSize << " points, frame "
+                          << std::fixed << std::setprecision(3)
+                          << mFrameTime * 1e3 / REPORT_FRAMES << " ms, update "
+                          << mUpdateTime * 1e3 / REPORT_FRAMES << " ms" << std::endl;
+                mFrameTime = 0.0;
+                mUpdateTime = 0.0;
+                mReportFrames = 0;
+            }
+        }
+
+        void renderSprites(float alpha)
         {
             // Clear the color buffer
             glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            // Update angle parameters
-            mAngle = mAngle + 0.01f;
+            // Interpolate the animation between the last two updates
+            mAnimation.acquire();
+            const animState& state = mAnimation.getReadBuffer();
+            float angle = state.prevAngle + (state.angle - state.prevAngle) * alpha;
+            float pulse = state.prevPulse + (state.pulse - state.prevPulse) * alpha;
 
             // Create the rotate and translate model view matrix
-            Mat4x4 matRot = rotateYMatrix(mAngle);
+            Mat4x4 matRot = rotateYMatrix(angle);
             Mat4x4 matMVP = matBack * matRot;
 
             // Create model parameters based on animation parameters
-            mCount += 3;
-            float rad = (float)(mCount % 360) * M_PI / 180.0f;
-
-            // Create animated sphere point array
-            float t = std::cos(rad) / 2.0f;
-            for (int i = 0; i < spherePosSize; ++i) {
-                 mPosition[i].x = (mdlSphere->getVertices(i))->x * (1.0f + t);
-                 mPosition[i].y = (mdlSphere->getVertices(i))->y * (1.0f + t);
-                 mPosition[i].z = (mdlSphere->getVertices(i))->z * (1.0f + t);
-            }
+            float scale = 1.0f + std::cos(pulse) / 2.0f;
 
             // Use the program object
             glUseProgram(mProgram);
             glUniformMatrix4fv(uMatProj,1, 0, &matMVP(0));
 
             // Update VBO
-            glBindBuffer(GL_ARRAY_BUFFER, mVertBuffer);
-            glBufferSubData(
-                     GL_ARRAY_BUFFER,
-                     0,
-                     sizeof(mPosition),
-                     &(mPosition[0])
-            );
+            double updateStart = mTimer->getAbsoluteTime();
+            const void* positionOffset = 0;
+            if (mAnimMode == animMode::SHADER) {
+                glUniform1f(uScale, scale);
+                glBindBuffer(GL_ARRAY_BUFFER, mVertBuffer);
+            } else {
+                glUniform1f(uScale, 1.0f);
+                positionOffset = updateVertices(scale);
+            }
+            mLastUpdateTime = mTimer->getAbsoluteTime() - updateStart;
+            mUpdateTime += mLastUpdateTime;
 
             // Set vertex color buffer
-            glVertexAttribPointer((GLuint)aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
+            glVertexAttribPointer((GLuint)aPosition, 3, GL_FLOAT, GL_FALSE, 0, positionOffset);
 
             glBindBuffer(GL_ARRAY_BUFFER, mColorBuffer);
             glVertexAttribPointer((GLuint)aColor, 4, GL_FLOAT, GL_FALSE, 0, 0);
@@ -234,20 +452,98 @@ void main() {
             glBindTexture(GL_TEXTURE_2D, mTexture);
 
             // Draw point(s)
-            glDrawArrays(GL_POINTS,  0, mSphereCol * mSphereRow);
+            if (mSortSprites) {
+                sortSprites(matMVP);
+                mIndexStream->beginFrame();
+                StreamSpan<GLushort> indices = mIndexStream->allocate<GLushort>(spherePosSize);
+                if (indices.valid()) {
+                    std::copy(mSortedIndices.begin(), mSortedIndices.end(), indices.begin());
+                }
+                mIndexStream->flush();
+                glDrawElements(GL_POINTS, spherePosSize, GL_UNSIGNED_SHORT, indices.offsetPointer());
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+                mIndexStream->endFrame();
+            } else {
+                glDrawArrays(GL_POINTS,  0, spherePosSize);
+            }
 
             glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-            // Vsync emulation
-            float cTime = mTimer->getAbsoluteTime();
-            float eTime = (cTime - mTime) * 1e3;
-            mTime = cTime;
-            if (eTime < 16.666f) angle::Sleep((std::int_fast32_t)(16.666f - eTime));
+            if (mVertexStream) {
+                mVertexStream->endFrame();
+            }
         }
 };
 
+// --sweep benchmarks every animation backend at every sphere size from 64x64 to 1024x1024
+// and prints a table of the mean frame and update times. Other arguments pass through to
+// each run, the frame counts are fixed.
+static int runSweep(int argc, char **argv)
+{
+    const char* modeArgs[] = {"--anim=cpu", "--anim=simd", "--anim=shader"};
+    const char* sizeArgs[] = {"--sphere=64", "--sphere=128", "--sphere=256", "--sphere=512",
+                              "--sphere=1024"};
+    const int modeCount = sizeof(modeArgs) / sizeof(modeArgs[0]);
+    const int sizeCount = sizeof(sizeArgs) / sizeof(sizeArgs[0]);
+
+    std::string framesArg = "--frames=" + std::to_string(SWEEP_FRAMES + SWEEP_WARMUP_FRAMES);
+    std::vector<char*> args;
+    for (int i = 0; i < argc; i++) {
+        if (strncmp(argv[i], "--anim=", 7) != 0 && strncmp(argv[i], "--sphere=", 9) != 0 &&
+            strncmp(argv[i], "--frames=", 9) != 0 && strncmp(argv[i], "--warmup=", 9) != 0) {
+            args.push_back(argv[i]);
+        }
+    }
+    args.push_back(const_cast<char*>(framesArg.c_str()));
+    args.push_back(const_cast<char*>("--warmup=0"));
+    const size_t baseCount = args.size();
+
+    double frameTime[sizeCount][modeCount];
+    double updateTime[sizeCount][modeCount];
+    int status = 0;
+    for (int size = 0; size < sizeCount; size++) {
+        for (int mode = 0; mode < modeCount; mode++) {
+            args.resize(baseCount);
+            args.push_back(const_cast<char*>(modeArgs[mode]));
+            args.push_back(const_cast<char*>(sizeArgs[size]));
+            args.push_back(nullptr);
+
+            PointSprite app(static_cast<int>(args.size()) - 1, args.data());
+            int result = app.run();
+            if (result != 0 && status == 0) {
+                status = result;
+            }
+            frameTime[size][mode] = app.getSweepFrameTime();
+            updateTime[size][mode] = app.getSweepUpdateTime();
+        }
+    }
+
+    // Frame time includes the GPU, update time is the CPU animation and upload alone
+    std::cout << std::endl << "PointSprite sweep, ms per frame (frame / update)" << std::endl;
+    std::cout << std::setw(10) << "sphere";
+    for (int mode = 0; mode < modeCount; mode++) {
+        std::cout << std::setw(20) << modeArgs[mode] + 7;
+    }
+    std::cout << std::endl << std::fixed << std::setprecision(3);
+    for (int size = 0; size < sizeCount; size++) {
+        std::string sphere = sizeArgs[size] + 9;
+        std::cout << std::setw(10) << sphere + "x" + sphere;
+        for (int mode = 0; mode < modeCount; mode++) {
+            std::cout << std::setw(11) << frameTime[size][mode] << " / "
+                      << std::setw(6) << updateTime[size][mode];
+        }
+        std::cout << std::endl;
+    }
+    return status;
+}
+
 int main(int argc, char **argv)
 {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sweep") == 0) {
+            return runSweep(argc, argv);
+        }
+    }
+
     PointSprite app(argc, argv);
     return app.run();
 }
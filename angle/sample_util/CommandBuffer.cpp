@@ -0,0 +1,490 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CommandBuffer.cpp: Draw packets recorded on any thread, sorted and issued on the GL thread.
+//
+
+#include "sample_util/CommandBuffer.h"
+
+#include <string.h>
+
+#include "sample_util/Trace.h"
+#include "util/shader_utils.h"
+
+namespace
+{
+// Uniform records are a location word, a kind | count << 16 word and the values
+constexpr size_t kUniformHeaderWords = 2;
+
+size_t GetIndexSize(GLenum indexType)
+{
+    switch (indexType)
+    {
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_UNSIGNED_SHORT:
+            return 2;
+        default:
+            return 4;
+    }
+}
+}  // anonymous namespace
+
+CommandRecorder::CommandRecorder() : mPendingUniforms(0) {}
+
+CommandRecorder::~CommandRecorder() = default;
+
+void CommandRecorder::setUniform1i(GLint location, GLint value)
+{
+    addUniform(kUniform1i, location, 1, &value, sizeof(value));
+}
+
+void CommandRecorder::setUniform1f(GLint location, GLfloat value)
+{
+    addUniform(kUniform1f, location, 1, &value, sizeof(value));
+}
+
+void CommandRecorder::setUniform2fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    addUniform(kUniform2f, location, count, values, sizeof(GLfloat) * 2 * count);
+}
+
+void CommandRecorder::setUniform3fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    addUniform(kUniform3f, location, count, values, sizeof(GLfloat) * 3 * count);
+}
+
+void CommandRecorder::setUniform4fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    addUniform(kUniform4f, location, count, values, sizeof(GLfloat) * 4 * count);
+}
+
+void CommandRecorder::setUniformMatrix3fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    addUniform(kUniformMatrix3f, location, count, values, sizeof(GLfloat) * 9 * count);
+}
+
+void CommandRecorder::setUniformMatrix4fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    addUniform(kUniformMatrix4f, location, count, values, sizeof(GLfloat) * 16 * count);
+}
+
+void CommandRecorder::addUniform(UniformKind kind,
+                                 GLint location,
+                                 GLsizei count,
+                                 const void *data,
+                                 size_t size)
+{
+    if (location < 0 || count <= 0 || count > 0xFFFF)
+    {
+        return;
+    }
+
+    const size_t start = mUniforms.size();
+    mUniforms.resize(start + kUniformHeaderWords + size / sizeof(uint32_t));
+    mUniforms[start]     = static_cast<uint32_t>(location);
+    mUniforms[start + 1] = kind | (static_cast<uint32_t>(count) << 16);
+    memcpy(&mUniforms[start + kUniformHeaderWords], data, size);
+}
+
+void CommandRecorder::draw(DrawHandle program,
+                           DrawHandle material,
+                           DrawHandle geometry,
+                           GLenum mode,
+                           uint32_t first,
+                           uint32_t count,
+                           uint16_t order)
+{
+    drawInstanced(program, material, geometry, mode, first, count, 0, 0, 0, order);
+}
+
+void CommandRecorder::drawInstanced(DrawHandle program,
+                                    DrawHandle material,
+                                    DrawHandle geometry,
+                                    GLenum mode,
+                                    uint32_t first,
+                                    uint32_t count,
+                                    uint32_t instanceCount,
+                                    GLuint instanceBuffer,
+                                    size_t instanceOffset,
+                                    uint16_t order)
+{
+    DrawPacket packet;
+    packet.key            = MakeDrawSortKey(program, material, geometry, order);
+    packet.program        = program;
+    packet.material       = material;
+    packet.geometry       = geometry;
+    packet.mode           = static_cast<uint16_t>(mode);
+    packet.first          = first;
+    packet.count          = count;
+    packet.uniformOffset  = static_cast<uint32_t>(mPendingUniforms);
+    packet.uniformSize    = static_cast<uint32_t>(mUniforms.size() - mPendingUniforms);
+    packet.instanceCount  = instanceCount;
+    packet.instanceBuffer = instanceBuffer;
+    packet.instanceOffset = static_cast<uint32_t>(instanceOffset);
+    mPackets.push_back(packet);
+
+    mPendingUniforms = mUniforms.size();
+}
+
+void CommandRecorder::reset()
+{
+    mPackets.clear();
+    mUniforms.clear();
+    mPendingUniforms = 0;
+}
+
+CommandQueue::CommandQueue()
+    : mAcquired(0), mEnabledAttributes(0), mInstancedAttributes(0), mDivisors()
+{}
+
+CommandQueue::~CommandQueue() = default;
+
+DrawHandle CommandQueue::addProgram(ShaderProgram *program)
+{
+    mPrograms.push_back(program);
+    return static_cast<DrawHandle>(mPrograms.size() - 1);
+}
+
+DrawHandle CommandQueue::addMaterial(const DrawMaterial &material)
+{
+    mMaterials.push_back(material);
+    return static_cast<DrawHandle>(mMaterials.size() - 1);
+}
+
+DrawHandle CommandQueue::addGeometry(const DrawGeometry &geometry)
+{
+    mGeometries.push_back(geometry);
+    return static_cast<DrawHandle>(mGeometries.size() - 1);
+}
+
+void CommandQueue::clear()
+{
+    mPrograms.clear();
+    mMaterials.clear();
+    mGeometries.clear();
+}
+
+CommandRecorder *CommandQueue::acquireRecorder()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mAcquired == mRecorders.size())
+    {
+        mRecorders.emplace_back(new CommandRecorder());
+    }
+    return mRecorders[mAcquired++].get();
+}
+
+void CommandQueue::submit()
+{
+    TraceScope traceScope("submit");
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mEntries.clear();
+    for (size_t recorderIndex = 0; recorderIndex < mAcquired; ++recorderIndex)
+    {
+        const CommandRecorder *recorder = mRecorders[recorderIndex].get();
+        for (const DrawPacket &packet : recorder->mPackets)
+        {
+            mEntries.push_back({packet.key, &packet, recorder});
+        }
+    }
+    sortEntries();
+
+    mStats         = CommandQueueStats();
+    mStats.packets = static_cast<uint32_t>(mEntries.size());
+
+    // Nothing is assumed about the state left by the previous frame
+    int currentProgram             = -1;
+    int currentMaterial            = -1;
+    int currentGeometry            = -1;
+    GLuint currentInstanceBuffer   = 0;
+    uint32_t currentInstanceOffset = 0;
+    for (const SortEntry &entry : mEntries)
+    {
+        const DrawPacket &packet = *entry.packet;
+        ShaderProgram *program   = mPrograms[packet.program];
+
+        if (packet.program != currentProgram)
+        {
+            program->use();
+            currentProgram = packet.program;
+            mStats.programChanges++;
+        }
+        if (packet.material != currentMaterial)
+        {
+            applyMaterial(mMaterials[packet.material]);
+            currentMaterial = packet.material;
+            mStats.materialChanges++;
+        }
+
+        const DrawGeometry &geometry = mGeometries[packet.geometry];
+        const bool geometryChanged   = packet.geometry != currentGeometry;
+        if (geometryChanged)
+        {
+            applyGeometry(geometry);
+            currentGeometry = packet.geometry;
+            mStats.geometryChanges++;
+        }
+        if (packet.instanceCount > 0 &&
+            (geometryChanged || packet.instanceBuffer != currentInstanceBuffer ||
+             packet.instanceOffset != currentInstanceOffset))
+        {
+            applyInstanceAttributes(geometry, packet.instanceBuffer, packet.instanceOffset);
+            currentInstanceBuffer = packet.instanceBuffer;
+            currentInstanceOffset = packet.instanceOffset;
+        }
+
+        applyUniforms(program, entry.recorder->mUniforms.data() + packet.uniformOffset,
+                      packet.uniformSize);
+
+        const GLsizei count     = static_cast<GLsizei>(packet.count);
+        const GLsizei instances = static_cast<GLsizei>(packet.instanceCount);
+        if (geometry.indexBuffer != 0)
+        {
+            const void *offset = reinterpret_cast<const void *>(
+                packet.first * GetIndexSize(geometry.indexType));
+            if (instances > 0)
+            {
+                glDrawElementsInstanced(packet.mode, count, geometry.indexType, offset, instances);
+            }
+            else
+            {
+                glDrawElements(packet.mode, count, geometry.indexType, offset);
+            }
+        }
+        else
+        {
+            const GLint first = static_cast<GLint>(packet.first);
+            if (instances > 0)
+            {
+                glDrawArraysInstanced(packet.mode, first, count, instances);
+            }
+            else
+            {
+                glDrawArrays(packet.mode, first, count);
+            }
+        }
+        mStats.instances += packet.instanceCount;
+    }
+
+    for (GLuint location = 0; mEnabledAttributes != 0; ++location)
+    {
+        if (mEnabledAttributes & (1u << location))
+        {
+            glDisableVertexAttribArray(location);
+            mEnabledAttributes &= ~(1u << location);
+        }
+    }
+    for (GLuint location = 0; mInstancedAttributes != 0; ++location)
+    {
+        setDivisor(location, 0);
+    }
+
+    for (size_t recorderIndex = 0; recorderIndex < mAcquired; ++recorderIndex)
+    {
+        mRecorders[recorderIndex]->reset();
+    }
+    mAcquired = 0;
+}
+
+void CommandQueue::sortEntries()
+{
+    // LSD radix sort on bytes, skipping the bytes every key has in common. Keys of a typical
+    // frame only differ in a few of them.
+    if (mEntries.size() < 2)
+    {
+        return;
+    }
+
+    uint64_t differingBits  = 0;
+    const uint64_t firstKey = mEntries[0].key;
+    for (const SortEntry &entry : mEntries)
+    {
+        differingBits |= entry.key ^ firstKey;
+    }
+
+    mSortScratch.resize(mEntries.size());
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        if (((differingBits >> shift) & 0xFF) == 0)
+        {
+            continue;
+        }
+
+        size_t offsets[256] = {};
+        for (const SortEntry &entry : mEntries)
+        {
+            offsets[(entry.key >> shift) & 0xFF]++;
+        }
+        size_t total = 0;
+        for (size_t &offset : offsets)
+        {
+            const size_t count = offset;
+            offset             = total;
+            total += count;
+        }
+        for (const SortEntry &entry : mEntries)
+        {
+            mSortScratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+        mEntries.swap(mSortScratch);
+    }
+}
+
+void CommandQueue::applyGeometry(const DrawGeometry &geometry)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.vertexBuffer);
+
+    uint32_t enabled = 0;
+    for (int attributeIndex = 0; attributeIndex < geometry.attributeCount; ++attributeIndex)
+    {
+        const DrawAttribute &attribute = geometry.attributes[attributeIndex];
+        if (attribute.location < 0)
+        {
+            continue;
+        }
+        const GLuint location = static_cast<GLuint>(attribute.location);
+        enabled |= 1u << location;
+        if (attribute.divisor == 0)
+        {
+            setDivisor(location, 0);
+            glVertexAttribPointer(location, attribute.size, attribute.type, attribute.normalized,
+                                  attribute.stride,
+                                  reinterpret_cast<const void *>(attribute.offset));
+        }
+    }
+
+    // Only touch the arrays whose state differs from the previous geometry
+    const uint32_t changed = enabled ^ mEnabledAttributes;
+    for (GLuint location = 0; (changed >> location) != 0; ++location)
+    {
+        if (changed & (1u << location))
+        {
+            if (enabled & (1u << location))
+            {
+                glEnableVertexAttribArray(location);
+            }
+            else
+            {
+                glDisableVertexAttribArray(location);
+            }
+        }
+    }
+    mEnabledAttributes = enabled;
+
+    if (geometry.indexBuffer != 0)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.indexBuffer);
+    }
+}
+
+void CommandQueue::applyInstanceAttributes(const DrawGeometry &geometry,
+                                           GLuint buffer,
+                                           uint32_t offset)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (int attributeIndex = 0; attributeIndex < geometry.attributeCount; ++attributeIndex)
+    {
+        const DrawAttribute &attribute = geometry.attributes[attributeIndex];
+        if (attribute.location < 0 || attribute.divisor == 0)
+        {
+            continue;
+        }
+        const GLuint location = static_cast<GLuint>(attribute.location);
+        setDivisor(location, attribute.divisor);
+        glVertexAttribPointer(location, attribute.size, attribute.type, attribute.normalized,
+                              attribute.stride,
+                              reinterpret_cast<const void *>(attribute.offset + offset));
+    }
+}
+
+void CommandQueue::setDivisor(GLuint location, GLuint divisor)
+{
+    // Divisors only ever become non-zero with instanced geometry, so ES2 never gets here
+    if (mDivisors[location] == divisor)
+    {
+        return;
+    }
+    glVertexAttribDivisor(location, divisor);
+    mDivisors[location] = divisor;
+    if (divisor != 0)
+    {
+        mInstancedAttributes |= 1u << location;
+    }
+    else
+    {
+        mInstancedAttributes &= ~(1u << location);
+    }
+}
+
+void CommandQueue::applyMaterial(const DrawMaterial &material)
+{
+    // Highest unit first so unit 0 is active afterwards
+    for (int unit = material.textureCount - 1; unit >= 0; --unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, material.textures[unit]);
+    }
+
+    if (material.blend)
+    {
+        glEnable(GL_BLEND);
+    }
+    else
+    {
+        glDisable(GL_BLEND);
+    }
+}
+
+void CommandQueue::applyUniforms(ShaderProgram *program, const uint32_t *data, size_t size)
+{
+    const uint32_t *end = data + size;
+    while (data < end)
+    {
+        const GLint location  = static_cast<GLint>(data[0]);
+        const uint32_t kind   = data[1] & 0xFFFF;
+        const GLsizei count   = static_cast<GLsizei>(data[1] >> 16);
+        const void *values    = data + kUniformHeaderWords;
+        const GLfloat *floats = static_cast<const GLfloat *>(values);
+
+        size_t words = 0;
+        switch (kind)
+        {
+            case CommandRecorder::kUniform1i:
+                program->setUniform1i(location, *static_cast<const GLint *>(values));
+                words = 1;
+                break;
+            case CommandRecorder::kUniform1f:
+                program->setUniform1f(location, *floats);
+                words = 1;
+                break;
+            case CommandRecorder::kUniform2f:
+                program->setUniform2fv(location, count, floats);
+                words = 2 * count;
+                break;
+            case CommandRecorder::kUniform3f:
+                program->setUniform3fv(location, count, floats);
+                words = 3 * count;
+                break;
+            case CommandRecorder::kUniform4f:
+                program->setUniform4fv(location, count, floats);
+                words = 4 * count;
+                break;
+            case CommandRecorder::kUniformMatrix3f:
+                program->setUniformMatrix3fv(location, count, floats);
+                words = 9 * count;
+                break;
+            case CommandRecorder::kUniformMatrix4f:
+                program->setUniformMatrix4fv(location, count, floats);
+                words = 16 * count;
+                break;
+            default:
+                return;
+        }
+        data += kUniformHeaderWords + words;
+    }
+}
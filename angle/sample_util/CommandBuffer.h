@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CommandBuffer.h: Draw packets recorded on any thread, sorted and issued on the GL thread.
+//
+
+#ifndef SAMPLE_UTIL_COMMAND_BUFFER_H
+#define SAMPLE_UTIL_COMMAND_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "util/gles_loader_autogen.h"
+
+class ShaderProgram;
+
+constexpr int kMaxDrawAttributes = 8;
+constexpr int kMaxDrawTextures   = 4;
+
+// Handles returned by CommandQueue::add*(), packets refer to their state through them
+using DrawHandle = uint16_t;
+
+struct DrawAttribute
+{
+    GLint location       = -1;
+    GLint size           = 4;
+    GLenum type          = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    GLsizei stride       = 0;
+    size_t offset        = 0;
+
+    // Non-zero reads from the packet's instance buffer instead of the vertex buffer
+    GLuint divisor = 0;
+};
+
+// Vertex and index buffers and how the vertex buffer is laid out. indexBuffer 0 draws arrays.
+struct DrawGeometry
+{
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer  = 0;
+    GLenum indexType    = GL_UNSIGNED_SHORT;
+    DrawAttribute attributes[kMaxDrawAttributes];
+    int attributeCount = 0;
+};
+
+// 2D textures bound to units 0..textureCount-1, and whether blending is on
+struct DrawMaterial
+{
+    GLuint textures[kMaxDrawTextures] = {};
+    int textureCount                  = 0;
+    bool blend                        = false;
+};
+
+// 48 bytes. The uniforms are a range of 32-bit words in the recording CommandRecorder.
+struct DrawPacket
+{
+    uint64_t key;
+    DrawHandle program;
+    DrawHandle material;
+    DrawHandle geometry;
+    uint16_t mode;
+    uint32_t first;
+    uint32_t count;
+    uint32_t uniformOffset;
+    uint32_t uniformSize;
+    uint32_t instanceCount;
+    GLuint instanceBuffer;
+    uint32_t instanceOffset;
+};
+static_assert(sizeof(DrawPacket) == 48, "DrawPacket size changed, update the comment");
+
+// Most significant first: program, material, geometry, then the caller's order, so sorting
+// groups packets by the state that is most expensive to change.
+inline uint64_t MakeDrawSortKey(DrawHandle program,
+                                DrawHandle material,
+                                DrawHandle geometry,
+                                uint16_t order)
+{
+    return (static_cast<uint64_t>(program) << 48) | (static_cast<uint64_t>(material) << 32) |
+           (static_cast<uint64_t>(geometry) << 16) | order;
+}
+
+// Records packets for one thread. Uniforms set before draw() are applied to that draw only,
+// through the program's ShaderProgram, so values the program already holds cost no GL call.
+// Storage is reused from frame to frame and only grows.
+class CommandRecorder : angle::NonCopyable
+{
+  public:
+    CommandRecorder();
+    ~CommandRecorder();
+
+    void setUniform1i(GLint location, GLint value);
+    void setUniform1f(GLint location, GLfloat value);
+    void setUniform2fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniform3fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniform4fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniformMatrix3fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniformMatrix4fv(GLint location, GLsizei count, const GLfloat *values);
+
+    // first and count are vertices for arrays and indices for indexed geometry. order breaks
+    // ties between packets with the same state, e.g. quantized depth.
+    void draw(DrawHandle program,
+              DrawHandle material,
+              DrawHandle geometry,
+              GLenum mode,
+              uint32_t first,
+              uint32_t count,
+              uint16_t order = 0);
+
+    // Needs ES 3.0. Attributes with a divisor are sourced from instanceBuffer, starting
+    // instanceOffset bytes in.
+    void drawInstanced(DrawHandle program,
+                       DrawHandle material,
+                       DrawHandle geometry,
+                       GLenum mode,
+                       uint32_t first,
+                       uint32_t count,
+                       uint32_t instanceCount,
+                       GLuint instanceBuffer,
+                       size_t instanceOffset,
+                       uint16_t order = 0);
+
+    size_t getPacketCount() const { return mPackets.size(); }
+
+  private:
+    friend class CommandQueue;
+
+    enum UniformKind : uint16_t
+    {
+        kUniform1i,
+        kUniform1f,
+        kUniform2f,
+        kUniform3f,
+        kUniform4f,
+        kUniformMatrix3f,
+        kUniformMatrix4f,
+    };
+
+    void addUniform(UniformKind kind, GLint location, GLsizei count, const void *data, size_t size);
+    void reset();
+
+    std::vector<DrawPacket> mPackets;
+    std::vector<uint32_t> mUniforms;
+    size_t mPendingUniforms;
+};
+
+struct CommandQueueStats
+{
+    uint32_t packets         = 0;
+    uint32_t programChanges  = 0;
+    uint32_t materialChanges = 0;
+    uint32_t geometryChanges = 0;
+    uint32_t instances       = 0;
+};
+
+// State is registered up front on the GL thread. Each frame, recording threads take a recorder
+// with acquireRecorder(), fill it and leave it alone until submit() has run on the GL thread.
+// submit() sorts every packet of the frame by key, then walks them in order and only binds
+// what changed from the previous packet.
+class CommandQueue : angle::NonCopyable
+{
+  public:
+    CommandQueue();
+    ~CommandQueue();
+
+    // Not thread safe, call while nothing is recording. The objects stay owned by the caller.
+    // Up to 65535 of each.
+    DrawHandle addProgram(ShaderProgram *program);
+    DrawHandle addMaterial(const DrawMaterial &material);
+    DrawHandle addGeometry(const DrawGeometry &geometry);
+    void clear();
+
+    // Thread safe. The recorder belongs to the caller until the next submit().
+    CommandRecorder *acquireRecorder();
+
+    // GL thread only. Issues the packets recorded since the last submit and recycles the
+    // recorders. Leaves no vertex attribute array enabled and every divisor at 0.
+    void submit();
+
+    const CommandQueueStats &getLastSubmitStats() const { return mStats; }
+
+  private:
+    struct SortEntry
+    {
+        uint64_t key;
+        const DrawPacket *packet;
+        const CommandRecorder *recorder;
+    };
+
+    void sortEntries();
+    void applyGeometry(const DrawGeometry &geometry);
+    void applyInstanceAttributes(const DrawGeometry &geometry, GLuint buffer, uint32_t offset);
+    void setDivisor(GLuint location, GLuint divisor);
+    void applyMaterial(const DrawMaterial &material);
+    void applyUniforms(ShaderProgram *program, const uint32_t *data, size_t size);
+
+    std::vector<ShaderProgram *> mPrograms;
+    std::vector<DrawMaterial> mMaterials;
+    std::vector<DrawGeometry> mGeometries;
+
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<CommandRecorder>> mRecorders;
+    size_t mAcquired;
+
+    std::vector<SortEntry> mEntries;
+    std::vector<SortEntry> mSortScratch;
+    uint32_t mEnabledAttributes;
+    uint32_t mInstancedAttributes;
+    GLuint mDivisors[32];
+    CommandQueueStats mStats;
+};
+
+#endif  // SAMPLE_UTIL_COMMAND_BUFFER_H
@@ -0,0 +1,592 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DynamicResolution.cpp: Scales the offscreen render resolution to hold a GPU frame time.
+//
+
+#include "sample_util/DynamicResolution.h"
+
+#include <math.h>
+#include <algorithm>
+
+#include "sample_util/GpuTimer.h"
+#include "util/shader_utils.h"
+
+namespace
+{
+// Scales are whole multiples of 1 / kScaleSteps
+constexpr int kScaleSteps = 20;
+
+// Weight of each new GPU time in the running average
+constexpr double kSmoothing = 0.25;
+
+// Measurements at a new scale before it may be lowered again
+constexpr int kMinSamples = 3;
+
+// The next step up must be predicted under this share of the target for kRaiseFrames
+// measurements in a row
+constexpr double kRaiseHeadroom = 0.9;
+constexpr int kRaiseFrames      = 30;
+
+// Frames of timer queries in flight before frames go untimed
+constexpr size_t kMaxPendingFrames = 8;
+
+// Fence mode gives up waiting for the previous frame after this long
+constexpr GLuint64 kFenceTimeoutNs = 100 * 1000 * 1000;
+
+// Full-screen triangle, the corners outside the viewport are clipped
+constexpr GLfloat kTriangle[] = {-1.0f, -1.0f, 3.0f, -1.0f, -1.0f, 3.0f};
+
+constexpr char kUpscaleVS[] = R"(attribute vec2 a_position;
+varying vec2 v_texCoord;
+void main()
+{
+    v_texCoord = a_position * 0.5 + 0.5;
+    gl_Position = vec4(a_position, 0.0, 1.0);
+})";
+
+// The sampler defaults to texture unit 0
+constexpr char kUpscaleFS[] = R"(precision mediump float;
+uniform sampler2D s_texture;
+varying vec2 v_texCoord;
+void main()
+{
+    gl_FragColor = texture2D(s_texture, v_texCoord);
+})";
+
+double MillisecondsBetween(std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void SetCapability(GLenum capability, GLboolean enabled)
+{
+    if (enabled)
+    {
+        glEnable(capability);
+    }
+    else
+    {
+        glDisable(capability);
+    }
+}
+}  // anonymous namespace
+
+DynamicResolution::DynamicResolution()
+    : mInitialized(false),
+      mTimeSource(GpuTimeSource::TimerQueries),
+      mIsES3(false),
+      mTargetMs(0.0),
+      mMinScaleSteps(kScaleSteps),
+      mScaleSteps(kScaleSteps),
+      mSmoothedMs(0.0),
+      mSamplesAtScale(0),
+      mRaiseFrames(0),
+      mTarget(nullptr),
+      mOutputFramebuffer(0),
+      mOutputWidth(0),
+      mOutputHeight(0),
+      mRenderWidth(0),
+      mRenderHeight(0),
+      mProgram(0),
+      mPositionLocation(-1),
+      mVertexBuffer(0),
+      mVertexArray(0),
+      mFence(0),
+      mPreviousFence(0),
+      mPreviousScaleSteps(kScaleSteps)
+{}
+
+DynamicResolution::~DynamicResolution()
+{
+    destroy();
+}
+
+bool DynamicResolution::initialize(double targetMs, float minScale)
+{
+    mIsES3 = IsGLES3OrLater();
+
+    // Some implementations expose the extension with elapsed time queries only
+    GLint timestampBits = 0;
+    if (HasGLExtension("GL_EXT_disjoint_timer_query") && glQueryCounterEXT)
+    {
+        glGetQueryivEXT(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT, &timestampBits);
+    }
+
+    if (timestampBits > 0)
+    {
+        mTimeSource = GpuTimeSource::TimerQueries;
+    }
+    else if (mIsES3 && glFenceSync && glClientWaitSync)
+    {
+        mTimeSource = GpuTimeSource::Fences;
+    }
+    else
+    {
+        return false;
+    }
+
+    mProgram = CompileProgram(kUpscaleVS, kUpscaleFS);
+    if (mProgram == 0)
+    {
+        return false;
+    }
+    mPositionLocation = glGetAttribLocation(mProgram, "a_position");
+
+    GLint arrayBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &arrayBuffer);
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(kTriangle), kTriangle, GL_STATIC_DRAW);
+
+    if (mIsES3)
+    {
+        GLint vertexArray = 0;
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+
+        glGenVertexArrays(1, &mVertexArray);
+        glBindVertexArray(mVertexArray);
+        glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(mPositionLocation);
+        glBindVertexArray(static_cast<GLuint>(vertexArray));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(arrayBuffer));
+
+    mPool.initialize();
+
+    mTargetMs      = targetMs;
+    mMinScaleSteps = std::min(
+        kScaleSteps, std::max(1, static_cast<int>(ceil(minScale * kScaleSteps - 0.001f))));
+    mScaleSteps         = kScaleSteps;
+    mPreviousScaleSteps = kScaleSteps;
+    mSmoothedMs         = 0.0;
+    mSamplesAtScale     = 0;
+    mRaiseFrames        = 0;
+    mStats              = DynamicResolutionStats();
+    mPreviousCollect    = std::chrono::steady_clock::now();
+    mInitialized        = true;
+    return true;
+}
+
+void DynamicResolution::destroy()
+{
+    if (mTarget)
+    {
+        mPool.release(mTarget);
+        mTarget = nullptr;
+    }
+    mPool.destroy();
+
+    for (const PendingFrame &pending : mPending)
+    {
+        mFreeQueries.push_back(pending.begin);
+        mFreeQueries.push_back(pending.end);
+    }
+    mPending.clear();
+    if (mCurrent.begin != 0)
+    {
+        mFreeQueries.push_back(mCurrent.begin);
+        mCurrent = PendingFrame();
+    }
+    if (!mFreeQueries.empty())
+    {
+        glDeleteQueriesEXT(static_cast<GLsizei>(mFreeQueries.size()), mFreeQueries.data());
+        mFreeQueries.clear();
+    }
+
+    for (GLsync *fence : {&mFence, &mPreviousFence})
+    {
+        if (*fence != 0)
+        {
+            glDeleteSync(*fence);
+            *fence = 0;
+        }
+    }
+
+    if (mVertexArray != 0)
+    {
+        glDeleteVertexArrays(1, &mVertexArray);
+        mVertexArray = 0;
+    }
+    if (mVertexBuffer != 0)
+    {
+        glDeleteBuffers(1, &mVertexBuffer);
+        mVertexBuffer = 0;
+    }
+    if (mProgram != 0)
+    {
+        glDeleteProgram(mProgram);
+        mProgram = 0;
+    }
+
+    mInitialized = false;
+}
+
+void DynamicResolution::beginFrame(GLuint outputFramebuffer,
+                                   size_t outputWidth,
+                                   size_t outputHeight)
+{
+    mOutputFramebuffer = outputFramebuffer;
+    mOutputWidth       = outputWidth;
+    mOutputHeight      = outputHeight;
+    mRenderWidth       = outputWidth;
+    mRenderHeight      = outputHeight;
+
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    mStats.frames++;
+    mStats.scaleSum += getScale();
+    mStats.minScale = std::min(mStats.minScale, getScale());
+
+    if (mTimeSource == GpuTimeSource::TimerQueries && mPending.size() < kMaxPendingFrames)
+    {
+        mCurrent.begin      = acquireQuery();
+        mCurrent.scaleSteps = mScaleSteps;
+        glQueryCounterEXT(mCurrent.begin, GL_TIMESTAMP_EXT);
+    }
+
+    // Rounded down, but never to nothing
+    const size_t width  = std::max<size_t>(1, outputWidth * mScaleSteps / kScaleSteps);
+    const size_t height = std::max<size_t>(1, outputHeight * mScaleSteps / kScaleSteps);
+    if (width != outputWidth || height != outputHeight)
+    {
+        mTarget = mPool.acquire(static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+
+        // Stay at full scale rather than failing again every frame
+        if (!mTarget)
+        {
+            mMinScaleSteps = kScaleSteps;
+            setScaleSteps(kScaleSteps);
+        }
+    }
+
+    if (mTarget)
+    {
+        mRenderWidth  = width;
+        mRenderHeight = height;
+    }
+    else
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+    }
+    glViewport(0, 0, static_cast<GLsizei>(mRenderWidth), static_cast<GLsizei>(mRenderHeight));
+}
+
+void DynamicResolution::endFrame()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    if (mTarget)
+    {
+        // Depth and stencil are not needed past the scene, tilers can skip storing them
+        glBindFramebuffer(GL_FRAMEBUFFER, mTarget->framebuffer);
+        if (mIsES3)
+        {
+            const GLenum attachments[] = {GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
+            glInvalidateFramebuffer(GL_FRAMEBUFFER, 2, attachments);
+        }
+
+        upscale();
+        mPool.release(mTarget);
+        mTarget = nullptr;
+    }
+
+    if (mCurrent.begin != 0)
+    {
+        mCurrent.end = acquireQuery();
+        glQueryCounterEXT(mCurrent.end, GL_TIMESTAMP_EXT);
+        mPending.push_back(mCurrent);
+        mCurrent = PendingFrame();
+    }
+
+    if (mTimeSource == GpuTimeSource::Fences)
+    {
+        mFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void DynamicResolution::collect()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    if (mTimeSource == GpuTimeSource::TimerQueries)
+    {
+        // Reading GL_GPU_DISJOINT_EXT resets it. The profiler checks it when there is one,
+        // smoothing absorbs the odd bad sample it would have caught.
+        GLint disjoint = 0;
+        if (!GpuProfiler::GetCurrent())
+        {
+            glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        }
+
+        // Queries finish in submission order, stop at the first frame that is not ready
+        while (!mPending.empty())
+        {
+            const PendingFrame pending = mPending.front();
+            if (!disjoint)
+            {
+                GLuint available = GL_FALSE;
+                glGetQueryObjectuivEXT(pending.end, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+                if (!available)
+                {
+                    break;
+                }
+
+                GLuint64 begin = 0;
+                GLuint64 end   = 0;
+                glGetQueryObjectui64vEXT(pending.begin, GL_QUERY_RESULT_EXT, &begin);
+                glGetQueryObjectui64vEXT(pending.end, GL_QUERY_RESULT_EXT, &end);
+                if (end >= begin)
+                {
+                    addSample(static_cast<double>(end - begin) * 1e-6, pending.scaleSteps);
+                }
+            }
+
+            mFreeQueries.push_back(pending.begin);
+            mFreeQueries.push_back(pending.end);
+            mPending.pop_front();
+        }
+    }
+    else
+    {
+        // Keeps at most one frame in flight. A wait means the GPU sets the pace.
+        if (mPreviousFence != 0)
+        {
+            const GLenum result = glClientWaitSync(mPreviousFence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                   kFenceTimeoutNs);
+            glDeleteSync(mPreviousFence);
+
+            // Signaled before the wait, the GPU kept up and its time is unknown but not the
+            // problem. A timeout or failed wait says nothing about the frame.
+            if (result == GL_ALREADY_SIGNALED)
+            {
+                addHeadroom(mPreviousScaleSteps);
+            }
+            else if (result == GL_CONDITION_SATISFIED)
+            {
+                addSample(MillisecondsBetween(mPreviousCollect, std::chrono::steady_clock::now()),
+                          mPreviousScaleSteps);
+            }
+        }
+        mPreviousFence      = mFence;
+        mPreviousScaleSteps = mScaleSteps;
+        mFence              = 0;
+    }
+
+    mPreviousCollect = std::chrono::steady_clock::now();
+    mPool.trim();
+}
+
+float DynamicResolution::getScale() const
+{
+    return static_cast<float>(mScaleSteps) / kScaleSteps;
+}
+
+float DynamicResolution::getMinScale() const
+{
+    return static_cast<float>(mMinScaleSteps) / kScaleSteps;
+}
+
+void DynamicResolution::addSample(double gpuMs, int scaleSteps)
+{
+    mStats.samples++;
+    if (gpuMs > mTargetMs)
+    {
+        mStats.overTarget++;
+    }
+
+    // Rendered before the last change, says nothing about the current scale
+    if (scaleSteps != mScaleSteps)
+    {
+        return;
+    }
+
+    mSmoothedMs = mSamplesAtScale == 0 ? gpuMs : mSmoothedMs + kSmoothing * (gpuMs - mSmoothedMs);
+    if (++mSamplesAtScale < kMinSamples)
+    {
+        return;
+    }
+
+    if (mSmoothedMs > mTargetMs)
+    {
+        mRaiseFrames = 0;
+        if (mScaleSteps > mMinScaleSteps)
+        {
+            // Fill cost follows the pixel count, the square of the scale
+            const double fit = mScaleSteps * sqrt(mTargetMs / mSmoothedMs);
+            setScaleSteps(std::max(mMinScaleSteps,
+                                   std::min(mScaleSteps - 1, static_cast<int>(floor(fit)))));
+        }
+        return;
+    }
+
+    if (mScaleSteps < kScaleSteps)
+    {
+        const double ratio = static_cast<double>(mScaleSteps + 1) / mScaleSteps;
+        if (mSmoothedMs * ratio * ratio < mTargetMs * kRaiseHeadroom)
+        {
+            if (++mRaiseFrames >= kRaiseFrames)
+            {
+                setScaleSteps(mScaleSteps + 1);
+            }
+        }
+        else
+        {
+            mRaiseFrames = 0;
+        }
+    }
+}
+
+void DynamicResolution::addHeadroom(int scaleSteps)
+{
+    mStats.samples++;
+    if (scaleSteps != mScaleSteps)
+    {
+        return;
+    }
+
+    if (mScaleSteps < kScaleSteps && ++mRaiseFrames >= kRaiseFrames)
+    {
+        setScaleSteps(mScaleSteps + 1);
+    }
+}
+
+void DynamicResolution::setScaleSteps(int scaleSteps)
+{
+    if (scaleSteps == mScaleSteps)
+    {
+        return;
+    }
+
+    mScaleSteps     = scaleSteps;
+    mSamplesAtScale = 0;
+    mRaiseFrames    = 0;
+    mStats.changes++;
+}
+
+void DynamicResolution::upscale()
+{
+    // Whatever draw() left behind has to survive the pass, the sample may rely on it next
+    // frame. ES 2.0 has no vertex array object to keep the attribute in.
+    GLint program       = 0;
+    GLint activeTexture = 0;
+    GLint texture       = 0;
+    GLint sampler       = 0;
+    GLint arrayBuffer   = 0;
+    GLint vertexArray   = 0;
+    GLint viewport[4]   = {};
+    GLboolean colorMask[4];
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &arrayBuffer);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+
+    const GLenum capabilities[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_SCISSOR_TEST,
+                                   GL_STENCIL_TEST};
+    GLboolean enabled[ArraySize(capabilities)];
+    for (size_t index = 0; index < ArraySize(capabilities); index++)
+    {
+        enabled[index] = glIsEnabled(capabilities[index]);
+        glDisable(capabilities[index]);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture);
+    if (mIsES3)
+    {
+        glGetIntegerv(GL_SAMPLER_BINDING, &sampler);
+        glBindSampler(0, 0);
+    }
+
+    const GLuint location = static_cast<GLuint>(mPositionLocation);
+    GLint attribEnabled    = 0;
+    GLint attribSize       = 4;
+    GLint attribType       = GL_FLOAT;
+    GLint attribNormalized = 0;
+    GLint attribStride     = 0;
+    GLint attribBuffer     = 0;
+    void *attribPointer    = nullptr;
+    if (mIsES3)
+    {
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+        glBindVertexArray(mVertexArray);
+    }
+    else
+    {
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &attribEnabled);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attribSize);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_TYPE, &attribType);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &attribNormalized);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &attribStride);
+        glGetVertexAttribiv(location, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &attribBuffer);
+        glGetVertexAttribPointerv(location, GL_VERTEX_ATTRIB_ARRAY_POINTER, &attribPointer);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+        glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(location);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mOutputFramebuffer);
+    glViewport(0, 0, static_cast<GLsizei>(mOutputWidth), static_cast<GLsizei>(mOutputHeight));
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glUseProgram(mProgram);
+    glBindTexture(GL_TEXTURE_2D, mTarget->colorTexture);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    if (mIsES3)
+    {
+        glBindVertexArray(static_cast<GLuint>(vertexArray));
+        glBindSampler(0, static_cast<GLuint>(sampler));
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(attribBuffer));
+        glVertexAttribPointer(location, attribSize, static_cast<GLenum>(attribType),
+                              static_cast<GLboolean>(attribNormalized), attribStride,
+                              attribPointer);
+        if (!attribEnabled)
+        {
+            glDisableVertexAttribArray(location);
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(arrayBuffer));
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(texture));
+    glActiveTexture(static_cast<GLenum>(activeTexture));
+    glUseProgram(static_cast<GLuint>(program));
+    glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    for (size_t index = 0; index < ArraySize(capabilities); index++)
+    {
+        SetCapability(capabilities[index], enabled[index]);
+    }
+}
+
+GLuint DynamicResolution::acquireQuery()
+{
+    GLuint query = 0;
+    if (!mFreeQueries.empty())
+    {
+        query = mFreeQueries.back();
+        mFreeQueries.pop_back();
+    }
+    else
+    {
+        glGenQueriesEXT(1, &query);
+    }
+    return query;
+}
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DynamicResolution.h: Scales the offscreen render resolution to hold a GPU frame time.
+//
+
+#ifndef SAMPLE_UTIL_DYNAMIC_RESOLUTION_H
+#define SAMPLE_UTIL_DYNAMIC_RESOLUTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "sample_util/RenderTargetPool.h"
+#include "util/gles_loader_autogen.h"
+
+enum class GpuTimeSource
+{
+    TimerQueries,  // GL_TIMESTAMP_EXT pairs around the frame, EXT_disjoint_timer_query
+    Fences,        // ES 3.0 fences, waits for the previous frame after each swap
+};
+
+struct DynamicResolutionStats
+{
+    uint64_t frames  = 0;
+    double scaleSum  = 0.0;
+    float minScale   = 1.0f;
+    uint64_t changes = 0;
+
+    // Frames whose GPU time came back, and how many of those were over the target
+    uint64_t samples    = 0;
+    uint64_t overTarget = 0;
+};
+
+// Each frame is drawn into a pooled offscreen target of the output size times the current
+// scale, then drawn into the output framebuffer with one bilinear full-screen triangle.
+//
+// GPU time is read back a few frames late, so every measurement carries the scale it was
+// rendered at and ones from before the last change are ignored. The time is smoothed and the
+// scale lowered as soon as it exceeds the target, by the square root of the overshoot since
+// fill cost follows the pixel count. It is raised one step at a time, and only after the
+// time predicted for the next step has stayed under the target for a while. Scales are
+// multiples of the step, so only a handful of target sizes are ever allocated.
+//
+// Timestamps measure from the first to the last command of the frame, including any time
+// the GPU spent waiting for the CPU in between. Fences only see the GPU once it holds the
+// frame back: while waiting for the previous frame blocks, the frame interval is the GPU
+// time. A fence that has already signaled only says the GPU kept up, such frames count
+// towards raising the scale but never lower it, and the controller finds the limit by
+// stepping up until the waits start. Timed out or failed waits are not counted.
+class DynamicResolution : angle::NonCopyable
+{
+  public:
+    DynamicResolution();
+    ~DynamicResolution();
+
+    // GL thread, with the context current. Fails when the context has neither timer
+    // queries nor fences, or the upscale program does not build.
+    bool initialize(double targetMs, float minScale);
+    void destroy();
+
+    GpuTimeSource getTimeSource() const { return mTimeSource; }
+    double getTargetMs() const { return mTargetMs; }
+    float getMinScale() const;
+
+    // Binds a target of the scaled output size and sets the viewport to it, draw() renders
+    // into it as it would into outputFramebuffer, 0 for the default one. At full scale, or
+    // when no target can be made, draw() renders into outputFramebuffer directly.
+    void beginFrame(GLuint outputFramebuffer, size_t outputWidth, size_t outputHeight);
+
+    // Upscales into the output framebuffer and leaves it bound. The GL state the pass
+    // changes is restored, except the framebuffer binding.
+    void endFrame();
+
+    // After the swap: reads back GPU times, waiting only in fence mode, and adjusts the scale
+    void collect();
+
+    float getScale() const;
+
+    // Size draw() renders at this frame
+    size_t getRenderWidth() const { return mRenderWidth; }
+    size_t getRenderHeight() const { return mRenderHeight; }
+
+    const DynamicResolutionStats &getStats() const { return mStats; }
+    const RenderTargetPool &getPool() const { return mPool; }
+
+  private:
+    struct PendingFrame
+    {
+        GLuint begin   = 0;
+        GLuint end     = 0;
+        int scaleSteps = 0;
+    };
+
+    void addSample(double gpuMs, int scaleSteps);
+    void addHeadroom(int scaleSteps);
+    void setScaleSteps(int scaleSteps);
+    void upscale();
+    GLuint acquireQuery();
+
+    bool mInitialized;
+    GpuTimeSource mTimeSource;
+    bool mIsES3;
+    double mTargetMs;
+    int mMinScaleSteps;
+
+    // The scale is mScaleSteps / 20, the step between scales 0.05
+    int mScaleSteps;
+    double mSmoothedMs;
+    int mSamplesAtScale;
+    int mRaiseFrames;
+
+    RenderTargetPool mPool;
+    RenderTarget *mTarget;
+    GLuint mOutputFramebuffer;
+    size_t mOutputWidth;
+    size_t mOutputHeight;
+    size_t mRenderWidth;
+    size_t mRenderHeight;
+
+    // Upscale pass. ES 2.0 has no vertex arrays, the pass saves and restores its attribute.
+    GLuint mProgram;
+    GLint mPositionLocation;
+    GLuint mVertexBuffer;
+    GLuint mVertexArray;
+
+    // Timer query mode, oldest frame first
+    std::vector<GLuint> mFreeQueries;
+    std::deque<PendingFrame> mPending;
+    PendingFrame mCurrent;
+
+    // Fence mode
+    GLsync mFence;
+    GLsync mPreviousFence;
+    int mPreviousScaleSteps;
+    std::chrono::steady_clock::time_point mPreviousCollect;
+
+    DynamicResolutionStats mStats;
+};
+
+#endif  // SAMPLE_UTIL_DYNAMIC_RESOLUTION_H
@@ -0,0 +1,523 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FrameCapture.cpp: Reads frames back without stalling and writes them out on a worker thread.
+//
+
+#include "sample_util/FrameCapture.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+#include "sample_util/Trace.h"
+#include "util/shader_utils.h"
+
+namespace
+{
+// Frames between a readback and the map of its pack buffer
+constexpr size_t kPackBufferCount = 3;
+
+// Frames the writer may fall behind before capture() waits for it
+constexpr size_t kMaxQueuedFrames = 4;
+
+// Largest stored deflate block
+constexpr size_t kStoredBlockSize = 65535;
+
+struct CrcTable
+{
+    uint32_t entries[256];
+
+    CrcTable()
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+    }
+};
+
+uint32_t UpdateCrc(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static const CrcTable table;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void PutBigEndian32(std::vector<uint8_t> *out, uint32_t value)
+{
+    out->push_back(static_cast<uint8_t>(value >> 24));
+    out->push_back(static_cast<uint8_t>(value >> 16));
+    out->push_back(static_cast<uint8_t>(value >> 8));
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+// Chunk length, type, data and the CRC of type and data
+void PutPngChunk(std::vector<uint8_t> *out, const char *type, const uint8_t *data, size_t size)
+{
+    PutBigEndian32(out, static_cast<uint32_t>(size));
+    const size_t typeOffset = out->size();
+    out->insert(out->end(), type, type + 4);
+    out->insert(out->end(), data, data + size);
+    uint32_t crc = UpdateCrc(0xFFFFFFFFu, out->data() + typeOffset, size + 4);
+    PutBigEndian32(out, crc ^ 0xFFFFFFFFu);
+}
+
+// Rows are prefixed with filter type 0 and wrapped in a zlib stream of stored blocks, which
+// costs a copy and two checksums instead of a compressor.
+bool WritePng(FILE *file, size_t width, size_t height, const uint8_t *pixels)
+{
+    const size_t rowSize = width * 4;
+    const size_t rawSize = (rowSize + 1) * height;
+
+    std::vector<uint8_t> raw(rawSize);
+    for (size_t y = 0; y < height; y++)
+    {
+        raw[y * (rowSize + 1)] = 0;
+        memcpy(&raw[y * (rowSize + 1) + 1], pixels + y * rowSize, rowSize);
+    }
+
+    std::vector<uint8_t> zlib;
+    zlib.reserve(rawSize + rawSize / kStoredBlockSize * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+    for (size_t offset = 0;; offset += kStoredBlockSize)
+    {
+        const size_t size = std::min(kStoredBlockSize, rawSize - offset);
+        const bool last   = offset + size == rawSize;
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(size));
+        zlib.push_back(static_cast<uint8_t>(size >> 8));
+        zlib.push_back(static_cast<uint8_t>(~size));
+        zlib.push_back(static_cast<uint8_t>(~size >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+
+        for (size_t i = offset; i < offset + size; i++)
+        {
+            adlerA += raw[i];
+            adlerB += adlerA;
+            // Fold well before 32-bit overflow, 5552 is zlib's bound
+            if ((i - offset) % 5552 == 5551)
+            {
+                adlerA %= 65521;
+                adlerB %= 65521;
+            }
+        }
+        adlerA %= 65521;
+        adlerB %= 65521;
+        if (last)
+        {
+            break;
+        }
+    }
+    PutBigEndian32(&zlib, (adlerB << 16) | adlerA);
+
+    static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> header;
+    PutBigEndian32(&header, static_cast<uint32_t>(width));
+    PutBigEndian32(&header, static_cast<uint32_t>(height));
+    header.push_back(8);  // bit depth
+    header.push_back(6);  // RGBA
+    header.push_back(0);  // deflate
+    header.push_back(0);  // adaptive filtering
+    header.push_back(0);  // no interlace
+
+    std::vector<uint8_t> png(kSignature, kSignature + 8);
+    PutPngChunk(&png, "IHDR", header.data(), header.size());
+    PutPngChunk(&png, "IDAT", zlib.data(), zlib.size());
+    PutPngChunk(&png, "IEND", nullptr, 0);
+    return fwrite(png.data(), 1, png.size(), file) == png.size();
+}
+
+// TGA stores rows bottom-up by default, the descriptor marks these as top-down instead
+bool WriteTga(FILE *file, size_t width, size_t height, const uint8_t *pixels)
+{
+    uint8_t header[18] = {};
+    header[2]          = 2;  // uncompressed true color
+    header[12]         = static_cast<uint8_t>(width);
+    header[13]         = static_cast<uint8_t>(width >> 8);
+    header[14]         = static_cast<uint8_t>(height);
+    header[15]         = static_cast<uint8_t>(height >> 8);
+    header[16]         = 32;
+    header[17]         = 0x28;  // 8 alpha bits, top-left origin
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> bgra(width * height * 4);
+    for (size_t i = 0; i < bgra.size(); i += 4)
+    {
+        bgra[i]     = pixels[i + 2];
+        bgra[i + 1] = pixels[i + 1];
+        bgra[i + 2] = pixels[i];
+        bgra[i + 3] = pixels[i + 3];
+    }
+    return fwrite(bgra.data(), 1, bgra.size(), file) == bgra.size();
+}
+
+const char *GetCaptureExtension(CaptureFormat format)
+{
+    switch (format)
+    {
+        case CaptureFormat::TGA:
+            return ".tga";
+        case CaptureFormat::PNG:
+            return ".png";
+        default:
+            return ".rgba";
+    }
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+}  // anonymous namespace
+
+bool ParseCaptureFormat(const char *name, CaptureFormat *formatOut)
+{
+    if (strcmp(name, "tga") == 0)
+    {
+        *formatOut = CaptureFormat::TGA;
+    }
+    else if (strcmp(name, "png") == 0)
+    {
+        *formatOut = CaptureFormat::PNG;
+    }
+    else if (strcmp(name, "raw") == 0)
+    {
+        *formatOut = CaptureFormat::Raw;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool WriteCaptureImage(const std::string &path,
+                       CaptureFormat format,
+                       size_t width,
+                       size_t height,
+                       const uint8_t *pixels)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = false;
+    switch (format)
+    {
+        case CaptureFormat::TGA:
+            written = WriteTga(file, width, height, pixels);
+            break;
+        case CaptureFormat::PNG:
+            written = WritePng(file, width, height, pixels);
+            break;
+        case CaptureFormat::Raw:
+            written = fwrite(pixels, 1, width * height * 4, file) == width * height * 4;
+            break;
+    }
+    return fclose(file) == 0 && written;
+}
+
+FrameCapture::FrameCapture()
+    : mInitialized(false),
+      mWidth(0),
+      mHeight(0),
+      mFormat(CaptureFormat::TGA),
+      mNextSlot(0),
+      mStopping(false)
+{}
+
+FrameCapture::~FrameCapture()
+{
+    destroy();
+}
+
+bool FrameCapture::initialize(size_t width,
+                              size_t height,
+                              CaptureFormat format,
+                              const std::string &prefix)
+{
+    mWidth  = width;
+    mHeight = height;
+    mFormat = format;
+    mPrefix = prefix;
+
+    if (mFormat == CaptureFormat::Raw)
+    {
+        mRawStream.open(mPrefix + GetCaptureExtension(mFormat), std::ios::binary);
+        if (!mRawStream)
+        {
+            std::cout << "Could not open " << mPrefix << GetCaptureExtension(mFormat)
+                      << std::endl;
+            return false;
+        }
+    }
+
+    // Pack buffers and fences are ES 3.0
+    if (IsGLES3OrLater() && glMapBufferRange && glFenceSync && glClientWaitSync)
+    {
+        mPackBuffers.resize(kPackBufferCount);
+        for (Slot &slot : mPackBuffers)
+        {
+            glGenBuffers(1, &slot.buffer);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(mWidth * mHeight * 4),
+                         nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    mStopping = false;
+    mWriter   = std::thread(&FrameCapture::writerLoop, this);
+
+    mInitialized = true;
+    return true;
+}
+
+void FrameCapture::destroy()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    // Oldest first, so the files come out in frame order
+    for (size_t i = 0; i < mPackBuffers.size(); i++)
+    {
+        Slot &slot = mPackBuffers[(mNextSlot + i) % mPackBuffers.size()];
+        if (slot.pending)
+        {
+            readSlot(&slot);
+        }
+        glDeleteBuffers(1, &slot.buffer);
+    }
+    mPackBuffers.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_all();
+    mWriter.join();
+
+    mRawStream.close();
+    mFreePixels.clear();
+    mInitialized = false;
+}
+
+void FrameCapture::capture(GLuint framebuffer, uint64_t frameIndex)
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    TraceScope traceScope("capture");
+    const auto start = std::chrono::steady_clock::now();
+
+    GLint previousFramebuffer = 0;
+    const GLenum readTarget   = isAsync() ? GL_READ_FRAMEBUFFER : GL_FRAMEBUFFER;
+    glGetIntegerv(isAsync() ? GL_READ_FRAMEBUFFER_BINDING : GL_FRAMEBUFFER_BINDING,
+                  &previousFramebuffer);
+    if (static_cast<GLuint>(previousFramebuffer) != framebuffer)
+    {
+        glBindFramebuffer(readTarget, framebuffer);
+    }
+
+    if (isAsync())
+    {
+        // Map the slots that are done, and the one about to be reused whether it is or not
+        for (size_t i = 0; i < mPackBuffers.size(); i++)
+        {
+            Slot &slot = mPackBuffers[(mNextSlot + i) % mPackBuffers.size()];
+            if (!slot.pending)
+            {
+                continue;
+            }
+            if (i > 0 && glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            {
+                break;
+            }
+            readSlot(&slot);
+        }
+
+        Slot &slot = mPackBuffers[mNextSlot];
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        glReadPixels(0, 0, static_cast<GLsizei>(mWidth), static_cast<GLsizei>(mHeight), GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.fence   = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.frame   = frameIndex;
+        slot.pending = true;
+        mNextSlot    = (mNextSlot + 1) % mPackBuffers.size();
+    }
+    else
+    {
+        Frame frame = acquireFrame(frameIndex);
+        glReadPixels(0, 0, static_cast<GLsizei>(mWidth), static_cast<GLsizei>(mHeight), GL_RGBA,
+                     GL_UNSIGNED_BYTE, frame.pixels.data());
+        queueFrame(std::move(frame));
+    }
+
+    if (static_cast<GLuint>(previousFramebuffer) != framebuffer)
+    {
+        glBindFramebuffer(readTarget, static_cast<GLuint>(previousFramebuffer));
+    }
+
+    const double elapsedMs = MillisecondsSince(start);
+    mStats.frames++;
+    mStats.totalMs += elapsedMs;
+    mStats.maxMs = std::max(mStats.maxMs, elapsedMs);
+}
+
+void FrameCapture::readSlot(Slot *slot)
+{
+    // Flushing on the first try keeps a slot that was never flushed from waiting forever
+    GLenum status = glClientWaitSync(slot->fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        mStats.readbackStalls++;
+        status = glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    }
+    glDeleteSync(slot->fence);
+    slot->fence   = 0;
+    slot->pending = false;
+
+    Frame frame = acquireFrame(slot->frame);
+    const size_t size = frame.pixels.size();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (mapped && status != GL_WAIT_FAILED)
+    {
+        memcpy(frame.pixels.data(), mapped, size);
+    }
+    if (mapped)
+    {
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (mapped && status != GL_WAIT_FAILED)
+    {
+        queueFrame(std::move(frame));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStats.writeFailures++;
+        mFreePixels.push_back(std::move(frame.pixels));
+    }
+}
+
+FrameCapture::Frame FrameCapture::acquireFrame(uint64_t frameIndex)
+{
+    Frame frame;
+    frame.index = frameIndex;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFreePixels.empty())
+        {
+            frame.pixels = std::move(mFreePixels.back());
+            mFreePixels.pop_back();
+        }
+    }
+    frame.pixels.resize(mWidth * mHeight * 4);
+    return frame;
+}
+
+void FrameCapture::queueFrame(Frame &&frame)
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mQueue.size() >= kMaxQueuedFrames)
+        {
+            mStats.writerStalls++;
+            mCondition.wait(lock, [this]() { return mQueue.size() < kMaxQueuedFrames; });
+        }
+        mQueue.push_back(std::move(frame));
+    }
+    mCondition.notify_all();
+}
+
+void FrameCapture::writerLoop()
+{
+    TraceSetThreadName("capture");
+
+    while (true)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+            if (mQueue.empty())
+            {
+                return;
+            }
+            frame = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+        mCondition.notify_all();
+
+        bool written = false;
+        {
+            TraceScope traceScope("write");
+            written = writeFrame(&frame);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!written)
+        {
+            mStats.writeFailures++;
+        }
+        mFreePixels.push_back(std::move(frame.pixels));
+    }
+}
+
+bool FrameCapture::writeFrame(Frame *frame)
+{
+    // GL rows start at the bottom
+    const size_t rowSize = mWidth * 4;
+    mScratch.resize(rowSize);
+    for (size_t y = 0; y < mHeight / 2; y++)
+    {
+        uint8_t *top    = &frame->pixels[y * rowSize];
+        uint8_t *bottom = &frame->pixels[(mHeight - 1 - y) * rowSize];
+        memcpy(mScratch.data(), top, rowSize);
+        memcpy(top, bottom, rowSize);
+        memcpy(bottom, mScratch.data(), rowSize);
+    }
+
+    if (mFormat == CaptureFormat::Raw)
+    {
+        mRawStream.write(reinterpret_cast<const char *>(frame->pixels.data()),
+                         static_cast<std::streamsize>(frame->pixels.size()));
+        return static_cast<bool>(mRawStream);
+    }
+
+    char index[32];
+    snprintf(index, sizeof(index), "_%06llu", static_cast<unsigned long long>(frame->index));
+    return WriteCaptureImage(mPrefix + index + GetCaptureExtension(mFormat), mFormat, mWidth,
+                             mHeight, frame->pixels.data());
+}
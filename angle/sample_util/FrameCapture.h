@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FrameCapture.h: Reads frames back without stalling and writes them out on a worker thread.
+//
+
+#ifndef SAMPLE_UTIL_FRAME_CAPTURE_H
+#define SAMPLE_UTIL_FRAME_CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "util/gles_loader_autogen.h"
+
+enum class CaptureFormat
+{
+    TGA,  // <prefix>_<frame>.tga, 32-bit uncompressed
+    PNG,  // <prefix>_<frame>.png, 8-bit RGBA with stored (uncompressed) deflate blocks
+    Raw,  // <prefix>.rgba, top-down RGBA frames back to back, e.g. for ffmpeg -f rawvideo
+};
+
+// Returns false for names other than "tga", "png" and "raw"
+bool ParseCaptureFormat(const char *name, CaptureFormat *formatOut);
+
+// Writes one top-down RGBA image, the format decides how it is encoded. Raw writes the
+// pixels as they are.
+bool WriteCaptureImage(const std::string &path,
+                       CaptureFormat format,
+                       size_t width,
+                       size_t height,
+                       const uint8_t *pixels);
+
+struct CaptureStats
+{
+    uint64_t frames = 0;
+
+    // Time capture() spent on the GL thread, including waits on a full ring or queue
+    double totalMs = 0.0;
+    double maxMs   = 0.0;
+
+    // Times capture() had to wait for the GPU or for the writer
+    uint64_t readbackStalls = 0;
+    uint64_t writerStalls   = 0;
+    uint64_t writeFailures  = 0;
+};
+
+// On ES 3.0, capture() reads into the next pixel pack buffer of a small ring and fences it.
+// Slots are mapped once their fence has signaled, a few frames later, so the GL thread only
+// waits when the GPU is more than the whole ring behind. ES 2.0 has no pack buffers and
+// reads synchronously with glReadPixels.
+//
+// Mapped pixels are copied into a pooled frame and handed to a writer thread that flips,
+// encodes and writes it, so encoding never runs on the GL thread. The writer keeps at most
+// a few frames queued and capture() waits for it beyond that rather than growing without
+// limit.
+class FrameCapture : angle::NonCopyable
+{
+  public:
+    FrameCapture();
+    ~FrameCapture();
+
+    // GL thread, with the context current. Frames are width x height from the origin of
+    // whatever framebuffer capture() is given.
+    bool initialize(size_t width,
+                    size_t height,
+                    CaptureFormat format,
+                    const std::string &prefix);
+
+    // Finishes every frame in flight, then stops the writer
+    void destroy();
+
+    bool isInitialized() const { return mInitialized; }
+    bool isAsync() const { return !mPackBuffers.empty(); }
+
+    // Reads the color buffer of framebuffer, 0 for the default one, before it is swapped.
+    // frameIndex names the file. Restores the framebuffer binding.
+    void capture(GLuint framebuffer, uint64_t frameIndex);
+
+    const CaptureStats &getStats() const { return mStats; }
+
+  private:
+    struct Slot
+    {
+        GLuint buffer  = 0;
+        GLsync fence   = 0;
+        uint64_t frame = 0;
+        bool pending   = false;
+    };
+
+    struct Frame
+    {
+        uint64_t index = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    void readSlot(Slot *slot);
+    Frame acquireFrame(uint64_t frameIndex);
+    void queueFrame(Frame &&frame);
+    void writerLoop();
+    bool writeFrame(Frame *frame);
+
+    bool mInitialized;
+    size_t mWidth;
+    size_t mHeight;
+    CaptureFormat mFormat;
+    std::string mPrefix;
+
+    // ES 3.0 readback ring, mNextSlot is the oldest and the next one to reuse
+    std::vector<Slot> mPackBuffers;
+    size_t mNextSlot;
+
+    std::thread mWriter;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Frame> mQueue;
+    std::vector<std::vector<uint8_t>> mFreePixels;
+    bool mStopping;
+
+    // Owned by the writer, only the raw stream stays open between frames
+    std::ofstream mRawStream;
+    std::vector<uint8_t> mScratch;
+
+    CaptureStats mStats;
+};
+
+#endif  // SAMPLE_UTIL_FRAME_CAPTURE_H
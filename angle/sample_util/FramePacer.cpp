@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FramePacer.cpp: Holds the frame loop to a target rate with absolute deadlines.
+//
+
+#include "sample_util/FramePacer.h"
+
+#include "common/platform.h"
+
+#if defined(ANGLE_PLATFORM_POSIX)
+#    include <errno.h>
+#    include <time.h>
+#else
+#    include <chrono>
+#    include <thread>
+#endif
+
+namespace
+{
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+
+// Sleeping ends this long before the deadline, the rest is spent spinning on the clock. It
+// covers the usual timer slack and scheduler wake-up latency.
+constexpr int64_t kSpinTime = 500000;
+
+// A frame counts as missed once it ends more than this fraction of a period late
+constexpr int64_t kMissedFraction = 4;
+
+void SleepUntil(int64_t deadline)
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    timespec time;
+    time.tv_sec  = static_cast<time_t>(deadline / kNanosecondsPerSecond);
+    time.tv_nsec = static_cast<long>(deadline % kNanosecondsPerSecond);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR)
+    {
+    }
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds(deadline))));
+#endif
+}
+}  // anonymous namespace
+
+FramePacer::FramePacer() : mPeriod(0), mDeadline(0), mFrameCount(0), mMissedCount(0) {}
+
+void FramePacer::start(double framesPerSecond)
+{
+    mPeriod      = framesPerSecond > 0.0
+                       ? static_cast<int64_t>(kNanosecondsPerSecond / framesPerSecond + 0.5)
+                       : 0;
+    mDeadline    = Now() + mPeriod;
+    mFrameCount  = 0;
+    mMissedCount = 0;
+}
+
+double FramePacer::getFrameRate() const
+{
+    return mPeriod > 0 ? static_cast<double>(kNanosecondsPerSecond) / mPeriod : 0.0;
+}
+
+void FramePacer::wait(bool sleep)
+{
+    if (mPeriod == 0)
+    {
+        return;
+    }
+
+    mFrameCount++;
+
+    int64_t now = Now();
+    if (now > mDeadline + mPeriod / kMissedFraction)
+    {
+        // Late, start a new schedule from here
+        mMissedCount++;
+        mDeadline = now + mPeriod;
+        return;
+    }
+
+    if (sleep)
+    {
+        if (mDeadline - now > kSpinTime)
+        {
+            SleepUntil(mDeadline - kSpinTime);
+        }
+        while (Now() < mDeadline)
+        {
+        }
+    }
+
+    mDeadline += mPeriod;
+}
+
+int64_t FramePacer::Now()
+{
+#if defined(ANGLE_PLATFORM_POSIX)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64_t>(time.tv_sec) * kNanosecondsPerSecond + time.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FramePacer.h: Holds the frame loop to a target rate with absolute deadlines.
+//
+
+#ifndef SAMPLE_UTIL_FRAME_PACER_H
+#define SAMPLE_UTIL_FRAME_PACER_H
+
+#include <stdint.h>
+
+// Deadlines advance by exactly one period per frame, so sleep overshoot and time spent in
+// swap do not accumulate into drift. The pacer sleeps to just short of the deadline and spins
+// for the remainder, which keeps wake-up jitter well under a millisecond. A frame that ends
+// less than a quarter period after its deadline returns at once and keeps the schedule, so
+// the next frame absorbs the overrun. Later than that it is counted as missed and the
+// schedule restarts from the current time instead of rushing to catch up.
+class FramePacer
+{
+  public:
+    FramePacer();
+
+    // A rate of 0 disables pacing
+    void start(double framesPerSecond);
+    bool isEnabled() const { return mPeriod > 0; }
+    double getFrameRate() const;
+
+    // Waits for the next deadline. With sleep false only the deadline bookkeeping is done,
+    // for frames that are already paced by the swap interval.
+    void wait(bool sleep = true);
+
+    uint64_t getFrameCount() const { return mFrameCount; }
+    uint64_t getMissedCount() const { return mMissedCount; }
+
+    // Monotonic clock in nanoseconds
+    static int64_t Now();
+
+  private:
+    int64_t mPeriod;
+    int64_t mDeadline;
+    uint64_t mFrameCount;
+    uint64_t mMissedCount;
+};
+
+#endif  // SAMPLE_UTIL_FRAME_PACER_H
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FrameStats.cpp: Frame time samples and their summary for the sample benchmark mode.
+//
+
+#include "sample_util/FrameStats.h"
+
+#include <math.h>
+#include <algorithm>
+#include <iomanip>
+
+namespace
+{
+double Percentile(const std::vector<double> &sorted, double percent)
+{
+    size_t rank = static_cast<size_t>(ceil(percent / 100.0 * sorted.size()));
+    rank        = std::min(std::max<size_t>(rank, 1), sorted.size());
+    return sorted[rank - 1];
+}
+}  // anonymous namespace
+
+FrameStats::FrameStats() = default;
+
+FrameStats::~FrameStats() = default;
+
+FrameTimeSummary FrameStats::summarize() const
+{
+    FrameTimeSummary summary;
+    if (mSamples.empty())
+    {
+        return summary;
+    }
+
+    std::vector<double> sorted(mSamples);
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0.0;
+    for (double sample : sorted)
+    {
+        total += sample;
+    }
+
+    summary.count  = sorted.size();
+    summary.min    = sorted.front() * 1e3;
+    summary.median = Percentile(sorted, 50.0) * 1e3;
+    summary.p95    = Percentile(sorted, 95.0) * 1e3;
+    summary.p99    = Percentile(sorted, 99.0) * 1e3;
+    summary.max    = sorted.back() * 1e3;
+    summary.mean   = total / sorted.size() * 1e3;
+    return summary;
+}
+
+void PrintFrameTimeSummary(std::ostream &out, const char *label, const FrameTimeSummary &summary)
+{
+    out << std::fixed << std::setprecision(3) << label << ": min " << summary.min << " median "
+        << summary.median << " p95 " << summary.p95 << " p99 " << summary.p99 << " max "
+        << summary.max << " mean " << summary.mean << " ms" << std::endl;
+}
+
+void WriteFrameTimeSummaryJSON(std::ostream &out, const FrameTimeSummary &summary)
+{
+    out << std::fixed << std::setprecision(4) << "{\"count\": " << summary.count
+        << ", \"min\": " << summary.min << ", \"median\": " << summary.median
+        << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99
+        << ", \"max\": " << summary.max << ", \"mean\": " << summary.mean << "}";
+}
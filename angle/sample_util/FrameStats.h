@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// FrameStats.h: Frame time samples and their summary for the sample benchmark mode.
+//
+
+#ifndef SAMPLE_UTIL_FRAME_STATS_H
+#define SAMPLE_UTIL_FRAME_STATS_H
+
+#include <stddef.h>
+#include <ostream>
+#include <vector>
+
+struct FrameTimeSummary
+{
+    size_t count  = 0;
+    double min    = 0.0;
+    double median = 0.0;
+    double p95    = 0.0;
+    double p99    = 0.0;
+    double max    = 0.0;
+    double mean   = 0.0;
+};
+
+// Collects per-frame durations in seconds
+class FrameStats
+{
+  public:
+    FrameStats();
+    ~FrameStats();
+
+    void reserve(size_t count) { mSamples.reserve(count); }
+    void add(double seconds) { mSamples.push_back(seconds); }
+    size_t size() const { return mSamples.size(); }
+
+    // Nearest-rank percentiles, in milliseconds
+    FrameTimeSummary summarize() const;
+
+  private:
+    std::vector<double> mSamples;
+};
+
+// One line human readable form, e.g. "min 1.02 median 1.10 p95 1.31 p99 1.52 max 2.01 ms"
+void PrintFrameTimeSummary(std::ostream &out, const char *label, const FrameTimeSummary &summary);
+
+// JSON object with the fields of FrameTimeSummary
+void WriteFrameTimeSummaryJSON(std::ostream &out, const FrameTimeSummary &summary);
+
+#endif  // SAMPLE_UTIL_FRAME_STATS_H
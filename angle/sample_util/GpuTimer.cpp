@@ -0,0 +1,257 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GpuTimer.cpp: Named GPU time scopes on top of EXT_disjoint_timer_query.
+//
+
+#include "sample_util/GpuTimer.h"
+
+#include <algorithm>
+
+#include "util/shader_utils.h"
+
+namespace
+{
+// Upper bound on queries waiting for their result; scopes beyond it are dropped rather than
+// letting a GPU that has fallen far behind grow the pool without limit.
+constexpr size_t kMaxPendingQueries = 256;
+
+GpuProfiler *gCurrentProfiler = nullptr;
+}  // anonymous namespace
+
+GpuProfiler::GpuProfiler()
+    : mInitialized(false),
+      mRecording(false),
+      mScopeDepth(0),
+      mActiveQuery(0),
+      mActiveScope(0),
+      mActiveSubmitTime(0),
+      mTraceTrack(nullptr),
+      mTraceTrackEnd(0),
+      mDisjointCount(0),
+      mDroppedCount(0)
+{}
+
+GpuProfiler::~GpuProfiler()
+{
+    destroy();
+}
+
+bool GpuProfiler::initialize()
+{
+    if (!HasGLExtension("GL_EXT_disjoint_timer_query") || !glGenQueriesEXT)
+    {
+        return false;
+    }
+
+    // Clear any disjoint event from before the first scope
+    checkDisjoint();
+    mTraceTrack  = TraceCreateTrack("GPU");
+    mInitialized = true;
+    return true;
+}
+
+void GpuProfiler::destroy()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    if (mActiveQuery != 0)
+    {
+        glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+        mFreeQueries.push_back(mActiveQuery);
+        mActiveQuery = 0;
+    }
+    mScopeDepth = 0;
+    for (const PendingQuery &pending : mPending)
+    {
+        mFreeQueries.push_back(pending.query);
+    }
+    mPending.clear();
+
+    if (!mFreeQueries.empty())
+    {
+        glDeleteQueriesEXT(static_cast<GLsizei>(mFreeQueries.size()), mFreeQueries.data());
+        mFreeQueries.clear();
+    }
+
+    if (gCurrentProfiler == this)
+    {
+        gCurrentProfiler = nullptr;
+    }
+    mInitialized = false;
+}
+
+void GpuProfiler::beginScope(const char *name)
+{
+    if (mScopeDepth++ > 0 || !mInitialized || !mRecording)
+    {
+        return;
+    }
+
+    if (mPending.size() >= kMaxPendingQueries)
+    {
+        mDroppedCount++;
+        return;
+    }
+
+    GLuint query = 0;
+    if (!mFreeQueries.empty())
+    {
+        query = mFreeQueries.back();
+        mFreeQueries.pop_back();
+    }
+    else
+    {
+        glGenQueriesEXT(1, &query);
+    }
+
+    mActiveQuery      = query;
+    mActiveScope      = findScope(name);
+    mActiveSubmitTime = mTraceTrack ? TraceNow() : 0;
+    glBeginQueryEXT(GL_TIME_ELAPSED_EXT, query);
+}
+
+void GpuProfiler::endScope()
+{
+    if (mScopeDepth == 0 || --mScopeDepth > 0 || mActiveQuery == 0)
+    {
+        return;
+    }
+
+    glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+    mPending.push_back({mActiveQuery, mActiveScope, mActiveSubmitTime});
+    mActiveQuery = 0;
+}
+
+void GpuProfiler::collect()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    // A disjoint event invalidates everything still in flight
+    if (checkDisjoint())
+    {
+        for (const PendingQuery &pending : mPending)
+        {
+            mFreeQueries.push_back(pending.query);
+        }
+        mPending.clear();
+        return;
+    }
+
+    // Queries finish in submission order, stop at the first one that is not ready
+    while (!mPending.empty())
+    {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuivEXT(mPending.front().query, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+        if (!available)
+        {
+            break;
+        }
+        readResult(mPending.front());
+        mPending.pop_front();
+    }
+}
+
+void GpuProfiler::finish()
+{
+    if (!mInitialized)
+    {
+        return;
+    }
+
+    glFinish();
+    if (checkDisjoint())
+    {
+        for (const PendingQuery &pending : mPending)
+        {
+            mFreeQueries.push_back(pending.query);
+        }
+        mPending.clear();
+        return;
+    }
+
+    // GL_QUERY_RESULT_EXT blocks until the result is available
+    while (!mPending.empty())
+    {
+        readResult(mPending.front());
+        mPending.pop_front();
+    }
+}
+
+GpuProfiler *GpuProfiler::GetCurrent()
+{
+    return gCurrentProfiler;
+}
+
+void GpuProfiler::SetCurrent(GpuProfiler *profiler)
+{
+    gCurrentProfiler = profiler;
+}
+
+size_t GpuProfiler::findScope(const char *name)
+{
+    for (size_t index = 0; index < mScopeNames.size(); index++)
+    {
+        if (mScopeNames[index] == name)
+        {
+            return index;
+        }
+    }
+
+    mScopeNames.emplace_back(name);
+    mTraceNames.push_back(TraceInternName(mScopeNames.back()));
+    mScopeTimes.emplace_back();
+    return mScopeNames.size() - 1;
+}
+
+bool GpuProfiler::checkDisjoint()
+{
+    // Reading GL_GPU_DISJOINT_EXT also resets it
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint)
+    {
+        mDisjointCount++;
+        return true;
+    }
+    return false;
+}
+
+void GpuProfiler::readResult(const PendingQuery &pending)
+{
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64vEXT(pending.query, GL_QUERY_RESULT_EXT, &elapsed);
+    mScopeTimes[pending.scope].add(static_cast<double>(elapsed) * 1e-9);
+    mFreeQueries.push_back(pending.query);
+
+    if (mTraceTrack)
+    {
+        uint64_t start = std::max(pending.submitTime, mTraceTrackEnd);
+        TraceAddEvent(mTraceTrack, mTraceNames[pending.scope], start, elapsed);
+        mTraceTrackEnd = start + elapsed;
+    }
+}
+
+GpuScope::GpuScope(const char *name) : mProfiler(GpuProfiler::GetCurrent())
+{
+    if (mProfiler)
+    {
+        mProfiler->beginScope(name);
+    }
+}
+
+GpuScope::~GpuScope()
+{
+    if (mProfiler)
+    {
+        mProfiler->endScope();
+    }
+}
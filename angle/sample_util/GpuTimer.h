@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GpuTimer.h: Named GPU time scopes on top of EXT_disjoint_timer_query.
+//
+
+#ifndef SAMPLE_UTIL_GPU_TIMER_H
+#define SAMPLE_UTIL_GPU_TIMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "sample_util/FrameStats.h"
+#include "sample_util/Trace.h"
+#include "util/gles_loader_autogen.h"
+
+// Each scope brackets its GL commands with a GL_TIME_ELAPSED_EXT query. Queries are recycled
+// through a free list and read back by collect() only once the oldest one reports
+// GL_QUERY_RESULT_AVAILABLE_EXT, so the CPU never waits on the GPU during a run. Results
+// that span a disjoint event (GL_GPU_DISJOINT_EXT) are discarded.
+//
+// Elapsed time queries cannot nest: a scope opened inside another scope is folded into the
+// outer one.
+//
+// While tracing, results also go to a "GPU" track. Without a CPU/GPU clock correlation each
+// event starts when its scope was submitted or when the previous GPU event ended, whichever
+// is later, which is how a single GPU queue would have run them.
+class GpuProfiler
+{
+  public:
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // Fails when EXT_disjoint_timer_query is not exposed by the current context
+    bool initialize();
+    void destroy();
+
+    // Scopes are ignored unless recording, e.g. during benchmark warmup
+    void setRecording(bool recording) { mRecording = recording; }
+    bool isRecording() const { return mRecording; }
+
+    void beginScope(const char *name);
+    void endScope();
+
+    // Reads back finished queries without waiting, call once per frame
+    void collect();
+
+    // Waits for every outstanding query, for the final report
+    void finish();
+
+    size_t getScopeCount() const { return mScopeNames.size(); }
+    const std::string &getScopeName(size_t index) const { return mScopeNames[index]; }
+    FrameTimeSummary summarizeScope(size_t index) const { return mScopeTimes[index].summarize(); }
+
+    uint64_t getDisjointCount() const { return mDisjointCount; }
+    uint64_t getDroppedCount() const { return mDroppedCount; }
+
+    // Profiler that GpuScope reports to, nullptr disables all scopes
+    static GpuProfiler *GetCurrent();
+    static void SetCurrent(GpuProfiler *profiler);
+
+  private:
+    struct PendingQuery
+    {
+        GLuint query;
+        size_t scope;
+        uint64_t submitTime;
+    };
+
+    size_t findScope(const char *name);
+    bool checkDisjoint();
+    void readResult(const PendingQuery &pending);
+
+    bool mInitialized;
+    bool mRecording;
+
+    // Trace events point at the interned copies, which outlive the profiler
+    std::deque<std::string> mScopeNames;
+    std::vector<const char *> mTraceNames;
+    std::vector<FrameStats> mScopeTimes;
+
+    std::vector<GLuint> mFreeQueries;
+    std::deque<PendingQuery> mPending;
+
+    // Depth of open scopes, only the outermost one owns a query
+    int mScopeDepth;
+    GLuint mActiveQuery;
+    size_t mActiveScope;
+    uint64_t mActiveSubmitTime;
+
+    TraceTrack *mTraceTrack;
+    uint64_t mTraceTrackEnd;
+
+    uint64_t mDisjointCount;
+    uint64_t mDroppedCount;
+};
+
+// RAII scope, e.g. GpuScope scope("draw");
+class GpuScope
+{
+  public:
+    explicit GpuScope(const char *name);
+    ~GpuScope();
+
+  private:
+    GpuProfiler *mProfiler;
+};
+
+#endif  // SAMPLE_UTIL_GPU_TIMER_H
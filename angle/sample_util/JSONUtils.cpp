@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// JSONUtils.cpp: Helpers shared by the JSON the samples write, benchmark results and traces.
+//
+
+#include "sample_util/JSONUtils.h"
+
+void WriteJSONString(std::ostream &out, const char *text)
+{
+    constexpr char kHexDigits[] = "0123456789abcdef";
+
+    out << '"';
+    for (; *text != '\0'; text++)
+    {
+        const unsigned char c = static_cast<unsigned char>(*text);
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << *text;
+        }
+        else if (c < 0x20)
+        {
+            out << "\\u00" << kHexDigits[c >> 4] << kHexDigits[c & 0xF];
+        }
+        else
+        {
+            out << *text;
+        }
+    }
+    out << '"';
+}
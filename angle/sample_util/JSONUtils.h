@@ -0,0 +1,18 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// JSONUtils.h: Helpers shared by the JSON the samples write, benchmark results and traces.
+//
+
+#ifndef SAMPLE_UTIL_JSON_UTILS_H
+#define SAMPLE_UTIL_JSON_UTILS_H
+
+#include <ostream>
+
+// Writes text as a quoted JSON string. Quotes, backslashes and control characters are
+// escaped, so names taken from the command line or the GL driver cannot break the output.
+void WriteJSONString(std::ostream &out, const char *text);
+
+#endif  // SAMPLE_UTIL_JSON_UTILS_H
@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RenderTargetPool.cpp: Offscreen framebuffers that are recycled by size.
+//
+
+#include "sample_util/RenderTargetPool.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "util/shader_utils.h"
+
+namespace
+{
+// Free targets unused for this many frames are deleted, about two seconds at 60 fps
+constexpr uint64_t kMaxIdleFrames = 120;
+}  // anonymous namespace
+
+RenderTargetPool::RenderTargetPool()
+    : mInitialized(false),
+      mTextureStorage(false),
+      mPackedDepthStencil(false),
+      mFrame(0),
+      mCreatedCount(0)
+{}
+
+RenderTargetPool::~RenderTargetPool()
+{
+    destroy();
+}
+
+void RenderTargetPool::initialize()
+{
+    mTextureStorage     = IsGLES3OrLater();
+    mPackedDepthStencil = mTextureStorage || HasGLExtension("GL_OES_packed_depth_stencil");
+    mInitialized        = true;
+}
+
+void RenderTargetPool::destroy()
+{
+    for (Entry &entry : mEntries)
+    {
+        deleteTarget(entry.target.get());
+    }
+    mEntries.clear();
+    mInitialized = false;
+}
+
+RenderTarget *RenderTargetPool::acquire(GLsizei width, GLsizei height)
+{
+    if (!mInitialized)
+    {
+        return nullptr;
+    }
+
+    for (Entry &entry : mEntries)
+    {
+        if (!entry.inUse && entry.target->width == width && entry.target->height == height)
+        {
+            entry.inUse         = true;
+            entry.lastUsedFrame = mFrame;
+            glBindFramebuffer(GL_FRAMEBUFFER, entry.target->framebuffer);
+            return entry.target.get();
+        }
+    }
+
+    Entry entry;
+    entry.target.reset(new RenderTarget());
+    entry.target->width  = width;
+    entry.target->height = height;
+    if (!createTarget(entry.target.get()))
+    {
+        std::cout << "Render target " << width << "x" << height << " is incomplete" << std::endl;
+        deleteTarget(entry.target.get());
+        return nullptr;
+    }
+
+    entry.inUse         = true;
+    entry.lastUsedFrame = mFrame;
+    mCreatedCount++;
+    mEntries.push_back(std::move(entry));
+    return mEntries.back().target.get();
+}
+
+void RenderTargetPool::release(RenderTarget *target)
+{
+    for (Entry &entry : mEntries)
+    {
+        if (entry.target.get() == target)
+        {
+            entry.inUse         = false;
+            entry.lastUsedFrame = mFrame;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::trim()
+{
+    mFrame++;
+
+    auto idle = [this](Entry &entry) {
+        if (entry.inUse || mFrame - entry.lastUsedFrame < kMaxIdleFrames)
+        {
+            return false;
+        }
+        deleteTarget(entry.target.get());
+        return true;
+    };
+    mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(), idle), mEntries.end());
+}
+
+bool RenderTargetPool::createTarget(RenderTarget *target)
+{
+    // Creating must not disturb the texture and renderbuffer the sample has bound
+    GLint texture      = 0;
+    GLint renderbuffer = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture);
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &renderbuffer);
+
+    // Unsized RGBA is the only renderable texture format ES 2.0 guarantees. Non power of two
+    // sizes need clamping and no mipmaps there.
+    glGenTextures(1, &target->colorTexture);
+    glBindTexture(GL_TEXTURE_2D, target->colorTexture);
+    if (mTextureStorage)
+    {
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, target->width, target->height);
+    }
+    else
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, target->width, target->height, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(texture));
+
+    glGenRenderbuffers(1, &target->depthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER,
+                          mPackedDepthStencil ? GL_DEPTH24_STENCIL8_OES : GL_DEPTH_COMPONENT16,
+                          target->width, target->height);
+    glBindRenderbuffer(GL_RENDERBUFFER, static_cast<GLuint>(renderbuffer));
+
+    glGenFramebuffers(1, &target->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           target->colorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                              target->depthStencil);
+    if (mPackedDepthStencil)
+    {
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                  target->depthStencil);
+    }
+
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void RenderTargetPool::deleteTarget(RenderTarget *target)
+{
+    if (target->framebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &target->framebuffer);
+    }
+    if (target->depthStencil != 0)
+    {
+        glDeleteRenderbuffers(1, &target->depthStencil);
+    }
+    if (target->colorTexture != 0)
+    {
+        glDeleteTextures(1, &target->colorTexture);
+    }
+    *target = RenderTarget();
+}
@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// RenderTargetPool.h: Offscreen framebuffers that are recycled by size.
+//
+
+#ifndef SAMPLE_UTIL_RENDER_TARGET_POOL_H
+#define SAMPLE_UTIL_RENDER_TARGET_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "common/angleutils.h"
+#include "util/gles_loader_autogen.h"
+
+// An RGBA8 color texture that can be sampled with GL_LINEAR, and a depth (and stencil where
+// supported) renderbuffer, both width x height.
+struct RenderTarget
+{
+    GLuint framebuffer  = 0;
+    GLuint colorTexture = 0;
+    GLuint depthStencil = 0;
+    GLsizei width       = 0;
+    GLsizei height      = 0;
+};
+
+// acquire() hands out a free target of the requested size or creates one, release() returns
+// it to the pool. Free targets stay allocated until trim() finds them unused for a while, so
+// sizes that come and go within a few seconds, e.g. while a resolution scale settles, are not
+// reallocated every time.
+class RenderTargetPool : angle::NonCopyable
+{
+  public:
+    RenderTargetPool();
+    ~RenderTargetPool();
+
+    // GL thread, with the context current. Picks the depth format the context supports.
+    void initialize();
+
+    // Deletes every target, acquired ones included
+    void destroy();
+
+    // Returns nullptr when the framebuffer is incomplete. Leaves the target bound to
+    // GL_FRAMEBUFFER, other bindings are preserved.
+    RenderTarget *acquire(GLsizei width, GLsizei height);
+    void release(RenderTarget *target);
+
+    // Call once per frame
+    void trim();
+
+    size_t getSize() const { return mEntries.size(); }
+    uint64_t getCreatedCount() const { return mCreatedCount; }
+
+  private:
+    struct Entry
+    {
+        std::unique_ptr<RenderTarget> target;
+        bool inUse             = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    bool createTarget(RenderTarget *target);
+    void deleteTarget(RenderTarget *target);
+
+    bool mInitialized;
+    bool mTextureStorage;
+    bool mPackedDepthStencil;
+
+    std::vector<Entry> mEntries;
+    uint64_t mFrame;
+    uint64_t mCreatedCount;
+};
+
+#endif  // SAMPLE_UTIL_RENDER_TARGET_POOL_H
@@ -6,39 +6,133 @@
 
 #include "SampleApplication.h"
 
+#include "sample_util/DynamicResolution.h"
+#include "sample_util/FrameStats.h"
+#include "sample_util/GpuTimer.h"
+#include "sample_util/JSONUtils.h"
+#include "sample_util/StateCache.h"
+#include "sample_util/Trace.h"
+#include "sample_util/UploadQueue.h"
 #include "util/EGLWindow.h"
 #include "util/gles_loader_autogen.h"
+#include "util/gles_loader_lazy.h"
 #include "util/random_utils.h"
+#include "util/shader_utils.h"
 #include "util/system_utils.h"
 
+#include <math.h>
+#include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <utility>
 
+// Not in the bundled eglext_angle.h yet
+#ifndef EGL_PLATFORM_ANGLE_DEVICE_TYPE_SWIFTSHADER_ANGLE
+#    define EGL_PLATFORM_ANGLE_DEVICE_TYPE_SWIFTSHADER_ANGLE 0x3487
+#endif
+
 namespace
 {
-const char *kUseAngleArg = "--use-angle=";
+const char *kUseAngleArg    = "--use-angle=";
+const char *kHeadlessArg    = "--headless";
+const char *kSizeArg        = "--size=";
+const char *kFramesArg      = "--frames=";
+const char *kWarmupArg      = "--warmup=";
+const char *kJsonArg        = "--json=";
+const char *kBudgetArg      = "--budget-ms=";
+const char *kTraceArg       = "--trace=";
+const char *kFpsArg         = "--fps=";
+const char *kVsyncArg       = "--vsync";
+const char *kThreadedArg    = "--threaded";
+const char *kFixedArg       = "--fixed-step=";
+const char *kMaxStepsArg    = "--max-steps=";
+const char *kAsyncUploadArg = "--async-upload";
+const char *kCacheArg       = "--program-cache";
+const char *kNoCacheArg     = "--no-program-cache";
+const char *kStateArg       = "--state-cache";
+const char *kNoStateArg     = "--no-state-cache";
+const char *kCaptureArg     = "--capture=";
+const char *kCaptureFmtArg  = "--capture-format=";
+const char *kCaptureStart   = "--capture-start=";
+const char *kCaptureCount   = "--capture-count=";
+const char *kInputThreadArg = "--threaded-input";
+const char *kLazyGLESArg    = "--lazy-gles";
+const char *kDynResArg      = "--dynamic-resolution";
+const char *kMinScaleArg    = "--min-render-scale=";
+
+// Program binary cache for --program-cache without a directory, next to the executable
+const char *kProgramCacheDirectory = "program_cache";
+
+constexpr double kDefaultUpdateRate   = 60.0;
+constexpr int kDefaultMaxCatchUpSteps = 5;
 
-using DisplayTypeInfo = std::pair<const char *, EGLint>;
+// Dynamic resolution holds the GPU to this share of the frame time, without a target frame
+// rate it assumes 60 fps
+constexpr double kGpuFrameTimeShare    = 0.9;
+constexpr double kDefaultFrameRate     = 60.0;
+constexpr float kDefaultMinRenderScale = 0.5f;
+
+// Events each thread can record while tracing, about 6 MB per thread
+constexpr size_t kTraceEventsPerTrack = 256 * 1024;
+
+// Benchmark exit codes besides 0 and -1 (initialization failure)
+constexpr int kExitGLError    = 1;
+constexpr int kExitOverBudget = 2;
+
+struct DisplayTypeInfo
+{
+    const char *name;
+    EGLint renderer;
+    EGLint deviceType;
+};
 
 const DisplayTypeInfo kDisplayTypes[] = {
-    {"d3d9", EGL_PLATFORM_ANGLE_TYPE_D3D9_ANGLE}, {"d3d11", EGL_PLATFORM_ANGLE_TYPE_D3D11_ANGLE},
-    {"gl", EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE}, {"gles", EGL_PLATFORM_ANGLE_TYPE_OPENGLES_ANGLE},
-    {"null", EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE}, {"vulkan", EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE}};
+    {"d3d9", EGL_PLATFORM_ANGLE_TYPE_D3D9_ANGLE, EGL_DONT_CARE},
+    {"d3d11", EGL_PLATFORM_ANGLE_TYPE_D3D11_ANGLE, EGL_DONT_CARE},
+    {"gl", EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE, EGL_DONT_CARE},
+    {"gles", EGL_PLATFORM_ANGLE_TYPE_OPENGLES_ANGLE, EGL_DONT_CARE},
+    {"null", EGL_PLATFORM_ANGLE_TYPE_NULL_ANGLE, EGL_DONT_CARE},
+    {"vulkan", EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE, EGL_DONT_CARE},
+    {"swiftshader", EGL_PLATFORM_ANGLE_TYPE_VULKAN_ANGLE,
+     EGL_PLATFORM_ANGLE_DEVICE_TYPE_SWIFTSHADER_ANGLE}};
 
-EGLint GetDisplayTypeFromArg(const char *displayTypeArg)
+DisplayTypeInfo GetDisplayTypeFromArg(const char *displayTypeArg)
 {
     for (const auto &displayTypeInfo : kDisplayTypes)
     {
-        if (strcmp(displayTypeInfo.first, displayTypeArg) == 0)
+        if (strcmp(displayTypeInfo.name, displayTypeArg) == 0)
         {
-            std::cout << "Using ANGLE back-end API: " << displayTypeInfo.first << std::endl;
-            return displayTypeInfo.second;
+            std::cout << "Using ANGLE back-end API: " << displayTypeInfo.name << std::endl;
+            return displayTypeInfo;
         }
     }
 
     std::cout << "Unknown ANGLE back-end API: " << displayTypeArg << std::endl;
-    return EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE;
+    return {"default", EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE, EGL_DONT_CARE};
+}
+
+// Parses "WxH", leaves the outputs untouched on malformed input
+void ParseSizeArg(const char *sizeArg, size_t *width, size_t *height)
+{
+    char *end = nullptr;
+    long w    = strtol(sizeArg, &end, 10);
+    if (end == sizeArg || (*end != 'x' && *end != 'X'))
+    {
+        std::cout << "Invalid size: " << sizeArg << std::endl;
+        return;
+    }
+    const char *heightArg = end + 1;
+    long h                = strtol(heightArg, &end, 10);
+    if (end == heightArg || w <= 0 || h <= 0)
+    {
+        std::cout << "Invalid size: " << sizeArg << std::endl;
+        return;
+    }
+    *width  = static_cast<size_t>(w);
+    *height = static_cast<size_t>(h);
 }
 }  // anonymous namespace
 
@@ -53,21 +147,177 @@ SampleApplication::SampleApplication(std::string name,
       mWidth(width),
       mHeight(height),
       mRunning(false),
+      mHeadless(false),
+      mHeadlessFramebuffer(0),
+      mHeadlessRenderbuffers{0, 0},
+      mBenchmarkFrames(0),
+      mWarmupFrames(0),
+      mFrameBudgetMs(0.0),
+      mTargetFrameRate(0.0),
+      mFrameRateFromArgs(false),
+      mVsync(false),
+      mThreaded(false),
+      mUpdateRate(kDefaultUpdateRate),
+      mUpdateRunning(false),
+      mThreadedInput(false),
+      mFixedStep(false),
+      mMaxCatchUpSteps(kDefaultMaxCatchUpSteps),
+      mStepAccumulator(0.0),
+      mSimulationTime(0.0),
+      mDroppedSteps(0),
+      mAsyncUpload(false),
+      mStateCache(false),
+      mLazyGLES(false),
+      mCaptureFormat(CaptureFormat::TGA),
+      mCaptureStart(0),
+      mCaptureCount(0),
+      mDynamicResolutionEnabled(false),
+      mGpuTargetMs(0.0),
+      mMinRenderScale(kDefaultMinRenderScale),
       mEGLWindow(nullptr),
       mOSWindow(nullptr)
 {
-    EGLint requestedRenderer = EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE;
+    DisplayTypeInfo requestedDisplay = {"default", EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE,
+                                        EGL_DONT_CARE};
+    std::string programCacheDirectory;
 
-    if (argc > 1 && strncmp(argv[1], kUseAngleArg, strlen(kUseAngleArg)) == 0)
+    // Common options may appear anywhere, samples skip the ones they do not know
+    for (int i = 1; i < argc; i++)
     {
-        requestedRenderer = GetDisplayTypeFromArg(argv[1] + strlen(kUseAngleArg));
+        if (strncmp(argv[i], kUseAngleArg, strlen(kUseAngleArg)) == 0)
+        {
+            requestedDisplay = GetDisplayTypeFromArg(argv[i] + strlen(kUseAngleArg));
+        }
+        else if (strcmp(argv[i], kHeadlessArg) == 0)
+        {
+            mHeadless = true;
+        }
+        else if (strncmp(argv[i], kSizeArg, strlen(kSizeArg)) == 0)
+        {
+            ParseSizeArg(argv[i] + strlen(kSizeArg), &mWidth, &mHeight);
+        }
+        else if (strncmp(argv[i], kFramesArg, strlen(kFramesArg)) == 0)
+        {
+            mBenchmarkFrames = std::max(0, atoi(argv[i] + strlen(kFramesArg)));
+        }
+        else if (strncmp(argv[i], kWarmupArg, strlen(kWarmupArg)) == 0)
+        {
+            mWarmupFrames = std::max(0, atoi(argv[i] + strlen(kWarmupArg)));
+        }
+        else if (strncmp(argv[i], kJsonArg, strlen(kJsonArg)) == 0)
+        {
+            mJsonPath = argv[i] + strlen(kJsonArg);
+        }
+        else if (strncmp(argv[i], kBudgetArg, strlen(kBudgetArg)) == 0)
+        {
+            mFrameBudgetMs = atof(argv[i] + strlen(kBudgetArg));
+        }
+        else if (strncmp(argv[i], kTraceArg, strlen(kTraceArg)) == 0)
+        {
+            mTracePath = argv[i] + strlen(kTraceArg);
+        }
+        else if (strncmp(argv[i], kFpsArg, strlen(kFpsArg)) == 0)
+        {
+            mTargetFrameRate   = std::max(0.0, atof(argv[i] + strlen(kFpsArg)));
+            mFrameRateFromArgs = true;
+        }
+        else if (strcmp(argv[i], kVsyncArg) == 0)
+        {
+            mVsync = true;
+        }
+        else if (strcmp(argv[i], kThreadedArg) == 0)
+        {
+            mThreaded = true;
+        }
+        else if (strcmp(argv[i], kInputThreadArg) == 0)
+        {
+            mThreadedInput = true;
+        }
+        else if (strncmp(argv[i], kFixedArg, strlen(kFixedArg)) == 0)
+        {
+            mFixedStep = true;
+            setUpdateRate(atof(argv[i] + strlen(kFixedArg)));
+        }
+        else if (strncmp(argv[i], kMaxStepsArg, strlen(kMaxStepsArg)) == 0)
+        {
+            mMaxCatchUpSteps = std::max(1, atoi(argv[i] + strlen(kMaxStepsArg)));
+        }
+        else if (strcmp(argv[i], kAsyncUploadArg) == 0)
+        {
+            mAsyncUpload = true;
+        }
+        else if (strncmp(argv[i], kCacheArg, strlen(kCacheArg)) == 0 &&
+                 argv[i][strlen(kCacheArg)] == '=')
+        {
+            programCacheDirectory = argv[i] + strlen(kCacheArg) + 1;
+        }
+        else if (strcmp(argv[i], kCacheArg) == 0)
+        {
+            programCacheDirectory = angle::GetExecutableDirectory();
+            if (!programCacheDirectory.empty())
+            {
+                programCacheDirectory += "/";
+            }
+            programCacheDirectory += kProgramCacheDirectory;
+        }
+        else if (strcmp(argv[i], kNoCacheArg) == 0)
+        {
+            programCacheDirectory.clear();
+        }
+        else if (strcmp(argv[i], kStateArg) == 0)
+        {
+            mStateCache = true;
+        }
+        else if (strcmp(argv[i], kNoStateArg) == 0)
+        {
+            mStateCache = false;
+        }
+        else if (strcmp(argv[i], kLazyGLESArg) == 0)
+        {
+            mLazyGLES = true;
+        }
+        else if (strncmp(argv[i], kCaptureArg, strlen(kCaptureArg)) == 0)
+        {
+            mCapturePrefix = argv[i] + strlen(kCaptureArg);
+        }
+        else if (strncmp(argv[i], kCaptureFmtArg, strlen(kCaptureFmtArg)) == 0)
+        {
+            if (!ParseCaptureFormat(argv[i] + strlen(kCaptureFmtArg), &mCaptureFormat))
+            {
+                std::cout << "Unknown capture format: " << argv[i] + strlen(kCaptureFmtArg)
+                          << std::endl;
+            }
+        }
+        else if (strncmp(argv[i], kCaptureStart, strlen(kCaptureStart)) == 0)
+        {
+            mCaptureStart = strtoull(argv[i] + strlen(kCaptureStart), nullptr, 10);
+        }
+        else if (strncmp(argv[i], kCaptureCount, strlen(kCaptureCount)) == 0)
+        {
+            mCaptureCount = strtoull(argv[i] + strlen(kCaptureCount), nullptr, 10);
+        }
+        else if (strncmp(argv[i], kDynResArg, strlen(kDynResArg)) == 0 &&
+                 (argv[i][strlen(kDynResArg)] == '\0' || argv[i][strlen(kDynResArg)] == '='))
+        {
+            mDynamicResolutionEnabled = true;
+            if (argv[i][strlen(kDynResArg)] == '=')
+            {
+                mGpuTargetMs = std::max(0.0, atof(argv[i] + strlen(kDynResArg) + 1));
+            }
+        }
+        else if (strncmp(argv[i], kMinScaleArg, strlen(kMinScaleArg)) == 0)
+        {
+            mMinRenderScale = static_cast<float>(atof(argv[i] + strlen(kMinScaleArg)));
+        }
     }
 
     // Load EGL library so we can initialize the display.
     mEntryPointsLib.reset(angle::OpenSharedLibrary(ANGLE_EGL_LIBRARY_NAME));
 
-    mEGLWindow = EGLWindow::New(glesMajorVersion, glesMinorVersion,
-                                EGLPlatformParameters(requestedRenderer));
+    mEGLWindow = EGLWindow::New(
+        glesMajorVersion, glesMinorVersion,
+        EGLPlatformParameters(requestedDisplay.renderer, EGL_DONT_CARE, EGL_DONT_CARE,
+                              requestedDisplay.deviceType));
     mTimer.reset(CreateTimer());
     mOSWindow = OSWindow::New();
 
@@ -78,8 +328,18 @@ SampleApplication::SampleApplication(std::string name,
     mEGLWindow->setConfigDepthBits(24);
     mEGLWindow->setConfigStencilBits(8);
 
-    // Disable vsync
-    mEGLWindow->setSwapInterval(0);
+    // Vsync only on request, otherwise the frame pacer sets the rate
+    mEGLWindow->setSwapInterval(mVsync ? 1 : 0);
+    mEGLWindow->setWorkerContextEnabled(mAsyncUpload);
+    mEGLWindow->setLazyGLESLoading(mLazyGLES);
+
+    // With --program-cache[=dir], programs from CompileProgram() are kept as driver binaries
+    // between runs
+    if (!SetProgramCacheDirectory(programCacheDirectory))
+    {
+        std::cout << "Cannot write to " << programCacheDirectory << ", program cache disabled"
+                  << std::endl;
+    }
 }
 
 SampleApplication::~SampleApplication()
@@ -95,9 +355,11 @@ bool SampleApplication::initialize()
 
 void SampleApplication::destroy() {}
 
+void SampleApplication::update(float dt, double totalTime) {}
+
 void SampleApplication::step(float dt, double totalTime) {}
 
-void SampleApplication::draw() {}
+void SampleApplication::draw(float alpha) {}
 
 void SampleApplication::swap()
 {
@@ -109,6 +371,64 @@ OSWindow *SampleApplication::getWindow() const
     return mOSWindow;
 }
 
+size_t SampleApplication::getWidth() const
+{
+    return mHeadless ? mWidth : static_cast<size_t>(mOSWindow->getWidth());
+}
+
+size_t SampleApplication::getHeight() const
+{
+    return mHeadless ? mHeight : static_cast<size_t>(mOSWindow->getHeight());
+}
+
+bool SampleApplication::isHeadless() const
+{
+    return mHeadless;
+}
+
+size_t SampleApplication::getRenderWidth() const
+{
+    return mDynamicResolution ? mDynamicResolution->getRenderWidth() : getWidth();
+}
+
+size_t SampleApplication::getRenderHeight() const
+{
+    return mDynamicResolution ? mDynamicResolution->getRenderHeight() : getHeight();
+}
+
+bool SampleApplication::isBenchmark() const
+{
+    return mBenchmarkFrames > 0;
+}
+
+bool SampleApplication::isFrameRateCapped() const
+{
+    return !mHeadless && !isBenchmark();
+}
+
+void SampleApplication::setUpdateRate(double stepsPerSecond)
+{
+    mUpdateRate = stepsPerSecond > 0.0 ? stepsPerSecond : kDefaultUpdateRate;
+}
+
+bool SampleApplication::isThreaded() const
+{
+    return mThreaded;
+}
+
+UploadQueue *SampleApplication::getUploadQueue() const
+{
+    return mUploadQueue.get();
+}
+
+void SampleApplication::setTargetFrameRate(double framesPerSecond)
+{
+    if (!mFrameRateFromArgs)
+    {
+        mTargetFrameRate = framesPerSecond;
+    }
+}
+
 EGLConfig SampleApplication::getConfig() const
 {
     return mEGLWindow->getConfig();
@@ -129,49 +449,274 @@ EGLContext SampleApplication::getContext() const
     return mEGLWindow->getContext();
 }
 
+// A surfaceless context has no default framebuffer, render into an FBO of the requested size.
+bool SampleApplication::initializeHeadlessFramebuffer()
+{
+    const bool isES3 = IsGLES3OrLater();
+
+    const GLenum colorFormat =
+        (isES3 || HasGLExtension("GL_OES_rgb8_rgba8")) ? GL_RGBA8_OES : GL_RGBA4;
+    const bool packedDepthStencil = isES3 || HasGLExtension("GL_OES_packed_depth_stencil");
+
+    const GLsizei width  = static_cast<GLsizei>(mWidth);
+    const GLsizei height = static_cast<GLsizei>(mHeight);
+
+    glGenRenderbuffers(2, mHeadlessRenderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, mHeadlessRenderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, colorFormat, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, mHeadlessRenderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER,
+                          packedDepthStencil ? GL_DEPTH24_STENCIL8_OES : GL_DEPTH_COMPONENT16,
+                          width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &mHeadlessFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, mHeadlessFramebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              mHeadlessRenderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                              mHeadlessRenderbuffers[1]);
+    if (packedDepthStencil)
+    {
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                  mHeadlessRenderbuffers[1]);
+    }
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Headless framebuffer is incomplete" << std::endl;
+        return false;
+    }
+
+    // Without a surface the initial viewport is empty
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void SampleApplication::destroyHeadlessFramebuffer()
+{
+    if (mHeadlessFramebuffer != 0)
+    {
+        glDeleteFramebuffers(1, &mHeadlessFramebuffer);
+        glDeleteRenderbuffers(2, mHeadlessRenderbuffers);
+        mHeadlessFramebuffer = 0;
+    }
+}
+
 int SampleApplication::run()
 {
-    if (!mOSWindow->initialize(mName, mWidth, mHeight))
+    if (!mTracePath.empty())
     {
-        return -1;
+        TraceInitialize(kTraceEventsPerTrack);
+        TraceSetThreadName("main");
     }
 
-    mOSWindow->setVisible(true);
+    if (mHeadless)
+    {
+        // No native window, events or vsync. The loop runs as fast as the driver allows.
+        if (!mEGLWindow->initializeHeadlessGL(static_cast<EGLint>(mWidth),
+                                              static_cast<EGLint>(mHeight),
+                                              mEntryPointsLib.get()))
+        {
+            return -1;
+        }
 
-    if (!mEGLWindow->initializeGL(mOSWindow, mEntryPointsLib.get()))
+        std::cout << "Headless " << mWidth << "x" << mHeight << " "
+                  << (mEGLWindow->isSurfaceless() ? "surfaceless FBO" : "pbuffer") << std::endl;
+
+        if (mEGLWindow->isSurfaceless() && !initializeHeadlessFramebuffer())
+        {
+            destroyHeadlessFramebuffer();
+            mEGLWindow->destroyGL();
+            return -1;
+        }
+    }
+    else
     {
-        return -1;
+        if (mThreadedInput && !mOSWindow->setThreadedInput(true))
+        {
+            std::cout << "No input thread on this platform, reading events per frame"
+                      << std::endl;
+        }
+
+        if (!mOSWindow->initialize(mName, mWidth, mHeight))
+        {
+            return -1;
+        }
+
+        mOSWindow->setVisible(true);
+
+        if (!mEGLWindow->initializeGL(mOSWindow, mEntryPointsLib.get()))
+        {
+            return -1;
+        }
     }
 
-    angle::LoadGLES(eglGetProcAddress);
+    // The window loaded the entry points along with the context
+    std::cout << "GLES entry points " << (mLazyGLES ? "stubbed" : "loaded") << " in "
+              << mEGLWindow->getGLESLoadTime() << " ms" << std::endl;
+
+    // Before the upload thread starts, it reads the entry points the cache replaces
+    if (mStateCache)
+    {
+        StateCacheInstall();
+    }
+
+    mUploadQueue.reset(new UploadQueue());
+    if (mUploadQueue->initialize(mEGLWindow))
+    {
+        std::cout << "Uploading on a shared context thread" << std::endl;
+    }
+    else if (mAsyncUpload)
+    {
+        std::cout << "No worker context, uploading synchronously" << std::endl;
+    }
 
     mRunning   = true;
     int result = 0;
 
-    if (!initialize())
+    bool initialized = false;
+    {
+        TraceScope traceScope("initialize");
+        initialized = initialize();
+    }
+
+    if (!initialized)
     {
         mRunning = false;
         result   = -1;
     }
 
+    // Benchmark mode: per-frame CPU time (step and draw) and swap-to-swap time
+    FrameStats cpuTimes;
+    FrameStats frameTimes;
+    cpuTimes.reserve(mBenchmarkFrames);
+    frameTimes.reserve(mBenchmarkFrames);
+    int frameIndex        = 0;
+    double prevSwapTime   = 0.0;
+    double benchmarkStart = 0.0;
+
+    // GPU scopes are timed in benchmark and trace runs when the context supports it
+    if (mRunning && (isBenchmark() || TraceIsEnabled()))
+    {
+        mGpuProfiler.reset(new GpuProfiler());
+        if (mGpuProfiler->initialize())
+        {
+            GpuProfiler::SetCurrent(mGpuProfiler.get());
+        }
+        else
+        {
+            std::cout << "EXT_disjoint_timer_query not supported, no GPU timings" << std::endl;
+            mGpuProfiler.reset();
+        }
+    }
+
+    if (mRunning && !mCapturePrefix.empty())
+    {
+        mFrameCapture.reset(new FrameCapture());
+        if (mFrameCapture->initialize(getWidth(), getHeight(), mCaptureFormat, mCapturePrefix))
+        {
+            std::cout << "Capturing to " << mCapturePrefix << " with "
+                      << (mFrameCapture->isAsync() ? "pixel pack buffers" : "glReadPixels")
+                      << std::endl;
+        }
+        else
+        {
+            mFrameCapture.reset();
+        }
+    }
+
+    if (mRunning && mDynamicResolutionEnabled)
+    {
+        const double frameRate = mTargetFrameRate > 0.0 ? mTargetFrameRate : kDefaultFrameRate;
+        const double targetMs =
+            mGpuTargetMs > 0.0 ? mGpuTargetMs : kGpuFrameTimeShare * 1000.0 / frameRate;
+
+        mDynamicResolution.reset(new DynamicResolution());
+        if (mDynamicResolution->initialize(targetMs, mMinRenderScale))
+        {
+            std::cout << "Dynamic resolution from "
+                      << (mDynamicResolution->getTimeSource() == GpuTimeSource::TimerQueries
+                              ? "timer queries"
+                              : "fences")
+                      << ", " << targetMs << " ms GPU target, scale "
+                      << mDynamicResolution->getMinScale() << " to 1" << std::endl;
+        }
+        else
+        {
+            std::cout << "No GPU timestamps or fences, rendering at full resolution" << std::endl;
+            mDynamicResolution.reset();
+        }
+    }
+
+    // With a working swap interval the display paces the loop, the pacer only tracks deadlines
+    const bool swapIntervalPaced = mVsync && mEGLWindow->getSwapInterval() > 0;
+    if (mRunning && isFrameRateCapped() && mTargetFrameRate > 0.0)
+    {
+        mFramePacer.start(mTargetFrameRate);
+        std::cout << "Pacing to " << mFramePacer.getFrameRate() << " fps"
+                  << (swapIntervalPaced ? " with swap interval" : "") << std::endl;
+    }
+
+    // The update thread never touches GL, the context stays current on this thread
+    if (mRunning && mThreaded)
+    {
+        mUpdateRunning.store(true, std::memory_order_release);
+        mUpdateThread = std::thread(&SampleApplication::updateLoop, this);
+    }
+
     mTimer->start();
-    double prevTime = 0.0;
+    double prevTime      = 0.0;
+    uint64_t framesDrawn = 0;
 
     while (mRunning)
     {
+        TraceScope frameScope("frame");
+
         double elapsedTime = mTimer->getElapsedTime();
         double deltaTime   = elapsedTime - prevTime;
 
-        step(static_cast<float>(deltaTime), elapsedTime);
+        // Trace runs skip the warmup too, frameIndex only counts in benchmarks
+        if (mGpuProfiler && framesDrawn == static_cast<uint64_t>(mWarmupFrames))
+        {
+            mGpuProfiler->setRecording(true);
+        }
+        if (isBenchmark() && frameIndex == mWarmupFrames)
+        {
+            mStateCacheBaseline = StateCacheGetCounters();
+        }
+
+        float alpha = 1.0f;
+        if (mFixedStep || isBenchmark())
+        {
+            alpha = runFixedSteps(deltaTime);
+        }
+        else if (!mThreaded)
+        {
+            TraceScope traceScope("update");
+            update(static_cast<float>(deltaTime), elapsedTime);
+        }
+
+        {
+            TraceScope traceScope("step");
+            step(static_cast<float>(deltaTime), elapsedTime);
+        }
 
         // Clear events that the application did not process from this frame
-        Event event;
-        while (popEvent(&event))
         {
-            // If the application did not catch a close event, close now
-            if (event.Type == Event::EVENT_CLOSED)
+            TraceScope traceScope("events");
+            Event event;
+            while (popEvent(&event))
             {
-                exit();
+                // If the application did not catch a close event, close now
+                if (event.Type == Event::EVENT_CLOSED)
+                {
+                    exit();
+                }
+                else if (event.Type == Event::EVENT_KEY_PRESSED && event.Key.Code == KEY_F12)
+                {
+                    writeTrace();
+                }
             }
         }
 
@@ -180,21 +725,400 @@ int SampleApplication::run()
             break;
         }
 
-        draw();
-        swap();
+        if (mDynamicResolution)
+        {
+            mDynamicResolution->beginFrame(mHeadlessFramebuffer, getWidth(), getHeight());
+        }
+        {
+            TraceScope traceScope("draw");
+            draw(alpha);
+        }
+        if (mDynamicResolution)
+        {
+            TraceScope traceScope("upscale");
+            mDynamicResolution->endFrame();
+        }
+        if (mFrameCapture && framesDrawn >= mCaptureStart &&
+            (mCaptureCount == 0 || framesDrawn - mCaptureStart < mCaptureCount))
+        {
+            mFrameCapture->capture(mHeadlessFramebuffer, framesDrawn);
+        }
+        double cpuEndTime = mTimer->getElapsedTime();
+        {
+            TraceScope traceScope("swap");
+            swap();
+        }
+        framesDrawn++;
+
+        // Before pacing, a fence wait there counts towards the frame it holds back
+        if (mDynamicResolution)
+        {
+            mDynamicResolution->collect();
+        }
+
+        if (mFramePacer.isEnabled())
+        {
+            TraceScope traceScope("pace");
+            mFramePacer.wait(!swapIntervalPaced);
+        }
+
+        if (isBenchmark())
+        {
+            double swapTime = mTimer->getElapsedTime();
+            if (frameIndex == mWarmupFrames)
+            {
+                benchmarkStart = elapsedTime;
+            }
+            if (frameIndex >= mWarmupFrames)
+            {
+                cpuTimes.add(cpuEndTime - elapsedTime);
+                frameTimes.add(frameIndex > 0 ? swapTime - prevSwapTime : swapTime - elapsedTime);
+                if (static_cast<int>(cpuTimes.size()) == mBenchmarkFrames)
+                {
+                    exit();
+                }
+            }
+            prevSwapTime = swapTime;
+            frameIndex++;
+        }
+
+        if (mGpuProfiler)
+        {
+            mGpuProfiler->collect();
+        }
 
-        mOSWindow->messageLoop();
+        if (!mHeadless)
+        {
+            TraceScope traceScope("messageLoop");
+            mOSWindow->messageLoop();
+        }
 
         prevTime = elapsedTime;
     }
 
+    if (mUpdateThread.joinable())
+    {
+        mUpdateRunning.store(false, std::memory_order_release);
+        mUpdateThread.join();
+    }
+
+    if (isBenchmark() && result == 0)
+    {
+        result = reportBenchmark(cpuTimes, frameTimes, prevSwapTime - benchmarkStart);
+    }
+    if (mDroppedSteps > 0)
+    {
+        std::cout << mName << ": dropped " << mDroppedSteps << " fixed steps to catch up"
+                  << std::endl;
+    }
+    size_t cacheHits     = 0;
+    size_t cacheMisses   = 0;
+    size_t cacheRejected = 0;
+    GetProgramCacheStats(&cacheHits, &cacheMisses, &cacheRejected);
+    if (cacheHits + cacheMisses > 0)
+    {
+        std::cout << mName << ": program cache " << cacheHits << " hits, " << cacheMisses
+                  << " misses, " << cacheRejected << " rejected binaries" << std::endl;
+    }
+    uint64_t uniformCalls        = 0;
+    uint64_t skippedUniformCalls = 0;
+    GetUniformCacheStats(&uniformCalls, &skippedUniformCalls);
+    if (uniformCalls > 0)
+    {
+        std::cout << mName << ": " << skippedUniformCalls << " of " << uniformCalls
+                  << " uniform updates skipped as redundant" << std::endl;
+    }
+    if (StateCacheIsInstalled() && framesDrawn > 0)
+    {
+        const StateCacheCounters counters = StateCacheGetCounters();
+        std::cout << mName << ": state cache elided " << counters.getTotalElided() << " of "
+                  << counters.getTotalCalls() << " calls, " << std::fixed << std::setprecision(1)
+                  << static_cast<double>(counters.getTotalElided()) / framesDrawn << " per frame"
+                  << std::endl;
+    }
+    if (mLazyGLES)
+    {
+        const angle::GLESLazyLoaderStats loader = angle::GetGLESLazyLoaderStats();
+        std::cout << mName << ": " << loader.resolved << " of " << loader.entryPoints
+                  << " GLES entry points resolved on first call, " << std::fixed
+                  << std::setprecision(3) << loader.resolveTimeMs << " ms in total" << std::endl;
+    }
+    if (!mHeadless && mOSWindow->getDroppedEventCount() > 0)
+    {
+        std::cout << mName << ": " << mOSWindow->getDroppedEventCount()
+                  << " window events dropped, the event queue was full" << std::endl;
+    }
+    if (mFramePacer.isEnabled())
+    {
+        std::cout << mName << ": " << mFramePacer.getMissedCount() << " of "
+                  << mFramePacer.getFrameCount() << " frames missed their deadline" << std::endl;
+    }
+    if (mFrameCapture)
+    {
+        // Waits for the frames still in flight to be written
+        mFrameCapture->destroy();
+        const CaptureStats &stats = mFrameCapture->getStats();
+        if (stats.frames > 0)
+        {
+            std::cout << mName << ": captured " << stats.frames << " frames, " << std::fixed
+                      << std::setprecision(3) << stats.totalMs / stats.frames
+                      << " ms average and " << stats.maxMs << " ms max on the GL thread, "
+                      << stats.readbackStalls << " readback and " << stats.writerStalls
+                      << " writer stalls, " << stats.writeFailures << " failures" << std::endl;
+        }
+        mFrameCapture.reset();
+    }
+    if (mDynamicResolution)
+    {
+        const DynamicResolutionStats &stats = mDynamicResolution->getStats();
+        if (stats.frames > 0)
+        {
+            std::cout << mName << ": render scale " << std::fixed << std::setprecision(2)
+                      << stats.scaleSum / stats.frames << " average and " << stats.minScale
+                      << " min, " << stats.changes << " changes, " << stats.overTarget << " of "
+                      << stats.samples << " timed frames over " << mDynamicResolution->getTargetMs()
+                      << " ms, " << mDynamicResolution->getPool().getCreatedCount()
+                      << " render targets created" << std::endl;
+        }
+        mDynamicResolution->destroy();
+        mDynamicResolution.reset();
+    }
+    if (TraceIsEnabled())
+    {
+        writeTrace();
+    }
+    if (mGpuProfiler)
+    {
+        mGpuProfiler->destroy();
+        mGpuProfiler.reset();
+    }
+
     destroy();
+    mUploadQueue.reset();
+    destroyHeadlessFramebuffer();
     mEGLWindow->destroyGL();
-    mOSWindow->destroy();
+    StateCacheUninstall();
+    if (!mHeadless)
+    {
+        mOSWindow->destroy();
+    }
 
     return result;
 }
 
+float SampleApplication::runFixedSteps(double deltaTime)
+{
+    if (mThreaded)
+    {
+        return 1.0f;
+    }
+
+    const double stepTime = 1.0 / mUpdateRate;
+
+    // Benchmarks advance exactly one step per frame so every run simulates the same thing
+    int steps = 0;
+    if (isBenchmark())
+    {
+        mStepAccumulator = 0.0;
+        steps            = 1;
+    }
+    else
+    {
+        mStepAccumulator += deltaTime;
+        while (mStepAccumulator >= stepTime && steps < mMaxCatchUpSteps)
+        {
+            mStepAccumulator -= stepTime;
+            steps++;
+        }
+
+        // Too far behind, let go of the backlog rather than spiral
+        if (mStepAccumulator >= stepTime)
+        {
+            mDroppedSteps += static_cast<uint64_t>(mStepAccumulator / stepTime);
+            mStepAccumulator = fmod(mStepAccumulator, stepTime);
+        }
+    }
+
+    for (int i = 0; i < steps; i++)
+    {
+        TraceScope traceScope("update");
+        update(static_cast<float>(stepTime), mSimulationTime);
+        mSimulationTime += stepTime;
+    }
+
+    return isBenchmark() ? 1.0f : static_cast<float>(mStepAccumulator / stepTime);
+}
+
+void SampleApplication::updateLoop()
+{
+    TraceSetThreadName("update");
+
+    // Fixed steps on absolute deadlines. When an update overruns, the pacer restarts its
+    // schedule, so the simulation slows down instead of trying to catch up.
+    FramePacer pacer;
+    pacer.start(mUpdateRate);
+    const float dt   = static_cast<float>(1.0 / mUpdateRate);
+    double totalTime = 0.0;
+
+    while (mUpdateRunning.load(std::memory_order_acquire))
+    {
+        {
+            TraceScope traceScope("update");
+            update(dt, totalTime);
+        }
+        totalTime += dt;
+        pacer.wait();
+    }
+
+    if (pacer.getMissedCount() > 0)
+    {
+        std::cout << mName << ": update thread missed " << pacer.getMissedCount() << " of "
+                  << pacer.getFrameCount() << " steps" << std::endl;
+    }
+}
+
+void SampleApplication::writeTrace()
+{
+    // Results still in flight would otherwise be missing from the GPU track
+    if (mGpuProfiler)
+    {
+        mGpuProfiler->finish();
+    }
+
+    if (TraceWriteJSON(mTracePath))
+    {
+        std::cout << "Trace written to " << mTracePath << std::endl;
+    }
+    else
+    {
+        std::cout << "Could not write trace to " << mTracePath << std::endl;
+    }
+}
+
+int SampleApplication::reportBenchmark(const FrameStats &cpuTimes,
+                                       const FrameStats &frameTimes,
+                                       double totalTime)
+{
+    const FrameTimeSummary cpu   = cpuTimes.summarize();
+    const FrameTimeSummary frame = frameTimes.summarize();
+    const double fps = totalTime > 0.0 ? static_cast<double>(frame.count) / totalTime : 0.0;
+
+    const bool glError    = glGetError() != GL_NO_ERROR;
+    const bool overBudget = mFrameBudgetMs > 0.0 && frame.p95 > mFrameBudgetMs;
+    const bool completed  = static_cast<int>(frame.count) == mBenchmarkFrames;
+
+    int status = 0;
+    if (!completed)
+    {
+        status = -1;
+    }
+    else if (glError)
+    {
+        status = kExitGLError;
+    }
+    else if (overBudget)
+    {
+        status = kExitOverBudget;
+    }
+
+    std::cout << mName << ": " << frame.count << " frames after " << mWarmupFrames
+              << " warmup, " << std::fixed << std::setprecision(2) << fps << " fps" << std::endl;
+    PrintFrameTimeSummary(std::cout, "  cpu  ", cpu);
+    PrintFrameTimeSummary(std::cout, "  frame", frame);
+
+    if (mGpuProfiler)
+    {
+        mGpuProfiler->finish();
+        for (size_t scope = 0; scope < mGpuProfiler->getScopeCount(); scope++)
+        {
+            std::string label = "  gpu " + mGpuProfiler->getScopeName(scope);
+            PrintFrameTimeSummary(std::cout, label.c_str(), mGpuProfiler->summarizeScope(scope));
+        }
+        if (mGpuProfiler->getDisjointCount() > 0)
+        {
+            std::cout << "  gpu disjoint events: " << mGpuProfiler->getDisjointCount()
+                      << std::endl;
+        }
+    }
+
+    // Per measured frame, by category
+    const StateCacheCounters stateCounters = StateCacheGetCounters();
+    double stateCalls[kStateCacheCategoryCount]  = {};
+    double stateElided[kStateCacheCategoryCount] = {};
+    if (StateCacheIsInstalled() && frame.count > 0)
+    {
+        std::cout << "  state calls per frame:";
+        for (int category = 0; category < kStateCacheCategoryCount; category++)
+        {
+            stateCalls[category] = static_cast<double>(stateCounters.calls[category] -
+                                                       mStateCacheBaseline.calls[category]) /
+                                   frame.count;
+            stateElided[category] = static_cast<double>(stateCounters.elided[category] -
+                                                        mStateCacheBaseline.elided[category]) /
+                                    frame.count;
+            std::cout << " " << StateCacheGetCategoryName(static_cast<StateCacheCategory>(category))
+                      << " " << std::setprecision(1) << stateElided[category] << "/"
+                      << stateCalls[category] << " elided";
+        }
+        std::cout << std::endl;
+    }
+
+    std::ofstream file;
+    if (!mJsonPath.empty())
+    {
+        file.open(mJsonPath);
+        if (!file)
+        {
+            std::cout << "Could not open " << mJsonPath << std::endl;
+        }
+    }
+    std::ostream &json = file.is_open() ? static_cast<std::ostream &>(file) : std::cout;
+
+    json << "{\"sample\": ";
+    WriteJSONString(json, mName.c_str());
+    json << ", \"width\": " << getWidth()
+         << ", \"height\": " << getHeight() << ", \"headless\": " << (mHeadless ? "true" : "false")
+         << ", \"warmup\": " << mWarmupFrames << ", \"frames\": " << frame.count
+         << ", \"fps\": " << std::fixed << std::setprecision(3) << fps << ", \"cpu_ms\": ";
+    WriteFrameTimeSummaryJSON(json, cpu);
+    json << ", \"frame_ms\": ";
+    WriteFrameTimeSummaryJSON(json, frame);
+    if (mGpuProfiler)
+    {
+        json << ", \"gpu_ms\": {";
+        for (size_t scope = 0; scope < mGpuProfiler->getScopeCount(); scope++)
+        {
+            json << (scope > 0 ? ", " : "");
+            WriteJSONString(json, mGpuProfiler->getScopeName(scope).c_str());
+            json << ": ";
+            WriteFrameTimeSummaryJSON(json, mGpuProfiler->summarizeScope(scope));
+        }
+        json << "}, \"gpu_disjoint\": " << mGpuProfiler->getDisjointCount();
+    }
+    uint64_t uniformCalls        = 0;
+    uint64_t skippedUniformCalls = 0;
+    GetUniformCacheStats(&uniformCalls, &skippedUniformCalls);
+    json << ", \"uniform_calls\": " << uniformCalls
+         << ", \"uniform_calls_skipped\": " << skippedUniformCalls;
+    if (StateCacheIsInstalled())
+    {
+        json << ", \"state_calls_per_frame\": {";
+        for (int category = 0; category < kStateCacheCategoryCount; category++)
+        {
+            json << (category > 0 ? ", " : "");
+            WriteJSONString(json,
+                            StateCacheGetCategoryName(static_cast<StateCacheCategory>(category)));
+            json << ": {\"calls\": " << stateCalls[category]
+                 << ", \"elided\": " << stateElided[category] << "}";
+        }
+        json << "}";
+    }
+    json << ", \"gl_error\": " << (glError ? "true" : "false") << ", \"status\": " << status
+         << "}" << std::endl;
+
+    return status;
+}
+
 void SampleApplication::exit()
 {
     mRunning = false;
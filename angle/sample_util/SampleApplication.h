@@ -8,15 +8,25 @@
 #define SAMPLE_UTIL_SAMPLE_APPLICATION_H
 
 #include <stdint.h>
+#include <atomic>
 #include <list>
 #include <memory>
 #include <string>
+#include <thread>
 
+#include "sample_util/FrameCapture.h"
+#include "sample_util/FramePacer.h"
+#include "sample_util/StateCache.h"
 #include "util/OSWindow.h"
 #include "util/Timer.h"
 #include "util/egl_loader_autogen.h"
+#include "util/gles_loader_autogen.h"
 
+class DynamicResolution;
 class EGLWindow;
+class FrameStats;
+class GpuProfiler;
+class UploadQueue;
 
 namespace angle
 {
@@ -38,12 +48,51 @@ class SampleApplication
     virtual bool initialize();
     virtual void destroy();
 
+    // Simulation that does not touch GL. With --threaded it runs on its own thread at the
+    // update rate with a fixed dt. Otherwise it runs on the render thread before step(): once
+    // per frame with the frame time, or with --fixed-step=N as many fixed steps as the frame
+    // time covers. Results reach draw() through a TripleBuffer of snapshots.
+    virtual void update(float dt, double totalTime);
     virtual void step(float dt, double totalTime);
-    virtual void draw();
+
+    // alpha in [0, 1] blends the previous update's state (0) into the latest one (1). Only
+    // fixed steps produce fractions, the other modes always pass 1.
+    virtual void draw(float alpha);
 
     virtual void swap();
 
     OSWindow *getWindow() const;
+
+    // Size of the default framebuffer, use these rather than the window in headless mode
+    size_t getWidth() const;
+    size_t getHeight() const;
+    bool isHeadless() const;
+
+    // Size draw() renders at, set the viewport from these. Below getWidth() x getHeight()
+    // while --dynamic-resolution has lowered the render scale, the frame is upscaled to the
+    // default framebuffer after draw().
+    size_t getRenderWidth() const;
+    size_t getRenderHeight() const;
+
+    // --frames=N runs N measured frames after --warmup=M frames, prints frame time
+    // statistics and JSON (to --json=path if given), then exits with a status code.
+    bool isBenchmark() const;
+
+    // False when headless or benchmarking, the frame pacer is off then
+    bool isFrameRateCapped() const;
+
+    // Rate the frame pacer holds run() to, 0 (the default) runs uncapped. --fps=N overrides
+    // it, --vsync paces with a swap interval of 1 when the config supports it.
+    void setTargetFrameRate(double framesPerSecond);
+
+    // Steps per second of the threaded and fixed step update loops
+    void setUpdateRate(double stepsPerSecond);
+    bool isThreaded() const;
+
+    // Buffers and textures created here are uploaded on a loader thread with --async-upload,
+    // and synchronously otherwise. Valid from initialize() until destroy() returns.
+    UploadQueue *getUploadQueue() const;
+
     EGLConfig getConfig() const;
     EGLDisplay getDisplay() const;
     EGLSurface getSurface() const;
@@ -55,11 +104,83 @@ class SampleApplication
     void exit();
 
   private:
+    bool initializeHeadlessFramebuffer();
+    void destroyHeadlessFramebuffer();
+    void writeTrace();
+    void updateLoop();
+    float runFixedSteps(double deltaTime);
+    int reportBenchmark(const FrameStats &cpuTimes, const FrameStats &frameTimes, double totalTime);
+
     std::string mName;
     size_t mWidth;
     size_t mHeight;
     bool mRunning;
 
+    // --headless renders into a pbuffer, or into this FBO on a surfaceless context
+    bool mHeadless;
+    GLuint mHeadlessFramebuffer;
+    GLuint mHeadlessRenderbuffers[2];
+
+    // Benchmark mode
+    int mBenchmarkFrames;
+    int mWarmupFrames;
+    double mFrameBudgetMs;
+    std::string mJsonPath;
+    std::unique_ptr<GpuProfiler> mGpuProfiler;
+
+    // Frame pacing
+    FramePacer mFramePacer;
+    double mTargetFrameRate;
+    bool mFrameRateFromArgs;
+    bool mVsync;
+
+    // Threaded update loop
+    bool mThreaded;
+    double mUpdateRate;
+    std::thread mUpdateThread;
+    std::atomic<bool> mUpdateRunning;
+
+    // --threaded-input reads window events on a platform thread where there is one
+    bool mThreadedInput;
+
+    // Fixed step accumulator
+    bool mFixedStep;
+    int mMaxCatchUpSteps;
+    double mStepAccumulator;
+    double mSimulationTime;
+    uint64_t mDroppedSteps;
+
+    // --async-upload creates a shared worker context for the upload queue
+    bool mAsyncUpload;
+    std::unique_ptr<UploadQueue> mUploadQueue;
+
+    // Redundant GL state changes are filtered with --state-cache. Off by default, a sample
+    // that switches contexts on the render thread would have to invalidate the cache.
+    bool mStateCache;
+    StateCacheCounters mStateCacheBaseline;
+
+    // --lazy-gles resolves GLES entry points on first call instead of at startup
+    bool mLazyGLES;
+
+    // --capture=prefix reads back frames --capture-start=N onwards, --capture-count=N of
+    // them or until exit, and writes them as --capture-format=tga|png|raw
+    std::string mCapturePrefix;
+    CaptureFormat mCaptureFormat;
+    uint64_t mCaptureStart;
+    uint64_t mCaptureCount;
+    std::unique_ptr<FrameCapture> mFrameCapture;
+
+    // --dynamic-resolution[=ms] renders offscreen at a scale that holds the GPU time to ms,
+    // by default 90% of the frame time at the target frame rate or 60 fps, and no lower than
+    // --min-render-scale=S
+    bool mDynamicResolutionEnabled;
+    double mGpuTargetMs;
+    float mMinRenderScale;
+    std::unique_ptr<DynamicResolution> mDynamicResolution;
+
+    // --trace=path records the run() phases and GPU scopes, written on exit or F12
+    std::string mTracePath;
+
     std::unique_ptr<Timer> mTimer;
     EGLWindow *mEGLWindow;
     OSWindow *mOSWindow;
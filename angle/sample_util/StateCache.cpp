@@ -0,0 +1,667 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// StateCache.cpp: Drops redundant binds and state changes before they reach the GL.
+//
+
+#include "sample_util/StateCache.h"
+
+#include <string.h>
+
+#include "util/gles_loader_autogen.h"
+
+namespace
+{
+// Entry points the cache puts itself in front of, with the replacement for each
+#define STATE_CACHE_ENTRY_POINTS(OP)                          \
+    OP(glActiveTexture, CachedActiveTexture)                  \
+    OP(glBindBuffer, CachedBindBuffer)                        \
+    OP(glBindTexture, CachedBindTexture)                      \
+    OP(glBindVertexArray, CachedBindVertexArray)              \
+    OP(glBindVertexArrayOES, CachedBindVertexArrayOES)        \
+    OP(glDeleteBuffers, CachedDeleteBuffers)                  \
+    OP(glDeleteTextures, CachedDeleteTextures)                \
+    OP(glDeleteVertexArrays, CachedDeleteVertexArrays)        \
+    OP(glDeleteVertexArraysOES, CachedDeleteVertexArraysOES)  \
+    OP(glUseProgram, CachedUseProgram)                        \
+    OP(glDeleteProgram, CachedDeleteProgram)                  \
+    OP(glEnable, CachedEnable)                                \
+    OP(glDisable, CachedDisable)                              \
+    OP(glBlendFunc, CachedBlendFunc)                          \
+    OP(glBlendFuncSeparate, CachedBlendFuncSeparate)          \
+    OP(glBlendEquation, CachedBlendEquation)                  \
+    OP(glBlendEquationSeparate, CachedBlendEquationSeparate)  \
+    OP(glDepthFunc, CachedDepthFunc)                          \
+    OP(glDepthMask, CachedDepthMask)                          \
+    OP(glCullFace, CachedCullFace)                            \
+    OP(glFrontFace, CachedFrontFace)                          \
+    OP(glClearColor, CachedClearColor)                        \
+    OP(glViewport, CachedViewport)
+
+struct RealEntryPoints
+{
+#define DECLARE_ENTRY_POINT(name, cached) decltype(::name) name = nullptr;
+    STATE_CACHE_ENTRY_POINTS(DECLARE_ENTRY_POINT)
+#undef DECLARE_ENTRY_POINT
+};
+
+RealEntryPoints gReal;
+
+constexpr GLuint kUnknown = 0xFFFFFFFFu;
+
+// Texture units past this are not cached
+constexpr size_t kTrackedTextureUnits = 32;
+
+enum TextureSlot
+{
+    kTexture2D,
+    kTextureCube,
+    kTextureSlotCount,
+};
+
+enum Capability
+{
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kDither,
+    kPolygonOffsetFill,
+    kRasterizerDiscard,
+    kSampleAlphaToCoverage,
+    kSampleCoverage,
+    kScissorTest,
+    kStencilTest,
+    kCapabilityCount,
+};
+
+struct ShadowState
+{
+    GLuint activeTexture;
+    GLuint arrayBuffer;
+    GLuint elementArrayBuffer;
+    GLuint vertexArray;
+    GLuint program;
+    GLuint textures[kTrackedTextureUnits][kTextureSlotCount];
+
+    // 0 or 1, kUnknown when not known
+    GLuint capabilities[kCapabilityCount];
+
+    GLuint blendFunc[4];
+    GLuint blendEquation[2];
+    GLuint depthFunc;
+    GLuint depthMask;
+    GLuint cullFace;
+    GLuint frontFace;
+
+    bool clearColorKnown;
+    GLfloat clearColor[4];
+    bool viewportKnown;
+    GLint viewport[4];
+
+    StateCacheCounters counters;
+};
+
+// Only the installing thread has a shadow, the others pass straight through
+thread_local ShadowState *tShadow = nullptr;
+ShadowState *gInstalled           = nullptr;
+
+void ResetShadow(ShadowState *shadow)
+{
+    StateCacheCounters counters = shadow->counters;
+    *shadow                     = ShadowState();
+    shadow->counters            = counters;
+
+    shadow->activeTexture      = kUnknown;
+    shadow->arrayBuffer        = kUnknown;
+    shadow->elementArrayBuffer = kUnknown;
+    shadow->vertexArray        = kUnknown;
+    shadow->program            = kUnknown;
+    for (auto &unit : shadow->textures)
+    {
+        for (GLuint &texture : unit)
+        {
+            texture = kUnknown;
+        }
+    }
+    for (GLuint &capability : shadow->capabilities)
+    {
+        capability = kUnknown;
+    }
+    for (GLuint &value : shadow->blendFunc)
+    {
+        value = kUnknown;
+    }
+    shadow->blendEquation[0] = kUnknown;
+    shadow->blendEquation[1] = kUnknown;
+    shadow->depthFunc        = kUnknown;
+    shadow->depthMask        = kUnknown;
+    shadow->cullFace         = kUnknown;
+    shadow->frontFace        = kUnknown;
+}
+
+// Counts the call and returns true when it changes nothing
+bool IsRedundant(ShadowState *shadow, StateCacheCategory category, bool unchanged)
+{
+    shadow->counters.calls[category]++;
+    if (unchanged)
+    {
+        shadow->counters.elided[category]++;
+    }
+    return unchanged;
+}
+
+GLuint *GetBufferBinding(ShadowState *shadow, GLenum target)
+{
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER:
+            return &shadow->arrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            return &shadow->elementArrayBuffer;
+        default:
+            return nullptr;
+    }
+}
+
+int GetTextureSlot(GLenum target)
+{
+    switch (target)
+    {
+        case GL_TEXTURE_2D:
+            return kTexture2D;
+        case GL_TEXTURE_CUBE_MAP:
+            return kTextureCube;
+        default:
+            return -1;
+    }
+}
+
+int GetCapability(GLenum cap)
+{
+    switch (cap)
+    {
+        case GL_BLEND:
+            return kBlend;
+        case GL_CULL_FACE:
+            return kCullFace;
+        case GL_DEPTH_TEST:
+            return kDepthTest;
+        case GL_DITHER:
+            return kDither;
+        case GL_POLYGON_OFFSET_FILL:
+            return kPolygonOffsetFill;
+        case GL_RASTERIZER_DISCARD:
+            return kRasterizerDiscard;
+        case GL_SAMPLE_ALPHA_TO_COVERAGE:
+            return kSampleAlphaToCoverage;
+        case GL_SAMPLE_COVERAGE:
+            return kSampleCoverage;
+        case GL_SCISSOR_TEST:
+            return kScissorTest;
+        case GL_STENCIL_TEST:
+            return kStencilTest;
+        default:
+            return -1;
+    }
+}
+
+void GL_APIENTRY CachedActiveTexture(GLenum texture)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow)
+    {
+        if (IsRedundant(shadow, kStateCacheBinds, shadow->activeTexture == texture))
+        {
+            return;
+        }
+        shadow->activeTexture = texture;
+    }
+    gReal.glActiveTexture(texture);
+}
+
+void GL_APIENTRY CachedBindBuffer(GLenum target, GLuint buffer)
+{
+    ShadowState *shadow = tShadow;
+    GLuint *binding     = shadow ? GetBufferBinding(shadow, target) : nullptr;
+    if (binding)
+    {
+        if (IsRedundant(shadow, kStateCacheBinds, *binding == buffer))
+        {
+            return;
+        }
+        *binding = buffer;
+    }
+    gReal.glBindBuffer(target, buffer);
+}
+
+void GL_APIENTRY CachedBindTexture(GLenum target, GLuint texture)
+{
+    ShadowState *shadow = tShadow;
+    const int slot      = GetTextureSlot(target);
+    if (shadow && slot >= 0)
+    {
+        const GLuint unit = shadow->activeTexture - GL_TEXTURE0;
+        if (shadow->activeTexture == kUnknown)
+        {
+            // Some unit changes, any of them could be the one
+            for (auto &unitTextures : shadow->textures)
+            {
+                unitTextures[slot] = kUnknown;
+            }
+        }
+        else if (unit < kTrackedTextureUnits)
+        {
+            GLuint &binding = shadow->textures[unit][slot];
+            if (IsRedundant(shadow, kStateCacheBinds, binding == texture))
+            {
+                return;
+            }
+            binding = texture;
+        }
+    }
+    gReal.glBindTexture(target, texture);
+}
+
+// Returns true when the vertex array is already bound
+bool UpdateVertexArray(GLuint array)
+{
+    ShadowState *shadow = tShadow;
+    if (!shadow)
+    {
+        return false;
+    }
+    if (IsRedundant(shadow, kStateCacheBinds, shadow->vertexArray == array))
+    {
+        return true;
+    }
+
+    // The element array binding is part of the vertex array
+    shadow->vertexArray        = array;
+    shadow->elementArrayBuffer = kUnknown;
+    return false;
+}
+
+void GL_APIENTRY CachedBindVertexArray(GLuint array)
+{
+    if (!UpdateVertexArray(array))
+    {
+        gReal.glBindVertexArray(array);
+    }
+}
+
+void GL_APIENTRY CachedBindVertexArrayOES(GLuint array)
+{
+    if (!UpdateVertexArray(array))
+    {
+        gReal.glBindVertexArrayOES(array);
+    }
+}
+
+// Deleting a bound object unbinds it in the current context
+void ForgetDeletedBuffers(GLsizei n, const GLuint *buffers)
+{
+    ShadowState *shadow = tShadow;
+    for (GLsizei i = 0; shadow && i < n; i++)
+    {
+        if (buffers[i] != 0 && shadow->arrayBuffer == buffers[i])
+        {
+            shadow->arrayBuffer = 0;
+        }
+        if (buffers[i] != 0 && shadow->elementArrayBuffer == buffers[i])
+        {
+            shadow->elementArrayBuffer = 0;
+        }
+    }
+}
+
+void GL_APIENTRY CachedDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    ForgetDeletedBuffers(n, buffers);
+    gReal.glDeleteBuffers(n, buffers);
+}
+
+void GL_APIENTRY CachedDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    ShadowState *shadow = tShadow;
+    for (GLsizei i = 0; shadow && i < n; i++)
+    {
+        for (auto &unitTextures : shadow->textures)
+        {
+            for (GLuint &binding : unitTextures)
+            {
+                if (textures[i] != 0 && binding == textures[i])
+                {
+                    binding = 0;
+                }
+            }
+        }
+    }
+    gReal.glDeleteTextures(n, textures);
+}
+
+void ForgetDeletedVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    ShadowState *shadow = tShadow;
+    for (GLsizei i = 0; shadow && i < n; i++)
+    {
+        if (arrays[i] != 0 && shadow->vertexArray == arrays[i])
+        {
+            shadow->vertexArray        = 0;
+            shadow->elementArrayBuffer = kUnknown;
+        }
+    }
+}
+
+void GL_APIENTRY CachedDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    ForgetDeletedVertexArrays(n, arrays);
+    gReal.glDeleteVertexArrays(n, arrays);
+}
+
+void GL_APIENTRY CachedDeleteVertexArraysOES(GLsizei n, const GLuint *arrays)
+{
+    ForgetDeletedVertexArrays(n, arrays);
+    gReal.glDeleteVertexArraysOES(n, arrays);
+}
+
+void GL_APIENTRY CachedUseProgram(GLuint program)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow)
+    {
+        if (IsRedundant(shadow, kStateCachePrograms, shadow->program == program))
+        {
+            return;
+        }
+        shadow->program = program;
+    }
+    gReal.glUseProgram(program);
+}
+
+void GL_APIENTRY CachedDeleteProgram(GLuint program)
+{
+    // A deleted program stays in use until another one is, but do not rely on its name
+    ShadowState *shadow = tShadow;
+    if (shadow && program != 0 && shadow->program == program)
+    {
+        shadow->program = kUnknown;
+    }
+    gReal.glDeleteProgram(program);
+}
+
+// Returns true when the capability already has the value
+bool UpdateCapability(GLenum cap, GLuint enabled)
+{
+    ShadowState *shadow  = tShadow;
+    const int capability = GetCapability(cap);
+    if (!shadow || capability < 0)
+    {
+        return false;
+    }
+
+    GLuint &value = shadow->capabilities[capability];
+    if (IsRedundant(shadow, kStateCacheCapabilities, value == enabled))
+    {
+        return true;
+    }
+    value = enabled;
+    return false;
+}
+
+void GL_APIENTRY CachedEnable(GLenum cap)
+{
+    if (!UpdateCapability(cap, 1))
+    {
+        gReal.glEnable(cap);
+    }
+}
+
+void GL_APIENTRY CachedDisable(GLenum cap)
+{
+    if (!UpdateCapability(cap, 0))
+    {
+        gReal.glDisable(cap);
+    }
+}
+
+// Returns true when every value already matches. Values without an unknown marker, such as
+// floats, carry a separate known flag.
+template <size_t N, typename T>
+bool UpdateFixedState(ShadowState *shadow,
+                      T (&shadowValues)[N],
+                      const T (&values)[N],
+                      bool *known = nullptr)
+{
+    const bool unchanged =
+        (known == nullptr || *known) && memcmp(shadowValues, values, sizeof(values)) == 0;
+    if (IsRedundant(shadow, kStateCacheFixedState, unchanged))
+    {
+        return true;
+    }
+    memcpy(shadowValues, values, sizeof(values));
+    if (known)
+    {
+        *known = true;
+    }
+    return false;
+}
+
+bool UpdateFixedState(ShadowState *shadow, GLuint *shadowValue, GLuint value)
+{
+    if (IsRedundant(shadow, kStateCacheFixedState, *shadowValue == value))
+    {
+        return true;
+    }
+    *shadowValue = value;
+    return false;
+}
+
+void GL_APIENTRY CachedBlendFuncSeparate(GLenum srcRGB,
+                                         GLenum dstRGB,
+                                         GLenum srcAlpha,
+                                         GLenum dstAlpha)
+{
+    ShadowState *shadow    = tShadow;
+    const GLuint values[4] = {srcRGB, dstRGB, srcAlpha, dstAlpha};
+    if (shadow && UpdateFixedState(shadow, shadow->blendFunc, values))
+    {
+        return;
+    }
+    gReal.glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+void GL_APIENTRY CachedBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    ShadowState *shadow    = tShadow;
+    const GLuint values[4] = {sfactor, dfactor, sfactor, dfactor};
+    if (shadow && UpdateFixedState(shadow, shadow->blendFunc, values))
+    {
+        return;
+    }
+    gReal.glBlendFunc(sfactor, dfactor);
+}
+
+void GL_APIENTRY CachedBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+    ShadowState *shadow    = tShadow;
+    const GLuint values[2] = {modeRGB, modeAlpha};
+    if (shadow && UpdateFixedState(shadow, shadow->blendEquation, values))
+    {
+        return;
+    }
+    gReal.glBlendEquationSeparate(modeRGB, modeAlpha);
+}
+
+void GL_APIENTRY CachedBlendEquation(GLenum mode)
+{
+    ShadowState *shadow    = tShadow;
+    const GLuint values[2] = {mode, mode};
+    if (shadow && UpdateFixedState(shadow, shadow->blendEquation, values))
+    {
+        return;
+    }
+    gReal.glBlendEquation(mode);
+}
+
+void GL_APIENTRY CachedDepthFunc(GLenum func)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow && UpdateFixedState(shadow, &shadow->depthFunc, func))
+    {
+        return;
+    }
+    gReal.glDepthFunc(func);
+}
+
+void GL_APIENTRY CachedDepthMask(GLboolean flag)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow && UpdateFixedState(shadow, &shadow->depthMask, flag ? 1u : 0u))
+    {
+        return;
+    }
+    gReal.glDepthMask(flag);
+}
+
+void GL_APIENTRY CachedCullFace(GLenum mode)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow && UpdateFixedState(shadow, &shadow->cullFace, mode))
+    {
+        return;
+    }
+    gReal.glCullFace(mode);
+}
+
+void GL_APIENTRY CachedFrontFace(GLenum mode)
+{
+    ShadowState *shadow = tShadow;
+    if (shadow && UpdateFixedState(shadow, &shadow->frontFace, mode))
+    {
+        return;
+    }
+    gReal.glFrontFace(mode);
+}
+
+void GL_APIENTRY CachedClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    ShadowState *shadow     = tShadow;
+    const GLfloat values[4] = {red, green, blue, alpha};
+    if (shadow && UpdateFixedState(shadow, shadow->clearColor, values, &shadow->clearColorKnown))
+    {
+        return;
+    }
+    gReal.glClearColor(red, green, blue, alpha);
+}
+
+void GL_APIENTRY CachedViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    ShadowState *shadow   = tShadow;
+    const GLint values[4] = {x, y, width, height};
+    if (shadow && UpdateFixedState(shadow, shadow->viewport, values, &shadow->viewportKnown))
+    {
+        return;
+    }
+    gReal.glViewport(x, y, width, height);
+}
+}  // anonymous namespace
+
+uint64_t StateCacheCounters::getTotalCalls() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : calls)
+    {
+        total += count;
+    }
+    return total;
+}
+
+uint64_t StateCacheCounters::getTotalElided() const
+{
+    uint64_t total = 0;
+    for (uint64_t count : elided)
+    {
+        total += count;
+    }
+    return total;
+}
+
+void StateCacheInstall()
+{
+    if (gInstalled)
+    {
+        return;
+    }
+
+    // Missing entry points, e.g. vertex arrays on ES2, stay missing
+#define INSTALL_ENTRY_POINT(name, cached) \
+    if (name != nullptr)                  \
+    {                                     \
+        gReal.name = name;                \
+        name       = cached;              \
+    }
+    STATE_CACHE_ENTRY_POINTS(INSTALL_ENTRY_POINT)
+#undef INSTALL_ENTRY_POINT
+
+    gInstalled = new ShadowState();
+    ResetShadow(gInstalled);
+    tShadow = gInstalled;
+}
+
+void StateCacheUninstall()
+{
+    if (!gInstalled)
+    {
+        return;
+    }
+
+    // Leaves alone entry points that were reloaded in the meantime
+#define UNINSTALL_ENTRY_POINT(name, cached) \
+    if (name == cached)                     \
+    {                                       \
+        name = gReal.name;                  \
+    }
+    STATE_CACHE_ENTRY_POINTS(UNINSTALL_ENTRY_POINT)
+#undef UNINSTALL_ENTRY_POINT
+
+    tShadow = nullptr;
+    delete gInstalled;
+    gInstalled = nullptr;
+}
+
+bool StateCacheIsInstalled()
+{
+    return gInstalled != nullptr;
+}
+
+void StateCacheInvalidate()
+{
+    if (gInstalled)
+    {
+        ResetShadow(gInstalled);
+    }
+}
+
+StateCacheCounters StateCacheGetCounters()
+{
+    return gInstalled ? gInstalled->counters : StateCacheCounters();
+}
+
+const char *StateCacheGetCategoryName(StateCacheCategory category)
+{
+    switch (category)
+    {
+        case kStateCacheBinds:
+            return "binds";
+        case kStateCachePrograms:
+            return "programs";
+        case kStateCacheCapabilities:
+            return "capabilities";
+        case kStateCacheFixedState:
+            return "fixed_state";
+        default:
+            return "";
+    }
+}
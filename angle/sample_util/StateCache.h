@@ -0,0 +1,59 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// StateCache.h: Drops redundant binds and state changes before they reach the GL.
+//
+
+#ifndef SAMPLE_UTIL_STATE_CACHE_H
+#define SAMPLE_UTIL_STATE_CACHE_H
+
+#include <stdint.h>
+
+// Installing replaces the gles_loader_autogen entry points for buffer, texture, vertex array
+// and program binds, glEnable/glDisable and the blend, depth, cull, clear color and viewport
+// state with versions that compare against a shadow copy and skip calls that would not
+// change anything. Code keeps calling the usual gl* functions.
+//
+// The shadow belongs to the installing thread and its current context, every other thread
+// goes straight to the driver. State starts out unknown so the first call of each kind always
+// goes through. Anything that changes state behind the cache's back, e.g. making another
+// context current on the same thread, must be followed by StateCacheInvalidate(). Reloading
+// the entry points with angle::LoadGLES() or angle::LoadGLESLazy() removes the cache. Lazy
+// stubs that the cache wraps before their first call stay behind the wrappers.
+enum StateCacheCategory
+{
+    kStateCacheBinds,         // glActiveTexture, glBindBuffer, glBindTexture, glBindVertexArray
+    kStateCachePrograms,      // glUseProgram
+    kStateCacheCapabilities,  // glEnable, glDisable
+    kStateCacheFixedState,    // blend, depth, cull, clear color, viewport
+    kStateCacheCategoryCount,
+};
+
+struct StateCacheCounters
+{
+    uint64_t calls[kStateCacheCategoryCount]  = {};
+    uint64_t elided[kStateCacheCategoryCount] = {};
+
+    uint64_t getTotalCalls() const;
+    uint64_t getTotalElided() const;
+};
+
+// Call after the GLES entry points are loaded, on the thread with the context current. The
+// entry points are process-wide: after the installing thread makes any context current,
+// including the same one again after another, call StateCacheInvalidate() before the next
+// GL call, or the shadow describes the wrong context and needed calls are skipped.
+void StateCacheInstall();
+void StateCacheUninstall();
+bool StateCacheIsInstalled();
+
+// Forgets the shadow, the next call of each kind goes through again
+void StateCacheInvalidate();
+
+// Totals since installation
+StateCacheCounters StateCacheGetCounters();
+
+const char *StateCacheGetCategoryName(StateCacheCategory category);
+
+#endif  // SAMPLE_UTIL_STATE_CACHE_H
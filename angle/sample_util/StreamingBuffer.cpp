@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// StreamingBuffer.cpp: Ring allocator for per-frame dynamic vertex, index and uniform data.
+//
+
+#include "sample_util/StreamingBuffer.h"
+
+#include <algorithm>
+
+#include "util/shader_utils.h"
+
+namespace
+{
+// Suballocations start on this boundary at least, enough for any vertex attribute type
+constexpr size_t kMinAlignment = 4;
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// The element array binding belongs to the bound vertex array, so the buffer's own binds put
+// back whatever was bound before rather than 0
+class ScopedBufferBinding
+{
+  public:
+    explicit ScopedBufferBinding(GLenum target) : mTarget(target), mBuffer(0)
+    {
+        glGetIntegerv(GetBindingQuery(target), &mBuffer);
+    }
+    ~ScopedBufferBinding() { glBindBuffer(mTarget, static_cast<GLuint>(mBuffer)); }
+
+  private:
+    static GLenum GetBindingQuery(GLenum target)
+    {
+        switch (target)
+        {
+            case GL_ELEMENT_ARRAY_BUFFER:
+                return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+            case GL_UNIFORM_BUFFER:
+                return GL_UNIFORM_BUFFER_BINDING;
+            default:
+                return GL_ARRAY_BUFFER_BINDING;
+        }
+    }
+
+    GLenum mTarget;
+    GLint mBuffer;
+};
+}  // anonymous namespace
+
+StreamingBuffer::StreamingBuffer(GLenum target, size_t frameSize, int framesInFlight)
+    : mTarget(target),
+      mFramesInFlight(std::max(framesInFlight, 1)),
+      mFrameSize(AlignUp(frameSize, kMinAlignment))
+{}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    destroy();
+}
+
+bool StreamingBuffer::initialize()
+{
+    mUseFences = IsGLES3OrLater();
+
+    return createBuffers();
+}
+
+void StreamingBuffer::destroy()
+{
+    if (mMapped)
+    {
+        ScopedBufferBinding binding(mTarget);
+        glBindBuffer(mTarget, mBuffers[0]);
+        glUnmapBuffer(mTarget);
+        mMapped = nullptr;
+    }
+    deleteBuffers();
+}
+
+bool StreamingBuffer::createBuffers()
+{
+    ScopedBufferBinding binding(mTarget);
+
+    // One buffer with a segment per frame in flight, or one buffer per frame in flight. The
+    // sizes are checked on the buffers themselves, glGetError() would also report errors
+    // left behind by unrelated calls.
+    const size_t bufferSize = mUseFences ? mFrameSize * mFramesInFlight : mFrameSize;
+    if (mUseFences)
+    {
+        mBuffers.resize(1);
+        mFences.assign(mFramesInFlight, nullptr);
+    }
+    else
+    {
+        mBuffers.resize(mFramesInFlight);
+        mStaging.resize(mFrameSize);
+    }
+
+    glGenBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
+    bool allocated = true;
+    for (GLuint buffer : mBuffers)
+    {
+        glBindBuffer(mTarget, buffer);
+        glBufferData(mTarget, bufferSize, nullptr, GL_STREAM_DRAW);
+
+        GLint size = 0;
+        glGetBufferParameteriv(mTarget, GL_BUFFER_SIZE, &size);
+        allocated = allocated && static_cast<size_t>(size) == bufferSize;
+    }
+    return allocated;
+}
+
+void StreamingBuffer::deleteBuffers()
+{
+    for (GLsync &fence : mFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (!mBuffers.empty())
+    {
+        glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
+        mBuffers.clear();
+    }
+}
+
+void StreamingBuffer::beginFrame()
+{
+    mFrame   = (mFrame + 1) % mFramesInFlight;
+    mHead    = 0;
+    mFlushed = false;
+
+    // Grow after an overflow. Every segment is replaced, so wait for all of them.
+    if (mRequiredSize > mFrameSize)
+    {
+        if (mUseFences)
+        {
+            glFinish();
+        }
+        deleteBuffers();
+        mFrameSize    = AlignUp(std::max(mRequiredSize, mFrameSize * 2), kMinAlignment);
+        mRequiredSize = 0;
+        createBuffers();
+    }
+
+    if (!mUseFences)
+    {
+        return;
+    }
+
+    GLsync &fence = mFences[mFrame];
+    if (fence)
+    {
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            mStallCount++;
+            do
+            {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    // The fence guarantees the GPU is done with this segment
+    ScopedBufferBinding binding(mTarget);
+    glBindBuffer(mTarget, mBuffers[0]);
+    mMapped = reinterpret_cast<uint8_t *>(
+        glMapBufferRange(mTarget, mFrameSize * mFrame, mFrameSize,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                             GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+}
+
+uint8_t *StreamingBuffer::allocateBytes(size_t size,
+                                        size_t alignment,
+                                        GLuint *bufferOut,
+                                        GLintptr *offsetOut)
+{
+    const size_t start = AlignUp(mHead, std::max(alignment, kMinAlignment));
+    if (mFlushed || start + size > mFrameSize || (mUseFences && !mMapped))
+    {
+        mRequiredSize = std::max(mRequiredSize, start + size);
+        return nullptr;
+    }
+    mHead = start + size;
+
+    if (mUseFences)
+    {
+        *bufferOut = mBuffers[0];
+        *offsetOut = static_cast<GLintptr>(mFrameSize * mFrame + start);
+        return mMapped + start;
+    }
+
+    *bufferOut = mBuffers[mFrame];
+    *offsetOut = static_cast<GLintptr>(start);
+    return mStaging.data() + start;
+}
+
+void StreamingBuffer::flush()
+{
+    if (mFlushed)
+    {
+        glBindBuffer(mTarget, mUseFences ? mBuffers[0] : mBuffers[mFrame]);
+        return;
+    }
+    mFlushed = true;
+
+    if (mUseFences)
+    {
+        glBindBuffer(mTarget, mBuffers[0]);
+        if (mMapped)
+        {
+            if (mHead > 0)
+            {
+                glFlushMappedBufferRange(mTarget, 0, mHead);
+            }
+            glUnmapBuffer(mTarget);
+            mMapped = nullptr;
+        }
+    }
+    else
+    {
+        glBindBuffer(mTarget, mBuffers[mFrame]);
+        if (mHead > 0)
+        {
+            glBufferSubData(mTarget, 0, mHead, mStaging.data());
+        }
+    }
+}
+
+void StreamingBuffer::endFrame()
+{
+    flush();
+    if (mUseFences)
+    {
+        mFences[mFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
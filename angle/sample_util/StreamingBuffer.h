@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// StreamingBuffer.h: Ring allocator for per-frame dynamic vertex, index and uniform data.
+//
+
+#ifndef SAMPLE_UTIL_STREAMING_BUFFER_H
+#define SAMPLE_UTIL_STREAMING_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "util/gles_loader_autogen.h"
+
+// Typed view of one suballocation. data is write-only CPU memory until the owning buffer is
+// flushed, after which buffer/offset describe where the GPU sees it.
+template <typename T>
+struct StreamSpan
+{
+    T *data         = nullptr;
+    size_t count    = 0;
+    GLuint buffer   = 0;
+    GLintptr offset = 0;
+
+    bool valid() const { return data != nullptr; }
+    size_t size() const { return count; }
+    size_t byteSize() const { return count * sizeof(T); }
+    T *begin() const { return data; }
+    T *end() const { return data + count; }
+    T &operator[](size_t index) const { return data[index]; }
+
+    // Offset in the form glVertexAttribPointer and glDrawElements expect
+    const void *offsetPointer() const { return reinterpret_cast<const void *>(offset); }
+};
+
+// Each frame gets its own segment, used again framesInFlight frames later. On ES3 the segment
+// is mapped unsynchronized once the fence of its last use has signaled, so allocations are
+// written straight into the buffer. On ES2 allocations go to a staging copy and every segment
+// is a separate buffer object, uploaded with glBufferSubData; the rotation keeps the CPU from
+// touching a buffer the GPU may still read.
+//
+// Usage per frame: beginFrame(), allocate(), flush(), draw with the spans, endFrame().
+class StreamingBuffer
+{
+  public:
+    StreamingBuffer(GLenum target, size_t frameSize, int framesInFlight = 3);
+    ~StreamingBuffer();
+
+    bool initialize();
+    void destroy();
+
+    void beginFrame();
+
+    // Returns an invalid span when the frame segment is full or already flushed. A full
+    // segment is grown at the next beginFrame() so later frames fit.
+    template <typename T>
+    StreamSpan<T> allocate(size_t count, size_t alignment = alignof(T))
+    {
+        StreamSpan<T> span;
+        uint8_t *memory = allocateBytes(count * sizeof(T), alignment, &span.buffer, &span.offset);
+        if (memory)
+        {
+            span.data  = reinterpret_cast<T *>(memory);
+            span.count = count;
+        }
+        return span;
+    }
+
+    // Make this frame's allocations visible to GL. Binds the buffer to the target.
+    void flush();
+    void endFrame();
+
+    GLenum getTarget() const { return mTarget; }
+    bool usesFences() const { return mUseFences; }
+
+    // Frames where beginFrame() had to wait for the GPU
+    uint64_t getStallCount() const { return mStallCount; }
+
+  private:
+    uint8_t *allocateBytes(size_t size, size_t alignment, GLuint *bufferOut, GLintptr *offsetOut);
+    bool createBuffers();
+    void deleteBuffers();
+
+    const GLenum mTarget;
+    const int mFramesInFlight;
+    size_t mFrameSize;
+    size_t mRequiredSize = 0;
+
+    bool mUseFences = false;
+    std::vector<GLuint> mBuffers;
+    std::vector<GLsync> mFences;
+    std::vector<uint8_t> mStaging;
+
+    int mFrame        = 0;
+    size_t mHead      = 0;
+    uint8_t *mMapped  = nullptr;
+    bool mFlushed     = false;
+    uint64_t mStallCount = 0;
+};
+
+#endif  // SAMPLE_UTIL_STREAMING_BUFFER_H
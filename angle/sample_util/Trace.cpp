@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Trace.cpp: Scoped CPU/GPU event recording, written out in the Chrome trace event format so it
+//   can be loaded in chrome://tracing or Perfetto.
+//
+
+#include "sample_util/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "sample_util/JSONUtils.h"
+
+struct TraceEvent
+{
+    const char *name;
+    uint64_t startTime;
+    uint64_t duration;
+};
+
+struct TraceTrack
+{
+    std::string name;
+    uint32_t id;
+    std::unique_ptr<TraceEvent[]> events;
+    size_t capacity;
+    std::atomic<size_t> count;
+    std::atomic<uint64_t> dropped;
+};
+
+namespace
+{
+std::atomic<bool> gEnabled(false);
+size_t gEventsPerTrack = 0;
+uint64_t gStartTime    = 0;
+
+// Guards the track list and track names, never taken while recording an event
+std::mutex gTrackMutex;
+std::vector<std::unique_ptr<TraceTrack>> gTracks;
+
+thread_local TraceTrack *tThreadTrack = nullptr;
+
+// Set nodes never move, so the names stay valid as more are added
+std::mutex gNameMutex;
+std::set<std::string> gNames;
+
+TraceTrack *CreateTrack(const char *name)
+{
+    std::lock_guard<std::mutex> lock(gTrackMutex);
+
+    std::unique_ptr<TraceTrack> track(new TraceTrack());
+    track->name     = name;
+    track->id       = static_cast<uint32_t>(gTracks.size() + 1);
+    track->events.reset(new TraceEvent[gEventsPerTrack]);
+    track->capacity = gEventsPerTrack;
+    track->count.store(0, std::memory_order_relaxed);
+    track->dropped.store(0, std::memory_order_relaxed);
+
+    gTracks.push_back(std::move(track));
+    return gTracks.back().get();
+}
+
+TraceTrack *GetThreadTrack()
+{
+    if (!tThreadTrack)
+    {
+        tThreadTrack = CreateTrack("thread");
+    }
+    return tThreadTrack;
+}
+}  // anonymous namespace
+
+void TraceInitialize(size_t eventsPerTrack)
+{
+    gEventsPerTrack = eventsPerTrack;
+    gStartTime      = TraceNow();
+    gEnabled.store(true, std::memory_order_release);
+}
+
+bool TraceIsEnabled()
+{
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t TraceNow()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void TraceSetThreadName(const char *name)
+{
+    if (!TraceIsEnabled())
+    {
+        return;
+    }
+
+    TraceTrack *track = GetThreadTrack();
+    std::lock_guard<std::mutex> lock(gTrackMutex);
+    track->name = name;
+}
+
+TraceTrack *TraceCreateTrack(const char *name)
+{
+    return TraceIsEnabled() ? CreateTrack(name) : nullptr;
+}
+
+const char *TraceInternName(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(gNameMutex);
+    return gNames.insert(name).first->c_str();
+}
+
+void TraceAddEvent(const char *name, uint64_t startTime, uint64_t duration)
+{
+    if (TraceIsEnabled())
+    {
+        TraceAddEvent(GetThreadTrack(), name, startTime, duration);
+    }
+}
+
+void TraceAddEvent(TraceTrack *track, const char *name, uint64_t startTime, uint64_t duration)
+{
+    if (!track)
+    {
+        return;
+    }
+
+    size_t index = track->count.load(std::memory_order_relaxed);
+    if (index >= track->capacity)
+    {
+        track->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    track->events[index] = {name, startTime, duration};
+    track->count.store(index + 1, std::memory_order_release);
+}
+
+bool TraceWriteJSON(const std::string &path)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(gTrackMutex);
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::fixed
+        << std::setprecision(3);
+
+    bool first = true;
+    for (const std::unique_ptr<TraceTrack> &track : gTracks)
+    {
+        out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+            << "\"tid\": " << track->id << ", \"args\": {\"name\": ";
+        WriteJSONString(out, track->name.c_str());
+        out << "}}";
+        first = false;
+
+        const size_t count = track->count.load(std::memory_order_acquire);
+        for (size_t index = 0; index < count; index++)
+        {
+            const TraceEvent &event = track->events[index];
+            const double start =
+                event.startTime >= gStartTime ? (event.startTime - gStartTime) * 1e-3 : 0.0;
+
+            out << ",\n{\"name\": ";
+            WriteJSONString(out, event.name);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << track->id << ", \"ts\": " << start
+                << ", \"dur\": " << event.duration * 1e-3 << "}";
+        }
+
+        const uint64_t dropped = track->dropped.load(std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            out << ",\n{\"name\": \"dropped events\", \"ph\": \"C\", \"pid\": 1, \"tid\": "
+                << track->id << ", \"ts\": 0, \"args\": {\"count\": " << dropped << "}}";
+        }
+    }
+
+    out << "\n]}" << std::endl;
+    return out.good();
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Trace.h: Scoped CPU/GPU event recording, written out in the Chrome trace event format so it
+//   can be loaded in chrome://tracing or Perfetto.
+//
+
+#ifndef SAMPLE_UTIL_TRACE_H
+#define SAMPLE_UTIL_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// Events go to a track: every thread gets its own the first time it records, other timelines
+// such as the GPU create one explicitly. A track is a fixed size array with a single writer,
+// the writer publishes each event by bumping an atomic count so recording takes no lock and
+// never allocates. Events past the capacity are counted and dropped.
+//
+// Event names are not copied and must outlive the trace: string literals, or names built at
+// run time and passed through TraceInternName().
+struct TraceTrack;
+
+// Enables recording. Tracks created afterwards hold eventsPerTrack events.
+void TraceInitialize(size_t eventsPerTrack);
+bool TraceIsEnabled();
+
+// Monotonic clock in nanoseconds
+uint64_t TraceNow();
+
+// Names the calling thread's track
+void TraceSetThreadName(const char *name);
+
+// Track for a timeline that is not a CPU thread, e.g. "GPU". Only one thread may write to it.
+TraceTrack *TraceCreateTrack(const char *name);
+
+// Returns a copy of name that lives until the program exits, the same pointer for equal
+// names. Takes a lock, look names up once rather than per event.
+const char *TraceInternName(const std::string &name);
+
+// Records a complete event on the calling thread's track, or on the given track
+void TraceAddEvent(const char *name, uint64_t startTime, uint64_t duration);
+void TraceAddEvent(TraceTrack *track, const char *name, uint64_t startTime, uint64_t duration);
+
+// Writes every event recorded so far. Safe while other threads keep recording, events they
+// publish during the write may or may not be included.
+bool TraceWriteJSON(const std::string &path);
+
+class TraceScope
+{
+  public:
+    explicit TraceScope(const char *name) : mName(name), mStartTime(0)
+    {
+        if (TraceIsEnabled())
+        {
+            mStartTime = TraceNow();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (mStartTime != 0)
+        {
+            TraceAddEvent(mName, mStartTime, TraceNow() - mStartTime);
+        }
+    }
+
+  private:
+    const char *mName;
+    uint64_t mStartTime;
+};
+
+#endif  // SAMPLE_UTIL_TRACE_H
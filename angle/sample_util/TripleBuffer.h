@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// TripleBuffer.h: Lock-free hand-off of the latest snapshot from one producer thread to one
+//   consumer thread.
+//
+
+#ifndef SAMPLE_UTIL_TRIPLE_BUFFER_H
+#define SAMPLE_UTIL_TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// The producer fills getWriteBuffer() and publish()es it, the consumer calls acquire() and
+// reads getReadBuffer(). Neither side ever waits: the third slot sits between them, holding
+// the most recent published snapshot. Snapshots the consumer was too slow to see are
+// overwritten, so it always gets the newest one.
+template <typename T>
+class TripleBuffer
+{
+  public:
+    TripleBuffer() : mWrite(0), mRead(1), mShared(2) {}
+
+    T &getWriteBuffer() { return mBuffers[mWrite]; }
+
+    // Hands the write buffer over and takes the shared one back for the next snapshot
+    void publish()
+    {
+        mWrite = mShared.exchange(mWrite | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Swaps in the latest snapshot, false when nothing new was published since the last call
+    bool acquire()
+    {
+        if ((mShared.load(std::memory_order_relaxed) & kFresh) == 0)
+        {
+            return false;
+        }
+        mRead = mShared.exchange(mRead, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    const T &getReadBuffer() const { return mBuffers[mRead]; }
+
+  private:
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFresh     = 4;
+
+    T mBuffers[3];
+    int mWrite;
+    int mRead;
+
+    // Index of the middle slot, with kFresh set when the consumer has not seen it yet
+    std::atomic<int> mShared;
+};
+
+#endif  // SAMPLE_UTIL_TRIPLE_BUFFER_H
@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// UploadQueue.cpp: Creates buffers and textures on a loader thread with a shared context.
+//
+
+#include "sample_util/UploadQueue.h"
+
+#include <string.h>
+
+#include "sample_util/Trace.h"
+#include "sample_util/tga_utils.h"
+#include "util/EGLWindow.h"
+
+struct UploadJob
+{
+    UploadQueue::Job job;
+    GLuint object      = 0;
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLSyncKHR sync    = EGL_NO_SYNC_KHR;
+
+    // Set by the worker once the job ran and its fence was inserted
+    std::atomic<bool> finished{false};
+
+    ~UploadJob()
+    {
+        if (sync != EGL_NO_SYNC_KHR)
+        {
+            eglDestroySyncKHR(display, sync);
+        }
+    }
+};
+
+UploadQueue::UploadQueue()
+    : mWindow(nullptr), mDisplay(EGL_NO_DISPLAY), mUseFenceSync(false), mStopping(false)
+{}
+
+UploadQueue::~UploadQueue()
+{
+    destroy();
+}
+
+bool UploadQueue::initialize(EGLWindow *window)
+{
+    mWindow  = window;
+    mDisplay = window->getDisplay();
+    if (!window->hasWorkerContext())
+    {
+        return false;
+    }
+
+    const char *displayExtensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
+    mUseFenceSync = displayExtensions && strstr(displayExtensions, "EGL_KHR_fence_sync") &&
+                    eglCreateSyncKHR && eglClientWaitSyncKHR;
+
+    // The worker context can only be made current on the thread itself, wait for the result
+    std::unique_lock<std::mutex> lock(mMutex);
+    bool started = false;
+    bool current = false;
+    mStopping    = false;
+    mThread      = std::thread([this, &started, &current]() {
+        const bool madeCurrent = mWindow->makeWorkerCurrent();
+        {
+            std::lock_guard<std::mutex> startLock(mMutex);
+            started = true;
+            current = madeCurrent;
+        }
+        mCondition.notify_all();
+        if (madeCurrent)
+        {
+            workerLoop();
+            mWindow->releaseWorkerContext();
+        }
+    });
+    mCondition.wait(lock, [&started]() { return started; });
+    lock.unlock();
+
+    if (!current)
+    {
+        mThread.join();
+        return false;
+    }
+    return true;
+}
+
+void UploadQueue::destroy()
+{
+    if (mThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        mThread.join();
+    }
+    mJobs.clear();
+}
+
+UploadTicket UploadQueue::submit(Job job)
+{
+    UploadTicket ticket = std::make_shared<UploadJob>();
+    ticket->job         = std::move(job);
+    ticket->display     = mDisplay;
+
+    if (!isAsync())
+    {
+        ticket->object = ticket->job();
+        ticket->finished.store(true, std::memory_order_release);
+        return ticket;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(ticket);
+    }
+    mCondition.notify_all();
+    return ticket;
+}
+
+UploadTicket UploadQueue::uploadBuffer(GLenum target, const void *data, size_t size, GLenum usage)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    auto copy            = std::make_shared<std::vector<uint8_t>>(bytes, bytes + size);
+
+    return submit([target, usage, copy]() {
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(target, buffer);
+        glBufferData(target, static_cast<GLsizeiptr>(copy->size()), copy->data(), usage);
+        glBindBuffer(target, 0);
+        return buffer;
+    });
+}
+
+UploadTicket UploadQueue::uploadTGATexture(const std::string &path)
+{
+    return submit([path]() -> GLuint {
+        TGAImage image;
+        if (!LoadTGAImageFromFile(path, &image))
+        {
+            return 0;
+        }
+        GLuint texture = LoadTextureFromTGAImage(image);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return texture;
+    });
+}
+
+bool UploadQueue::isReady(const UploadTicket &ticket, GLuint *objectOut)
+{
+    if (!ticket->finished.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    if (ticket->sync != EGL_NO_SYNC_KHR)
+    {
+        if (eglClientWaitSyncKHR(mDisplay, ticket->sync, 0, 0) != EGL_CONDITION_SATISFIED_KHR)
+        {
+            return false;
+        }
+        eglDestroySyncKHR(mDisplay, ticket->sync);
+        ticket->sync = EGL_NO_SYNC_KHR;
+    }
+
+    *objectOut = ticket->object;
+    return true;
+}
+
+GLuint UploadQueue::wait(const UploadTicket &ticket)
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [&ticket]() {
+            return ticket->finished.load(std::memory_order_acquire);
+        });
+    }
+
+    if (ticket->sync != EGL_NO_SYNC_KHR)
+    {
+        eglClientWaitSyncKHR(mDisplay, ticket->sync, 0, EGL_FOREVER_KHR);
+        eglDestroySyncKHR(mDisplay, ticket->sync);
+        ticket->sync = EGL_NO_SYNC_KHR;
+    }
+    return ticket->object;
+}
+
+void UploadQueue::workerLoop()
+{
+    TraceSetThreadName("upload");
+
+    while (true)
+    {
+        UploadTicket ticket;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStopping || !mJobs.empty(); });
+            if (mJobs.empty())
+            {
+                return;
+            }
+            ticket = mJobs.front();
+            mJobs.pop_front();
+        }
+
+        {
+            TraceScope traceScope("upload");
+            ticket->object = ticket->job();
+        }
+        finishJob(ticket.get());
+    }
+}
+
+void UploadQueue::finishJob(UploadJob *job)
+{
+    // The render context may only use the object once the GPU is done with the upload
+    if (mUseFenceSync)
+    {
+        job->sync = eglCreateSyncKHR(mDisplay, EGL_SYNC_FENCE_KHR, nullptr);
+        glFlush();
+    }
+    if (job->sync == EGL_NO_SYNC_KHR)
+    {
+        glFinish();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        job->finished.store(true, std::memory_order_release);
+    }
+    mCondition.notify_all();
+}
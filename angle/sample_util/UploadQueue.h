@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// UploadQueue.h: Creates buffers and textures on a loader thread with a shared context.
+//
+
+#ifndef SAMPLE_UTIL_UPLOAD_QUEUE_H
+#define SAMPLE_UTIL_UPLOAD_QUEUE_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/egl_loader_autogen.h"
+#include "util/gles_loader_autogen.h"
+
+class EGLWindow;
+
+struct UploadJob;
+using UploadTicket = std::shared_ptr<UploadJob>;
+
+// Jobs run in submission order on a thread where the window's worker context is current.
+// Each finished job is followed by a fence (EGL_KHR_fence_sync, or glFinish without it) and
+// the render thread only sees the object once that fence has signaled, so it never binds a
+// half-uploaded buffer or texture. Objects are shared through the share group; containers
+// such as VAOs and framebuffers are not and must stay on the render thread.
+//
+// Without a worker context every job runs inside submit() on the calling thread, so samples
+// use the same code either way.
+class UploadQueue
+{
+  public:
+    // Runs with a current context, returns the created object or 0 on failure
+    using Job = std::function<GLuint()>;
+
+    UploadQueue();
+    ~UploadQueue();
+
+    bool initialize(EGLWindow *window);
+    void destroy();
+
+    bool isAsync() const { return mThread.joinable(); }
+
+    UploadTicket submit(Job job);
+
+    // Copies data before returning
+    UploadTicket uploadBuffer(GLenum target, const void *data, size_t size, GLenum usage);
+
+    // Loads and decodes the file on the loader thread as well
+    UploadTicket uploadTGATexture(const std::string &path);
+
+    // Polled from the render thread. *objectOut is 0 when the job failed.
+    bool isReady(const UploadTicket &ticket, GLuint *objectOut);
+
+    // Blocks until the object can be used on the render thread
+    GLuint wait(const UploadTicket &ticket);
+
+  private:
+    void workerLoop();
+    void finishJob(UploadJob *job);
+
+    EGLWindow *mWindow;
+    EGLDisplay mDisplay;
+    bool mUseFenceSync;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<UploadTicket> mJobs;
+    bool mStopping;
+};
+
+#endif  // SAMPLE_UTIL_UPLOAD_QUEUE_H
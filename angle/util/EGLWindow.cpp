@@ -6,7 +6,9 @@
 
 #include "util/EGLWindow.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -16,6 +18,10 @@
 #include "util/OSWindow.h"
 #include "util/system_utils.h"
 
+#if defined(ANGLE_USE_UTIL_LOADER)
+#    include "util/gles_loader_lazy.h"
+#endif  // defined(ANGLE_USE_UTIL_LOADER)
+
 EGLPlatformParameters::EGLPlatformParameters()
     : renderer(EGL_PLATFORM_ANGLE_TYPE_DEFAULT_ANGLE),
       majorVersion(EGL_DONT_CARE),
@@ -125,7 +131,13 @@ EGLWindow::EGLWindow(EGLint glesMajorVersion,
       mSamples(-1),
       mDebugLayersEnabled(),
       mContextProgramCacheEnabled(),
-      mContextVirtualization()
+      mContextVirtualization(),
+      mSurfaceless(false),
+      mLazyGLESLoading(false),
+      mGLESLoadTime(0.0),
+      mWorkerContextEnabled(false),
+      mWorkerContext(EGL_NO_CONTEXT),
+      mWorkerSurface(EGL_NO_SURFACE)
 {}
 
 EGLWindow::~EGLWindow()
@@ -135,7 +147,11 @@ EGLWindow::~EGLWindow()
 
 void EGLWindow::swap()
 {
-    eglSwapBuffers(mDisplay, mSurface);
+    // Nothing to present without a surface, rendering goes to the application's FBO
+    if (!mSurfaceless)
+    {
+        eglSwapBuffers(mDisplay, mSurface);
+    }
 }
 
 EGLConfig EGLWindow::getConfig() const
@@ -166,6 +182,108 @@ bool EGLWindow::initializeGL(OSWindow *osWindow, angle::Library *glWindowingLibr
 }
 
 bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *glWindowingLibrary)
+{
+    if (!initializeDisplay(osWindow->getNativeDisplay(), glWindowingLibrary))
+    {
+        return false;
+    }
+
+    if (!initializeConfig(EGL_DONT_CARE))
+    {
+        std::cout << "Could not find a suitable EGL config!" << std::endl;
+        destroyGL();
+        return false;
+    }
+
+    const char *displayExtensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
+
+    std::vector<EGLint> surfaceAttributes;
+    if (strstr(displayExtensions, "EGL_NV_post_sub_buffer") != nullptr)
+    {
+        surfaceAttributes.push_back(EGL_POST_SUB_BUFFER_SUPPORTED_NV);
+        surfaceAttributes.push_back(EGL_TRUE);
+    }
+
+    bool hasRobustResourceInit =
+        strstr(displayExtensions, "EGL_ANGLE_robust_resource_initialization") != nullptr;
+    if (hasRobustResourceInit && mRobustResourceInit.valid())
+    {
+        surfaceAttributes.push_back(EGL_ROBUST_RESOURCE_INITIALIZATION_ANGLE);
+        surfaceAttributes.push_back(mRobustResourceInit.value() ? EGL_TRUE : EGL_FALSE);
+    }
+
+    surfaceAttributes.push_back(EGL_NONE);
+
+    mSurface = eglCreateWindowSurface(mDisplay, mConfig, osWindow->getNativeWindow(),
+                                      &surfaceAttributes[0]);
+    if (eglGetError() != EGL_SUCCESS || (mSurface == EGL_NO_SURFACE))
+    {
+        destroyGL();
+        return false;
+    }
+
+    loadGLES();
+
+    return true;
+}
+
+bool EGLWindow::initializeHeadlessGL(EGLint width,
+                                     EGLint height,
+                                     angle::Library *glWindowingLibrary)
+{
+    if (!initializeDisplay(EGL_DEFAULT_DISPLAY, glWindowingLibrary))
+    {
+        return false;
+    }
+
+    const char *displayExtensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
+    const bool hasSurfaceless =
+        strstr(displayExtensions, "EGL_KHR_surfaceless_context") != nullptr;
+
+    // Prefer a pbuffer, fall back to a surfaceless context when none can be created
+    if (initializeConfig(EGL_PBUFFER_BIT))
+    {
+        const EGLint pbufferAttributes[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+        mSurface = eglCreatePbufferSurface(mDisplay, mConfig, pbufferAttributes);
+        if (mSurface == EGL_NO_SURFACE)
+        {
+            // Clear the error before trying the surfaceless path
+            eglGetError();
+        }
+    }
+    if (mSurface == EGL_NO_SURFACE && !(hasSurfaceless && initializeConfig(EGL_DONT_CARE)))
+    {
+        std::cout << "Could not create a pbuffer or surfaceless context!" << std::endl;
+        destroyGL();
+        return false;
+    }
+    mSurfaceless = mSurface == EGL_NO_SURFACE;
+
+    loadGLES();
+
+    return initializeContext();
+}
+
+void EGLWindow::loadGLES()
+{
+#if defined(ANGLE_USE_UTIL_LOADER)
+    const auto start = std::chrono::steady_clock::now();
+    if (mLazyGLESLoading)
+    {
+        angle::LoadGLESLazy(eglGetProcAddress);
+    }
+    else
+    {
+        angle::LoadGLES(eglGetProcAddress);
+    }
+    mGLESLoadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                              start)
+                        .count();
+#endif  // defined(ANGLE_USE_UTIL_LOADER)
+}
+
+bool EGLWindow::initializeDisplay(EGLNativeDisplayType nativeDisplay,
+                                  angle::Library *glWindowingLibrary)
 {
 #if defined(ANGLE_USE_UTIL_LOADER)
     PFNEGLGETPROCADDRESSPROC getProcAddress;
@@ -230,7 +348,7 @@ bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *
     displayAttributes.push_back(EGL_NONE);
 
     mDisplay = eglGetPlatformDisplay(EGL_PLATFORM_ANGLE_ANGLE,
-                                     reinterpret_cast<void *>(osWindow->getNativeDisplay()),
+                                     reinterpret_cast<void *>(nativeDisplay),
                                      &displayAttributes[0]);
     if (mDisplay == EGL_NO_DISPLAY)
     {
@@ -244,6 +362,12 @@ bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *
         return false;
     }
 
+    return true;
+}
+
+// Pick the config, surfaceType is a mask of EGL_*_BIT the config must support.
+bool EGLWindow::initializeConfig(EGLint surfaceType)
+{
     const char *displayExtensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
 
     std::vector<EGLint> configAttributes = {
@@ -255,13 +379,13 @@ bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *
         EGL_STENCIL_SIZE,   (mStencilBits >= 0) ? mStencilBits : EGL_DONT_CARE,
         EGL_SAMPLE_BUFFERS, mMultisample ? 1 : 0,
         EGL_SAMPLES,        (mSamples >= 0) ? mSamples : EGL_DONT_CARE,
+        EGL_SURFACE_TYPE,   surfaceType,
     };
 
     // Add dynamic attributes
     bool hasPixelFormatFloat = strstr(displayExtensions, "EGL_EXT_pixel_format_float") != nullptr;
     if (!hasPixelFormatFloat && mComponentType != EGL_COLOR_COMPONENT_TYPE_FIXED_EXT)
     {
-        destroyGL();
         return false;
     }
     if (hasPixelFormatFloat)
@@ -275,8 +399,6 @@ bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *
 
     if (!FindEGLConfig(mDisplay, configAttributes.data(), &mConfig))
     {
-        std::cout << "Could not find a suitable EGL config!" << std::endl;
-        destroyGL();
         return false;
     }
 
@@ -288,35 +410,6 @@ bool EGLWindow::initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *
     eglGetConfigAttrib(mDisplay, mConfig, EGL_STENCIL_SIZE, &mStencilBits);
     eglGetConfigAttrib(mDisplay, mConfig, EGL_SAMPLES, &mSamples);
 
-    std::vector<EGLint> surfaceAttributes;
-    if (strstr(displayExtensions, "EGL_NV_post_sub_buffer") != nullptr)
-    {
-        surfaceAttributes.push_back(EGL_POST_SUB_BUFFER_SUPPORTED_NV);
-        surfaceAttributes.push_back(EGL_TRUE);
-    }
-
-    bool hasRobustResourceInit =
-        strstr(displayExtensions, "EGL_ANGLE_robust_resource_initialization") != nullptr;
-    if (hasRobustResourceInit && mRobustResourceInit.valid())
-    {
-        surfaceAttributes.push_back(EGL_ROBUST_RESOURCE_INITIALIZATION_ANGLE);
-        surfaceAttributes.push_back(mRobustResourceInit.value() ? EGL_TRUE : EGL_FALSE);
-    }
-
-    surfaceAttributes.push_back(EGL_NONE);
-
-    mSurface = eglCreateWindowSurface(mDisplay, mConfig, osWindow->getNativeWindow(),
-                                      &surfaceAttributes[0]);
-    if (eglGetError() != EGL_SUCCESS || (mSurface == EGL_NO_SURFACE))
-    {
-        destroyGL();
-        return false;
-    }
-
-#if defined(ANGLE_USE_UTIL_LOADER)
-    angle::LoadGLES(eglGetProcAddress);
-#endif  // defined(ANGLE_USE_UTIL_LOADER)
-
     return true;
 }
 
@@ -445,7 +538,7 @@ EGLContext EGLWindow::createContext(EGLContext share) const
     }
     contextAttributes.push_back(EGL_NONE);
 
-    EGLContext context = eglCreateContext(mDisplay, mConfig, nullptr, &contextAttributes[0]);
+    EGLContext context = eglCreateContext(mDisplay, mConfig, share, &contextAttributes[0]);
     if (eglGetError() != EGL_SUCCESS)
     {
         return EGL_NO_CONTEXT;
@@ -470,16 +563,85 @@ bool EGLWindow::initializeContext()
         return false;
     }
 
+    if (mWorkerContextEnabled && !initializeWorkerContext())
+    {
+        std::cout << "Could not create a shared worker context." << std::endl;
+    }
+
     if (mSwapInterval != -1)
     {
-        eglSwapInterval(mDisplay, mSwapInterval);
+        // Keep the interval that is actually in effect, EGL clamps it to the config's range
+        EGLint minInterval = mSwapInterval;
+        EGLint maxInterval = mSwapInterval;
+        eglGetConfigAttrib(mDisplay, mConfig, EGL_MIN_SWAP_INTERVAL, &minInterval);
+        eglGetConfigAttrib(mDisplay, mConfig, EGL_MAX_SWAP_INTERVAL, &maxInterval);
+        if (eglSwapInterval(mDisplay, mSwapInterval) == EGL_TRUE)
+        {
+            mSwapInterval = std::min(std::max<EGLint>(mSwapInterval, minInterval), maxInterval);
+        }
+        else
+        {
+            mSwapInterval = -1;
+        }
+    }
+
+    return true;
+}
+
+bool EGLWindow::initializeWorkerContext()
+{
+    mWorkerContext = createContext(mContext);
+    if (mWorkerContext == EGL_NO_CONTEXT)
+    {
+        eglGetError();
+        return false;
+    }
+
+    const char *displayExtensions = eglQueryString(mDisplay, EGL_EXTENSIONS);
+    if (strstr(displayExtensions, "EGL_KHR_surfaceless_context") == nullptr)
+    {
+        const EGLint pbufferAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        mWorkerSurface = eglCreatePbufferSurface(mDisplay, mConfig, pbufferAttributes);
+        if (mWorkerSurface == EGL_NO_SURFACE)
+        {
+            eglGetError();
+            eglDestroyContext(mDisplay, mWorkerContext);
+            mWorkerContext = EGL_NO_CONTEXT;
+            return false;
+        }
     }
 
     return true;
 }
 
+bool EGLWindow::makeWorkerCurrent()
+{
+    if (mWorkerContext == EGL_NO_CONTEXT)
+    {
+        return false;
+    }
+    return eglMakeCurrent(mDisplay, mWorkerSurface, mWorkerSurface, mWorkerContext) == EGL_TRUE;
+}
+
+void EGLWindow::releaseWorkerContext()
+{
+    eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
 void EGLWindow::destroyGL()
 {
+    if (mWorkerSurface != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(mDisplay, mWorkerSurface);
+        mWorkerSurface = EGL_NO_SURFACE;
+    }
+
+    if (mWorkerContext != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(mDisplay, mWorkerContext);
+        mWorkerContext = EGL_NO_CONTEXT;
+    }
+
     if (mSurface != EGL_NO_SURFACE)
     {
         assert(mDisplay != EGL_NO_DISPLAY);
@@ -500,11 +662,13 @@ void EGLWindow::destroyGL()
         eglTerminate(mDisplay);
         mDisplay = EGL_NO_DISPLAY;
     }
+    mSurfaceless = false;
 }
 
 bool EGLWindow::isGLInitialized() const
 {
-    return mSurface != EGL_NO_SURFACE && mContext != EGL_NO_CONTEXT && mDisplay != EGL_NO_DISPLAY;
+    return (mSurface != EGL_NO_SURFACE || mSurfaceless) && mContext != EGL_NO_CONTEXT &&
+           mDisplay != EGL_NO_DISPLAY;
 }
 
 // Find an EGLConfig that is an exact match for the specified attributes. EGL_FALSE is returned if
@@ -528,6 +692,13 @@ EGLBoolean EGLWindow::FindEGLConfig(EGLDisplay dpy, const EGLint *attrib_list, E
 
             EGLint actualValue = EGL_DONT_CARE;
             eglGetConfigAttrib(dpy, allConfigs[i], curAttrib[0], &actualValue);
+
+            // Surface types are a bitmask, the requested bits only need to be present
+            if (curAttrib[0] == EGL_SURFACE_TYPE)
+            {
+                actualValue &= curAttrib[1];
+            }
+
             if (curAttrib[1] != actualValue)
             {
                 matchFound = false;
@@ -46,6 +46,7 @@ class ANGLE_UTIL_EXPORT GLWindowBase : angle::NonCopyable
     int getConfigAlphaBits() const { return mAlphaBits; }
     int getConfigDepthBits() const { return mDepthBits; }
     int getConfigStencilBits() const { return mStencilBits; }
+    // After initialization, the interval in effect or -1 when it could not be set
     int getSwapInterval() const { return mSwapInterval; }
     void setPlatformMethods(angle::PlatformMethods *platformMethods)
     {
@@ -129,12 +130,36 @@ class ANGLE_UTIL_EXPORT EGLWindow : public GLWindowBase
     // Only initializes the Display and Surface.
     bool initializeDisplayAndSurface(OSWindow *osWindow, angle::Library *glWindowingLibrary);
 
+    // Initializes the Display, a pbuffer Surface of the given size and the Context without a
+    // native window. Falls back to a surfaceless context (EGL_KHR_surfaceless_context), in
+    // which case the caller has to render into its own framebuffer object.
+    bool initializeHeadlessGL(EGLint width, EGLint height, angle::Library *glWindowingLibrary);
+    bool isSurfaceless() const { return mSurfaceless; }
+
     // Create an EGL context with this window's configuration
     EGLContext createContext(EGLContext share) const;
 
+    // Second context in the same share group for a loader thread, created along with the
+    // main context when enabled beforehand. It only gets a surface of its own when the
+    // display lacks EGL_KHR_surfaceless_context. Initialization does not fail without it.
+    void setWorkerContextEnabled(bool enabled) { mWorkerContextEnabled = enabled; }
+    bool hasWorkerContext() const { return mWorkerContext != EGL_NO_CONTEXT; }
+
+    // Binds the worker context to, or releases it from, the calling thread
+    bool makeWorkerCurrent();
+    void releaseWorkerContext();
+
     // Only initializes the Context.
     bool initializeContext();
 
+    // With the util loader, initialization points the GLES entry points at stubs that resolve
+    // on first call (angle::LoadGLESLazy) instead of resolving all of them up front
+    void setLazyGLESLoading(bool lazy) { mLazyGLESLoading = lazy; }
+    bool isLazyGLESLoading() const { return mLazyGLESLoading; }
+
+    // Wall time initialization spent loading the GLES entry points, in milliseconds
+    double getGLESLoadTime() const { return mGLESLoadTime; }
+
     void destroyGL() override;
     bool isGLInitialized() const override;
     void makeCurrent() override;
@@ -149,6 +174,11 @@ class ANGLE_UTIL_EXPORT EGLWindow : public GLWindowBase
 
     ~EGLWindow() override;
 
+    bool initializeDisplay(EGLNativeDisplayType nativeDisplay, angle::Library *glWindowingLibrary);
+    bool initializeConfig(EGLint surfaceType);
+    void loadGLES();
+    bool initializeWorkerContext();
+
     EGLConfig mConfig;
     EGLDisplay mDisplay;
     EGLSurface mSurface;
@@ -169,6 +199,13 @@ class ANGLE_UTIL_EXPORT EGLWindow : public GLWindowBase
     Optional<bool> mDebugLayersEnabled;
     Optional<bool> mContextProgramCacheEnabled;
     Optional<bool> mContextVirtualization;
+    bool mSurfaceless;
+    bool mLazyGLESLoading;
+    double mGLESLoadTime;
+
+    bool mWorkerContextEnabled;
+    EGLContext mWorkerContext;
+    EGLSurface mWorkerSurface;
 };
 
 ANGLE_UTIL_EXPORT bool CheckExtensionExists(const char *allExtensions, const std::string &extName);
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// EventQueue.h: Fixed capacity single producer, single consumer queue of window events.
+
+#ifndef UTIL_EVENT_QUEUE_H
+#define UTIL_EVENT_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#include "util/Event.h"
+
+// One thread pushes, one thread pops, which may be the same thread. Neither ever allocates
+// or blocks: push() drops the event and counts it when the queue is full.
+//
+// The indices only grow, the slot is the index modulo the capacity. Each side owns one index
+// and publishes it with a release store once the slot is written or read, so the other side
+// sees the slot contents whenever it sees the index move.
+class EventQueue
+{
+  public:
+    static constexpr size_t kCapacity = 256;
+
+    EventQueue() : mHead(0), mTail(0), mDropped(0) {}
+
+    // Producer
+    bool push(const Event &event)
+    {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == kCapacity)
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        mEvents[tail % kCapacity] = event;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer
+    bool pop(Event *event)
+    {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        *event = mEvents[head % kCapacity];
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+    }
+
+    uint64_t getDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+  private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    // On separate cache lines so the two threads do not contend for them
+    alignas(64) std::atomic<size_t> mHead;
+    alignas(64) std::atomic<size_t> mTail;
+    std::atomic<uint64_t> mDropped;
+    Event mEvents[kCapacity];
+};
+
+#endif  // UTIL_EVENT_QUEUE_H
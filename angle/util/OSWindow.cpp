@@ -376,18 +376,14 @@ bool OSWindow::takeScreenshot(uint8_t *pixelData)
     return false;
 }
 
+bool OSWindow::setThreadedInput(bool threaded)
+{
+    return false;
+}
+
 bool OSWindow::popEvent(Event *event)
 {
-    if (mEvents.size() > 0 && event)
-    {
-        *event = mEvents.front();
-        mEvents.pop_front();
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    return event && mEvents.pop(event);
 }
 
 void OSWindow::pushEvent(Event event)
@@ -406,13 +402,18 @@ void OSWindow::pushEvent(Event event)
             break;
     }
 
-    mEvents.push_back(event);
+    mEvents.push(event);
 
 #if DEBUG_EVENTS
     PrintEvent(event);
 #endif
 }
 
+uint64_t OSWindow::getDroppedEventCount() const
+{
+    return mEvents.getDroppedCount();
+}
+
 bool OSWindow::didTestEventFire()
 {
     Event topEvent;
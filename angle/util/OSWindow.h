@@ -10,13 +10,14 @@
 #define UTIL_OSWINDOW_H_
 
 #include <stdint.h>
-#include <list>
+#include <atomic>
 #include <string>
 
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 
 #include "util/Event.h"
+#include "util/EventQueue.h"
 #include "util/util_export.h"
 
 class ANGLE_UTIL_EXPORT OSWindow
@@ -44,9 +45,18 @@ class ANGLE_UTIL_EXPORT OSWindow
 
     virtual void messageLoop() = 0;
 
+    // Call before initialize(). With threaded input a platform thread reads the native events
+    // and pushes them, and messageLoop() has nothing left to do. Returns false when the
+    // platform has no input thread, events are then read by messageLoop() as usual.
+    virtual bool setThreadedInput(bool threaded);
+
+    // Only one thread may pop, and only one other may push
     bool popEvent(Event *event);
     virtual void pushEvent(Event event);
 
+    // Events lost because the queue was full
+    uint64_t getDroppedEventCount() const;
+
     virtual void setMousePosition(int x, int y) = 0;
     virtual bool setPosition(int x, int y)      = 0;
     virtual bool resize(int width, int height)  = 0;
@@ -62,12 +72,13 @@ class ANGLE_UTIL_EXPORT OSWindow
     virtual ~OSWindow();
     friend ANGLE_UTIL_EXPORT void FreeOSWindow(OSWindow *window);
 
-    int mX;
-    int mY;
-    int mWidth;
-    int mHeight;
+    // Written by the thread that pushes events, read from any thread
+    std::atomic<int> mX;
+    std::atomic<int> mY;
+    std::atomic<int> mWidth;
+    std::atomic<int> mHeight;
 
-    std::list<Event> mEvents;
+    EventQueue mEvents;
 };
 
 #endif  // UTIL_OSWINDOW_H_
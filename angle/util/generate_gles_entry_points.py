@@ -0,0 +1,76 @@
+#!/usr/bin/python
+#
+# Copyright 2019 The ANGLE Project Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+# generate_gles_entry_points.py:
+#   Generates gles_entry_points_autogen.h from the entry points angle::LoadGLES() in
+#   gles_loader_autogen.cpp resolves. Run it from any directory after the loader changes.
+
+import os
+import re
+import sys
+
+template_header = """// GENERATED FILE - DO NOT EDIT.
+// Generated by {script_name} from the entry points angle::LoadGLES() in
+// {loader_name} resolves.
+//
+// Copyright 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// {file_name}:
+//   X-macro list of every GLES entry point of the loader, as (PFN type, name).
+
+#ifndef UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
+#define UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
+
+#define ANGLE_GLES_ENTRY_POINTS(X) \\
+{entry_points}
+
+#endif  // UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
+"""
+
+# glAlphaFunc = reinterpret_cast<PFNGLALPHAFUNCPROC>(loadProc("glAlphaFunc"));
+# clang-format may break the line after the '='.
+load_pattern = re.compile(r'(\w+)\s*=\s*reinterpret_cast<(\w+)>\(\s*loadProc\("(\w+)"\)\);')
+
+
+def main():
+    util_dir = os.path.dirname(os.path.abspath(__file__))
+    loader_name = 'gles_loader_autogen.cpp'
+    file_name = 'gles_entry_points_autogen.h'
+
+    with open(os.path.join(util_dir, loader_name)) as loader_file:
+        loader = loader_file.read()
+
+    body_start = loader.find('void LoadGLES(LoadProc loadProc)')
+    if body_start < 0:
+        sys.stderr.write('LoadGLES not found in %s\n' % loader_name)
+        return 1
+    body = loader[body_start:loader.find('\n}', body_start)]
+
+    entry_points = []
+    for variable, pfn_type, name in load_pattern.findall(body):
+        if variable != name:
+            sys.stderr.write('%s is loaded as "%s"\n' % (variable, name))
+            return 1
+        entry_points.append('    X(%s, %s)' % (pfn_type, name))
+
+    if not entry_points:
+        sys.stderr.write('No entry points found in %s\n' % loader_name)
+        return 1
+
+    with open(os.path.join(util_dir, file_name), 'w') as out_file:
+        out_file.write(
+            template_header.format(
+                script_name=os.path.basename(__file__),
+                loader_name=loader_name,
+                file_name=file_name,
+                entry_points=' \\\n'.join(entry_points)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
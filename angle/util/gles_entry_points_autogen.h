@@ -0,0 +1,1261 @@
+// GENERATED FILE - DO NOT EDIT.
+// Generated by generate_gles_entry_points.py from the entry points angle::LoadGLES() in
+// gles_loader_autogen.cpp resolves.
+//
+// Copyright 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// gles_entry_points_autogen.h:
+//   X-macro list of every GLES entry point of the loader, as (PFN type, name).
+
+#ifndef UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
+#define UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
+
+#define ANGLE_GLES_ENTRY_POINTS(X) \
+    X(PFNGLALPHAFUNCPROC, glAlphaFunc) \
+    X(PFNGLCLIPPLANEFPROC, glClipPlanef) \
+    X(PFNGLCOLOR4FPROC, glColor4f) \
+    X(PFNGLFOGFPROC, glFogf) \
+    X(PFNGLFOGFVPROC, glFogfv) \
+    X(PFNGLFRUSTUMFPROC, glFrustumf) \
+    X(PFNGLGETCLIPPLANEFPROC, glGetClipPlanef) \
+    X(PFNGLGETLIGHTFVPROC, glGetLightfv) \
+    X(PFNGLGETMATERIALFVPROC, glGetMaterialfv) \
+    X(PFNGLGETTEXENVFVPROC, glGetTexEnvfv) \
+    X(PFNGLLIGHTMODELFPROC, glLightModelf) \
+    X(PFNGLLIGHTMODELFVPROC, glLightModelfv) \
+    X(PFNGLLIGHTFPROC, glLightf) \
+    X(PFNGLLIGHTFVPROC, glLightfv) \
+    X(PFNGLLOADMATRIXFPROC, glLoadMatrixf) \
+    X(PFNGLMATERIALFPROC, glMaterialf) \
+    X(PFNGLMATERIALFVPROC, glMaterialfv) \
+    X(PFNGLMULTMATRIXFPROC, glMultMatrixf) \
+    X(PFNGLMULTITEXCOORD4FPROC, glMultiTexCoord4f) \
+    X(PFNGLNORMAL3FPROC, glNormal3f) \
+    X(PFNGLORTHOFPROC, glOrthof) \
+    X(PFNGLPOINTPARAMETERFPROC, glPointParameterf) \
+    X(PFNGLPOINTPARAMETERFVPROC, glPointParameterfv) \
+    X(PFNGLPOINTSIZEPROC, glPointSize) \
+    X(PFNGLROTATEFPROC, glRotatef) \
+    X(PFNGLSCALEFPROC, glScalef) \
+    X(PFNGLTEXENVFPROC, glTexEnvf) \
+    X(PFNGLTEXENVFVPROC, glTexEnvfv) \
+    X(PFNGLTRANSLATEFPROC, glTranslatef) \
+    X(PFNGLALPHAFUNCXPROC, glAlphaFuncx) \
+    X(PFNGLCLEARCOLORXPROC, glClearColorx) \
+    X(PFNGLCLEARDEPTHXPROC, glClearDepthx) \
+    X(PFNGLCLIENTACTIVETEXTUREPROC, glClientActiveTexture) \
+    X(PFNGLCLIPPLANEXPROC, glClipPlanex) \
+    X(PFNGLCOLOR4UBPROC, glColor4ub) \
+    X(PFNGLCOLOR4XPROC, glColor4x) \
+    X(PFNGLCOLORPOINTERPROC, glColorPointer) \
+    X(PFNGLDEPTHRANGEXPROC, glDepthRangex) \
+    X(PFNGLDISABLECLIENTSTATEPROC, glDisableClientState) \
+    X(PFNGLENABLECLIENTSTATEPROC, glEnableClientState) \
+    X(PFNGLFOGXPROC, glFogx) \
+    X(PFNGLFOGXVPROC, glFogxv) \
+    X(PFNGLFRUSTUMXPROC, glFrustumx) \
+    X(PFNGLGETCLIPPLANEXPROC, glGetClipPlanex) \
+    X(PFNGLGETFIXEDVPROC, glGetFixedv) \
+    X(PFNGLGETLIGHTXVPROC, glGetLightxv) \
+    X(PFNGLGETMATERIALXVPROC, glGetMaterialxv) \
+    X(PFNGLGETPOINTERVPROC, glGetPointerv) \
+    X(PFNGLGETTEXENVIVPROC, glGetTexEnviv) \
+    X(PFNGLGETTEXENVXVPROC, glGetTexEnvxv) \
+    X(PFNGLGETTEXPARAMETERXVPROC, glGetTexParameterxv) \
+    X(PFNGLLIGHTMODELXPROC, glLightModelx) \
+    X(PFNGLLIGHTMODELXVPROC, glLightModelxv) \
+    X(PFNGLLIGHTXPROC, glLightx) \
+    X(PFNGLLIGHTXVPROC, glLightxv) \
+    X(PFNGLLINEWIDTHXPROC, glLineWidthx) \
+    X(PFNGLLOADIDENTITYPROC, glLoadIdentity) \
+    X(PFNGLLOADMATRIXXPROC, glLoadMatrixx) \
+    X(PFNGLLOGICOPPROC, glLogicOp) \
+    X(PFNGLMATERIALXPROC, glMaterialx) \
+    X(PFNGLMATERIALXVPROC, glMaterialxv) \
+    X(PFNGLMATRIXMODEPROC, glMatrixMode) \
+    X(PFNGLMULTMATRIXXPROC, glMultMatrixx) \
+    X(PFNGLMULTITEXCOORD4XPROC, glMultiTexCoord4x) \
+    X(PFNGLNORMAL3XPROC, glNormal3x) \
+    X(PFNGLNORMALPOINTERPROC, glNormalPointer) \
+    X(PFNGLORTHOXPROC, glOrthox) \
+    X(PFNGLPOINTPARAMETERXPROC, glPointParameterx) \
+    X(PFNGLPOINTPARAMETERXVPROC, glPointParameterxv) \
+    X(PFNGLPOINTSIZEXPROC, glPointSizex) \
+    X(PFNGLPOLYGONOFFSETXPROC, glPolygonOffsetx) \
+    X(PFNGLPOPMATRIXPROC, glPopMatrix) \
+    X(PFNGLPUSHMATRIXPROC, glPushMatrix) \
+    X(PFNGLROTATEXPROC, glRotatex) \
+    X(PFNGLSAMPLECOVERAGEXPROC, glSampleCoveragex) \
+    X(PFNGLSCALEXPROC, glScalex) \
+    X(PFNGLSHADEMODELPROC, glShadeModel) \
+    X(PFNGLTEXCOORDPOINTERPROC, glTexCoordPointer) \
+    X(PFNGLTEXENVIPROC, glTexEnvi) \
+    X(PFNGLTEXENVXPROC, glTexEnvx) \
+    X(PFNGLTEXENVIVPROC, glTexEnviv) \
+    X(PFNGLTEXENVXVPROC, glTexEnvxv) \
+    X(PFNGLTEXPARAMETERXPROC, glTexParameterx) \
+    X(PFNGLTEXPARAMETERXVPROC, glTexParameterxv) \
+    X(PFNGLTRANSLATEXPROC, glTranslatex) \
+    X(PFNGLVERTEXPOINTERPROC, glVertexPointer) \
+    X(PFNGLACTIVETEXTUREPROC, glActiveTexture) \
+    X(PFNGLATTACHSHADERPROC, glAttachShader) \
+    X(PFNGLBINDATTRIBLOCATIONPROC, glBindAttribLocation) \
+    X(PFNGLBINDBUFFERPROC, glBindBuffer) \
+    X(PFNGLBINDFRAMEBUFFERPROC, glBindFramebuffer) \
+    X(PFNGLBINDRENDERBUFFERPROC, glBindRenderbuffer) \
+    X(PFNGLBINDTEXTUREPROC, glBindTexture) \
+    X(PFNGLBLENDCOLORPROC, glBlendColor) \
+    X(PFNGLBLENDEQUATIONPROC, glBlendEquation) \
+    X(PFNGLBLENDEQUATIONSEPARATEPROC, glBlendEquationSeparate) \
+    X(PFNGLBLENDFUNCPROC, glBlendFunc) \
+    X(PFNGLBLENDFUNCSEPARATEPROC, glBlendFuncSeparate) \
+    X(PFNGLBUFFERDATAPROC, glBufferData) \
+    X(PFNGLBUFFERSUBDATAPROC, glBufferSubData) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus) \
+    X(PFNGLCLEARPROC, glClear) \
+    X(PFNGLCLEARCOLORPROC, glClearColor) \
+    X(PFNGLCLEARDEPTHFPROC, glClearDepthf) \
+    X(PFNGLCLEARSTENCILPROC, glClearStencil) \
+    X(PFNGLCOLORMASKPROC, glColorMask) \
+    X(PFNGLCOMPILESHADERPROC, glCompileShader) \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DPROC, glCompressedTexImage2D) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, glCompressedTexSubImage2D) \
+    X(PFNGLCOPYTEXIMAGE2DPROC, glCopyTexImage2D) \
+    X(PFNGLCOPYTEXSUBIMAGE2DPROC, glCopyTexSubImage2D) \
+    X(PFNGLCREATEPROGRAMPROC, glCreateProgram) \
+    X(PFNGLCREATESHADERPROC, glCreateShader) \
+    X(PFNGLCULLFACEPROC, glCullFace) \
+    X(PFNGLDELETEBUFFERSPROC, glDeleteBuffers) \
+    X(PFNGLDELETEFRAMEBUFFERSPROC, glDeleteFramebuffers) \
+    X(PFNGLDELETEPROGRAMPROC, glDeleteProgram) \
+    X(PFNGLDELETERENDERBUFFERSPROC, glDeleteRenderbuffers) \
+    X(PFNGLDELETESHADERPROC, glDeleteShader) \
+    X(PFNGLDELETETEXTURESPROC, glDeleteTextures) \
+    X(PFNGLDEPTHFUNCPROC, glDepthFunc) \
+    X(PFNGLDEPTHMASKPROC, glDepthMask) \
+    X(PFNGLDEPTHRANGEFPROC, glDepthRangef) \
+    X(PFNGLDETACHSHADERPROC, glDetachShader) \
+    X(PFNGLDISABLEPROC, glDisable) \
+    X(PFNGLDISABLEVERTEXATTRIBARRAYPROC, glDisableVertexAttribArray) \
+    X(PFNGLDRAWARRAYSPROC, glDrawArrays) \
+    X(PFNGLDRAWELEMENTSPROC, glDrawElements) \
+    X(PFNGLENABLEPROC, glEnable) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, glEnableVertexAttribArray) \
+    X(PFNGLFINISHPROC, glFinish) \
+    X(PFNGLFLUSHPROC, glFlush) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glFramebufferRenderbuffer) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DPROC, glFramebufferTexture2D) \
+    X(PFNGLFRONTFACEPROC, glFrontFace) \
+    X(PFNGLGENBUFFERSPROC, glGenBuffers) \
+    X(PFNGLGENERATEMIPMAPPROC, glGenerateMipmap) \
+    X(PFNGLGENFRAMEBUFFERSPROC, glGenFramebuffers) \
+    X(PFNGLGENRENDERBUFFERSPROC, glGenRenderbuffers) \
+    X(PFNGLGENTEXTURESPROC, glGenTextures) \
+    X(PFNGLGETACTIVEATTRIBPROC, glGetActiveAttrib) \
+    X(PFNGLGETACTIVEUNIFORMPROC, glGetActiveUniform) \
+    X(PFNGLGETATTACHEDSHADERSPROC, glGetAttachedShaders) \
+    X(PFNGLGETATTRIBLOCATIONPROC, glGetAttribLocation) \
+    X(PFNGLGETBOOLEANVPROC, glGetBooleanv) \
+    X(PFNGLGETBUFFERPARAMETERIVPROC, glGetBufferParameteriv) \
+    X(PFNGLGETERRORPROC, glGetError) \
+    X(PFNGLGETFLOATVPROC, glGetFloatv) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC, glGetFramebufferAttachmentParameteriv) \
+    X(PFNGLGETINTEGERVPROC, glGetIntegerv) \
+    X(PFNGLGETPROGRAMIVPROC, glGetProgramiv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, glGetProgramInfoLog) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVPROC, glGetRenderbufferParameteriv) \
+    X(PFNGLGETSHADERIVPROC, glGetShaderiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, glGetShaderInfoLog) \
+    X(PFNGLGETSHADERPRECISIONFORMATPROC, glGetShaderPrecisionFormat) \
+    X(PFNGLGETSHADERSOURCEPROC, glGetShaderSource) \
+    X(PFNGLGETSTRINGPROC, glGetString) \
+    X(PFNGLGETTEXPARAMETERFVPROC, glGetTexParameterfv) \
+    X(PFNGLGETTEXPARAMETERIVPROC, glGetTexParameteriv) \
+    X(PFNGLGETUNIFORMFVPROC, glGetUniformfv) \
+    X(PFNGLGETUNIFORMIVPROC, glGetUniformiv) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation) \
+    X(PFNGLGETVERTEXATTRIBFVPROC, glGetVertexAttribfv) \
+    X(PFNGLGETVERTEXATTRIBIVPROC, glGetVertexAttribiv) \
+    X(PFNGLGETVERTEXATTRIBPOINTERVPROC, glGetVertexAttribPointerv) \
+    X(PFNGLHINTPROC, glHint) \
+    X(PFNGLISBUFFERPROC, glIsBuffer) \
+    X(PFNGLISENABLEDPROC, glIsEnabled) \
+    X(PFNGLISFRAMEBUFFERPROC, glIsFramebuffer) \
+    X(PFNGLISPROGRAMPROC, glIsProgram) \
+    X(PFNGLISRENDERBUFFERPROC, glIsRenderbuffer) \
+    X(PFNGLISSHADERPROC, glIsShader) \
+    X(PFNGLISTEXTUREPROC, glIsTexture) \
+    X(PFNGLLINEWIDTHPROC, glLineWidth) \
+    X(PFNGLLINKPROGRAMPROC, glLinkProgram) \
+    X(PFNGLPIXELSTOREIPROC, glPixelStorei) \
+    X(PFNGLPOLYGONOFFSETPROC, glPolygonOffset) \
+    X(PFNGLREADPIXELSPROC, glReadPixels) \
+    X(PFNGLRELEASESHADERCOMPILERPROC, glReleaseShaderCompiler) \
+    X(PFNGLRENDERBUFFERSTORAGEPROC, glRenderbufferStorage) \
+    X(PFNGLSAMPLECOVERAGEPROC, glSampleCoverage) \
+    X(PFNGLSCISSORPROC, glScissor) \
+    X(PFNGLSHADERBINARYPROC, glShaderBinary) \
+    X(PFNGLSHADERSOURCEPROC, glShaderSource) \
+    X(PFNGLSTENCILFUNCPROC, glStencilFunc) \
+    X(PFNGLSTENCILFUNCSEPARATEPROC, glStencilFuncSeparate) \
+    X(PFNGLSTENCILMASKPROC, glStencilMask) \
+    X(PFNGLSTENCILMASKSEPARATEPROC, glStencilMaskSeparate) \
+    X(PFNGLSTENCILOPPROC, glStencilOp) \
+    X(PFNGLSTENCILOPSEPARATEPROC, glStencilOpSeparate) \
+    X(PFNGLTEXIMAGE2DPROC, glTexImage2D) \
+    X(PFNGLTEXPARAMETERFPROC, glTexParameterf) \
+    X(PFNGLTEXPARAMETERFVPROC, glTexParameterfv) \
+    X(PFNGLTEXPARAMETERIPROC, glTexParameteri) \
+    X(PFNGLTEXPARAMETERIVPROC, glTexParameteriv) \
+    X(PFNGLTEXSUBIMAGE2DPROC, glTexSubImage2D) \
+    X(PFNGLUNIFORM1FPROC, glUniform1f) \
+    X(PFNGLUNIFORM1FVPROC, glUniform1fv) \
+    X(PFNGLUNIFORM1IPROC, glUniform1i) \
+    X(PFNGLUNIFORM1IVPROC, glUniform1iv) \
+    X(PFNGLUNIFORM2FPROC, glUniform2f) \
+    X(PFNGLUNIFORM2FVPROC, glUniform2fv) \
+    X(PFNGLUNIFORM2IPROC, glUniform2i) \
+    X(PFNGLUNIFORM2IVPROC, glUniform2iv) \
+    X(PFNGLUNIFORM3FPROC, glUniform3f) \
+    X(PFNGLUNIFORM3FVPROC, glUniform3fv) \
+    X(PFNGLUNIFORM3IPROC, glUniform3i) \
+    X(PFNGLUNIFORM3IVPROC, glUniform3iv) \
+    X(PFNGLUNIFORM4FPROC, glUniform4f) \
+    X(PFNGLUNIFORM4FVPROC, glUniform4fv) \
+    X(PFNGLUNIFORM4IPROC, glUniform4i) \
+    X(PFNGLUNIFORM4IVPROC, glUniform4iv) \
+    X(PFNGLUNIFORMMATRIX2FVPROC, glUniformMatrix2fv) \
+    X(PFNGLUNIFORMMATRIX3FVPROC, glUniformMatrix3fv) \
+    X(PFNGLUNIFORMMATRIX4FVPROC, glUniformMatrix4fv) \
+    X(PFNGLUSEPROGRAMPROC, glUseProgram) \
+    X(PFNGLVALIDATEPROGRAMPROC, glValidateProgram) \
+    X(PFNGLVERTEXATTRIB1FPROC, glVertexAttrib1f) \
+    X(PFNGLVERTEXATTRIB1FVPROC, glVertexAttrib1fv) \
+    X(PFNGLVERTEXATTRIB2FPROC, glVertexAttrib2f) \
+    X(PFNGLVERTEXATTRIB2FVPROC, glVertexAttrib2fv) \
+    X(PFNGLVERTEXATTRIB3FPROC, glVertexAttrib3f) \
+    X(PFNGLVERTEXATTRIB3FVPROC, glVertexAttrib3fv) \
+    X(PFNGLVERTEXATTRIB4FPROC, glVertexAttrib4f) \
+    X(PFNGLVERTEXATTRIB4FVPROC, glVertexAttrib4fv) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, glVertexAttribPointer) \
+    X(PFNGLVIEWPORTPROC, glViewport) \
+    X(PFNGLREADBUFFERPROC, glReadBuffer) \
+    X(PFNGLDRAWRANGEELEMENTSPROC, glDrawRangeElements) \
+    X(PFNGLTEXIMAGE3DPROC, glTexImage3D) \
+    X(PFNGLTEXSUBIMAGE3DPROC, glTexSubImage3D) \
+    X(PFNGLCOPYTEXSUBIMAGE3DPROC, glCopyTexSubImage3D) \
+    X(PFNGLCOMPRESSEDTEXIMAGE3DPROC, glCompressedTexImage3D) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC, glCompressedTexSubImage3D) \
+    X(PFNGLGENQUERIESPROC, glGenQueries) \
+    X(PFNGLDELETEQUERIESPROC, glDeleteQueries) \
+    X(PFNGLISQUERYPROC, glIsQuery) \
+    X(PFNGLBEGINQUERYPROC, glBeginQuery) \
+    X(PFNGLENDQUERYPROC, glEndQuery) \
+    X(PFNGLGETQUERYIVPROC, glGetQueryiv) \
+    X(PFNGLGETQUERYOBJECTUIVPROC, glGetQueryObjectuiv) \
+    X(PFNGLUNMAPBUFFERPROC, glUnmapBuffer) \
+    X(PFNGLGETBUFFERPOINTERVPROC, glGetBufferPointerv) \
+    X(PFNGLDRAWBUFFERSPROC, glDrawBuffers) \
+    X(PFNGLUNIFORMMATRIX2X3FVPROC, glUniformMatrix2x3fv) \
+    X(PFNGLUNIFORMMATRIX3X2FVPROC, glUniformMatrix3x2fv) \
+    X(PFNGLUNIFORMMATRIX2X4FVPROC, glUniformMatrix2x4fv) \
+    X(PFNGLUNIFORMMATRIX4X2FVPROC, glUniformMatrix4x2fv) \
+    X(PFNGLUNIFORMMATRIX3X4FVPROC, glUniformMatrix3x4fv) \
+    X(PFNGLUNIFORMMATRIX4X3FVPROC, glUniformMatrix4x3fv) \
+    X(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer) \
+    X(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, glRenderbufferStorageMultisample) \
+    X(PFNGLFRAMEBUFFERTEXTURELAYERPROC, glFramebufferTextureLayer) \
+    X(PFNGLMAPBUFFERRANGEPROC, glMapBufferRange) \
+    X(PFNGLFLUSHMAPPEDBUFFERRANGEPROC, glFlushMappedBufferRange) \
+    X(PFNGLBINDVERTEXARRAYPROC, glBindVertexArray) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, glDeleteVertexArrays) \
+    X(PFNGLGENVERTEXARRAYSPROC, glGenVertexArrays) \
+    X(PFNGLISVERTEXARRAYPROC, glIsVertexArray) \
+    X(PFNGLGETINTEGERI_VPROC, glGetIntegeri_v) \
+    X(PFNGLBEGINTRANSFORMFEEDBACKPROC, glBeginTransformFeedback) \
+    X(PFNGLENDTRANSFORMFEEDBACKPROC, glEndTransformFeedback) \
+    X(PFNGLBINDBUFFERRANGEPROC, glBindBufferRange) \
+    X(PFNGLBINDBUFFERBASEPROC, glBindBufferBase) \
+    X(PFNGLTRANSFORMFEEDBACKVARYINGSPROC, glTransformFeedbackVaryings) \
+    X(PFNGLGETTRANSFORMFEEDBACKVARYINGPROC, glGetTransformFeedbackVarying) \
+    X(PFNGLVERTEXATTRIBIPOINTERPROC, glVertexAttribIPointer) \
+    X(PFNGLGETVERTEXATTRIBIIVPROC, glGetVertexAttribIiv) \
+    X(PFNGLGETVERTEXATTRIBIUIVPROC, glGetVertexAttribIuiv) \
+    X(PFNGLVERTEXATTRIBI4IPROC, glVertexAttribI4i) \
+    X(PFNGLVERTEXATTRIBI4UIPROC, glVertexAttribI4ui) \
+    X(PFNGLVERTEXATTRIBI4IVPROC, glVertexAttribI4iv) \
+    X(PFNGLVERTEXATTRIBI4UIVPROC, glVertexAttribI4uiv) \
+    X(PFNGLGETUNIFORMUIVPROC, glGetUniformuiv) \
+    X(PFNGLGETFRAGDATALOCATIONPROC, glGetFragDataLocation) \
+    X(PFNGLUNIFORM1UIPROC, glUniform1ui) \
+    X(PFNGLUNIFORM2UIPROC, glUniform2ui) \
+    X(PFNGLUNIFORM3UIPROC, glUniform3ui) \
+    X(PFNGLUNIFORM4UIPROC, glUniform4ui) \
+    X(PFNGLUNIFORM1UIVPROC, glUniform1uiv) \
+    X(PFNGLUNIFORM2UIVPROC, glUniform2uiv) \
+    X(PFNGLUNIFORM3UIVPROC, glUniform3uiv) \
+    X(PFNGLUNIFORM4UIVPROC, glUniform4uiv) \
+    X(PFNGLCLEARBUFFERIVPROC, glClearBufferiv) \
+    X(PFNGLCLEARBUFFERUIVPROC, glClearBufferuiv) \
+    X(PFNGLCLEARBUFFERFVPROC, glClearBufferfv) \
+    X(PFNGLCLEARBUFFERFIPROC, glClearBufferfi) \
+    X(PFNGLGETSTRINGIPROC, glGetStringi) \
+    X(PFNGLCOPYBUFFERSUBDATAPROC, glCopyBufferSubData) \
+    X(PFNGLGETUNIFORMINDICESPROC, glGetUniformIndices) \
+    X(PFNGLGETACTIVEUNIFORMSIVPROC, glGetActiveUniformsiv) \
+    X(PFNGLGETUNIFORMBLOCKINDEXPROC, glGetUniformBlockIndex) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKIVPROC, glGetActiveUniformBlockiv) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC, glGetActiveUniformBlockName) \
+    X(PFNGLUNIFORMBLOCKBINDINGPROC, glUniformBlockBinding) \
+    X(PFNGLDRAWARRAYSINSTANCEDPROC, glDrawArraysInstanced) \
+    X(PFNGLDRAWELEMENTSINSTANCEDPROC, glDrawElementsInstanced) \
+    X(PFNGLFENCESYNCPROC, glFenceSync) \
+    X(PFNGLISSYNCPROC, glIsSync) \
+    X(PFNGLDELETESYNCPROC, glDeleteSync) \
+    X(PFNGLCLIENTWAITSYNCPROC, glClientWaitSync) \
+    X(PFNGLWAITSYNCPROC, glWaitSync) \
+    X(PFNGLGETINTEGER64VPROC, glGetInteger64v) \
+    X(PFNGLGETSYNCIVPROC, glGetSynciv) \
+    X(PFNGLGETINTEGER64I_VPROC, glGetInteger64i_v) \
+    X(PFNGLGETBUFFERPARAMETERI64VPROC, glGetBufferParameteri64v) \
+    X(PFNGLGENSAMPLERSPROC, glGenSamplers) \
+    X(PFNGLDELETESAMPLERSPROC, glDeleteSamplers) \
+    X(PFNGLISSAMPLERPROC, glIsSampler) \
+    X(PFNGLBINDSAMPLERPROC, glBindSampler) \
+    X(PFNGLSAMPLERPARAMETERIPROC, glSamplerParameteri) \
+    X(PFNGLSAMPLERPARAMETERIVPROC, glSamplerParameteriv) \
+    X(PFNGLSAMPLERPARAMETERFPROC, glSamplerParameterf) \
+    X(PFNGLSAMPLERPARAMETERFVPROC, glSamplerParameterfv) \
+    X(PFNGLGETSAMPLERPARAMETERIVPROC, glGetSamplerParameteriv) \
+    X(PFNGLGETSAMPLERPARAMETERFVPROC, glGetSamplerParameterfv) \
+    X(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor) \
+    X(PFNGLBINDTRANSFORMFEEDBACKPROC, glBindTransformFeedback) \
+    X(PFNGLDELETETRANSFORMFEEDBACKSPROC, glDeleteTransformFeedbacks) \
+    X(PFNGLGENTRANSFORMFEEDBACKSPROC, glGenTransformFeedbacks) \
+    X(PFNGLISTRANSFORMFEEDBACKPROC, glIsTransformFeedback) \
+    X(PFNGLPAUSETRANSFORMFEEDBACKPROC, glPauseTransformFeedback) \
+    X(PFNGLRESUMETRANSFORMFEEDBACKPROC, glResumeTransformFeedback) \
+    X(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary) \
+    X(PFNGLPROGRAMBINARYPROC, glProgramBinary) \
+    X(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri) \
+    X(PFNGLINVALIDATEFRAMEBUFFERPROC, glInvalidateFramebuffer) \
+    X(PFNGLINVALIDATESUBFRAMEBUFFERPROC, glInvalidateSubFramebuffer) \
+    X(PFNGLTEXSTORAGE2DPROC, glTexStorage2D) \
+    X(PFNGLTEXSTORAGE3DPROC, glTexStorage3D) \
+    X(PFNGLGETINTERNALFORMATIVPROC, glGetInternalformativ) \
+    X(PFNGLDISPATCHCOMPUTEPROC, glDispatchCompute) \
+    X(PFNGLDISPATCHCOMPUTEINDIRECTPROC, glDispatchComputeIndirect) \
+    X(PFNGLDRAWARRAYSINDIRECTPROC, glDrawArraysIndirect) \
+    X(PFNGLDRAWELEMENTSINDIRECTPROC, glDrawElementsIndirect) \
+    X(PFNGLFRAMEBUFFERPARAMETERIPROC, glFramebufferParameteri) \
+    X(PFNGLGETFRAMEBUFFERPARAMETERIVPROC, glGetFramebufferParameteriv) \
+    X(PFNGLGETPROGRAMINTERFACEIVPROC, glGetProgramInterfaceiv) \
+    X(PFNGLGETPROGRAMRESOURCEINDEXPROC, glGetProgramResourceIndex) \
+    X(PFNGLGETPROGRAMRESOURCENAMEPROC, glGetProgramResourceName) \
+    X(PFNGLGETPROGRAMRESOURCEIVPROC, glGetProgramResourceiv) \
+    X(PFNGLGETPROGRAMRESOURCELOCATIONPROC, glGetProgramResourceLocation) \
+    X(PFNGLUSEPROGRAMSTAGESPROC, glUseProgramStages) \
+    X(PFNGLACTIVESHADERPROGRAMPROC, glActiveShaderProgram) \
+    X(PFNGLCREATESHADERPROGRAMVPROC, glCreateShaderProgramv) \
+    X(PFNGLBINDPROGRAMPIPELINEPROC, glBindProgramPipeline) \
+    X(PFNGLDELETEPROGRAMPIPELINESPROC, glDeleteProgramPipelines) \
+    X(PFNGLGENPROGRAMPIPELINESPROC, glGenProgramPipelines) \
+    X(PFNGLISPROGRAMPIPELINEPROC, glIsProgramPipeline) \
+    X(PFNGLGETPROGRAMPIPELINEIVPROC, glGetProgramPipelineiv) \
+    X(PFNGLPROGRAMUNIFORM1IPROC, glProgramUniform1i) \
+    X(PFNGLPROGRAMUNIFORM2IPROC, glProgramUniform2i) \
+    X(PFNGLPROGRAMUNIFORM3IPROC, glProgramUniform3i) \
+    X(PFNGLPROGRAMUNIFORM4IPROC, glProgramUniform4i) \
+    X(PFNGLPROGRAMUNIFORM1UIPROC, glProgramUniform1ui) \
+    X(PFNGLPROGRAMUNIFORM2UIPROC, glProgramUniform2ui) \
+    X(PFNGLPROGRAMUNIFORM3UIPROC, glProgramUniform3ui) \
+    X(PFNGLPROGRAMUNIFORM4UIPROC, glProgramUniform4ui) \
+    X(PFNGLPROGRAMUNIFORM1FPROC, glProgramUniform1f) \
+    X(PFNGLPROGRAMUNIFORM2FPROC, glProgramUniform2f) \
+    X(PFNGLPROGRAMUNIFORM3FPROC, glProgramUniform3f) \
+    X(PFNGLPROGRAMUNIFORM4FPROC, glProgramUniform4f) \
+    X(PFNGLPROGRAMUNIFORM1IVPROC, glProgramUniform1iv) \
+    X(PFNGLPROGRAMUNIFORM2IVPROC, glProgramUniform2iv) \
+    X(PFNGLPROGRAMUNIFORM3IVPROC, glProgramUniform3iv) \
+    X(PFNGLPROGRAMUNIFORM4IVPROC, glProgramUniform4iv) \
+    X(PFNGLPROGRAMUNIFORM1UIVPROC, glProgramUniform1uiv) \
+    X(PFNGLPROGRAMUNIFORM2UIVPROC, glProgramUniform2uiv) \
+    X(PFNGLPROGRAMUNIFORM3UIVPROC, glProgramUniform3uiv) \
+    X(PFNGLPROGRAMUNIFORM4UIVPROC, glProgramUniform4uiv) \
+    X(PFNGLPROGRAMUNIFORM1FVPROC, glProgramUniform1fv) \
+    X(PFNGLPROGRAMUNIFORM2FVPROC, glProgramUniform2fv) \
+    X(PFNGLPROGRAMUNIFORM3FVPROC, glProgramUniform3fv) \
+    X(PFNGLPROGRAMUNIFORM4FVPROC, glProgramUniform4fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2FVPROC, glProgramUniformMatrix2fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3FVPROC, glProgramUniformMatrix3fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4FVPROC, glProgramUniformMatrix4fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC, glProgramUniformMatrix2x3fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC, glProgramUniformMatrix3x2fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC, glProgramUniformMatrix2x4fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC, glProgramUniformMatrix4x2fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC, glProgramUniformMatrix3x4fv) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC, glProgramUniformMatrix4x3fv) \
+    X(PFNGLVALIDATEPROGRAMPIPELINEPROC, glValidateProgramPipeline) \
+    X(PFNGLGETPROGRAMPIPELINEINFOLOGPROC, glGetProgramPipelineInfoLog) \
+    X(PFNGLBINDIMAGETEXTUREPROC, glBindImageTexture) \
+    X(PFNGLGETBOOLEANI_VPROC, glGetBooleani_v) \
+    X(PFNGLMEMORYBARRIERPROC, glMemoryBarrier) \
+    X(PFNGLMEMORYBARRIERBYREGIONPROC, glMemoryBarrierByRegion) \
+    X(PFNGLTEXSTORAGE2DMULTISAMPLEPROC, glTexStorage2DMultisample) \
+    X(PFNGLGETMULTISAMPLEFVPROC, glGetMultisamplefv) \
+    X(PFNGLSAMPLEMASKIPROC, glSampleMaski) \
+    X(PFNGLGETTEXLEVELPARAMETERIVPROC, glGetTexLevelParameteriv) \
+    X(PFNGLGETTEXLEVELPARAMETERFVPROC, glGetTexLevelParameterfv) \
+    X(PFNGLBINDVERTEXBUFFERPROC, glBindVertexBuffer) \
+    X(PFNGLVERTEXATTRIBFORMATPROC, glVertexAttribFormat) \
+    X(PFNGLVERTEXATTRIBIFORMATPROC, glVertexAttribIFormat) \
+    X(PFNGLVERTEXATTRIBBINDINGPROC, glVertexAttribBinding) \
+    X(PFNGLVERTEXBINDINGDIVISORPROC, glVertexBindingDivisor) \
+    X(PFNGLCOPYSUBTEXTURE3DANGLEPROC, glCopySubTexture3DANGLE) \
+    X(PFNGLCOPYTEXTURE3DANGLEPROC, glCopyTexture3DANGLE) \
+    X(PFNGLBLITFRAMEBUFFERANGLEPROC, glBlitFramebufferANGLE) \
+    X(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEANGLEPROC, glRenderbufferStorageMultisampleANGLE) \
+    X(PFNGLDRAWARRAYSINSTANCEDANGLEPROC, glDrawArraysInstancedANGLE) \
+    X(PFNGLDRAWELEMENTSINSTANCEDANGLEPROC, glDrawElementsInstancedANGLE) \
+    X(PFNGLVERTEXATTRIBDIVISORANGLEPROC, glVertexAttribDivisorANGLE) \
+    X(PFNGLMULTIDRAWARRAYSANGLEPROC, glMultiDrawArraysANGLE) \
+    X(PFNGLMULTIDRAWARRAYSINSTANCEDANGLEPROC, glMultiDrawArraysInstancedANGLE) \
+    X(PFNGLMULTIDRAWELEMENTSANGLEPROC, glMultiDrawElementsANGLE) \
+    X(PFNGLMULTIDRAWELEMENTSINSTANCEDANGLEPROC, glMultiDrawElementsInstancedANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWLAYEREDANGLEPROC, glFramebufferTextureMultiviewLayeredANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWSIDEBYSIDEANGLEPROC, glFramebufferTextureMultiviewSideBySideANGLE) \
+    X(PFNGLPROVOKINGVERTEXANGLEPROC, glProvokingVertexANGLE) \
+    X(PFNGLREQUESTEXTENSIONANGLEPROC, glRequestExtensionANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DROBUSTANGLEPROC, glCompressedTexImage2DRobustANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE3DROBUSTANGLEPROC, glCompressedTexImage3DRobustANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE2DROBUSTANGLEPROC, glCompressedTexSubImage2DRobustANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE3DROBUSTANGLEPROC, glCompressedTexSubImage3DRobustANGLE) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKIVROBUSTANGLEPROC, glGetActiveUniformBlockivRobustANGLE) \
+    X(PFNGLGETBOOLEANI_VROBUSTANGLEPROC, glGetBooleani_vRobustANGLE) \
+    X(PFNGLGETBOOLEANVROBUSTANGLEPROC, glGetBooleanvRobustANGLE) \
+    X(PFNGLGETBUFFERPARAMETERI64VROBUSTANGLEPROC, glGetBufferParameteri64vRobustANGLE) \
+    X(PFNGLGETBUFFERPARAMETERIVROBUSTANGLEPROC, glGetBufferParameterivRobustANGLE) \
+    X(PFNGLGETBUFFERPOINTERVROBUSTANGLEPROC, glGetBufferPointervRobustANGLE) \
+    X(PFNGLGETFLOATVROBUSTANGLEPROC, glGetFloatvRobustANGLE) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVROBUSTANGLEPROC, glGetFramebufferAttachmentParameterivRobustANGLE) \
+    X(PFNGLGETFRAMEBUFFERPARAMETERIVROBUSTANGLEPROC, glGetFramebufferParameterivRobustANGLE) \
+    X(PFNGLGETINTEGER64I_VROBUSTANGLEPROC, glGetInteger64i_vRobustANGLE) \
+    X(PFNGLGETINTEGER64VROBUSTANGLEPROC, glGetInteger64vRobustANGLE) \
+    X(PFNGLGETINTEGERI_VROBUSTANGLEPROC, glGetIntegeri_vRobustANGLE) \
+    X(PFNGLGETINTEGERVROBUSTANGLEPROC, glGetIntegervRobustANGLE) \
+    X(PFNGLGETINTERNALFORMATIVROBUSTANGLEPROC, glGetInternalformativRobustANGLE) \
+    X(PFNGLGETMULTISAMPLEFVROBUSTANGLEPROC, glGetMultisamplefvRobustANGLE) \
+    X(PFNGLGETPOINTERVROBUSTANGLEROBUSTANGLEPROC, glGetPointervRobustANGLERobustANGLE) \
+    X(PFNGLGETPROGRAMINTERFACEIVROBUSTANGLEPROC, glGetProgramInterfaceivRobustANGLE) \
+    X(PFNGLGETPROGRAMIVROBUSTANGLEPROC, glGetProgramivRobustANGLE) \
+    X(PFNGLGETQUERYOBJECTI64VROBUSTANGLEPROC, glGetQueryObjecti64vRobustANGLE) \
+    X(PFNGLGETQUERYOBJECTIVROBUSTANGLEPROC, glGetQueryObjectivRobustANGLE) \
+    X(PFNGLGETQUERYOBJECTUI64VROBUSTANGLEPROC, glGetQueryObjectui64vRobustANGLE) \
+    X(PFNGLGETQUERYOBJECTUIVROBUSTANGLEPROC, glGetQueryObjectuivRobustANGLE) \
+    X(PFNGLGETQUERYIVROBUSTANGLEPROC, glGetQueryivRobustANGLE) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVROBUSTANGLEPROC, glGetRenderbufferParameterivRobustANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIIVROBUSTANGLEPROC, glGetSamplerParameterIivRobustANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIUIVROBUSTANGLEPROC, glGetSamplerParameterIuivRobustANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERFVROBUSTANGLEPROC, glGetSamplerParameterfvRobustANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIVROBUSTANGLEPROC, glGetSamplerParameterivRobustANGLE) \
+    X(PFNGLGETSHADERIVROBUSTANGLEPROC, glGetShaderivRobustANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERFVROBUSTANGLEPROC, glGetTexLevelParameterfvRobustANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERIVROBUSTANGLEPROC, glGetTexLevelParameterivRobustANGLE) \
+    X(PFNGLGETTEXPARAMETERIIVROBUSTANGLEPROC, glGetTexParameterIivRobustANGLE) \
+    X(PFNGLGETTEXPARAMETERIUIVROBUSTANGLEPROC, glGetTexParameterIuivRobustANGLE) \
+    X(PFNGLGETTEXPARAMETERFVROBUSTANGLEPROC, glGetTexParameterfvRobustANGLE) \
+    X(PFNGLGETTEXPARAMETERIVROBUSTANGLEPROC, glGetTexParameterivRobustANGLE) \
+    X(PFNGLGETUNIFORMFVROBUSTANGLEPROC, glGetUniformfvRobustANGLE) \
+    X(PFNGLGETUNIFORMIVROBUSTANGLEPROC, glGetUniformivRobustANGLE) \
+    X(PFNGLGETUNIFORMUIVROBUSTANGLEPROC, glGetUniformuivRobustANGLE) \
+    X(PFNGLGETVERTEXATTRIBIIVROBUSTANGLEPROC, glGetVertexAttribIivRobustANGLE) \
+    X(PFNGLGETVERTEXATTRIBIUIVROBUSTANGLEPROC, glGetVertexAttribIuivRobustANGLE) \
+    X(PFNGLGETVERTEXATTRIBPOINTERVROBUSTANGLEPROC, glGetVertexAttribPointervRobustANGLE) \
+    X(PFNGLGETVERTEXATTRIBFVROBUSTANGLEPROC, glGetVertexAttribfvRobustANGLE) \
+    X(PFNGLGETVERTEXATTRIBIVROBUSTANGLEPROC, glGetVertexAttribivRobustANGLE) \
+    X(PFNGLGETNUNIFORMFVROBUSTANGLEPROC, glGetnUniformfvRobustANGLE) \
+    X(PFNGLGETNUNIFORMIVROBUSTANGLEPROC, glGetnUniformivRobustANGLE) \
+    X(PFNGLGETNUNIFORMUIVROBUSTANGLEPROC, glGetnUniformuivRobustANGLE) \
+    X(PFNGLREADPIXELSROBUSTANGLEPROC, glReadPixelsRobustANGLE) \
+    X(PFNGLREADNPIXELSROBUSTANGLEPROC, glReadnPixelsRobustANGLE) \
+    X(PFNGLSAMPLERPARAMETERIIVROBUSTANGLEPROC, glSamplerParameterIivRobustANGLE) \
+    X(PFNGLSAMPLERPARAMETERIUIVROBUSTANGLEPROC, glSamplerParameterIuivRobustANGLE) \
+    X(PFNGLSAMPLERPARAMETERFVROBUSTANGLEPROC, glSamplerParameterfvRobustANGLE) \
+    X(PFNGLSAMPLERPARAMETERIVROBUSTANGLEPROC, glSamplerParameterivRobustANGLE) \
+    X(PFNGLTEXIMAGE2DROBUSTANGLEPROC, glTexImage2DRobustANGLE) \
+    X(PFNGLTEXIMAGE3DROBUSTANGLEPROC, glTexImage3DRobustANGLE) \
+    X(PFNGLTEXPARAMETERIIVROBUSTANGLEPROC, glTexParameterIivRobustANGLE) \
+    X(PFNGLTEXPARAMETERIUIVROBUSTANGLEPROC, glTexParameterIuivRobustANGLE) \
+    X(PFNGLTEXPARAMETERFVROBUSTANGLEPROC, glTexParameterfvRobustANGLE) \
+    X(PFNGLTEXPARAMETERIVROBUSTANGLEPROC, glTexParameterivRobustANGLE) \
+    X(PFNGLTEXSUBIMAGE2DROBUSTANGLEPROC, glTexSubImage2DRobustANGLE) \
+    X(PFNGLTEXSUBIMAGE3DROBUSTANGLEPROC, glTexSubImage3DRobustANGLE) \
+    X(PFNGLGETMULTISAMPLEFVANGLEPROC, glGetMultisamplefvANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERFVANGLEPROC, glGetTexLevelParameterfvANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERIVANGLEPROC, glGetTexLevelParameterivANGLE) \
+    X(PFNGLSAMPLEMASKIANGLEPROC, glSampleMaskiANGLE) \
+    X(PFNGLTEXSTORAGE2DMULTISAMPLEANGLEPROC, glTexStorage2DMultisampleANGLE) \
+    X(PFNGLGETTRANSLATEDSHADERSOURCEANGLEPROC, glGetTranslatedShaderSourceANGLE) \
+    X(PFNGLBINDUNIFORMLOCATIONCHROMIUMPROC, glBindUniformLocationCHROMIUM) \
+    X(PFNGLCOMPRESSEDCOPYTEXTURECHROMIUMPROC, glCompressedCopyTextureCHROMIUM) \
+    X(PFNGLCOPYSUBTEXTURECHROMIUMPROC, glCopySubTextureCHROMIUM) \
+    X(PFNGLCOPYTEXTURECHROMIUMPROC, glCopyTextureCHROMIUM) \
+    X(PFNGLCOVERAGEMODULATIONCHROMIUMPROC, glCoverageModulationCHROMIUM) \
+    X(PFNGLMATRIXLOADIDENTITYCHROMIUMPROC, glMatrixLoadIdentityCHROMIUM) \
+    X(PFNGLMATRIXLOADFCHROMIUMPROC, glMatrixLoadfCHROMIUM) \
+    X(PFNGLBINDFRAGMENTINPUTLOCATIONCHROMIUMPROC, glBindFragmentInputLocationCHROMIUM) \
+    X(PFNGLCOVERFILLPATHCHROMIUMPROC, glCoverFillPathCHROMIUM) \
+    X(PFNGLCOVERFILLPATHINSTANCEDCHROMIUMPROC, glCoverFillPathInstancedCHROMIUM) \
+    X(PFNGLCOVERSTROKEPATHCHROMIUMPROC, glCoverStrokePathCHROMIUM) \
+    X(PFNGLCOVERSTROKEPATHINSTANCEDCHROMIUMPROC, glCoverStrokePathInstancedCHROMIUM) \
+    X(PFNGLDELETEPATHSCHROMIUMPROC, glDeletePathsCHROMIUM) \
+    X(PFNGLGENPATHSCHROMIUMPROC, glGenPathsCHROMIUM) \
+    X(PFNGLGETPATHPARAMETERFVCHROMIUMPROC, glGetPathParameterfvCHROMIUM) \
+    X(PFNGLGETPATHPARAMETERIVCHROMIUMPROC, glGetPathParameterivCHROMIUM) \
+    X(PFNGLISPATHCHROMIUMPROC, glIsPathCHROMIUM) \
+    X(PFNGLPATHCOMMANDSCHROMIUMPROC, glPathCommandsCHROMIUM) \
+    X(PFNGLPATHPARAMETERFCHROMIUMPROC, glPathParameterfCHROMIUM) \
+    X(PFNGLPATHPARAMETERICHROMIUMPROC, glPathParameteriCHROMIUM) \
+    X(PFNGLPATHSTENCILFUNCCHROMIUMPROC, glPathStencilFuncCHROMIUM) \
+    X(PFNGLPROGRAMPATHFRAGMENTINPUTGENCHROMIUMPROC, glProgramPathFragmentInputGenCHROMIUM) \
+    X(PFNGLSTENCILFILLPATHCHROMIUMPROC, glStencilFillPathCHROMIUM) \
+    X(PFNGLSTENCILFILLPATHINSTANCEDCHROMIUMPROC, glStencilFillPathInstancedCHROMIUM) \
+    X(PFNGLSTENCILSTROKEPATHCHROMIUMPROC, glStencilStrokePathCHROMIUM) \
+    X(PFNGLSTENCILSTROKEPATHINSTANCEDCHROMIUMPROC, glStencilStrokePathInstancedCHROMIUM) \
+    X(PFNGLSTENCILTHENCOVERFILLPATHCHROMIUMPROC, glStencilThenCoverFillPathCHROMIUM) \
+    X(PFNGLSTENCILTHENCOVERFILLPATHINSTANCEDCHROMIUMPROC, glStencilThenCoverFillPathInstancedCHROMIUM) \
+    X(PFNGLSTENCILTHENCOVERSTROKEPATHCHROMIUMPROC, glStencilThenCoverStrokePathCHROMIUM) \
+    X(PFNGLSTENCILTHENCOVERSTROKEPATHINSTANCEDCHROMIUMPROC, glStencilThenCoverStrokePathInstancedCHROMIUM) \
+    X(PFNGLBINDFRAGDATALOCATIONEXTPROC, glBindFragDataLocationEXT) \
+    X(PFNGLBINDFRAGDATALOCATIONINDEXEDEXTPROC, glBindFragDataLocationIndexedEXT) \
+    X(PFNGLGETFRAGDATAINDEXEXTPROC, glGetFragDataIndexEXT) \
+    X(PFNGLGETPROGRAMRESOURCELOCATIONINDEXEXTPROC, glGetProgramResourceLocationIndexEXT) \
+    X(PFNGLINSERTEVENTMARKEREXTPROC, glInsertEventMarkerEXT) \
+    X(PFNGLPOPGROUPMARKEREXTPROC, glPopGroupMarkerEXT) \
+    X(PFNGLPUSHGROUPMARKEREXTPROC, glPushGroupMarkerEXT) \
+    X(PFNGLDISCARDFRAMEBUFFEREXTPROC, glDiscardFramebufferEXT) \
+    X(PFNGLBEGINQUERYEXTPROC, glBeginQueryEXT) \
+    X(PFNGLDELETEQUERIESEXTPROC, glDeleteQueriesEXT) \
+    X(PFNGLENDQUERYEXTPROC, glEndQueryEXT) \
+    X(PFNGLGENQUERIESEXTPROC, glGenQueriesEXT) \
+    X(PFNGLGETQUERYOBJECTI64VEXTPROC, glGetQueryObjecti64vEXT) \
+    X(PFNGLGETQUERYOBJECTIVEXTPROC, glGetQueryObjectivEXT) \
+    X(PFNGLGETQUERYOBJECTUI64VEXTPROC, glGetQueryObjectui64vEXT) \
+    X(PFNGLGETQUERYOBJECTUIVEXTPROC, glGetQueryObjectuivEXT) \
+    X(PFNGLGETQUERYIVEXTPROC, glGetQueryivEXT) \
+    X(PFNGLISQUERYEXTPROC, glIsQueryEXT) \
+    X(PFNGLQUERYCOUNTEREXTPROC, glQueryCounterEXT) \
+    X(PFNGLDRAWBUFFERSEXTPROC, glDrawBuffersEXT) \
+    X(PFNGLFRAMEBUFFERTEXTUREEXTPROC, glFramebufferTextureEXT) \
+    X(PFNGLFLUSHMAPPEDBUFFERRANGEEXTPROC, glFlushMappedBufferRangeEXT) \
+    X(PFNGLMAPBUFFERRANGEEXTPROC, glMapBufferRangeEXT) \
+    X(PFNGLGETGRAPHICSRESETSTATUSEXTPROC, glGetGraphicsResetStatusEXT) \
+    X(PFNGLGETNUNIFORMFVEXTPROC, glGetnUniformfvEXT) \
+    X(PFNGLGETNUNIFORMIVEXTPROC, glGetnUniformivEXT) \
+    X(PFNGLREADNPIXELSEXTPROC, glReadnPixelsEXT) \
+    X(PFNGLTEXSTORAGE1DEXTPROC, glTexStorage1DEXT) \
+    X(PFNGLTEXSTORAGE2DEXTPROC, glTexStorage2DEXT) \
+    X(PFNGLTEXSTORAGE3DEXTPROC, glTexStorage3DEXT) \
+    X(PFNGLDEBUGMESSAGECALLBACKKHRPROC, glDebugMessageCallbackKHR) \
+    X(PFNGLDEBUGMESSAGECONTROLKHRPROC, glDebugMessageControlKHR) \
+    X(PFNGLDEBUGMESSAGEINSERTKHRPROC, glDebugMessageInsertKHR) \
+    X(PFNGLGETDEBUGMESSAGELOGKHRPROC, glGetDebugMessageLogKHR) \
+    X(PFNGLGETOBJECTLABELKHRPROC, glGetObjectLabelKHR) \
+    X(PFNGLGETOBJECTPTRLABELKHRPROC, glGetObjectPtrLabelKHR) \
+    X(PFNGLGETPOINTERVKHRPROC, glGetPointervKHR) \
+    X(PFNGLOBJECTLABELKHRPROC, glObjectLabelKHR) \
+    X(PFNGLOBJECTPTRLABELKHRPROC, glObjectPtrLabelKHR) \
+    X(PFNGLPOPDEBUGGROUPKHRPROC, glPopDebugGroupKHR) \
+    X(PFNGLPUSHDEBUGGROUPKHRPROC, glPushDebugGroupKHR) \
+    X(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, glMaxShaderCompilerThreadsKHR) \
+    X(PFNGLDELETEFENCESNVPROC, glDeleteFencesNV) \
+    X(PFNGLFINISHFENCENVPROC, glFinishFenceNV) \
+    X(PFNGLGENFENCESNVPROC, glGenFencesNV) \
+    X(PFNGLGETFENCEIVNVPROC, glGetFenceivNV) \
+    X(PFNGLISFENCENVPROC, glIsFenceNV) \
+    X(PFNGLSETFENCENVPROC, glSetFenceNV) \
+    X(PFNGLTESTFENCENVPROC, glTestFenceNV) \
+    X(PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC, glEGLImageTargetRenderbufferStorageOES) \
+    X(PFNGLEGLIMAGETARGETTEXTURE2DOESPROC, glEGLImageTargetTexture2DOES) \
+    X(PFNGLGETPROGRAMBINARYOESPROC, glGetProgramBinaryOES) \
+    X(PFNGLPROGRAMBINARYOESPROC, glProgramBinaryOES) \
+    X(PFNGLGETBUFFERPOINTERVOESPROC, glGetBufferPointervOES) \
+    X(PFNGLMAPBUFFEROESPROC, glMapBufferOES) \
+    X(PFNGLUNMAPBUFFEROESPROC, glUnmapBufferOES) \
+    X(PFNGLGETSAMPLERPARAMETERIIVOESPROC, glGetSamplerParameterIivOES) \
+    X(PFNGLGETSAMPLERPARAMETERIUIVOESPROC, glGetSamplerParameterIuivOES) \
+    X(PFNGLGETTEXPARAMETERIIVOESPROC, glGetTexParameterIivOES) \
+    X(PFNGLGETTEXPARAMETERIUIVOESPROC, glGetTexParameterIuivOES) \
+    X(PFNGLSAMPLERPARAMETERIIVOESPROC, glSamplerParameterIivOES) \
+    X(PFNGLSAMPLERPARAMETERIUIVOESPROC, glSamplerParameterIuivOES) \
+    X(PFNGLTEXPARAMETERIIVOESPROC, glTexParameterIivOES) \
+    X(PFNGLTEXPARAMETERIUIVOESPROC, glTexParameterIuivOES) \
+    X(PFNGLTEXSTORAGE3DMULTISAMPLEOESPROC, glTexStorage3DMultisampleOES) \
+    X(PFNGLBINDVERTEXARRAYOESPROC, glBindVertexArrayOES) \
+    X(PFNGLDELETEVERTEXARRAYSOESPROC, glDeleteVertexArraysOES) \
+    X(PFNGLGENVERTEXARRAYSOESPROC, glGenVertexArraysOES) \
+    X(PFNGLISVERTEXARRAYOESPROC, glIsVertexArrayOES) \
+    X(PFNGLDRAWTEXFOESPROC, glDrawTexfOES) \
+    X(PFNGLDRAWTEXFVOESPROC, glDrawTexfvOES) \
+    X(PFNGLDRAWTEXIOESPROC, glDrawTexiOES) \
+    X(PFNGLDRAWTEXIVOESPROC, glDrawTexivOES) \
+    X(PFNGLDRAWTEXSOESPROC, glDrawTexsOES) \
+    X(PFNGLDRAWTEXSVOESPROC, glDrawTexsvOES) \
+    X(PFNGLDRAWTEXXOESPROC, glDrawTexxOES) \
+    X(PFNGLDRAWTEXXVOESPROC, glDrawTexxvOES) \
+    X(PFNGLBINDFRAMEBUFFEROESPROC, glBindFramebufferOES) \
+    X(PFNGLBINDRENDERBUFFEROESPROC, glBindRenderbufferOES) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSOESPROC, glCheckFramebufferStatusOES) \
+    X(PFNGLDELETEFRAMEBUFFERSOESPROC, glDeleteFramebuffersOES) \
+    X(PFNGLDELETERENDERBUFFERSOESPROC, glDeleteRenderbuffersOES) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFEROESPROC, glFramebufferRenderbufferOES) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DOESPROC, glFramebufferTexture2DOES) \
+    X(PFNGLGENFRAMEBUFFERSOESPROC, glGenFramebuffersOES) \
+    X(PFNGLGENRENDERBUFFERSOESPROC, glGenRenderbuffersOES) \
+    X(PFNGLGENERATEMIPMAPOESPROC, glGenerateMipmapOES) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVOESPROC, glGetFramebufferAttachmentParameterivOES) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVOESPROC, glGetRenderbufferParameterivOES) \
+    X(PFNGLISFRAMEBUFFEROESPROC, glIsFramebufferOES) \
+    X(PFNGLISRENDERBUFFEROESPROC, glIsRenderbufferOES) \
+    X(PFNGLRENDERBUFFERSTORAGEOESPROC, glRenderbufferStorageOES) \
+    X(PFNGLCURRENTPALETTEMATRIXOESPROC, glCurrentPaletteMatrixOES) \
+    X(PFNGLLOADPALETTEFROMMODELVIEWMATRIXOESPROC, glLoadPaletteFromModelViewMatrixOES) \
+    X(PFNGLMATRIXINDEXPOINTEROESPROC, glMatrixIndexPointerOES) \
+    X(PFNGLWEIGHTPOINTEROESPROC, glWeightPointerOES) \
+    X(PFNGLPOINTSIZEPOINTEROESPROC, glPointSizePointerOES) \
+    X(PFNGLQUERYMATRIXXOESPROC, glQueryMatrixxOES) \
+    X(PFNGLGETTEXGENFVOESPROC, glGetTexGenfvOES) \
+    X(PFNGLGETTEXGENIVOESPROC, glGetTexGenivOES) \
+    X(PFNGLGETTEXGENXVOESPROC, glGetTexGenxvOES) \
+    X(PFNGLTEXGENFOESPROC, glTexGenfOES) \
+    X(PFNGLTEXGENFVOESPROC, glTexGenfvOES) \
+    X(PFNGLTEXGENIOESPROC, glTexGeniOES) \
+    X(PFNGLTEXGENIVOESPROC, glTexGenivOES) \
+    X(PFNGLTEXGENXOESPROC, glTexGenxOES) \
+    X(PFNGLTEXGENXVOESPROC, glTexGenxvOES) \
+    X(PFNGLALPHAFUNCCONTEXTANGLEPROC, glAlphaFuncContextANGLE) \
+    X(PFNGLCLIPPLANEFCONTEXTANGLEPROC, glClipPlanefContextANGLE) \
+    X(PFNGLCOLOR4FCONTEXTANGLEPROC, glColor4fContextANGLE) \
+    X(PFNGLFOGFCONTEXTANGLEPROC, glFogfContextANGLE) \
+    X(PFNGLFOGFVCONTEXTANGLEPROC, glFogfvContextANGLE) \
+    X(PFNGLFRUSTUMFCONTEXTANGLEPROC, glFrustumfContextANGLE) \
+    X(PFNGLGETCLIPPLANEFCONTEXTANGLEPROC, glGetClipPlanefContextANGLE) \
+    X(PFNGLGETLIGHTFVCONTEXTANGLEPROC, glGetLightfvContextANGLE) \
+    X(PFNGLGETMATERIALFVCONTEXTANGLEPROC, glGetMaterialfvContextANGLE) \
+    X(PFNGLGETTEXENVFVCONTEXTANGLEPROC, glGetTexEnvfvContextANGLE) \
+    X(PFNGLLIGHTMODELFCONTEXTANGLEPROC, glLightModelfContextANGLE) \
+    X(PFNGLLIGHTMODELFVCONTEXTANGLEPROC, glLightModelfvContextANGLE) \
+    X(PFNGLLIGHTFCONTEXTANGLEPROC, glLightfContextANGLE) \
+    X(PFNGLLIGHTFVCONTEXTANGLEPROC, glLightfvContextANGLE) \
+    X(PFNGLLOADMATRIXFCONTEXTANGLEPROC, glLoadMatrixfContextANGLE) \
+    X(PFNGLMATERIALFCONTEXTANGLEPROC, glMaterialfContextANGLE) \
+    X(PFNGLMATERIALFVCONTEXTANGLEPROC, glMaterialfvContextANGLE) \
+    X(PFNGLMULTMATRIXFCONTEXTANGLEPROC, glMultMatrixfContextANGLE) \
+    X(PFNGLMULTITEXCOORD4FCONTEXTANGLEPROC, glMultiTexCoord4fContextANGLE) \
+    X(PFNGLNORMAL3FCONTEXTANGLEPROC, glNormal3fContextANGLE) \
+    X(PFNGLORTHOFCONTEXTANGLEPROC, glOrthofContextANGLE) \
+    X(PFNGLPOINTPARAMETERFCONTEXTANGLEPROC, glPointParameterfContextANGLE) \
+    X(PFNGLPOINTPARAMETERFVCONTEXTANGLEPROC, glPointParameterfvContextANGLE) \
+    X(PFNGLPOINTSIZECONTEXTANGLEPROC, glPointSizeContextANGLE) \
+    X(PFNGLROTATEFCONTEXTANGLEPROC, glRotatefContextANGLE) \
+    X(PFNGLSCALEFCONTEXTANGLEPROC, glScalefContextANGLE) \
+    X(PFNGLTEXENVFCONTEXTANGLEPROC, glTexEnvfContextANGLE) \
+    X(PFNGLTEXENVFVCONTEXTANGLEPROC, glTexEnvfvContextANGLE) \
+    X(PFNGLTRANSLATEFCONTEXTANGLEPROC, glTranslatefContextANGLE) \
+    X(PFNGLALPHAFUNCXCONTEXTANGLEPROC, glAlphaFuncxContextANGLE) \
+    X(PFNGLCLEARCOLORXCONTEXTANGLEPROC, glClearColorxContextANGLE) \
+    X(PFNGLCLEARDEPTHXCONTEXTANGLEPROC, glClearDepthxContextANGLE) \
+    X(PFNGLCLIENTACTIVETEXTURECONTEXTANGLEPROC, glClientActiveTextureContextANGLE) \
+    X(PFNGLCLIPPLANEXCONTEXTANGLEPROC, glClipPlanexContextANGLE) \
+    X(PFNGLCOLOR4UBCONTEXTANGLEPROC, glColor4ubContextANGLE) \
+    X(PFNGLCOLOR4XCONTEXTANGLEPROC, glColor4xContextANGLE) \
+    X(PFNGLCOLORPOINTERCONTEXTANGLEPROC, glColorPointerContextANGLE) \
+    X(PFNGLDEPTHRANGEXCONTEXTANGLEPROC, glDepthRangexContextANGLE) \
+    X(PFNGLDISABLECLIENTSTATECONTEXTANGLEPROC, glDisableClientStateContextANGLE) \
+    X(PFNGLENABLECLIENTSTATECONTEXTANGLEPROC, glEnableClientStateContextANGLE) \
+    X(PFNGLFOGXCONTEXTANGLEPROC, glFogxContextANGLE) \
+    X(PFNGLFOGXVCONTEXTANGLEPROC, glFogxvContextANGLE) \
+    X(PFNGLFRUSTUMXCONTEXTANGLEPROC, glFrustumxContextANGLE) \
+    X(PFNGLGETCLIPPLANEXCONTEXTANGLEPROC, glGetClipPlanexContextANGLE) \
+    X(PFNGLGETFIXEDVCONTEXTANGLEPROC, glGetFixedvContextANGLE) \
+    X(PFNGLGETLIGHTXVCONTEXTANGLEPROC, glGetLightxvContextANGLE) \
+    X(PFNGLGETMATERIALXVCONTEXTANGLEPROC, glGetMaterialxvContextANGLE) \
+    X(PFNGLGETPOINTERVCONTEXTANGLEPROC, glGetPointervContextANGLE) \
+    X(PFNGLGETTEXENVIVCONTEXTANGLEPROC, glGetTexEnvivContextANGLE) \
+    X(PFNGLGETTEXENVXVCONTEXTANGLEPROC, glGetTexEnvxvContextANGLE) \
+    X(PFNGLGETTEXPARAMETERXVCONTEXTANGLEPROC, glGetTexParameterxvContextANGLE) \
+    X(PFNGLLIGHTMODELXCONTEXTANGLEPROC, glLightModelxContextANGLE) \
+    X(PFNGLLIGHTMODELXVCONTEXTANGLEPROC, glLightModelxvContextANGLE) \
+    X(PFNGLLIGHTXCONTEXTANGLEPROC, glLightxContextANGLE) \
+    X(PFNGLLIGHTXVCONTEXTANGLEPROC, glLightxvContextANGLE) \
+    X(PFNGLLINEWIDTHXCONTEXTANGLEPROC, glLineWidthxContextANGLE) \
+    X(PFNGLLOADIDENTITYCONTEXTANGLEPROC, glLoadIdentityContextANGLE) \
+    X(PFNGLLOADMATRIXXCONTEXTANGLEPROC, glLoadMatrixxContextANGLE) \
+    X(PFNGLLOGICOPCONTEXTANGLEPROC, glLogicOpContextANGLE) \
+    X(PFNGLMATERIALXCONTEXTANGLEPROC, glMaterialxContextANGLE) \
+    X(PFNGLMATERIALXVCONTEXTANGLEPROC, glMaterialxvContextANGLE) \
+    X(PFNGLMATRIXMODECONTEXTANGLEPROC, glMatrixModeContextANGLE) \
+    X(PFNGLMULTMATRIXXCONTEXTANGLEPROC, glMultMatrixxContextANGLE) \
+    X(PFNGLMULTITEXCOORD4XCONTEXTANGLEPROC, glMultiTexCoord4xContextANGLE) \
+    X(PFNGLNORMAL3XCONTEXTANGLEPROC, glNormal3xContextANGLE) \
+    X(PFNGLNORMALPOINTERCONTEXTANGLEPROC, glNormalPointerContextANGLE) \
+    X(PFNGLORTHOXCONTEXTANGLEPROC, glOrthoxContextANGLE) \
+    X(PFNGLPOINTPARAMETERXCONTEXTANGLEPROC, glPointParameterxContextANGLE) \
+    X(PFNGLPOINTPARAMETERXVCONTEXTANGLEPROC, glPointParameterxvContextANGLE) \
+    X(PFNGLPOINTSIZEXCONTEXTANGLEPROC, glPointSizexContextANGLE) \
+    X(PFNGLPOLYGONOFFSETXCONTEXTANGLEPROC, glPolygonOffsetxContextANGLE) \
+    X(PFNGLPOPMATRIXCONTEXTANGLEPROC, glPopMatrixContextANGLE) \
+    X(PFNGLPUSHMATRIXCONTEXTANGLEPROC, glPushMatrixContextANGLE) \
+    X(PFNGLROTATEXCONTEXTANGLEPROC, glRotatexContextANGLE) \
+    X(PFNGLSAMPLECOVERAGEXCONTEXTANGLEPROC, glSampleCoveragexContextANGLE) \
+    X(PFNGLSCALEXCONTEXTANGLEPROC, glScalexContextANGLE) \
+    X(PFNGLSHADEMODELCONTEXTANGLEPROC, glShadeModelContextANGLE) \
+    X(PFNGLTEXCOORDPOINTERCONTEXTANGLEPROC, glTexCoordPointerContextANGLE) \
+    X(PFNGLTEXENVICONTEXTANGLEPROC, glTexEnviContextANGLE) \
+    X(PFNGLTEXENVXCONTEXTANGLEPROC, glTexEnvxContextANGLE) \
+    X(PFNGLTEXENVIVCONTEXTANGLEPROC, glTexEnvivContextANGLE) \
+    X(PFNGLTEXENVXVCONTEXTANGLEPROC, glTexEnvxvContextANGLE) \
+    X(PFNGLTEXPARAMETERXCONTEXTANGLEPROC, glTexParameterxContextANGLE) \
+    X(PFNGLTEXPARAMETERXVCONTEXTANGLEPROC, glTexParameterxvContextANGLE) \
+    X(PFNGLTRANSLATEXCONTEXTANGLEPROC, glTranslatexContextANGLE) \
+    X(PFNGLVERTEXPOINTERCONTEXTANGLEPROC, glVertexPointerContextANGLE) \
+    X(PFNGLACTIVETEXTURECONTEXTANGLEPROC, glActiveTextureContextANGLE) \
+    X(PFNGLATTACHSHADERCONTEXTANGLEPROC, glAttachShaderContextANGLE) \
+    X(PFNGLBINDATTRIBLOCATIONCONTEXTANGLEPROC, glBindAttribLocationContextANGLE) \
+    X(PFNGLBINDBUFFERCONTEXTANGLEPROC, glBindBufferContextANGLE) \
+    X(PFNGLBINDFRAMEBUFFERCONTEXTANGLEPROC, glBindFramebufferContextANGLE) \
+    X(PFNGLBINDRENDERBUFFERCONTEXTANGLEPROC, glBindRenderbufferContextANGLE) \
+    X(PFNGLBINDTEXTURECONTEXTANGLEPROC, glBindTextureContextANGLE) \
+    X(PFNGLBLENDCOLORCONTEXTANGLEPROC, glBlendColorContextANGLE) \
+    X(PFNGLBLENDEQUATIONCONTEXTANGLEPROC, glBlendEquationContextANGLE) \
+    X(PFNGLBLENDEQUATIONSEPARATECONTEXTANGLEPROC, glBlendEquationSeparateContextANGLE) \
+    X(PFNGLBLENDFUNCCONTEXTANGLEPROC, glBlendFuncContextANGLE) \
+    X(PFNGLBLENDFUNCSEPARATECONTEXTANGLEPROC, glBlendFuncSeparateContextANGLE) \
+    X(PFNGLBUFFERDATACONTEXTANGLEPROC, glBufferDataContextANGLE) \
+    X(PFNGLBUFFERSUBDATACONTEXTANGLEPROC, glBufferSubDataContextANGLE) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSCONTEXTANGLEPROC, glCheckFramebufferStatusContextANGLE) \
+    X(PFNGLCLEARCONTEXTANGLEPROC, glClearContextANGLE) \
+    X(PFNGLCLEARCOLORCONTEXTANGLEPROC, glClearColorContextANGLE) \
+    X(PFNGLCLEARDEPTHFCONTEXTANGLEPROC, glClearDepthfContextANGLE) \
+    X(PFNGLCLEARSTENCILCONTEXTANGLEPROC, glClearStencilContextANGLE) \
+    X(PFNGLCOLORMASKCONTEXTANGLEPROC, glColorMaskContextANGLE) \
+    X(PFNGLCOMPILESHADERCONTEXTANGLEPROC, glCompileShaderContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DCONTEXTANGLEPROC, glCompressedTexImage2DContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE2DCONTEXTANGLEPROC, glCompressedTexSubImage2DContextANGLE) \
+    X(PFNGLCOPYTEXIMAGE2DCONTEXTANGLEPROC, glCopyTexImage2DContextANGLE) \
+    X(PFNGLCOPYTEXSUBIMAGE2DCONTEXTANGLEPROC, glCopyTexSubImage2DContextANGLE) \
+    X(PFNGLCREATEPROGRAMCONTEXTANGLEPROC, glCreateProgramContextANGLE) \
+    X(PFNGLCREATESHADERCONTEXTANGLEPROC, glCreateShaderContextANGLE) \
+    X(PFNGLCULLFACECONTEXTANGLEPROC, glCullFaceContextANGLE) \
+    X(PFNGLDELETEBUFFERSCONTEXTANGLEPROC, glDeleteBuffersContextANGLE) \
+    X(PFNGLDELETEFRAMEBUFFERSCONTEXTANGLEPROC, glDeleteFramebuffersContextANGLE) \
+    X(PFNGLDELETEPROGRAMCONTEXTANGLEPROC, glDeleteProgramContextANGLE) \
+    X(PFNGLDELETERENDERBUFFERSCONTEXTANGLEPROC, glDeleteRenderbuffersContextANGLE) \
+    X(PFNGLDELETESHADERCONTEXTANGLEPROC, glDeleteShaderContextANGLE) \
+    X(PFNGLDELETETEXTURESCONTEXTANGLEPROC, glDeleteTexturesContextANGLE) \
+    X(PFNGLDEPTHFUNCCONTEXTANGLEPROC, glDepthFuncContextANGLE) \
+    X(PFNGLDEPTHMASKCONTEXTANGLEPROC, glDepthMaskContextANGLE) \
+    X(PFNGLDEPTHRANGEFCONTEXTANGLEPROC, glDepthRangefContextANGLE) \
+    X(PFNGLDETACHSHADERCONTEXTANGLEPROC, glDetachShaderContextANGLE) \
+    X(PFNGLDISABLECONTEXTANGLEPROC, glDisableContextANGLE) \
+    X(PFNGLDISABLEVERTEXATTRIBARRAYCONTEXTANGLEPROC, glDisableVertexAttribArrayContextANGLE) \
+    X(PFNGLDRAWARRAYSCONTEXTANGLEPROC, glDrawArraysContextANGLE) \
+    X(PFNGLDRAWELEMENTSCONTEXTANGLEPROC, glDrawElementsContextANGLE) \
+    X(PFNGLENABLECONTEXTANGLEPROC, glEnableContextANGLE) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYCONTEXTANGLEPROC, glEnableVertexAttribArrayContextANGLE) \
+    X(PFNGLFINISHCONTEXTANGLEPROC, glFinishContextANGLE) \
+    X(PFNGLFLUSHCONTEXTANGLEPROC, glFlushContextANGLE) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFERCONTEXTANGLEPROC, glFramebufferRenderbufferContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DCONTEXTANGLEPROC, glFramebufferTexture2DContextANGLE) \
+    X(PFNGLFRONTFACECONTEXTANGLEPROC, glFrontFaceContextANGLE) \
+    X(PFNGLGENBUFFERSCONTEXTANGLEPROC, glGenBuffersContextANGLE) \
+    X(PFNGLGENERATEMIPMAPCONTEXTANGLEPROC, glGenerateMipmapContextANGLE) \
+    X(PFNGLGENFRAMEBUFFERSCONTEXTANGLEPROC, glGenFramebuffersContextANGLE) \
+    X(PFNGLGENRENDERBUFFERSCONTEXTANGLEPROC, glGenRenderbuffersContextANGLE) \
+    X(PFNGLGENTEXTURESCONTEXTANGLEPROC, glGenTexturesContextANGLE) \
+    X(PFNGLGETACTIVEATTRIBCONTEXTANGLEPROC, glGetActiveAttribContextANGLE) \
+    X(PFNGLGETACTIVEUNIFORMCONTEXTANGLEPROC, glGetActiveUniformContextANGLE) \
+    X(PFNGLGETATTACHEDSHADERSCONTEXTANGLEPROC, glGetAttachedShadersContextANGLE) \
+    X(PFNGLGETATTRIBLOCATIONCONTEXTANGLEPROC, glGetAttribLocationContextANGLE) \
+    X(PFNGLGETBOOLEANVCONTEXTANGLEPROC, glGetBooleanvContextANGLE) \
+    X(PFNGLGETBUFFERPARAMETERIVCONTEXTANGLEPROC, glGetBufferParameterivContextANGLE) \
+    X(PFNGLGETERRORCONTEXTANGLEPROC, glGetErrorContextANGLE) \
+    X(PFNGLGETFLOATVCONTEXTANGLEPROC, glGetFloatvContextANGLE) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVCONTEXTANGLEPROC, glGetFramebufferAttachmentParameterivContextANGLE) \
+    X(PFNGLGETINTEGERVCONTEXTANGLEPROC, glGetIntegervContextANGLE) \
+    X(PFNGLGETPROGRAMIVCONTEXTANGLEPROC, glGetProgramivContextANGLE) \
+    X(PFNGLGETPROGRAMINFOLOGCONTEXTANGLEPROC, glGetProgramInfoLogContextANGLE) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVCONTEXTANGLEPROC, glGetRenderbufferParameterivContextANGLE) \
+    X(PFNGLGETSHADERIVCONTEXTANGLEPROC, glGetShaderivContextANGLE) \
+    X(PFNGLGETSHADERINFOLOGCONTEXTANGLEPROC, glGetShaderInfoLogContextANGLE) \
+    X(PFNGLGETSHADERPRECISIONFORMATCONTEXTANGLEPROC, glGetShaderPrecisionFormatContextANGLE) \
+    X(PFNGLGETSHADERSOURCECONTEXTANGLEPROC, glGetShaderSourceContextANGLE) \
+    X(PFNGLGETSTRINGCONTEXTANGLEPROC, glGetStringContextANGLE) \
+    X(PFNGLGETTEXPARAMETERFVCONTEXTANGLEPROC, glGetTexParameterfvContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIVCONTEXTANGLEPROC, glGetTexParameterivContextANGLE) \
+    X(PFNGLGETUNIFORMFVCONTEXTANGLEPROC, glGetUniformfvContextANGLE) \
+    X(PFNGLGETUNIFORMIVCONTEXTANGLEPROC, glGetUniformivContextANGLE) \
+    X(PFNGLGETUNIFORMLOCATIONCONTEXTANGLEPROC, glGetUniformLocationContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBFVCONTEXTANGLEPROC, glGetVertexAttribfvContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIVCONTEXTANGLEPROC, glGetVertexAttribivContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBPOINTERVCONTEXTANGLEPROC, glGetVertexAttribPointervContextANGLE) \
+    X(PFNGLHINTCONTEXTANGLEPROC, glHintContextANGLE) \
+    X(PFNGLISBUFFERCONTEXTANGLEPROC, glIsBufferContextANGLE) \
+    X(PFNGLISENABLEDCONTEXTANGLEPROC, glIsEnabledContextANGLE) \
+    X(PFNGLISFRAMEBUFFERCONTEXTANGLEPROC, glIsFramebufferContextANGLE) \
+    X(PFNGLISPROGRAMCONTEXTANGLEPROC, glIsProgramContextANGLE) \
+    X(PFNGLISRENDERBUFFERCONTEXTANGLEPROC, glIsRenderbufferContextANGLE) \
+    X(PFNGLISSHADERCONTEXTANGLEPROC, glIsShaderContextANGLE) \
+    X(PFNGLISTEXTURECONTEXTANGLEPROC, glIsTextureContextANGLE) \
+    X(PFNGLLINEWIDTHCONTEXTANGLEPROC, glLineWidthContextANGLE) \
+    X(PFNGLLINKPROGRAMCONTEXTANGLEPROC, glLinkProgramContextANGLE) \
+    X(PFNGLPIXELSTOREICONTEXTANGLEPROC, glPixelStoreiContextANGLE) \
+    X(PFNGLPOLYGONOFFSETCONTEXTANGLEPROC, glPolygonOffsetContextANGLE) \
+    X(PFNGLREADPIXELSCONTEXTANGLEPROC, glReadPixelsContextANGLE) \
+    X(PFNGLRELEASESHADERCOMPILERCONTEXTANGLEPROC, glReleaseShaderCompilerContextANGLE) \
+    X(PFNGLRENDERBUFFERSTORAGECONTEXTANGLEPROC, glRenderbufferStorageContextANGLE) \
+    X(PFNGLSAMPLECOVERAGECONTEXTANGLEPROC, glSampleCoverageContextANGLE) \
+    X(PFNGLSCISSORCONTEXTANGLEPROC, glScissorContextANGLE) \
+    X(PFNGLSHADERBINARYCONTEXTANGLEPROC, glShaderBinaryContextANGLE) \
+    X(PFNGLSHADERSOURCECONTEXTANGLEPROC, glShaderSourceContextANGLE) \
+    X(PFNGLSTENCILFUNCCONTEXTANGLEPROC, glStencilFuncContextANGLE) \
+    X(PFNGLSTENCILFUNCSEPARATECONTEXTANGLEPROC, glStencilFuncSeparateContextANGLE) \
+    X(PFNGLSTENCILMASKCONTEXTANGLEPROC, glStencilMaskContextANGLE) \
+    X(PFNGLSTENCILMASKSEPARATECONTEXTANGLEPROC, glStencilMaskSeparateContextANGLE) \
+    X(PFNGLSTENCILOPCONTEXTANGLEPROC, glStencilOpContextANGLE) \
+    X(PFNGLSTENCILOPSEPARATECONTEXTANGLEPROC, glStencilOpSeparateContextANGLE) \
+    X(PFNGLTEXIMAGE2DCONTEXTANGLEPROC, glTexImage2DContextANGLE) \
+    X(PFNGLTEXPARAMETERFCONTEXTANGLEPROC, glTexParameterfContextANGLE) \
+    X(PFNGLTEXPARAMETERFVCONTEXTANGLEPROC, glTexParameterfvContextANGLE) \
+    X(PFNGLTEXPARAMETERICONTEXTANGLEPROC, glTexParameteriContextANGLE) \
+    X(PFNGLTEXPARAMETERIVCONTEXTANGLEPROC, glTexParameterivContextANGLE) \
+    X(PFNGLTEXSUBIMAGE2DCONTEXTANGLEPROC, glTexSubImage2DContextANGLE) \
+    X(PFNGLUNIFORM1FCONTEXTANGLEPROC, glUniform1fContextANGLE) \
+    X(PFNGLUNIFORM1FVCONTEXTANGLEPROC, glUniform1fvContextANGLE) \
+    X(PFNGLUNIFORM1ICONTEXTANGLEPROC, glUniform1iContextANGLE) \
+    X(PFNGLUNIFORM1IVCONTEXTANGLEPROC, glUniform1ivContextANGLE) \
+    X(PFNGLUNIFORM2FCONTEXTANGLEPROC, glUniform2fContextANGLE) \
+    X(PFNGLUNIFORM2FVCONTEXTANGLEPROC, glUniform2fvContextANGLE) \
+    X(PFNGLUNIFORM2ICONTEXTANGLEPROC, glUniform2iContextANGLE) \
+    X(PFNGLUNIFORM2IVCONTEXTANGLEPROC, glUniform2ivContextANGLE) \
+    X(PFNGLUNIFORM3FCONTEXTANGLEPROC, glUniform3fContextANGLE) \
+    X(PFNGLUNIFORM3FVCONTEXTANGLEPROC, glUniform3fvContextANGLE) \
+    X(PFNGLUNIFORM3ICONTEXTANGLEPROC, glUniform3iContextANGLE) \
+    X(PFNGLUNIFORM3IVCONTEXTANGLEPROC, glUniform3ivContextANGLE) \
+    X(PFNGLUNIFORM4FCONTEXTANGLEPROC, glUniform4fContextANGLE) \
+    X(PFNGLUNIFORM4FVCONTEXTANGLEPROC, glUniform4fvContextANGLE) \
+    X(PFNGLUNIFORM4ICONTEXTANGLEPROC, glUniform4iContextANGLE) \
+    X(PFNGLUNIFORM4IVCONTEXTANGLEPROC, glUniform4ivContextANGLE) \
+    X(PFNGLUNIFORMMATRIX2FVCONTEXTANGLEPROC, glUniformMatrix2fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX3FVCONTEXTANGLEPROC, glUniformMatrix3fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX4FVCONTEXTANGLEPROC, glUniformMatrix4fvContextANGLE) \
+    X(PFNGLUSEPROGRAMCONTEXTANGLEPROC, glUseProgramContextANGLE) \
+    X(PFNGLVALIDATEPROGRAMCONTEXTANGLEPROC, glValidateProgramContextANGLE) \
+    X(PFNGLVERTEXATTRIB1FCONTEXTANGLEPROC, glVertexAttrib1fContextANGLE) \
+    X(PFNGLVERTEXATTRIB1FVCONTEXTANGLEPROC, glVertexAttrib1fvContextANGLE) \
+    X(PFNGLVERTEXATTRIB2FCONTEXTANGLEPROC, glVertexAttrib2fContextANGLE) \
+    X(PFNGLVERTEXATTRIB2FVCONTEXTANGLEPROC, glVertexAttrib2fvContextANGLE) \
+    X(PFNGLVERTEXATTRIB3FCONTEXTANGLEPROC, glVertexAttrib3fContextANGLE) \
+    X(PFNGLVERTEXATTRIB3FVCONTEXTANGLEPROC, glVertexAttrib3fvContextANGLE) \
+    X(PFNGLVERTEXATTRIB4FCONTEXTANGLEPROC, glVertexAttrib4fContextANGLE) \
+    X(PFNGLVERTEXATTRIB4FVCONTEXTANGLEPROC, glVertexAttrib4fvContextANGLE) \
+    X(PFNGLVERTEXATTRIBPOINTERCONTEXTANGLEPROC, glVertexAttribPointerContextANGLE) \
+    X(PFNGLVIEWPORTCONTEXTANGLEPROC, glViewportContextANGLE) \
+    X(PFNGLREADBUFFERCONTEXTANGLEPROC, glReadBufferContextANGLE) \
+    X(PFNGLDRAWRANGEELEMENTSCONTEXTANGLEPROC, glDrawRangeElementsContextANGLE) \
+    X(PFNGLTEXIMAGE3DCONTEXTANGLEPROC, glTexImage3DContextANGLE) \
+    X(PFNGLTEXSUBIMAGE3DCONTEXTANGLEPROC, glTexSubImage3DContextANGLE) \
+    X(PFNGLCOPYTEXSUBIMAGE3DCONTEXTANGLEPROC, glCopyTexSubImage3DContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE3DCONTEXTANGLEPROC, glCompressedTexImage3DContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE3DCONTEXTANGLEPROC, glCompressedTexSubImage3DContextANGLE) \
+    X(PFNGLGENQUERIESCONTEXTANGLEPROC, glGenQueriesContextANGLE) \
+    X(PFNGLDELETEQUERIESCONTEXTANGLEPROC, glDeleteQueriesContextANGLE) \
+    X(PFNGLISQUERYCONTEXTANGLEPROC, glIsQueryContextANGLE) \
+    X(PFNGLBEGINQUERYCONTEXTANGLEPROC, glBeginQueryContextANGLE) \
+    X(PFNGLENDQUERYCONTEXTANGLEPROC, glEndQueryContextANGLE) \
+    X(PFNGLGETQUERYIVCONTEXTANGLEPROC, glGetQueryivContextANGLE) \
+    X(PFNGLGETQUERYOBJECTUIVCONTEXTANGLEPROC, glGetQueryObjectuivContextANGLE) \
+    X(PFNGLUNMAPBUFFERCONTEXTANGLEPROC, glUnmapBufferContextANGLE) \
+    X(PFNGLGETBUFFERPOINTERVCONTEXTANGLEPROC, glGetBufferPointervContextANGLE) \
+    X(PFNGLDRAWBUFFERSCONTEXTANGLEPROC, glDrawBuffersContextANGLE) \
+    X(PFNGLUNIFORMMATRIX2X3FVCONTEXTANGLEPROC, glUniformMatrix2x3fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX3X2FVCONTEXTANGLEPROC, glUniformMatrix3x2fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX2X4FVCONTEXTANGLEPROC, glUniformMatrix2x4fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX4X2FVCONTEXTANGLEPROC, glUniformMatrix4x2fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX3X4FVCONTEXTANGLEPROC, glUniformMatrix3x4fvContextANGLE) \
+    X(PFNGLUNIFORMMATRIX4X3FVCONTEXTANGLEPROC, glUniformMatrix4x3fvContextANGLE) \
+    X(PFNGLBLITFRAMEBUFFERCONTEXTANGLEPROC, glBlitFramebufferContextANGLE) \
+    X(PFNGLRENDERBUFFERSTORAGEMULTISAMPLECONTEXTANGLEPROC, glRenderbufferStorageMultisampleContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTURELAYERCONTEXTANGLEPROC, glFramebufferTextureLayerContextANGLE) \
+    X(PFNGLMAPBUFFERRANGECONTEXTANGLEPROC, glMapBufferRangeContextANGLE) \
+    X(PFNGLFLUSHMAPPEDBUFFERRANGECONTEXTANGLEPROC, glFlushMappedBufferRangeContextANGLE) \
+    X(PFNGLBINDVERTEXARRAYCONTEXTANGLEPROC, glBindVertexArrayContextANGLE) \
+    X(PFNGLDELETEVERTEXARRAYSCONTEXTANGLEPROC, glDeleteVertexArraysContextANGLE) \
+    X(PFNGLGENVERTEXARRAYSCONTEXTANGLEPROC, glGenVertexArraysContextANGLE) \
+    X(PFNGLISVERTEXARRAYCONTEXTANGLEPROC, glIsVertexArrayContextANGLE) \
+    X(PFNGLGETINTEGERI_VCONTEXTANGLEPROC, glGetIntegeri_vContextANGLE) \
+    X(PFNGLBEGINTRANSFORMFEEDBACKCONTEXTANGLEPROC, glBeginTransformFeedbackContextANGLE) \
+    X(PFNGLENDTRANSFORMFEEDBACKCONTEXTANGLEPROC, glEndTransformFeedbackContextANGLE) \
+    X(PFNGLBINDBUFFERRANGECONTEXTANGLEPROC, glBindBufferRangeContextANGLE) \
+    X(PFNGLBINDBUFFERBASECONTEXTANGLEPROC, glBindBufferBaseContextANGLE) \
+    X(PFNGLTRANSFORMFEEDBACKVARYINGSCONTEXTANGLEPROC, glTransformFeedbackVaryingsContextANGLE) \
+    X(PFNGLGETTRANSFORMFEEDBACKVARYINGCONTEXTANGLEPROC, glGetTransformFeedbackVaryingContextANGLE) \
+    X(PFNGLVERTEXATTRIBIPOINTERCONTEXTANGLEPROC, glVertexAttribIPointerContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIIVCONTEXTANGLEPROC, glGetVertexAttribIivContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIUIVCONTEXTANGLEPROC, glGetVertexAttribIuivContextANGLE) \
+    X(PFNGLVERTEXATTRIBI4ICONTEXTANGLEPROC, glVertexAttribI4iContextANGLE) \
+    X(PFNGLVERTEXATTRIBI4UICONTEXTANGLEPROC, glVertexAttribI4uiContextANGLE) \
+    X(PFNGLVERTEXATTRIBI4IVCONTEXTANGLEPROC, glVertexAttribI4ivContextANGLE) \
+    X(PFNGLVERTEXATTRIBI4UIVCONTEXTANGLEPROC, glVertexAttribI4uivContextANGLE) \
+    X(PFNGLGETUNIFORMUIVCONTEXTANGLEPROC, glGetUniformuivContextANGLE) \
+    X(PFNGLGETFRAGDATALOCATIONCONTEXTANGLEPROC, glGetFragDataLocationContextANGLE) \
+    X(PFNGLUNIFORM1UICONTEXTANGLEPROC, glUniform1uiContextANGLE) \
+    X(PFNGLUNIFORM2UICONTEXTANGLEPROC, glUniform2uiContextANGLE) \
+    X(PFNGLUNIFORM3UICONTEXTANGLEPROC, glUniform3uiContextANGLE) \
+    X(PFNGLUNIFORM4UICONTEXTANGLEPROC, glUniform4uiContextANGLE) \
+    X(PFNGLUNIFORM1UIVCONTEXTANGLEPROC, glUniform1uivContextANGLE) \
+    X(PFNGLUNIFORM2UIVCONTEXTANGLEPROC, glUniform2uivContextANGLE) \
+    X(PFNGLUNIFORM3UIVCONTEXTANGLEPROC, glUniform3uivContextANGLE) \
+    X(PFNGLUNIFORM4UIVCONTEXTANGLEPROC, glUniform4uivContextANGLE) \
+    X(PFNGLCLEARBUFFERIVCONTEXTANGLEPROC, glClearBufferivContextANGLE) \
+    X(PFNGLCLEARBUFFERUIVCONTEXTANGLEPROC, glClearBufferuivContextANGLE) \
+    X(PFNGLCLEARBUFFERFVCONTEXTANGLEPROC, glClearBufferfvContextANGLE) \
+    X(PFNGLCLEARBUFFERFICONTEXTANGLEPROC, glClearBufferfiContextANGLE) \
+    X(PFNGLGETSTRINGICONTEXTANGLEPROC, glGetStringiContextANGLE) \
+    X(PFNGLCOPYBUFFERSUBDATACONTEXTANGLEPROC, glCopyBufferSubDataContextANGLE) \
+    X(PFNGLGETUNIFORMINDICESCONTEXTANGLEPROC, glGetUniformIndicesContextANGLE) \
+    X(PFNGLGETACTIVEUNIFORMSIVCONTEXTANGLEPROC, glGetActiveUniformsivContextANGLE) \
+    X(PFNGLGETUNIFORMBLOCKINDEXCONTEXTANGLEPROC, glGetUniformBlockIndexContextANGLE) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKIVCONTEXTANGLEPROC, glGetActiveUniformBlockivContextANGLE) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKNAMECONTEXTANGLEPROC, glGetActiveUniformBlockNameContextANGLE) \
+    X(PFNGLUNIFORMBLOCKBINDINGCONTEXTANGLEPROC, glUniformBlockBindingContextANGLE) \
+    X(PFNGLDRAWARRAYSINSTANCEDCONTEXTANGLEPROC, glDrawArraysInstancedContextANGLE) \
+    X(PFNGLDRAWELEMENTSINSTANCEDCONTEXTANGLEPROC, glDrawElementsInstancedContextANGLE) \
+    X(PFNGLFENCESYNCCONTEXTANGLEPROC, glFenceSyncContextANGLE) \
+    X(PFNGLISSYNCCONTEXTANGLEPROC, glIsSyncContextANGLE) \
+    X(PFNGLDELETESYNCCONTEXTANGLEPROC, glDeleteSyncContextANGLE) \
+    X(PFNGLCLIENTWAITSYNCCONTEXTANGLEPROC, glClientWaitSyncContextANGLE) \
+    X(PFNGLWAITSYNCCONTEXTANGLEPROC, glWaitSyncContextANGLE) \
+    X(PFNGLGETINTEGER64VCONTEXTANGLEPROC, glGetInteger64vContextANGLE) \
+    X(PFNGLGETSYNCIVCONTEXTANGLEPROC, glGetSyncivContextANGLE) \
+    X(PFNGLGETINTEGER64I_VCONTEXTANGLEPROC, glGetInteger64i_vContextANGLE) \
+    X(PFNGLGETBUFFERPARAMETERI64VCONTEXTANGLEPROC, glGetBufferParameteri64vContextANGLE) \
+    X(PFNGLGENSAMPLERSCONTEXTANGLEPROC, glGenSamplersContextANGLE) \
+    X(PFNGLDELETESAMPLERSCONTEXTANGLEPROC, glDeleteSamplersContextANGLE) \
+    X(PFNGLISSAMPLERCONTEXTANGLEPROC, glIsSamplerContextANGLE) \
+    X(PFNGLBINDSAMPLERCONTEXTANGLEPROC, glBindSamplerContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERICONTEXTANGLEPROC, glSamplerParameteriContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIVCONTEXTANGLEPROC, glSamplerParameterivContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERFCONTEXTANGLEPROC, glSamplerParameterfContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERFVCONTEXTANGLEPROC, glSamplerParameterfvContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIVCONTEXTANGLEPROC, glGetSamplerParameterivContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERFVCONTEXTANGLEPROC, glGetSamplerParameterfvContextANGLE) \
+    X(PFNGLVERTEXATTRIBDIVISORCONTEXTANGLEPROC, glVertexAttribDivisorContextANGLE) \
+    X(PFNGLBINDTRANSFORMFEEDBACKCONTEXTANGLEPROC, glBindTransformFeedbackContextANGLE) \
+    X(PFNGLDELETETRANSFORMFEEDBACKSCONTEXTANGLEPROC, glDeleteTransformFeedbacksContextANGLE) \
+    X(PFNGLGENTRANSFORMFEEDBACKSCONTEXTANGLEPROC, glGenTransformFeedbacksContextANGLE) \
+    X(PFNGLISTRANSFORMFEEDBACKCONTEXTANGLEPROC, glIsTransformFeedbackContextANGLE) \
+    X(PFNGLPAUSETRANSFORMFEEDBACKCONTEXTANGLEPROC, glPauseTransformFeedbackContextANGLE) \
+    X(PFNGLRESUMETRANSFORMFEEDBACKCONTEXTANGLEPROC, glResumeTransformFeedbackContextANGLE) \
+    X(PFNGLGETPROGRAMBINARYCONTEXTANGLEPROC, glGetProgramBinaryContextANGLE) \
+    X(PFNGLPROGRAMBINARYCONTEXTANGLEPROC, glProgramBinaryContextANGLE) \
+    X(PFNGLPROGRAMPARAMETERICONTEXTANGLEPROC, glProgramParameteriContextANGLE) \
+    X(PFNGLINVALIDATEFRAMEBUFFERCONTEXTANGLEPROC, glInvalidateFramebufferContextANGLE) \
+    X(PFNGLINVALIDATESUBFRAMEBUFFERCONTEXTANGLEPROC, glInvalidateSubFramebufferContextANGLE) \
+    X(PFNGLTEXSTORAGE2DCONTEXTANGLEPROC, glTexStorage2DContextANGLE) \
+    X(PFNGLTEXSTORAGE3DCONTEXTANGLEPROC, glTexStorage3DContextANGLE) \
+    X(PFNGLGETINTERNALFORMATIVCONTEXTANGLEPROC, glGetInternalformativContextANGLE) \
+    X(PFNGLDISPATCHCOMPUTECONTEXTANGLEPROC, glDispatchComputeContextANGLE) \
+    X(PFNGLDISPATCHCOMPUTEINDIRECTCONTEXTANGLEPROC, glDispatchComputeIndirectContextANGLE) \
+    X(PFNGLDRAWARRAYSINDIRECTCONTEXTANGLEPROC, glDrawArraysIndirectContextANGLE) \
+    X(PFNGLDRAWELEMENTSINDIRECTCONTEXTANGLEPROC, glDrawElementsIndirectContextANGLE) \
+    X(PFNGLFRAMEBUFFERPARAMETERICONTEXTANGLEPROC, glFramebufferParameteriContextANGLE) \
+    X(PFNGLGETFRAMEBUFFERPARAMETERIVCONTEXTANGLEPROC, glGetFramebufferParameterivContextANGLE) \
+    X(PFNGLGETPROGRAMINTERFACEIVCONTEXTANGLEPROC, glGetProgramInterfaceivContextANGLE) \
+    X(PFNGLGETPROGRAMRESOURCEINDEXCONTEXTANGLEPROC, glGetProgramResourceIndexContextANGLE) \
+    X(PFNGLGETPROGRAMRESOURCENAMECONTEXTANGLEPROC, glGetProgramResourceNameContextANGLE) \
+    X(PFNGLGETPROGRAMRESOURCEIVCONTEXTANGLEPROC, glGetProgramResourceivContextANGLE) \
+    X(PFNGLGETPROGRAMRESOURCELOCATIONCONTEXTANGLEPROC, glGetProgramResourceLocationContextANGLE) \
+    X(PFNGLUSEPROGRAMSTAGESCONTEXTANGLEPROC, glUseProgramStagesContextANGLE) \
+    X(PFNGLACTIVESHADERPROGRAMCONTEXTANGLEPROC, glActiveShaderProgramContextANGLE) \
+    X(PFNGLCREATESHADERPROGRAMVCONTEXTANGLEPROC, glCreateShaderProgramvContextANGLE) \
+    X(PFNGLBINDPROGRAMPIPELINECONTEXTANGLEPROC, glBindProgramPipelineContextANGLE) \
+    X(PFNGLDELETEPROGRAMPIPELINESCONTEXTANGLEPROC, glDeleteProgramPipelinesContextANGLE) \
+    X(PFNGLGENPROGRAMPIPELINESCONTEXTANGLEPROC, glGenProgramPipelinesContextANGLE) \
+    X(PFNGLISPROGRAMPIPELINECONTEXTANGLEPROC, glIsProgramPipelineContextANGLE) \
+    X(PFNGLGETPROGRAMPIPELINEIVCONTEXTANGLEPROC, glGetProgramPipelineivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1ICONTEXTANGLEPROC, glProgramUniform1iContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2ICONTEXTANGLEPROC, glProgramUniform2iContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3ICONTEXTANGLEPROC, glProgramUniform3iContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4ICONTEXTANGLEPROC, glProgramUniform4iContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1UICONTEXTANGLEPROC, glProgramUniform1uiContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2UICONTEXTANGLEPROC, glProgramUniform2uiContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3UICONTEXTANGLEPROC, glProgramUniform3uiContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4UICONTEXTANGLEPROC, glProgramUniform4uiContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1FCONTEXTANGLEPROC, glProgramUniform1fContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2FCONTEXTANGLEPROC, glProgramUniform2fContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3FCONTEXTANGLEPROC, glProgramUniform3fContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4FCONTEXTANGLEPROC, glProgramUniform4fContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1IVCONTEXTANGLEPROC, glProgramUniform1ivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2IVCONTEXTANGLEPROC, glProgramUniform2ivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3IVCONTEXTANGLEPROC, glProgramUniform3ivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4IVCONTEXTANGLEPROC, glProgramUniform4ivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1UIVCONTEXTANGLEPROC, glProgramUniform1uivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2UIVCONTEXTANGLEPROC, glProgramUniform2uivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3UIVCONTEXTANGLEPROC, glProgramUniform3uivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4UIVCONTEXTANGLEPROC, glProgramUniform4uivContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM1FVCONTEXTANGLEPROC, glProgramUniform1fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM2FVCONTEXTANGLEPROC, glProgramUniform2fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM3FVCONTEXTANGLEPROC, glProgramUniform3fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORM4FVCONTEXTANGLEPROC, glProgramUniform4fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2FVCONTEXTANGLEPROC, glProgramUniformMatrix2fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3FVCONTEXTANGLEPROC, glProgramUniformMatrix3fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4FVCONTEXTANGLEPROC, glProgramUniformMatrix4fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2X3FVCONTEXTANGLEPROC, glProgramUniformMatrix2x3fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3X2FVCONTEXTANGLEPROC, glProgramUniformMatrix3x2fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX2X4FVCONTEXTANGLEPROC, glProgramUniformMatrix2x4fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4X2FVCONTEXTANGLEPROC, glProgramUniformMatrix4x2fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX3X4FVCONTEXTANGLEPROC, glProgramUniformMatrix3x4fvContextANGLE) \
+    X(PFNGLPROGRAMUNIFORMMATRIX4X3FVCONTEXTANGLEPROC, glProgramUniformMatrix4x3fvContextANGLE) \
+    X(PFNGLVALIDATEPROGRAMPIPELINECONTEXTANGLEPROC, glValidateProgramPipelineContextANGLE) \
+    X(PFNGLGETPROGRAMPIPELINEINFOLOGCONTEXTANGLEPROC, glGetProgramPipelineInfoLogContextANGLE) \
+    X(PFNGLBINDIMAGETEXTURECONTEXTANGLEPROC, glBindImageTextureContextANGLE) \
+    X(PFNGLGETBOOLEANI_VCONTEXTANGLEPROC, glGetBooleani_vContextANGLE) \
+    X(PFNGLMEMORYBARRIERCONTEXTANGLEPROC, glMemoryBarrierContextANGLE) \
+    X(PFNGLMEMORYBARRIERBYREGIONCONTEXTANGLEPROC, glMemoryBarrierByRegionContextANGLE) \
+    X(PFNGLTEXSTORAGE2DMULTISAMPLECONTEXTANGLEPROC, glTexStorage2DMultisampleContextANGLE) \
+    X(PFNGLGETMULTISAMPLEFVCONTEXTANGLEPROC, glGetMultisamplefvContextANGLE) \
+    X(PFNGLSAMPLEMASKICONTEXTANGLEPROC, glSampleMaskiContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERIVCONTEXTANGLEPROC, glGetTexLevelParameterivContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERFVCONTEXTANGLEPROC, glGetTexLevelParameterfvContextANGLE) \
+    X(PFNGLBINDVERTEXBUFFERCONTEXTANGLEPROC, glBindVertexBufferContextANGLE) \
+    X(PFNGLVERTEXATTRIBFORMATCONTEXTANGLEPROC, glVertexAttribFormatContextANGLE) \
+    X(PFNGLVERTEXATTRIBIFORMATCONTEXTANGLEPROC, glVertexAttribIFormatContextANGLE) \
+    X(PFNGLVERTEXATTRIBBINDINGCONTEXTANGLEPROC, glVertexAttribBindingContextANGLE) \
+    X(PFNGLVERTEXBINDINGDIVISORCONTEXTANGLEPROC, glVertexBindingDivisorContextANGLE) \
+    X(PFNGLCOPYSUBTEXTURE3DANGLECONTEXTANGLEPROC, glCopySubTexture3DANGLEContextANGLE) \
+    X(PFNGLCOPYTEXTURE3DANGLECONTEXTANGLEPROC, glCopyTexture3DANGLEContextANGLE) \
+    X(PFNGLBLITFRAMEBUFFERANGLECONTEXTANGLEPROC, glBlitFramebufferANGLEContextANGLE) \
+    X(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEANGLECONTEXTANGLEPROC, glRenderbufferStorageMultisampleANGLEContextANGLE) \
+    X(PFNGLDRAWARRAYSINSTANCEDANGLECONTEXTANGLEPROC, glDrawArraysInstancedANGLEContextANGLE) \
+    X(PFNGLDRAWELEMENTSINSTANCEDANGLECONTEXTANGLEPROC, glDrawElementsInstancedANGLEContextANGLE) \
+    X(PFNGLVERTEXATTRIBDIVISORANGLECONTEXTANGLEPROC, glVertexAttribDivisorANGLEContextANGLE) \
+    X(PFNGLMULTIDRAWARRAYSANGLECONTEXTANGLEPROC, glMultiDrawArraysANGLEContextANGLE) \
+    X(PFNGLMULTIDRAWARRAYSINSTANCEDANGLECONTEXTANGLEPROC, glMultiDrawArraysInstancedANGLEContextANGLE) \
+    X(PFNGLMULTIDRAWELEMENTSANGLECONTEXTANGLEPROC, glMultiDrawElementsANGLEContextANGLE) \
+    X(PFNGLMULTIDRAWELEMENTSINSTANCEDANGLECONTEXTANGLEPROC, glMultiDrawElementsInstancedANGLEContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWLAYEREDANGLECONTEXTANGLEPROC, glFramebufferTextureMultiviewLayeredANGLEContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWSIDEBYSIDEANGLECONTEXTANGLEPROC, glFramebufferTextureMultiviewSideBySideANGLEContextANGLE) \
+    X(PFNGLPROVOKINGVERTEXANGLECONTEXTANGLEPROC, glProvokingVertexANGLEContextANGLE) \
+    X(PFNGLREQUESTEXTENSIONANGLECONTEXTANGLEPROC, glRequestExtensionANGLEContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE2DROBUSTANGLECONTEXTANGLEPROC, glCompressedTexImage2DRobustANGLEContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXIMAGE3DROBUSTANGLECONTEXTANGLEPROC, glCompressedTexImage3DRobustANGLEContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE2DROBUSTANGLECONTEXTANGLEPROC, glCompressedTexSubImage2DRobustANGLEContextANGLE) \
+    X(PFNGLCOMPRESSEDTEXSUBIMAGE3DROBUSTANGLECONTEXTANGLEPROC, glCompressedTexSubImage3DRobustANGLEContextANGLE) \
+    X(PFNGLGETACTIVEUNIFORMBLOCKIVROBUSTANGLECONTEXTANGLEPROC, glGetActiveUniformBlockivRobustANGLEContextANGLE) \
+    X(PFNGLGETBOOLEANI_VROBUSTANGLECONTEXTANGLEPROC, glGetBooleani_vRobustANGLEContextANGLE) \
+    X(PFNGLGETBOOLEANVROBUSTANGLECONTEXTANGLEPROC, glGetBooleanvRobustANGLEContextANGLE) \
+    X(PFNGLGETBUFFERPARAMETERI64VROBUSTANGLECONTEXTANGLEPROC, glGetBufferParameteri64vRobustANGLEContextANGLE) \
+    X(PFNGLGETBUFFERPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetBufferParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETBUFFERPOINTERVROBUSTANGLECONTEXTANGLEPROC, glGetBufferPointervRobustANGLEContextANGLE) \
+    X(PFNGLGETFLOATVROBUSTANGLECONTEXTANGLEPROC, glGetFloatvRobustANGLEContextANGLE) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetFramebufferAttachmentParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETFRAMEBUFFERPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetFramebufferParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETINTEGER64I_VROBUSTANGLECONTEXTANGLEPROC, glGetInteger64i_vRobustANGLEContextANGLE) \
+    X(PFNGLGETINTEGER64VROBUSTANGLECONTEXTANGLEPROC, glGetInteger64vRobustANGLEContextANGLE) \
+    X(PFNGLGETINTEGERI_VROBUSTANGLECONTEXTANGLEPROC, glGetIntegeri_vRobustANGLEContextANGLE) \
+    X(PFNGLGETINTEGERVROBUSTANGLECONTEXTANGLEPROC, glGetIntegervRobustANGLEContextANGLE) \
+    X(PFNGLGETINTERNALFORMATIVROBUSTANGLECONTEXTANGLEPROC, glGetInternalformativRobustANGLEContextANGLE) \
+    X(PFNGLGETMULTISAMPLEFVROBUSTANGLECONTEXTANGLEPROC, glGetMultisamplefvRobustANGLEContextANGLE) \
+    X(PFNGLGETPOINTERVROBUSTANGLEROBUSTANGLECONTEXTANGLEPROC, glGetPointervRobustANGLERobustANGLEContextANGLE) \
+    X(PFNGLGETPROGRAMINTERFACEIVROBUSTANGLECONTEXTANGLEPROC, glGetProgramInterfaceivRobustANGLEContextANGLE) \
+    X(PFNGLGETPROGRAMIVROBUSTANGLECONTEXTANGLEPROC, glGetProgramivRobustANGLEContextANGLE) \
+    X(PFNGLGETQUERYOBJECTI64VROBUSTANGLECONTEXTANGLEPROC, glGetQueryObjecti64vRobustANGLEContextANGLE) \
+    X(PFNGLGETQUERYOBJECTIVROBUSTANGLECONTEXTANGLEPROC, glGetQueryObjectivRobustANGLEContextANGLE) \
+    X(PFNGLGETQUERYOBJECTUI64VROBUSTANGLECONTEXTANGLEPROC, glGetQueryObjectui64vRobustANGLEContextANGLE) \
+    X(PFNGLGETQUERYOBJECTUIVROBUSTANGLECONTEXTANGLEPROC, glGetQueryObjectuivRobustANGLEContextANGLE) \
+    X(PFNGLGETQUERYIVROBUSTANGLECONTEXTANGLEPROC, glGetQueryivRobustANGLEContextANGLE) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetRenderbufferParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIIVROBUSTANGLECONTEXTANGLEPROC, glGetSamplerParameterIivRobustANGLEContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIUIVROBUSTANGLECONTEXTANGLEPROC, glGetSamplerParameterIuivRobustANGLEContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERFVROBUSTANGLECONTEXTANGLEPROC, glGetSamplerParameterfvRobustANGLEContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetSamplerParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETSHADERIVROBUSTANGLECONTEXTANGLEPROC, glGetShaderivRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERFVROBUSTANGLECONTEXTANGLEPROC, glGetTexLevelParameterfvRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetTexLevelParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIIVROBUSTANGLECONTEXTANGLEPROC, glGetTexParameterIivRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIUIVROBUSTANGLECONTEXTANGLEPROC, glGetTexParameterIuivRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXPARAMETERFVROBUSTANGLECONTEXTANGLEPROC, glGetTexParameterfvRobustANGLEContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glGetTexParameterivRobustANGLEContextANGLE) \
+    X(PFNGLGETUNIFORMFVROBUSTANGLECONTEXTANGLEPROC, glGetUniformfvRobustANGLEContextANGLE) \
+    X(PFNGLGETUNIFORMIVROBUSTANGLECONTEXTANGLEPROC, glGetUniformivRobustANGLEContextANGLE) \
+    X(PFNGLGETUNIFORMUIVROBUSTANGLECONTEXTANGLEPROC, glGetUniformuivRobustANGLEContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIIVROBUSTANGLECONTEXTANGLEPROC, glGetVertexAttribIivRobustANGLEContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIUIVROBUSTANGLECONTEXTANGLEPROC, glGetVertexAttribIuivRobustANGLEContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBPOINTERVROBUSTANGLECONTEXTANGLEPROC, glGetVertexAttribPointervRobustANGLEContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBFVROBUSTANGLECONTEXTANGLEPROC, glGetVertexAttribfvRobustANGLEContextANGLE) \
+    X(PFNGLGETVERTEXATTRIBIVROBUSTANGLECONTEXTANGLEPROC, glGetVertexAttribivRobustANGLEContextANGLE) \
+    X(PFNGLGETNUNIFORMFVROBUSTANGLECONTEXTANGLEPROC, glGetnUniformfvRobustANGLEContextANGLE) \
+    X(PFNGLGETNUNIFORMIVROBUSTANGLECONTEXTANGLEPROC, glGetnUniformivRobustANGLEContextANGLE) \
+    X(PFNGLGETNUNIFORMUIVROBUSTANGLECONTEXTANGLEPROC, glGetnUniformuivRobustANGLEContextANGLE) \
+    X(PFNGLREADPIXELSROBUSTANGLECONTEXTANGLEPROC, glReadPixelsRobustANGLEContextANGLE) \
+    X(PFNGLREADNPIXELSROBUSTANGLECONTEXTANGLEPROC, glReadnPixelsRobustANGLEContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIIVROBUSTANGLECONTEXTANGLEPROC, glSamplerParameterIivRobustANGLEContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIUIVROBUSTANGLECONTEXTANGLEPROC, glSamplerParameterIuivRobustANGLEContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERFVROBUSTANGLECONTEXTANGLEPROC, glSamplerParameterfvRobustANGLEContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glSamplerParameterivRobustANGLEContextANGLE) \
+    X(PFNGLTEXIMAGE2DROBUSTANGLECONTEXTANGLEPROC, glTexImage2DRobustANGLEContextANGLE) \
+    X(PFNGLTEXIMAGE3DROBUSTANGLECONTEXTANGLEPROC, glTexImage3DRobustANGLEContextANGLE) \
+    X(PFNGLTEXPARAMETERIIVROBUSTANGLECONTEXTANGLEPROC, glTexParameterIivRobustANGLEContextANGLE) \
+    X(PFNGLTEXPARAMETERIUIVROBUSTANGLECONTEXTANGLEPROC, glTexParameterIuivRobustANGLEContextANGLE) \
+    X(PFNGLTEXPARAMETERFVROBUSTANGLECONTEXTANGLEPROC, glTexParameterfvRobustANGLEContextANGLE) \
+    X(PFNGLTEXPARAMETERIVROBUSTANGLECONTEXTANGLEPROC, glTexParameterivRobustANGLEContextANGLE) \
+    X(PFNGLTEXSUBIMAGE2DROBUSTANGLECONTEXTANGLEPROC, glTexSubImage2DRobustANGLEContextANGLE) \
+    X(PFNGLTEXSUBIMAGE3DROBUSTANGLECONTEXTANGLEPROC, glTexSubImage3DRobustANGLEContextANGLE) \
+    X(PFNGLGETMULTISAMPLEFVANGLECONTEXTANGLEPROC, glGetMultisamplefvANGLEContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERFVANGLECONTEXTANGLEPROC, glGetTexLevelParameterfvANGLEContextANGLE) \
+    X(PFNGLGETTEXLEVELPARAMETERIVANGLECONTEXTANGLEPROC, glGetTexLevelParameterivANGLEContextANGLE) \
+    X(PFNGLSAMPLEMASKIANGLECONTEXTANGLEPROC, glSampleMaskiANGLEContextANGLE) \
+    X(PFNGLTEXSTORAGE2DMULTISAMPLEANGLECONTEXTANGLEPROC, glTexStorage2DMultisampleANGLEContextANGLE) \
+    X(PFNGLGETTRANSLATEDSHADERSOURCEANGLECONTEXTANGLEPROC, glGetTranslatedShaderSourceANGLEContextANGLE) \
+    X(PFNGLBINDUNIFORMLOCATIONCHROMIUMCONTEXTANGLEPROC, glBindUniformLocationCHROMIUMContextANGLE) \
+    X(PFNGLCOMPRESSEDCOPYTEXTURECHROMIUMCONTEXTANGLEPROC, glCompressedCopyTextureCHROMIUMContextANGLE) \
+    X(PFNGLCOPYSUBTEXTURECHROMIUMCONTEXTANGLEPROC, glCopySubTextureCHROMIUMContextANGLE) \
+    X(PFNGLCOPYTEXTURECHROMIUMCONTEXTANGLEPROC, glCopyTextureCHROMIUMContextANGLE) \
+    X(PFNGLCOVERAGEMODULATIONCHROMIUMCONTEXTANGLEPROC, glCoverageModulationCHROMIUMContextANGLE) \
+    X(PFNGLMATRIXLOADIDENTITYCHROMIUMCONTEXTANGLEPROC, glMatrixLoadIdentityCHROMIUMContextANGLE) \
+    X(PFNGLMATRIXLOADFCHROMIUMCONTEXTANGLEPROC, glMatrixLoadfCHROMIUMContextANGLE) \
+    X(PFNGLBINDFRAGMENTINPUTLOCATIONCHROMIUMCONTEXTANGLEPROC, glBindFragmentInputLocationCHROMIUMContextANGLE) \
+    X(PFNGLCOVERFILLPATHCHROMIUMCONTEXTANGLEPROC, glCoverFillPathCHROMIUMContextANGLE) \
+    X(PFNGLCOVERFILLPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glCoverFillPathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLCOVERSTROKEPATHCHROMIUMCONTEXTANGLEPROC, glCoverStrokePathCHROMIUMContextANGLE) \
+    X(PFNGLCOVERSTROKEPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glCoverStrokePathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLDELETEPATHSCHROMIUMCONTEXTANGLEPROC, glDeletePathsCHROMIUMContextANGLE) \
+    X(PFNGLGENPATHSCHROMIUMCONTEXTANGLEPROC, glGenPathsCHROMIUMContextANGLE) \
+    X(PFNGLGETPATHPARAMETERFVCHROMIUMCONTEXTANGLEPROC, glGetPathParameterfvCHROMIUMContextANGLE) \
+    X(PFNGLGETPATHPARAMETERIVCHROMIUMCONTEXTANGLEPROC, glGetPathParameterivCHROMIUMContextANGLE) \
+    X(PFNGLISPATHCHROMIUMCONTEXTANGLEPROC, glIsPathCHROMIUMContextANGLE) \
+    X(PFNGLPATHCOMMANDSCHROMIUMCONTEXTANGLEPROC, glPathCommandsCHROMIUMContextANGLE) \
+    X(PFNGLPATHPARAMETERFCHROMIUMCONTEXTANGLEPROC, glPathParameterfCHROMIUMContextANGLE) \
+    X(PFNGLPATHPARAMETERICHROMIUMCONTEXTANGLEPROC, glPathParameteriCHROMIUMContextANGLE) \
+    X(PFNGLPATHSTENCILFUNCCHROMIUMCONTEXTANGLEPROC, glPathStencilFuncCHROMIUMContextANGLE) \
+    X(PFNGLPROGRAMPATHFRAGMENTINPUTGENCHROMIUMCONTEXTANGLEPROC, glProgramPathFragmentInputGenCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILFILLPATHCHROMIUMCONTEXTANGLEPROC, glStencilFillPathCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILFILLPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glStencilFillPathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILSTROKEPATHCHROMIUMCONTEXTANGLEPROC, glStencilStrokePathCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILSTROKEPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glStencilStrokePathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILTHENCOVERFILLPATHCHROMIUMCONTEXTANGLEPROC, glStencilThenCoverFillPathCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILTHENCOVERFILLPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glStencilThenCoverFillPathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILTHENCOVERSTROKEPATHCHROMIUMCONTEXTANGLEPROC, glStencilThenCoverStrokePathCHROMIUMContextANGLE) \
+    X(PFNGLSTENCILTHENCOVERSTROKEPATHINSTANCEDCHROMIUMCONTEXTANGLEPROC, glStencilThenCoverStrokePathInstancedCHROMIUMContextANGLE) \
+    X(PFNGLBINDFRAGDATALOCATIONEXTCONTEXTANGLEPROC, glBindFragDataLocationEXTContextANGLE) \
+    X(PFNGLBINDFRAGDATALOCATIONINDEXEDEXTCONTEXTANGLEPROC, glBindFragDataLocationIndexedEXTContextANGLE) \
+    X(PFNGLGETFRAGDATAINDEXEXTCONTEXTANGLEPROC, glGetFragDataIndexEXTContextANGLE) \
+    X(PFNGLGETPROGRAMRESOURCELOCATIONINDEXEXTCONTEXTANGLEPROC, glGetProgramResourceLocationIndexEXTContextANGLE) \
+    X(PFNGLINSERTEVENTMARKEREXTCONTEXTANGLEPROC, glInsertEventMarkerEXTContextANGLE) \
+    X(PFNGLPOPGROUPMARKEREXTCONTEXTANGLEPROC, glPopGroupMarkerEXTContextANGLE) \
+    X(PFNGLPUSHGROUPMARKEREXTCONTEXTANGLEPROC, glPushGroupMarkerEXTContextANGLE) \
+    X(PFNGLDISCARDFRAMEBUFFEREXTCONTEXTANGLEPROC, glDiscardFramebufferEXTContextANGLE) \
+    X(PFNGLBEGINQUERYEXTCONTEXTANGLEPROC, glBeginQueryEXTContextANGLE) \
+    X(PFNGLDELETEQUERIESEXTCONTEXTANGLEPROC, glDeleteQueriesEXTContextANGLE) \
+    X(PFNGLENDQUERYEXTCONTEXTANGLEPROC, glEndQueryEXTContextANGLE) \
+    X(PFNGLGENQUERIESEXTCONTEXTANGLEPROC, glGenQueriesEXTContextANGLE) \
+    X(PFNGLGETQUERYOBJECTI64VEXTCONTEXTANGLEPROC, glGetQueryObjecti64vEXTContextANGLE) \
+    X(PFNGLGETQUERYOBJECTIVEXTCONTEXTANGLEPROC, glGetQueryObjectivEXTContextANGLE) \
+    X(PFNGLGETQUERYOBJECTUI64VEXTCONTEXTANGLEPROC, glGetQueryObjectui64vEXTContextANGLE) \
+    X(PFNGLGETQUERYOBJECTUIVEXTCONTEXTANGLEPROC, glGetQueryObjectuivEXTContextANGLE) \
+    X(PFNGLGETQUERYIVEXTCONTEXTANGLEPROC, glGetQueryivEXTContextANGLE) \
+    X(PFNGLISQUERYEXTCONTEXTANGLEPROC, glIsQueryEXTContextANGLE) \
+    X(PFNGLQUERYCOUNTEREXTCONTEXTANGLEPROC, glQueryCounterEXTContextANGLE) \
+    X(PFNGLDRAWBUFFERSEXTCONTEXTANGLEPROC, glDrawBuffersEXTContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTUREEXTCONTEXTANGLEPROC, glFramebufferTextureEXTContextANGLE) \
+    X(PFNGLFLUSHMAPPEDBUFFERRANGEEXTCONTEXTANGLEPROC, glFlushMappedBufferRangeEXTContextANGLE) \
+    X(PFNGLMAPBUFFERRANGEEXTCONTEXTANGLEPROC, glMapBufferRangeEXTContextANGLE) \
+    X(PFNGLGETGRAPHICSRESETSTATUSEXTCONTEXTANGLEPROC, glGetGraphicsResetStatusEXTContextANGLE) \
+    X(PFNGLGETNUNIFORMFVEXTCONTEXTANGLEPROC, glGetnUniformfvEXTContextANGLE) \
+    X(PFNGLGETNUNIFORMIVEXTCONTEXTANGLEPROC, glGetnUniformivEXTContextANGLE) \
+    X(PFNGLREADNPIXELSEXTCONTEXTANGLEPROC, glReadnPixelsEXTContextANGLE) \
+    X(PFNGLTEXSTORAGE1DEXTCONTEXTANGLEPROC, glTexStorage1DEXTContextANGLE) \
+    X(PFNGLTEXSTORAGE2DEXTCONTEXTANGLEPROC, glTexStorage2DEXTContextANGLE) \
+    X(PFNGLTEXSTORAGE3DEXTCONTEXTANGLEPROC, glTexStorage3DEXTContextANGLE) \
+    X(PFNGLDEBUGMESSAGECALLBACKKHRCONTEXTANGLEPROC, glDebugMessageCallbackKHRContextANGLE) \
+    X(PFNGLDEBUGMESSAGECONTROLKHRCONTEXTANGLEPROC, glDebugMessageControlKHRContextANGLE) \
+    X(PFNGLDEBUGMESSAGEINSERTKHRCONTEXTANGLEPROC, glDebugMessageInsertKHRContextANGLE) \
+    X(PFNGLGETDEBUGMESSAGELOGKHRCONTEXTANGLEPROC, glGetDebugMessageLogKHRContextANGLE) \
+    X(PFNGLGETOBJECTLABELKHRCONTEXTANGLEPROC, glGetObjectLabelKHRContextANGLE) \
+    X(PFNGLGETOBJECTPTRLABELKHRCONTEXTANGLEPROC, glGetObjectPtrLabelKHRContextANGLE) \
+    X(PFNGLGETPOINTERVKHRCONTEXTANGLEPROC, glGetPointervKHRContextANGLE) \
+    X(PFNGLOBJECTLABELKHRCONTEXTANGLEPROC, glObjectLabelKHRContextANGLE) \
+    X(PFNGLOBJECTPTRLABELKHRCONTEXTANGLEPROC, glObjectPtrLabelKHRContextANGLE) \
+    X(PFNGLPOPDEBUGGROUPKHRCONTEXTANGLEPROC, glPopDebugGroupKHRContextANGLE) \
+    X(PFNGLPUSHDEBUGGROUPKHRCONTEXTANGLEPROC, glPushDebugGroupKHRContextANGLE) \
+    X(PFNGLMAXSHADERCOMPILERTHREADSKHRCONTEXTANGLEPROC, glMaxShaderCompilerThreadsKHRContextANGLE) \
+    X(PFNGLDELETEFENCESNVCONTEXTANGLEPROC, glDeleteFencesNVContextANGLE) \
+    X(PFNGLFINISHFENCENVCONTEXTANGLEPROC, glFinishFenceNVContextANGLE) \
+    X(PFNGLGENFENCESNVCONTEXTANGLEPROC, glGenFencesNVContextANGLE) \
+    X(PFNGLGETFENCEIVNVCONTEXTANGLEPROC, glGetFenceivNVContextANGLE) \
+    X(PFNGLISFENCENVCONTEXTANGLEPROC, glIsFenceNVContextANGLE) \
+    X(PFNGLSETFENCENVCONTEXTANGLEPROC, glSetFenceNVContextANGLE) \
+    X(PFNGLTESTFENCENVCONTEXTANGLEPROC, glTestFenceNVContextANGLE) \
+    X(PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESCONTEXTANGLEPROC, glEGLImageTargetRenderbufferStorageOESContextANGLE) \
+    X(PFNGLEGLIMAGETARGETTEXTURE2DOESCONTEXTANGLEPROC, glEGLImageTargetTexture2DOESContextANGLE) \
+    X(PFNGLGETPROGRAMBINARYOESCONTEXTANGLEPROC, glGetProgramBinaryOESContextANGLE) \
+    X(PFNGLPROGRAMBINARYOESCONTEXTANGLEPROC, glProgramBinaryOESContextANGLE) \
+    X(PFNGLGETBUFFERPOINTERVOESCONTEXTANGLEPROC, glGetBufferPointervOESContextANGLE) \
+    X(PFNGLMAPBUFFEROESCONTEXTANGLEPROC, glMapBufferOESContextANGLE) \
+    X(PFNGLUNMAPBUFFEROESCONTEXTANGLEPROC, glUnmapBufferOESContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIIVOESCONTEXTANGLEPROC, glGetSamplerParameterIivOESContextANGLE) \
+    X(PFNGLGETSAMPLERPARAMETERIUIVOESCONTEXTANGLEPROC, glGetSamplerParameterIuivOESContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIIVOESCONTEXTANGLEPROC, glGetTexParameterIivOESContextANGLE) \
+    X(PFNGLGETTEXPARAMETERIUIVOESCONTEXTANGLEPROC, glGetTexParameterIuivOESContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIIVOESCONTEXTANGLEPROC, glSamplerParameterIivOESContextANGLE) \
+    X(PFNGLSAMPLERPARAMETERIUIVOESCONTEXTANGLEPROC, glSamplerParameterIuivOESContextANGLE) \
+    X(PFNGLTEXPARAMETERIIVOESCONTEXTANGLEPROC, glTexParameterIivOESContextANGLE) \
+    X(PFNGLTEXPARAMETERIUIVOESCONTEXTANGLEPROC, glTexParameterIuivOESContextANGLE) \
+    X(PFNGLTEXSTORAGE3DMULTISAMPLEOESCONTEXTANGLEPROC, glTexStorage3DMultisampleOESContextANGLE) \
+    X(PFNGLBINDVERTEXARRAYOESCONTEXTANGLEPROC, glBindVertexArrayOESContextANGLE) \
+    X(PFNGLDELETEVERTEXARRAYSOESCONTEXTANGLEPROC, glDeleteVertexArraysOESContextANGLE) \
+    X(PFNGLGENVERTEXARRAYSOESCONTEXTANGLEPROC, glGenVertexArraysOESContextANGLE) \
+    X(PFNGLISVERTEXARRAYOESCONTEXTANGLEPROC, glIsVertexArrayOESContextANGLE) \
+    X(PFNGLDRAWTEXFOESCONTEXTANGLEPROC, glDrawTexfOESContextANGLE) \
+    X(PFNGLDRAWTEXFVOESCONTEXTANGLEPROC, glDrawTexfvOESContextANGLE) \
+    X(PFNGLDRAWTEXIOESCONTEXTANGLEPROC, glDrawTexiOESContextANGLE) \
+    X(PFNGLDRAWTEXIVOESCONTEXTANGLEPROC, glDrawTexivOESContextANGLE) \
+    X(PFNGLDRAWTEXSOESCONTEXTANGLEPROC, glDrawTexsOESContextANGLE) \
+    X(PFNGLDRAWTEXSVOESCONTEXTANGLEPROC, glDrawTexsvOESContextANGLE) \
+    X(PFNGLDRAWTEXXOESCONTEXTANGLEPROC, glDrawTexxOESContextANGLE) \
+    X(PFNGLDRAWTEXXVOESCONTEXTANGLEPROC, glDrawTexxvOESContextANGLE) \
+    X(PFNGLBINDFRAMEBUFFEROESCONTEXTANGLEPROC, glBindFramebufferOESContextANGLE) \
+    X(PFNGLBINDRENDERBUFFEROESCONTEXTANGLEPROC, glBindRenderbufferOESContextANGLE) \
+    X(PFNGLCHECKFRAMEBUFFERSTATUSOESCONTEXTANGLEPROC, glCheckFramebufferStatusOESContextANGLE) \
+    X(PFNGLDELETEFRAMEBUFFERSOESCONTEXTANGLEPROC, glDeleteFramebuffersOESContextANGLE) \
+    X(PFNGLDELETERENDERBUFFERSOESCONTEXTANGLEPROC, glDeleteRenderbuffersOESContextANGLE) \
+    X(PFNGLFRAMEBUFFERRENDERBUFFEROESCONTEXTANGLEPROC, glFramebufferRenderbufferOESContextANGLE) \
+    X(PFNGLFRAMEBUFFERTEXTURE2DOESCONTEXTANGLEPROC, glFramebufferTexture2DOESContextANGLE) \
+    X(PFNGLGENFRAMEBUFFERSOESCONTEXTANGLEPROC, glGenFramebuffersOESContextANGLE) \
+    X(PFNGLGENRENDERBUFFERSOESCONTEXTANGLEPROC, glGenRenderbuffersOESContextANGLE) \
+    X(PFNGLGENERATEMIPMAPOESCONTEXTANGLEPROC, glGenerateMipmapOESContextANGLE) \
+    X(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVOESCONTEXTANGLEPROC, glGetFramebufferAttachmentParameterivOESContextANGLE) \
+    X(PFNGLGETRENDERBUFFERPARAMETERIVOESCONTEXTANGLEPROC, glGetRenderbufferParameterivOESContextANGLE) \
+    X(PFNGLISFRAMEBUFFEROESCONTEXTANGLEPROC, glIsFramebufferOESContextANGLE) \
+    X(PFNGLISRENDERBUFFEROESCONTEXTANGLEPROC, glIsRenderbufferOESContextANGLE) \
+    X(PFNGLRENDERBUFFERSTORAGEOESCONTEXTANGLEPROC, glRenderbufferStorageOESContextANGLE) \
+    X(PFNGLCURRENTPALETTEMATRIXOESCONTEXTANGLEPROC, glCurrentPaletteMatrixOESContextANGLE) \
+    X(PFNGLLOADPALETTEFROMMODELVIEWMATRIXOESCONTEXTANGLEPROC, glLoadPaletteFromModelViewMatrixOESContextANGLE) \
+    X(PFNGLMATRIXINDEXPOINTEROESCONTEXTANGLEPROC, glMatrixIndexPointerOESContextANGLE) \
+    X(PFNGLWEIGHTPOINTEROESCONTEXTANGLEPROC, glWeightPointerOESContextANGLE) \
+    X(PFNGLPOINTSIZEPOINTEROESCONTEXTANGLEPROC, glPointSizePointerOESContextANGLE) \
+    X(PFNGLQUERYMATRIXXOESCONTEXTANGLEPROC, glQueryMatrixxOESContextANGLE) \
+    X(PFNGLGETTEXGENFVOESCONTEXTANGLEPROC, glGetTexGenfvOESContextANGLE) \
+    X(PFNGLGETTEXGENIVOESCONTEXTANGLEPROC, glGetTexGenivOESContextANGLE) \
+    X(PFNGLGETTEXGENXVOESCONTEXTANGLEPROC, glGetTexGenxvOESContextANGLE) \
+    X(PFNGLTEXGENFOESCONTEXTANGLEPROC, glTexGenfOESContextANGLE) \
+    X(PFNGLTEXGENFVOESCONTEXTANGLEPROC, glTexGenfvOESContextANGLE) \
+    X(PFNGLTEXGENIOESCONTEXTANGLEPROC, glTexGeniOESContextANGLE) \
+    X(PFNGLTEXGENIVOESCONTEXTANGLEPROC, glTexGenivOESContextANGLE) \
+    X(PFNGLTEXGENXOESCONTEXTANGLEPROC, glTexGenxOESContextANGLE) \
+    X(PFNGLTEXGENXVOESCONTEXTANGLEPROC, glTexGenxvOESContextANGLE)
+
+#endif  // UTIL_GLES_ENTRY_POINTS_AUTOGEN_H_
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// gles_loader_lazy.cpp: Resolves GLES entry points on their first call instead of all up front.
+
+#include "util/gles_loader_lazy.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+
+#include "util/gles_entry_points_autogen.h"
+
+namespace angle
+{
+namespace
+{
+enum EntryPointIndex : size_t
+{
+#define ANGLE_ENTRY_POINT_INDEX(Proc, name) kEntryPoint_##name,
+    ANGLE_GLES_ENTRY_POINTS(ANGLE_ENTRY_POINT_INDEX)
+#undef ANGLE_ENTRY_POINT_INDEX
+        kEntryPointCount
+};
+
+const char *const kEntryPointNames[kEntryPointCount] = {
+#define ANGLE_ENTRY_POINT_NAME(Proc, name) #name,
+    ANGLE_GLES_ENTRY_POINTS(ANGLE_ENTRY_POINT_NAME)
+#undef ANGLE_ENTRY_POINT_NAME
+};
+
+std::atomic<LoadProc> gLoadProc(nullptr);
+std::atomic<GenericProc> gResolved[kEntryPointCount];
+std::atomic<size_t> gResolvedCount(0);
+std::atomic<uint64_t> gResolveTimeNs(0);
+
+// Two threads may race to resolve the same entry point, both get the same answer
+GenericProc Resolve(size_t index)
+{
+    GenericProc proc = gResolved[index].load(std::memory_order_acquire);
+    if (proc)
+    {
+        return proc;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    proc = gLoadProc.load(std::memory_order_acquire)(kEntryPointNames[index]);
+    gResolveTimeNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count(),
+                             std::memory_order_relaxed);
+
+    GenericProc expected = nullptr;
+    if (proc && gResolved[index].compare_exchange_strong(expected, proc))
+    {
+        gResolvedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return proc;
+}
+
+template <typename Proc, Proc *Slot, size_t Index>
+struct LazyEntryPoint;
+
+// Calling an entry point the driver does not have crashes, as it would with a null pointer
+template <typename Return, typename... Args, Return(KHRONOS_APIENTRY **Slot)(Args...), size_t Index>
+struct LazyEntryPoint<Return(KHRONOS_APIENTRY *)(Args...), Slot, Index>
+{
+    using Proc = Return(KHRONOS_APIENTRY *)(Args...);
+
+    static Return KHRONOS_APIENTRY Stub(Args... args)
+    {
+        Proc proc = reinterpret_cast<Proc>(Resolve(Index));
+        if (*Slot == &Stub)
+        {
+            *Slot = proc;
+        }
+        return proc(args...);
+    }
+};
+}  // anonymous namespace
+
+void LoadGLESLazy(LoadProc loadProc)
+{
+    gLoadProc.store(loadProc, std::memory_order_release);
+    for (std::atomic<GenericProc> &resolved : gResolved)
+    {
+        resolved.store(nullptr, std::memory_order_relaxed);
+    }
+    gResolvedCount.store(0, std::memory_order_relaxed);
+    gResolveTimeNs.store(0, std::memory_order_relaxed);
+
+#define ANGLE_INSTALL_STUB(Proc, name) \
+    name = &LazyEntryPoint<Proc, &name, kEntryPoint_##name>::Stub;
+    ANGLE_GLES_ENTRY_POINTS(ANGLE_INSTALL_STUB)
+#undef ANGLE_INSTALL_STUB
+}
+
+GLESLazyLoaderStats GetGLESLazyLoaderStats()
+{
+    GLESLazyLoaderStats stats;
+    stats.entryPoints   = kEntryPointCount;
+    stats.resolved      = gResolvedCount.load(std::memory_order_relaxed);
+    stats.resolveTimeMs = gResolveTimeNs.load(std::memory_order_relaxed) / 1e6;
+    return stats;
+}
+}  // namespace angle
@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2019 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// gles_loader_lazy.h: Resolves GLES entry points on their first call instead of all up front.
+
+#ifndef UTIL_GLES_LOADER_LAZY_H_
+#define UTIL_GLES_LOADER_LAZY_H_
+
+#include <stddef.h>
+
+#include "util/gles_loader_autogen.h"
+#include "util/util_export.h"
+
+namespace angle
+{
+// Points every entry point of gles_loader_autogen.h at a stub and returns without calling
+// loadProc. The first call of a stub resolves the real function through loadProc, puts it in
+// place of the stub and forwards the call, so later calls go straight to the driver.
+//
+// A stub that has been wrapped in the meantime, e.g. by the state cache, leaves the wrapper in
+// place and forwards to the resolved function on every call.
+//
+// Entry points are never null afterwards, so whether one exists has to come from the GL
+// version or the extension string rather than from a null check. loadProc has to stay valid
+// and safe to call from any thread that calls GL.
+ANGLE_UTIL_EXPORT void LoadGLESLazy(LoadProc loadProc);
+
+struct GLESLazyLoaderStats
+{
+    size_t entryPoints   = 0;
+    size_t resolved      = 0;
+    double resolveTimeMs = 0.0;
+};
+
+// Entry points resolved so far by the stubs and the time they spent in loadProc
+ANGLE_UTIL_EXPORT GLESLazyLoaderStats GetGLESLazyLoaderStats();
+}  // namespace angle
+
+#endif  // UTIL_GLES_LOADER_LAZY_H_
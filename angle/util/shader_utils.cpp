@@ -6,11 +6,23 @@
 
 #include "shader_utils.h"
 
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
+#include "common/platform.h"
+#include "util/EGLWindow.h"
+
+#if defined(ANGLE_PLATFORM_WINDOWS)
+#    include <direct.h>
+#else
+#    include <sys/stat.h>
+#endif
+
 namespace
 {
 std::string ReadFileToString(const std::string &source)
@@ -82,16 +94,271 @@ GLuint CompileProgramInternal(const char *vsSource,
 
     return CheckLinkStatusAndReturnProgram(program, true);
 }
-}  // namespace
 
-GLuint CompileShader(GLenum type, const char *source)
+// Program binary cache. Entries are a header followed by the binary, in a file named after
+// the key so a lookup is a single open.
+struct ProgramCacheState
 {
-    GLuint shader = glCreateShader(type);
+    std::string directory;
+    size_t hits     = 0;
+    size_t misses   = 0;
+    size_t rejected = 0;
+};
 
-    const char *sourceArray[1] = {source};
-    glShaderSource(shader, 1, sourceArray, nullptr);
-    glCompileShader(shader);
+ProgramCacheState &GetProgramCache()
+{
+    static ProgramCacheState cache;
+    return cache;
+}
+
+// Bump when the key or file layout changes, old entries then miss
+constexpr uint32_t kProgramCacheMagic   = 0x42505041;  // "APPB"
+constexpr uint32_t kProgramCacheVersion = 1;
+
+struct ProgramCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t checksum;
+    uint32_t binaryFormat;
+    uint32_t binarySize;
+};
+
+enum class ProgramBinaryAPI
+{
+    Unsupported,
+    OES,
+    ES3,
+};
+
+// 64-bit FNV-1a
+constexpr uint64_t kFNVOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kFNVPrime       = 0x100000001b3ull;
+
+uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * kFNVPrime;
+    }
+    return hash;
+}
+
+// Hashes the terminator too, so that consecutive strings cannot run into each other
+uint64_t HashString(uint64_t hash, const char *str)
+{
+    return str ? HashBytes(hash, str, strlen(str) + 1) : HashBytes(hash, "", 1);
+}
+
+const char *GetGLString(GLenum name)
+{
+    return reinterpret_cast<const char *>(glGetString(name));
+}
+
+ProgramBinaryAPI GetProgramBinaryAPI()
+{
+    ProgramBinaryAPI api = ProgramBinaryAPI::Unsupported;
+
+    if (IsGLES3OrLater() && glGetProgramBinary && glProgramBinary)
+    {
+        api = ProgramBinaryAPI::ES3;
+    }
+    else if (HasGLExtension("GL_OES_get_program_binary") && glGetProgramBinaryOES &&
+             glProgramBinaryOES)
+    {
+        api = ProgramBinaryAPI::OES;
+    }
+    else
+    {
+        // The format count enum is an error without either, and the error would stay pending
+        return ProgramBinaryAPI::Unsupported;
+    }
+
+    // Some drivers expose the entry points but no format they will accept back
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formatCount);
+    return formatCount > 0 ? api : ProgramBinaryAPI::Unsupported;
+}
+
+// Binaries are only valid for the driver that produced them, so it is part of the key
+uint64_t GetProgramCacheKey(const char *vsSource, const char *fsSource)
+{
+    uint64_t key = HashBytes(kFNVOffsetBasis, &kProgramCacheVersion, sizeof(kProgramCacheVersion));
+    key          = HashString(key, vsSource);
+    key          = HashString(key, fsSource);
+    key          = HashString(key, GetGLString(GL_VENDOR));
+    key          = HashString(key, GetGLString(GL_RENDERER));
+    key          = HashString(key, GetGLString(GL_VERSION));
+    key          = HashString(key, GetGLString(GL_SHADING_LANGUAGE_VERSION));
+    return key;
+}
+
+std::string GetProgramCachePath(uint64_t key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return GetProgramCache().directory + "/" + name;
+}
+
+GLuint LoadCachedProgram(ProgramBinaryAPI api, uint64_t key)
+{
+    const std::string path = GetProgramCachePath(key);
+    std::ifstream stream(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!stream)
+    {
+        return 0;
+    }
+
+    const std::streamoff fileSize = stream.tellg();
+    stream.seekg(0, std::ios::beg);
+
+    ProgramCacheHeader header;
+    std::vector<uint8_t> binary;
+    if (stream.read(reinterpret_cast<char *>(&header), sizeof(header)) &&
+        header.binarySize == fileSize - static_cast<std::streamoff>(sizeof(header)))
+    {
+        binary.resize(header.binarySize);
+    }
+    if (!stream || header.magic != kProgramCacheMagic || header.version != kProgramCacheVersion ||
+        header.key != key || binary.empty() ||
+        !stream.read(reinterpret_cast<char *>(binary.data()), binary.size()) ||
+        HashBytes(kFNVOffsetBasis, binary.data(), binary.size()) != header.checksum)
+    {
+        // Truncated or from another build, it is rewritten after the compile
+        stream.close();
+        remove(path.c_str());
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    if (api == ProgramBinaryAPI::ES3)
+    {
+        glProgramBinary(program, header.binaryFormat, binary.data(),
+                        static_cast<GLsizei>(binary.size()));
+    }
+    else
+    {
+        glProgramBinaryOES(program, header.binaryFormat, binary.data(),
+                           static_cast<GLint>(binary.size()));
+    }
+
+    // Drivers reject binaries after an update without changing the version strings. That is a
+    // failed link rather than an error worth reporting, the program is compiled instead.
+    GLint linkStatus = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == 0)
+    {
+        while (glGetError() != GL_NO_ERROR)
+        {
+        }
+        glDeleteProgram(program);
+        remove(path.c_str());
+        GetProgramCache().rejected++;
+        return 0;
+    }
+
+    return program;
+}
+
+void SaveCachedProgram(ProgramBinaryAPI api, uint64_t key, GLuint program)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> binary(length);
+    GLsizei written     = 0;
+    GLenum binaryFormat = GL_NONE;
+    if (api == ProgramBinaryAPI::ES3)
+    {
+        glGetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+    }
+    else
+    {
+        glGetProgramBinaryOES(program, length, &written, &binaryFormat, binary.data());
+    }
+    if (written <= 0)
+    {
+        return;
+    }
+    binary.resize(written);
+
+    ProgramCacheHeader header;
+    header.magic        = kProgramCacheMagic;
+    header.version      = kProgramCacheVersion;
+    header.key          = key;
+    header.checksum     = HashBytes(kFNVOffsetBasis, binary.data(), binary.size());
+    header.binaryFormat = binaryFormat;
+    header.binarySize   = static_cast<uint32_t>(binary.size());
+
+    // Written aside and renamed into place, so a concurrent run never reads a partial entry
+    const std::string path     = GetProgramCachePath(key);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream stream(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(binary.data()), binary.size());
+        if (!stream)
+        {
+            stream.close();
+            remove(tempPath.c_str());
+            return;
+        }
+    }
+    if (rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        remove(tempPath.c_str());
+    }
+}
 
+ProgramBinaryAPI GetProgramCacheAPI()
+{
+    return GetProgramCache().directory.empty() ? ProgramBinaryAPI::Unsupported
+                                               : GetProgramBinaryAPI();
+}
+
+void SetBinaryRetrievableHint(ProgramBinaryAPI api, GLuint program)
+{
+    if (api == ProgramBinaryAPI::ES3)
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+GLuint CompileProgramCached(const char *vsSource, const char *fsSource)
+{
+    ProgramCacheState &cache = GetProgramCache();
+    ProgramBinaryAPI api     = GetProgramCacheAPI();
+    if (api == ProgramBinaryAPI::Unsupported)
+    {
+        return CompileProgramInternal(vsSource, "", fsSource, nullptr);
+    }
+
+    const uint64_t key = GetProgramCacheKey(vsSource, fsSource);
+    GLuint program     = LoadCachedProgram(api, key);
+    if (program != 0)
+    {
+        cache.hits++;
+        return program;
+    }
+
+    cache.misses++;
+    auto preLink = [api](GLuint newProgram) { SetBinaryRetrievableHint(api, newProgram); };
+    program      = CompileProgramInternal(vsSource, "", fsSource, preLink);
+    if (program != 0)
+    {
+        SaveCachedProgram(api, key, program);
+    }
+    return program;
+}
+
+bool CheckCompileStatus(GLuint shader)
+{
     GLint compileResult;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &compileResult);
 
@@ -114,7 +381,139 @@ GLuint CompileShader(GLenum type, const char *source)
         }
 
         std::cerr << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Starts the compile without querying its status, which would make the driver wait for it
+GLuint SubmitShader(GLenum type, const char *source)
+{
+    GLuint shader = glCreateShader(type);
+
+    const char *sourceArray[1] = {source};
+    glShaderSource(shader, 1, sourceArray, nullptr);
+    glCompileShader(shader);
+
+    return shader;
+}
+
+AsyncProgram SubmitProgram(const char *vsSource,
+                           const char *fsSource,
+                           const std::function<void(GLuint)> &preLinkCallback)
+{
+    AsyncProgram result;
+    result.vertexShader   = SubmitShader(GL_VERTEX_SHADER, vsSource);
+    result.fragmentShader = SubmitShader(GL_FRAGMENT_SHADER, fsSource);
+    result.program        = glCreateProgram();
+
+    glAttachShader(result.program, result.vertexShader);
+    glAttachShader(result.program, result.fragmentShader);
+
+    if (preLinkCallback)
+    {
+        preLinkCallback(result.program);
+    }
+
+    // Linking does not need the compile results first, a failed compile fails the link
+    glLinkProgram(result.program);
+
+    return result;
+}
 
+// Uniform updates over all ShaderPrograms
+uint64_t gUniformCalls        = 0;
+uint64_t gSkippedUniformCalls = 0;
+
+constexpr int32_t kEmptySlot = -1;
+
+// Open addressing tables are kept at most half full
+size_t GetTableSize(size_t count)
+{
+    size_t size = 8;
+    while (size < count * 2)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+size_t HashName(const char *name, size_t length)
+{
+    return static_cast<size_t>(HashBytes(kFNVOffsetBasis, name, length));
+}
+
+size_t HashLocation(GLint location)
+{
+    return static_cast<size_t>(static_cast<uint32_t>(location) * 2654435761u);
+}
+
+// Bytes of one element, 0 for types that are never shadowed
+size_t GetUniformTypeSize(GLenum type)
+{
+    switch (type)
+    {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_EXTERNAL_OES:
+            return 4;
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_BOOL_VEC2:
+            return 8;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_BOOL_VEC3:
+            return 12;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2:
+            return 16;
+        case GL_FLOAT_MAT3:
+            return 36;
+        case GL_FLOAT_MAT4:
+            return 64;
+        default:
+            return 0;
+    }
+}
+
+// glUniform1i sets samplers as well as ints, every other setter needs the exact type
+bool IsSetterType(GLenum uniformType, GLenum setterType)
+{
+    switch (uniformType)
+    {
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_EXTERNAL_OES:
+            return setterType == GL_INT;
+        default:
+            return uniformType == setterType;
+    }
+}
+}  // namespace
+
+GLuint CompileShader(GLenum type, const char *source)
+{
+    GLuint shader = SubmitShader(type, source);
+
+    if (!CheckCompileStatus(shader))
+    {
         glDeleteShader(shader);
         shader = 0;
     }
@@ -197,7 +596,7 @@ GLuint CompileProgramWithTransformFeedback(
 
 GLuint CompileProgram(const char *vsSource, const char *fsSource)
 {
-    return CompileProgramInternal(vsSource, "", fsSource, nullptr);
+    return CompileProgramCached(vsSource, fsSource);
 }
 
 GLuint CompileProgram(const char *vsSource,
@@ -256,6 +655,451 @@ GLuint LoadBinaryProgramES3(const std::vector<uint8_t> &binary, GLenum binaryFor
     return CheckLinkStatusAndReturnProgram(program, true);
 }
 
+bool IsGLES3OrLater()
+{
+    int majorVersion    = 0;
+    const char *version = GetGLString(GL_VERSION);
+    return version && sscanf(version, "OpenGL ES %d", &majorVersion) == 1 && majorVersion >= 3;
+}
+
+bool HasGLExtension(const char *name)
+{
+    // Whole names only, GL_EXT_foo must not match GL_EXT_foo_bar
+    const char *extensions = GetGLString(GL_EXTENSIONS);
+    return extensions && CheckExtensionExists(extensions, name);
+}
+
+bool IsParallelShaderCompileSupported()
+{
+    return HasGLExtension("GL_KHR_parallel_shader_compile") && glMaxShaderCompilerThreadsKHR;
+}
+
+AsyncProgram CompileProgramAsync(const char *vsSource, const char *fsSource)
+{
+    if (IsParallelShaderCompileSupported())
+    {
+        // Let the driver use as many threads as it likes
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+
+    AsyncProgram result;
+    ProgramBinaryAPI api = GetProgramCacheAPI();
+    if (api == ProgramBinaryAPI::Unsupported)
+    {
+        return SubmitProgram(vsSource, fsSource, nullptr);
+    }
+
+    // A cache hit is a program that is already linked, with no shaders left to wait for
+    const uint64_t key = GetProgramCacheKey(vsSource, fsSource);
+    result.program     = LoadCachedProgram(api, key);
+    if (result.program != 0)
+    {
+        GetProgramCache().hits++;
+        return result;
+    }
+
+    GetProgramCache().misses++;
+    auto preLink    = [api](GLuint program) { SetBinaryRetrievableHint(api, program); };
+    result          = SubmitProgram(vsSource, fsSource, preLink);
+    result.cacheKey = key;
+    return result;
+}
+
+AsyncProgram CompileProgramAsync(const char *vsSource,
+                                 const char *fsSource,
+                                 const std::function<void(GLuint)> &preLinkCallback)
+{
+    if (IsParallelShaderCompileSupported())
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+
+    return SubmitProgram(vsSource, fsSource, preLinkCallback);
+}
+
+bool IsProgramReady(const AsyncProgram &program)
+{
+    // Cache hits have no shaders, and without the extension only ResolveProgram() can wait
+    if (program.program == 0 || program.vertexShader == 0 || !IsParallelShaderCompileSupported())
+    {
+        return true;
+    }
+
+    GLint completed = GL_FALSE;
+    glGetProgramiv(program.program, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+
+GLuint ResolveProgram(AsyncProgram *program)
+{
+    GLuint result = program->program;
+    if (result != 0 && program->vertexShader != 0)
+    {
+        GLint linkStatus = 0;
+        glGetProgramiv(result, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus == 0)
+        {
+            // Report the compile errors first, the link log only repeats them
+            CheckCompileStatus(program->vertexShader);
+            CheckCompileStatus(program->fragmentShader);
+        }
+
+        result = CheckLinkStatusAndReturnProgram(result, true);
+        if (result != 0 && program->cacheKey != 0)
+        {
+            SaveCachedProgram(GetProgramBinaryAPI(), program->cacheKey, result);
+        }
+
+        glDeleteShader(program->vertexShader);
+        glDeleteShader(program->fragmentShader);
+    }
+
+    *program = AsyncProgram();
+    return result;
+}
+
+ShaderProgram::ShaderProgram() : mProgram(0), mUniformCalls(0), mSkippedUniformCalls(0) {}
+
+ShaderProgram::~ShaderProgram()
+{
+    destroy();
+}
+
+bool ShaderProgram::initialize(GLuint program)
+{
+    destroy();
+    if (program == 0)
+    {
+        return false;
+    }
+    mProgram = program;
+
+    GLint attributeCount  = 0;
+    GLint attributeLength = 0;
+    GLint uniformCount    = 0;
+    GLint uniformLength   = 0;
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &attributeCount);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &attributeLength);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniformLength);
+
+    std::vector<GLchar> name(std::max(std::max(attributeLength, uniformLength), 1));
+    for (GLint index = 0; index < attributeCount; index++)
+    {
+        GLsizei length = 0;
+        GLint size     = 0;
+        Variable attribute;
+        glGetActiveAttrib(program, index, static_cast<GLsizei>(name.size()), &length, &size,
+                          &attribute.type, name.data());
+        attribute.name.assign(name.data(), length);
+        attribute.location = glGetAttribLocation(program, attribute.name.c_str());
+        mAttributes.push_back(attribute);
+    }
+
+    for (GLint index = 0; index < uniformCount; index++)
+    {
+        GLsizei length = 0;
+        GLint size     = 0;
+        Variable uniform;
+        glGetActiveUniform(program, index, static_cast<GLsizei>(name.size()), &length, &size,
+                           &uniform.type, name.data());
+        uniform.name.assign(name.data(), length);
+        uniform.location = glGetUniformLocation(program, uniform.name.c_str());
+
+        // Uniform block members have no location
+        if (uniform.location < 0)
+        {
+            continue;
+        }
+
+        // Arrays are reported as "name[0]"
+        const size_t bracket = uniform.name.rfind("[0]");
+        if (bracket != std::string::npos && bracket + 3 == uniform.name.size())
+        {
+            uniform.name.resize(bracket);
+        }
+
+        // Elements past the last one the driver kept active have no location, and a setter
+        // call reaching them must go to GL
+        std::vector<GLint> locations(1, uniform.location);
+        for (GLint element = 1; element < size; element++)
+        {
+            const std::string elementName = uniform.name + "[" + std::to_string(element) + "]";
+            const GLint location          = glGetUniformLocation(program, elementName.c_str());
+            if (location < 0)
+            {
+                break;
+            }
+            locations.push_back(location);
+        }
+
+        const uint32_t elementSize = static_cast<uint32_t>(GetUniformTypeSize(uniform.type));
+        for (size_t element = 0; element < locations.size(); element++)
+        {
+            UniformElement uniformElement;
+            uniformElement.location  = locations[element];
+            uniformElement.offset    = static_cast<uint32_t>(mShadow.size());
+            uniformElement.type      = uniform.type;
+            uniformElement.remaining = static_cast<uint32_t>(locations.size() - element);
+            uniformElement.known     = false;
+            mElements.push_back(uniformElement);
+            mShadow.resize(mShadow.size() + elementSize);
+        }
+
+        mUniforms.push_back(uniform);
+    }
+
+    BuildNameTable(mAttributes, &mAttributeTable);
+    BuildNameTable(mUniforms, &mUniformTable);
+
+    mElementTable.assign(GetTableSize(mElements.size()), kEmptySlot);
+    const size_t mask = mElementTable.size() - 1;
+    for (size_t index = 0; index < mElements.size(); index++)
+    {
+        size_t slot = HashLocation(mElements[index].location) & mask;
+        while (mElementTable[slot] != kEmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        mElementTable[slot] = static_cast<int32_t>(index);
+    }
+
+    return true;
+}
+
+void ShaderProgram::destroy()
+{
+    if (mProgram != 0)
+    {
+        glDeleteProgram(mProgram);
+        mProgram = 0;
+    }
+
+    mAttributes.clear();
+    mUniforms.clear();
+    mAttributeTable.clear();
+    mUniformTable.clear();
+    mElements.clear();
+    mElementTable.clear();
+    mShadow.clear();
+}
+
+GLint ShaderProgram::getAttribLocation(const char *name) const
+{
+    return FindLocation(mAttributes, mAttributeTable, name);
+}
+
+GLint ShaderProgram::getUniformLocation(const char *name) const
+{
+    return FindLocation(mUniforms, mUniformTable, name);
+}
+
+void ShaderProgram::setUniform1i(GLint location, GLint value)
+{
+    if (updateShadow(location, 1, &value, GL_INT))
+    {
+        glUniform1i(location, value);
+    }
+}
+
+void ShaderProgram::setUniform1f(GLint location, GLfloat value)
+{
+    if (updateShadow(location, 1, &value, GL_FLOAT))
+    {
+        glUniform1f(location, value);
+    }
+}
+
+void ShaderProgram::setUniform2fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_VEC2))
+    {
+        glUniform2fv(location, count, values);
+    }
+}
+
+void ShaderProgram::setUniform3fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_VEC3))
+    {
+        glUniform3fv(location, count, values);
+    }
+}
+
+void ShaderProgram::setUniform4fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_VEC4))
+    {
+        glUniform4fv(location, count, values);
+    }
+}
+
+void ShaderProgram::setUniformMatrix2fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_MAT2))
+    {
+        glUniformMatrix2fv(location, count, GL_FALSE, values);
+    }
+}
+
+void ShaderProgram::setUniformMatrix3fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_MAT3))
+    {
+        glUniformMatrix3fv(location, count, GL_FALSE, values);
+    }
+}
+
+void ShaderProgram::setUniformMatrix4fv(GLint location, GLsizei count, const GLfloat *values)
+{
+    if (updateShadow(location, count, values, GL_FLOAT_MAT4))
+    {
+        glUniformMatrix4fv(location, count, GL_FALSE, values);
+    }
+}
+
+void ShaderProgram::BuildNameTable(const std::vector<Variable> &variables,
+                                   std::vector<int32_t> *table)
+{
+    table->assign(GetTableSize(variables.size()), kEmptySlot);
+    const size_t mask = table->size() - 1;
+    for (size_t index = 0; index < variables.size(); index++)
+    {
+        const std::string &name = variables[index].name;
+        size_t slot             = HashName(name.c_str(), name.size()) & mask;
+        while ((*table)[slot] != kEmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        (*table)[slot] = static_cast<int32_t>(index);
+    }
+}
+
+GLint ShaderProgram::FindLocation(const std::vector<Variable> &variables,
+                                  const std::vector<int32_t> &table,
+                                  const char *name)
+{
+    if (table.empty())
+    {
+        return -1;
+    }
+
+    // "name[0]" finds the array "name" as well
+    size_t length = strlen(name);
+    if (length > 3 && strcmp(name + length - 3, "[0]") == 0)
+    {
+        length -= 3;
+    }
+
+    const size_t mask = table.size() - 1;
+    for (size_t slot = HashName(name, length) & mask; table[slot] != kEmptySlot;
+         slot        = (slot + 1) & mask)
+    {
+        const Variable &variable = variables[table[slot]];
+        if (variable.name.size() == length && memcmp(variable.name.data(), name, length) == 0)
+        {
+            return variable.location;
+        }
+    }
+    return -1;
+}
+
+bool ShaderProgram::updateShadow(GLint location, GLsizei count, const void *data, GLenum type)
+{
+    // GL ignores location -1
+    if (location < 0 || mElementTable.empty())
+    {
+        return false;
+    }
+
+    const size_t mask = mElementTable.size() - 1;
+    size_t slot       = HashLocation(location) & mask;
+    while (mElementTable[slot] != kEmptySlot && mElements[mElementTable[slot]].location != location)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    mUniformCalls++;
+    gUniformCalls++;
+
+    // Unknown locations and mismatched types go straight to GL, which reports the error. So
+    // do bool uniforms, both glUniform1i and glUniform1f set them and the bytes of one do not
+    // compare with the other.
+    UniformElement *element =
+        mElementTable[slot] != kEmptySlot ? &mElements[mElementTable[slot]] : nullptr;
+    if (element == nullptr || !IsSetterType(element->type, type) || count <= 0 ||
+        static_cast<uint32_t>(count) > element->remaining)
+    {
+        return true;
+    }
+
+    bool known = true;
+    for (GLsizei index = 0; index < count; index++)
+    {
+        known = known && element[index].known;
+    }
+
+    const size_t bytes = GetUniformTypeSize(type) * count;
+    uint8_t *shadow    = &mShadow[element->offset];
+    if (known && memcmp(shadow, data, bytes) == 0)
+    {
+        mSkippedUniformCalls++;
+        gSkippedUniformCalls++;
+        return false;
+    }
+
+    memcpy(shadow, data, bytes);
+    for (GLsizei index = 0; index < count; index++)
+    {
+        element[index].known = true;
+    }
+    return true;
+}
+
+void GetUniformCacheStats(uint64_t *callsOut, uint64_t *skippedOut)
+{
+    *callsOut   = gUniformCalls;
+    *skippedOut = gSkippedUniformCalls;
+}
+
+bool SetProgramCacheDirectory(const std::string &directory)
+{
+    ProgramCacheState &cache = GetProgramCache();
+    cache.directory.clear();
+    if (directory.empty())
+    {
+        return true;
+    }
+
+    // Only the last level is created, an existing directory is fine
+#if defined(ANGLE_PLATFORM_WINDOWS)
+    _mkdir(directory.c_str());
+#else
+    mkdir(directory.c_str(), 0755);
+#endif
+
+    // A read-only install directory would fail every save, leave the cache off instead
+    const std::string probePath = directory + "/.write_test";
+    std::ofstream probe(probePath.c_str(), std::ios::binary);
+    if (!probe)
+    {
+        return false;
+    }
+    probe.close();
+    remove(probePath.c_str());
+
+    cache.directory = directory;
+    return true;
+}
+
+void GetProgramCacheStats(size_t *hitsOut, size_t *missesOut, size_t *rejectedOut)
+{
+    const ProgramCacheState &cache = GetProgramCache();
+    *hitsOut                       = cache.hits;
+    *missesOut                     = cache.misses;
+    *rejectedOut                   = cache.rejected;
+}
+
 bool LinkAttachedProgram(GLuint program)
 {
     glLinkProgram(program);
@@ -7,10 +7,12 @@
 #ifndef SAMPLE_UTIL_SHADER_UTILS_H
 #define SAMPLE_UTIL_SHADER_UTILS_H
 
+#include <stdint.h>
 #include <functional>
 #include <string>
 #include <vector>
 
+#include "common/angleutils.h"
 #include "util/util_export.h"
 #include "util/util_gl.h"
 
@@ -39,11 +41,137 @@ ANGLE_UTIL_EXPORT GLuint CompileComputeProgram(const char *csSource,
                                                bool outputErrorMessages = true);
 ANGLE_UTIL_EXPORT bool LinkAttachedProgram(GLuint program);
 
+// A program whose compile and link may still be running on driver threads. With
+// GL_KHR_parallel_shader_compile nothing in CompileProgramAsync() waits for the driver, so
+// many programs can be submitted up front and resolved once asset loading is done. Without
+// the extension ResolveProgram() is where the wait happens.
+struct AsyncProgram
+{
+    GLuint program        = 0;
+    GLuint vertexShader   = 0;
+    GLuint fragmentShader = 0;
+
+    // Program cache entry written on resolve, 0 for none
+    uint64_t cacheKey = 0;
+};
+
+// Queries on the current context, the version is parsed from GL_VERSION
+ANGLE_UTIL_EXPORT bool IsGLES3OrLater();
+ANGLE_UTIL_EXPORT bool HasGLExtension(const char *name);
+
+ANGLE_UTIL_EXPORT bool IsParallelShaderCompileSupported();
+
+// Like CompileProgram(), including the program binary cache for the variant without a
+// pre-link callback. A cache hit comes back already linked.
+ANGLE_UTIL_EXPORT AsyncProgram CompileProgramAsync(const char *vsSource, const char *fsSource);
+ANGLE_UTIL_EXPORT AsyncProgram
+CompileProgramAsync(const char *vsSource,
+                    const char *fsSource,
+                    const std::function<void(GLuint)> &preLinkCallback);
+
+// Polls GL_COMPLETION_STATUS_KHR, always true without the extension
+ANGLE_UTIL_EXPORT bool IsProgramReady(const AsyncProgram &program);
+
+// Waits if needed and returns the linked program, or 0 after printing the compile and link
+// logs. The shaders are released and *program is reset either way.
+ANGLE_UTIL_EXPORT GLuint ResolveProgram(AsyncProgram *program);
+
+// A linked program with its active attributes and uniforms reflected once into flat hash
+// tables, and a CPU copy of every uniform value. Setting a uniform to the value it already
+// holds skips the glUniform call. The setters assume the program is current and that its
+// uniforms only change through this object. Arrays are found by their base name and set
+// from the location of their first element.
+class ANGLE_UTIL_EXPORT ShaderProgram : angle::NonCopyable
+{
+  public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    // Takes ownership of a linked program, destroy() deletes it
+    bool initialize(GLuint program);
+    void destroy();
+
+    GLuint get() const { return mProgram; }
+    void use() const { glUseProgram(mProgram); }
+
+    // -1 when the program has no such active variable
+    GLint getAttribLocation(const char *name) const;
+    GLint getUniformLocation(const char *name) const;
+
+    void setUniform1i(GLint location, GLint value);
+    void setUniform1f(GLint location, GLfloat value);
+    void setUniform2fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniform3fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniform4fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniformMatrix2fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniformMatrix3fv(GLint location, GLsizei count, const GLfloat *values);
+    void setUniformMatrix4fv(GLint location, GLsizei count, const GLfloat *values);
+
+    // Setter calls on valid locations, and how many of them were skipped as redundant
+    uint64_t getUniformCallCount() const { return mUniformCalls; }
+    uint64_t getSkippedUniformCallCount() const { return mSkippedUniformCalls; }
+
+  private:
+    struct Variable
+    {
+        std::string name;
+        GLenum type;
+        GLint location;
+    };
+
+    // One per uniform location, array elements are consecutive
+    struct UniformElement
+    {
+        GLint location;
+        uint32_t offset;
+        GLenum type;
+        uint32_t remaining;
+        bool known;
+    };
+
+    static void BuildNameTable(const std::vector<Variable> &variables, std::vector<int32_t> *table);
+    static GLint FindLocation(const std::vector<Variable> &variables,
+                              const std::vector<int32_t> &table,
+                              const char *name);
+
+    // False when the value matches the copy and the GL call can be skipped. type is the one
+    // the setter takes, GL_FLOAT_VEC3 for setUniform3fv.
+    bool updateShadow(GLint location, GLsizei count, const void *data, GLenum type);
+
+    GLuint mProgram;
+
+    std::vector<Variable> mAttributes;
+    std::vector<Variable> mUniforms;
+    std::vector<int32_t> mAttributeTable;
+    std::vector<int32_t> mUniformTable;
+
+    std::vector<UniformElement> mElements;
+    std::vector<int32_t> mElementTable;
+    std::vector<uint8_t> mShadow;
+
+    uint64_t mUniformCalls;
+    uint64_t mSkippedUniformCalls;
+};
+
+// Setter calls and skipped calls, totalled over every ShaderProgram in the process
+ANGLE_UTIL_EXPORT void GetUniformCacheStats(uint64_t *callsOut, uint64_t *skippedOut);
+
 ANGLE_UTIL_EXPORT GLuint LoadBinaryProgramOES(const std::vector<uint8_t> &binary,
                                               GLenum binaryFormat);
 ANGLE_UTIL_EXPORT GLuint LoadBinaryProgramES3(const std::vector<uint8_t> &binary,
                                               GLenum binaryFormat);
 
+// On-disk program binary cache for CompileProgram(vsSource, fsSource). Entries are keyed by
+// the sources and the GL vendor, renderer and version strings, and a binary the driver
+// rejects is recompiled and replaced. Needs ES 3.0 or GL_OES_get_program_binary with at least
+// one binary format, programs are always compiled otherwise. An empty directory (the default)
+// disables it, so does a directory that cannot be created or written to, which returns false.
+// The other CompileProgram variants never use the cache.
+ANGLE_UTIL_EXPORT bool SetProgramCacheDirectory(const std::string &directory);
+ANGLE_UTIL_EXPORT void GetProgramCacheStats(size_t *hitsOut,
+                                            size_t *missesOut,
+                                            size_t *rejectedOut);
+
 namespace angle
 {
 
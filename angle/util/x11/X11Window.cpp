@@ -8,13 +8,23 @@
 
 #include "util/x11/X11Window.h"
 
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <chrono>
+
 #include "common/debug.h"
-#include "util/Timer.h"
-#include "util/system_utils.h"
 
 namespace
 {
 
+// The input thread also wakes up this often to pick up events that another thread read off
+// the connection, since those no longer make the socket readable
+constexpr int kInputPollTimeoutMs = 16;
+
+// How long resize() waits for the window manager
+constexpr std::chrono::milliseconds kResizeWaitDelay(200);
+
 Bool WaitForMapNotify(Display *dpy, XEvent *event, XPointer window)
 {
     return event->type == MapNotify && event->xmap.window == reinterpret_cast<Window>(window);
@@ -259,7 +269,9 @@ X11Window::X11Window()
       mDisplay(nullptr),
       mWindow(0),
       mRequestedVisualId(-1),
-      mVisible(false)
+      mVisible(false),
+      mThreadedInput(false),
+      mWakePipe{-1, -1}
 {}
 
 X11Window::X11Window(int visualId)
@@ -269,7 +281,9 @@ X11Window::X11Window(int visualId)
       mDisplay(nullptr),
       mWindow(0),
       mRequestedVisualId(visualId),
-      mVisible(false)
+      mVisible(false),
+      mThreadedInput(false),
+      mWakePipe{-1, -1}
 {}
 
 X11Window::~X11Window()
@@ -281,6 +295,12 @@ bool X11Window::initialize(const std::string &name, size_t width, size_t height)
 {
     destroy();
 
+    // Must come before any other Xlib call of the process to have any effect
+    if (mThreadedInput && (XInitThreads() == 0 || pipe(mWakePipe) != 0))
+    {
+        mThreadedInput = false;
+    }
+
     mDisplay = XOpenDisplay(nullptr);
     if (!mDisplay)
     {
@@ -373,6 +393,15 @@ bool X11Window::initialize(const std::string &name, size_t width, size_t height)
 
 void X11Window::destroy()
 {
+    stopInputThread();
+    if (mWakePipe[0] != -1)
+    {
+        close(mWakePipe[0]);
+        close(mWakePipe[1]);
+        mWakePipe[0] = -1;
+        mWakePipe[1] = -1;
+    }
+
     if (mWindow)
     {
         XDestroyWindow(mDisplay, mWindow);
@@ -401,15 +430,75 @@ EGLNativeDisplayType X11Window::getNativeDisplay() const
 
 void X11Window::messageLoop()
 {
+    if (mThreadedInput)
+    {
+        // Started here rather than in initialize() so it cannot take the MapNotify
+        // setVisible() waits for
+        if (!mInputThread.joinable())
+        {
+            mInputThread = std::thread(&X11Window::inputLoop, this);
+        }
+        return;
+    }
+    drainEvents();
+}
+
+bool X11Window::setThreadedInput(bool threaded)
+{
+    mThreadedInput = threaded;
+    return true;
+}
+
+void X11Window::drainEvents()
+{
+    // Only what is pending now, so a steady stream of events cannot keep the caller here
     int eventCount = XPending(mDisplay);
     while (eventCount--)
     {
         XEvent event;
         XNextEvent(mDisplay, &event);
+
+        // Of a run of motion or configure events only the last one matters
+        if ((event.type == MotionNotify || event.type == ConfigureNotify) && eventCount > 0)
+        {
+            XEvent next;
+            XPeekEvent(mDisplay, &next);
+            if (next.type == event.type && next.xany.window == event.xany.window)
+            {
+                continue;
+            }
+        }
         processEvent(event);
     }
 }
 
+void X11Window::inputLoop()
+{
+    pollfd fds[2] = {{ConnectionNumber(mDisplay), POLLIN, 0}, {mWakePipe[0], POLLIN, 0}};
+    while (true)
+    {
+        drainEvents();
+        if (poll(fds, 2, kInputPollTimeoutMs) > 0 && (fds[1].revents & POLLIN))
+        {
+            return;
+        }
+    }
+}
+
+void X11Window::stopInputThread()
+{
+    if (mInputThread.joinable())
+    {
+        const char wake = 0;
+        ssize_t written = -1;
+        do
+        {
+            written = write(mWakePipe[1], &wake, 1);
+        } while (written < 0 && errno == EINTR);
+        mInputThread.join();
+    }
+}
+
 void X11Window::setMousePosition(int x, int y)
 {
     XWarpPointer(mDisplay, None, mWindow, 0, 0, 0, 0, x, y);
@@ -427,19 +516,30 @@ bool X11Window::resize(int width, int height)
     XResizeWindow(mDisplay, mWindow, width, height);
     XFlush(mDisplay);
 
-    Timer *timer = CreateTimer();
-    timer->start();
-
     // Wait until the window as actually been resized so that the code calling resize
     // can assume the window has been resized.
-    const double kResizeWaitDelay = 0.2;
-    while ((mHeight != height || mWidth != width) && timer->getElapsedTime() < kResizeWaitDelay)
+    auto resized = [this, width, height]() { return mWidth == width && mHeight == height; };
+    if (mInputThread.joinable())
     {
-        messageLoop();
-        angle::Sleep(10);
+        std::unique_lock<std::mutex> lock(mResizeMutex);
+        mResizeCondition.wait_for(lock, kResizeWaitDelay, resized);
+        return true;
     }
 
-    delete timer;
+    // Sleep in poll() until the server sends something instead of waking up on a timer
+    const auto deadline = std::chrono::steady_clock::now() + kResizeWaitDelay;
+    pollfd fd           = {ConnectionNumber(mDisplay), POLLIN, 0};
+    while (true)
+    {
+        drainEvents();
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (resized() || remaining.count() <= 0)
+        {
+            break;
+        }
+        poll(&fd, 1, static_cast<int>(remaining.count()));
+    }
 
     return true;
 }
@@ -642,6 +742,12 @@ void X11Window::processEvent(const XEvent &xEvent)
                 event.Size.Width  = xEvent.xconfigure.width;
                 event.Size.Height = xEvent.xconfigure.height;
                 pushEvent(event);
+
+                // Through the mutex so a resize() about to wait cannot miss the new size
+                {
+                    std::lock_guard<std::mutex> lock(mResizeMutex);
+                }
+                mResizeCondition.notify_all();
             }
             if (xEvent.xconfigure.x != mX || xEvent.xconfigure.y != mY)
             {
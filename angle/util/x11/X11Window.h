@@ -12,7 +12,10 @@
 #include <X11/Xlib.h>
 #include <X11/Xresource.h>
 #include <X11/Xutil.h>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "util/OSWindow.h"
 #include "util/util_export.h"
@@ -32,8 +35,12 @@ class ANGLE_UTIL_EXPORT X11Window : public OSWindow
     EGLNativeWindowType getNativeWindow() const override;
     EGLNativeDisplayType getNativeDisplay() const override;
 
+    // With threaded input the first call starts the input thread, later calls return at once
     void messageLoop() override;
 
+    // Needs XInitThreads(), which initialize() calls first thing when threaded input is on
+    bool setThreadedInput(bool threaded) override;
+
     void setMousePosition(int x, int y) override;
     bool setPosition(int x, int y) override;
     bool resize(int width, int height) override;
@@ -43,6 +50,9 @@ class ANGLE_UTIL_EXPORT X11Window : public OSWindow
 
   private:
     void processEvent(const XEvent &event);
+    void drainEvents();
+    void inputLoop();
+    void stopInputThread();
 
     Atom WM_DELETE_WINDOW;
     Atom WM_PROTOCOLS;
@@ -52,6 +62,16 @@ class ANGLE_UTIL_EXPORT X11Window : public OSWindow
     Window mWindow;
     int mRequestedVisualId;
     bool mVisible;
+
+    // Reads the connection so the render thread never does, destroy() wakes its poll()
+    // through the pipe
+    bool mThreadedInput;
+    std::thread mInputThread;
+    int mWakePipe[2];
+
+    // Signaled by the input thread after each resize, for resize() to wait on
+    std::mutex mResizeMutex;
+    std::condition_variable mResizeCondition;
 };
 
 #endif  // UTIL_X11_WINDOW_H
@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "util_culling.hpp"
+#include "util_occlusion.hpp"
+#include "util_parallel.hpp"
+#include "util_simd.hpp"
+
+// SIMD groups handled by one parallelFor chunk
+#define CULL_GRAIN 1024
+
+// Consecutive boxes sharing one bounding box, tested before the boxes themselves
+#define CULL_CLUSTER 64
+
+enum class clusterTest {
+    OUTSIDE = 0,
+    INSIDE,
+    INTERSECTING,
+};
+
+static clusterTest testCluster(const frustumPlane* planes, const float* bounds)
+{
+    const float cx = (bounds[0] + bounds[3]) * 0.5f;
+    const float cy = (bounds[1] + bounds[4]) * 0.5f;
+    const float cz = (bounds[2] + bounds[5]) * 0.5f;
+    const float ex = (bounds[3] - bounds[0]) * 0.5f;
+    const float ey = (bounds[4] - bounds[1]) * 0.5f;
+    const float ez = (bounds[5] - bounds[2]) * 0.5f;
+
+    clusterTest result = clusterTest::INSIDE;
+    for (auto p = 0; p < 6; p++) {
+        const frustumPlane& plane = planes[p];
+        float d = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+        float r = std::fabs(plane.x) * ex + std::fabs(plane.y) * ey + std::fabs(plane.z) * ez;
+        if (d + r < 0.0f)
+            return clusterTest::OUTSIDE;
+        if (d - r < 0.0f)
+            result = clusterTest::INTERSECTING;
+    }
+    return result;
+}
+
+void extractFrustumPlanes(const Mat4x4& viewProj, frustumPlane planes[6])
+{
+    // Rows of the matrix, combined as in Gribb and Hartmann
+    float row[4][4];
+    for (auto r = 0; r < 4; r++) {
+        for (auto c = 0; c < 4; c++) {
+            row[r][c] = viewProj(r, c);
+        }
+    }
+
+    for (auto p = 0; p < 6; p++) {
+        const float sign = (p & 1) ? -1.0f : 1.0f;
+        const float* axis = row[p / 2];
+        float x = row[3][0] + sign * axis[0];
+        float y = row[3][1] + sign * axis[1];
+        float z = row[3][2] + sign * axis[2];
+        float w = row[3][3] + sign * axis[3];
+
+        float length = std::sqrt(x * x + y * y + z * z);
+        float inv = length > 0.0f ? 1.0f / length : 0.0f;
+        planes[p] = frustumPlane{x * inv, y * inv, z * inv, w * inv};
+    }
+}
+
+frustumCuller::frustumCuller() :
+    count(0),
+    visibleCount(0) {
+}
+
+frustumCuller::~frustumCuller() {
+}
+
+void frustumCuller::clear()
+{
+    count = 0;
+    visibleCount = 0;
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+    clusterBounds.clear();
+}
+
+std::int_fast32_t frustumCuller::addBox(const vec3& center, const vec3& extent)
+{
+    // Keep the arrays padded so the last group can be loaded whole
+    std::int_fast32_t padded = simdPadCount(count + 1);
+    if (static_cast<std::int_fast32_t>(centerX.size()) < padded) {
+        centerX.resize(padded, 0.0f);
+        centerY.resize(padded, 0.0f);
+        centerZ.resize(padded, 0.0f);
+        extentX.resize(padded, 0.0f);
+        extentY.resize(padded, 0.0f);
+        extentZ.resize(padded, 0.0f);
+    }
+
+    centerX[count] = center.x;
+    centerY[count] = center.y;
+    centerZ[count] = center.z;
+    extentX[count] = std::fabs(extent.x);
+    extentY[count] = std::fabs(extent.y);
+    extentZ[count] = std::fabs(extent.z);
+
+    const float boxMin[3] = {
+        center.x - extentX[count], center.y - extentY[count], center.z - extentZ[count]
+    };
+    const float boxMax[3] = {
+        center.x + extentX[count], center.y + extentY[count], center.z + extentZ[count]
+    };
+    if (count % CULL_CLUSTER == 0) {
+        clusterBounds.insert(clusterBounds.end(), boxMin, boxMin + 3);
+        clusterBounds.insert(clusterBounds.end(), boxMax, boxMax + 3);
+    } else {
+        float* bounds = &clusterBounds[(count / CULL_CLUSTER) * 6];
+        for (auto a = 0; a < 3; a++) {
+            bounds[a] = std::min(bounds[a], boxMin[a]);
+            bounds[a + 3] = std::max(bounds[a + 3], boxMax[a]);
+        }
+    }
+    return count++;
+}
+
+void frustumCuller::cullChunk(const frustumPlane* planes, std::int_fast32_t chunk)
+{
+    simd4f px[6], py[6], pz[6], pw[6];
+    simd4f ax[6], ay[6], az[6];
+    for (auto p = 0; p < 6; p++) {
+        px[p] = simdSet1(planes[p].x);
+        py[p] = simdSet1(planes[p].y);
+        pz[p] = simdSet1(planes[p].z);
+        pw[p] = simdSet1(planes[p].w);
+        ax[p] = simdSet1(std::fabs(planes[p].x));
+        ay[p] = simdSet1(std::fabs(planes[p].y));
+        az[p] = simdSet1(std::fabs(planes[p].z));
+    }
+    const simd4f zero = simdSet1(0.0f);
+
+    const std::int_fast32_t begin = chunk * CULL_GRAIN * SIMD_WIDTH;
+    const std::int_fast32_t end =
+        std::min<std::int_fast32_t>(count, begin + CULL_GRAIN * SIMD_WIDTH);
+    std::uint32_t* out = &visible[begin];
+    std::int_fast32_t kept = 0;
+
+    for (std::int_fast32_t cluster = begin; cluster < end; cluster += CULL_CLUSTER) {
+        const std::int_fast32_t clusterEnd =
+            std::min<std::int_fast32_t>(end, cluster + CULL_CLUSTER);
+
+        // Whole clusters are dropped or kept without looking at their boxes
+        clusterTest test = testCluster(planes, &clusterBounds[(cluster / CULL_CLUSTER) * 6]);
+        if (test == clusterTest::OUTSIDE)
+            continue;
+        if (test == clusterTest::INSIDE) {
+            for (std::int_fast32_t i = cluster; i < clusterEnd; i++) {
+                out[kept++] = static_cast<std::uint32_t>(i);
+            }
+            continue;
+        }
+
+        for (std::int_fast32_t i = cluster; i < clusterEnd; i += SIMD_WIDTH) {
+            simd4f cx = simdLoad(&centerX[i]);
+            simd4f cy = simdLoad(&centerY[i]);
+            simd4f cz = simdLoad(&centerZ[i]);
+            simd4f ex = simdLoad(&extentX[i]);
+            simd4f ey = simdLoad(&extentY[i]);
+            simd4f ez = simdLoad(&extentZ[i]);
+
+            // Signed distance of the center plus the box radius along the plane normal
+            simd4f inside = simdCmpGe(zero, zero);
+            for (auto p = 0; p < 6; p++) {
+                simd4f d = simdMulAdd(cx, px[p],
+                                      simdMulAdd(cy, py[p], simdMulAdd(cz, pz[p], pw[p])));
+                simd4f r = simdMulAdd(ex, ax[p], simdMulAdd(ey, ay[p], ez * az[p]));
+                inside = simdAnd(inside, simdCmpGe(d + r, zero));
+            }
+
+            int mask = simdMoveMask(inside);
+            if (clusterEnd - i < SIMD_WIDTH) {
+                mask &= (1 << (clusterEnd - i)) - 1;
+            }
+            while (mask) {
+                int lane = 0;
+                while (!(mask & (1 << lane)))
+                    lane++;
+                mask &= mask - 1;
+                out[kept++] = static_cast<std::uint32_t>(i + lane);
+            }
+        }
+    }
+    chunkVisible[chunk] = kept;
+}
+
+std::int_fast32_t frustumCuller::cull(const Mat4x4& viewProj)
+{
+    frustumPlane planes[6];
+    extractFrustumPlanes(viewProj, planes);
+
+    const std::int_fast32_t groups = simdPadCount(count) / SIMD_WIDTH;
+    const std::int_fast32_t chunks = (groups + CULL_GRAIN - 1) / CULL_GRAIN;
+    visible.resize(count);
+    chunkVisible.assign(chunks, 0);
+
+    parallelFor(chunks, 1, [this, &planes](std::int_fast32_t begin, std::int_fast32_t end) {
+        for (std::int_fast32_t chunk = begin; chunk < end; chunk++) {
+            cullChunk(planes, chunk);
+        }
+    });
+
+    // Pack the slices, the first one is already in place
+    visibleCount = chunks > 0 ? chunkVisible[0] : 0;
+    for (std::int_fast32_t chunk = 1; chunk < chunks; chunk++) {
+        const std::uint32_t* slice = &visible[chunk * CULL_GRAIN * SIMD_WIDTH];
+        std::memmove(&visible[visibleCount], slice, chunkVisible[chunk] * sizeof(std::uint32_t));
+        visibleCount += chunkVisible[chunk];
+    }
+    return visibleCount;
+}
+
+void frustumCuller::occludeChunk(const occlusionBuffer& buffer, std::int_fast32_t chunk)
+{
+    const std::int_fast32_t begin = chunk * CULL_GRAIN * SIMD_WIDTH;
+    const std::int_fast32_t end =
+        std::min<std::int_fast32_t>(visibleCount, begin + CULL_GRAIN * SIMD_WIDTH);
+
+    // Survivors move to the front of the chunk's own slice
+    std::int_fast32_t kept = begin;
+    for (std::int_fast32_t i = begin; i < end; i++) {
+        const std::uint32_t box = visible[i];
+        const float center[3] = {centerX[box], centerY[box], centerZ[box]};
+        const float extent[3] = {extentX[box], extentY[box], extentZ[box]};
+        if (buffer.testBox(center, extent))
+            visible[kept++] = box;
+    }
+    chunkVisible[chunk] = kept - begin;
+}
+
+std::int_fast32_t frustumCuller::cullOccluded(const occlusionBuffer& buffer)
+{
+    const std::int_fast32_t chunks =
+        (visibleCount + CULL_GRAIN * SIMD_WIDTH - 1) / (CULL_GRAIN * SIMD_WIDTH);
+    chunkVisible.assign(chunks, 0);
+
+    parallelFor(chunks, 1, [this, &buffer](std::int_fast32_t begin, std::int_fast32_t end) {
+        for (std::int_fast32_t chunk = begin; chunk < end; chunk++) {
+            occludeChunk(buffer, chunk);
+        }
+    });
+
+    visibleCount = chunks > 0 ? chunkVisible[0] : 0;
+    for (std::int_fast32_t chunk = 1; chunk < chunks; chunk++) {
+        const std::uint32_t* slice = &visible[chunk * CULL_GRAIN * SIMD_WIDTH];
+        std::memmove(&visible[visibleCount], slice, chunkVisible[chunk] * sizeof(std::uint32_t));
+        visibleCount += chunkVisible[chunk];
+    }
+    return visibleCount;
+}
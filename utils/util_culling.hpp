@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Frustum culling of structure-of-arrays bounding boxes on the worker pool
+
+#ifndef UTIL_CULLING_H
+#define UTIL_CULLING_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util_matrix.hpp"
+#include "util_vector.hpp"
+
+class occlusionBuffer;
+
+// A point p is inside when x * p.x + y * p.y + z * p.z + w >= 0
+struct frustumPlane {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+// Left, right, bottom, top, near and far planes of a view-projection matrix,
+// normalized so w is a distance in world units
+void extractFrustumPlanes(const Mat4x4& viewProj, frustumPlane planes[6]);
+
+class frustumCuller {
+
+    private:
+        std::int_fast32_t count;
+
+        // World-space box centers and half extents, padded to SIMD_WIDTH
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+
+        // Min and max corners of every CULL_CLUSTER consecutive boxes
+        std::vector<float> clusterBounds;
+
+        // Every chunk writes the indices it keeps at the start of its own
+        // slice, the slices are packed together afterwards
+        std::vector<std::uint32_t> visible;
+        std::vector<std::int_fast32_t> chunkVisible;
+        std::int_fast32_t visibleCount;
+
+        void cullChunk(const frustumPlane* planes, std::int_fast32_t chunk);
+        void occludeChunk(const occlusionBuffer& buffer, std::int_fast32_t chunk);
+
+    public:
+        frustumCuller();
+        ~frustumCuller();
+
+        void clear();
+
+        // Returns the index of the box, boxes are numbered in the order they are added
+        std::int_fast32_t addBox(const vec3& center, const vec3& extent);
+        std::int_fast32_t getBoxCount()                          { return count; }
+
+        // Test every box against the frustum, four at a time in parallel chunks.
+        // A box is culled when it lies fully outside one of the planes, boxes
+        // crossing a frustum corner may be kept. Groups of consecutive boxes are
+        // tested as a whole first, so adding boxes in spatial order pays off.
+        // Returns the visible count.
+        std::int_fast32_t cull(const Mat4x4& viewProj);
+
+        // Test the boxes kept by the last cull() against a rendered occlusion
+        // buffer and drop the hidden ones, in parallel chunks as well. Returns
+        // the new visible count.
+        std::int_fast32_t cullOccluded(const occlusionBuffer& buffer);
+
+        // Ascending indices of the boxes kept by the last cull()
+        const std::uint32_t*  getVisible()                       { return visible.data(); }
+        std::int_fast32_t     getVisibleCount()                  { return visibleCount; }
+};
+
+#endif
@@ -0,0 +1,619 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
+
+#include "util_occlusion.hpp"
+#include "util_parallel.hpp"
+#include "util_simd.hpp"
+
+// Rows rasterized by one parallelFor job
+#define OCCLUSION_BAND 8
+
+// Vertices closer to the eye than this, in clip w, are treated as behind it
+#define OCCLUSION_MIN_W 1e-5f
+
+// Largest voxel grid of buildOccluderMesh() per axis
+#define OCCLUDER_MAX_CELLS 128
+
+// Separating axis test of a triangle against a box given by its center and half size
+static bool triangleOverlapsBox(const float center[3], const float half[3], const float tri[3][3])
+{
+    float v[3][3], e[3][3];
+    for (auto i = 0; i < 3; i++) {
+        for (auto a = 0; a < 3; a++) {
+            v[i][a] = tri[i][a] - center[a];
+        }
+    }
+    for (auto i = 0; i < 3; i++) {
+        for (auto a = 0; a < 3; a++) {
+            e[i][a] = v[(i + 1) % 3][a] - v[i][a];
+        }
+    }
+
+    // Box normals, the cross products of the edges with them, and the triangle normal
+    float axes[13][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    for (auto i = 0; i < 3; i++) {
+        for (auto a = 0; a < 3; a++) {
+            float* axis = axes[3 + i * 3 + a];
+            const float u[3] = {a == 0 ? 1.0f : 0.0f, a == 1 ? 1.0f : 0.0f, a == 2 ? 1.0f : 0.0f};
+            axis[0] = e[i][1] * u[2] - e[i][2] * u[1];
+            axis[1] = e[i][2] * u[0] - e[i][0] * u[2];
+            axis[2] = e[i][0] * u[1] - e[i][1] * u[0];
+        }
+    }
+    axes[12][0] = e[0][1] * e[1][2] - e[0][2] * e[1][1];
+    axes[12][1] = e[0][2] * e[1][0] - e[0][0] * e[1][2];
+    axes[12][2] = e[0][0] * e[1][1] - e[0][1] * e[1][0];
+
+    for (const float* axis : axes) {
+        float p0 = v[0][0] * axis[0] + v[0][1] * axis[1] + v[0][2] * axis[2];
+        float p1 = v[1][0] * axis[0] + v[1][1] * axis[1] + v[1][2] * axis[2];
+        float p2 = v[2][0] * axis[0] + v[2][1] * axis[1] + v[2][2] * axis[2];
+        float r = half[0] * std::fabs(axis[0]) + half[1] * std::fabs(axis[1]) +
+                  half[2] * std::fabs(axis[2]);
+        if (std::min({p0, p1, p2}) > r || std::max({p0, p1, p2}) < -r)
+            return false;
+    }
+    return true;
+}
+
+// Positions of the triangle at indices, false when an index is out of range
+static bool loadTriangle(const packedVertex* vertices, std::int_fast32_t vertexCount,
+                         const std::uint32_t* indices, float tri[3][3])
+{
+    for (auto k = 0; k < 3; k++) {
+        if (indices[k] >= static_cast<std::uint32_t>(vertexCount))
+            return false;
+        const vec3& p = vertices[indices[k]].vPosition;
+        tri[k][0] = p.x;
+        tri[k][1] = p.y;
+        tri[k][2] = p.z;
+    }
+    return true;
+}
+
+occluderMesh buildOccluderMesh(const packedVertex* vertices, std::int_fast32_t vertexCount,
+                               const std::uint32_t* indices, std::int_fast32_t indexCount,
+                               std::int_fast32_t cells)
+{
+    occluderMesh mesh;
+    if (vertexCount == 0 || cells < 1)
+        return mesh;
+    cells = std::min<std::int_fast32_t>(cells, OCCLUDER_MAX_CELLS);
+
+    float vmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float vmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (std::int_fast32_t i = 0; i < vertexCount; i++) {
+        const vec3& p = vertices[i].vPosition;
+        const float position[3] = {p.x, p.y, p.z};
+        for (auto a = 0; a < 3; a++) {
+            vmin[a] = std::min(vmin[a], position[a]);
+            vmax[a] = std::max(vmax[a], position[a]);
+        }
+    }
+
+    // A flat mesh has no inside
+    float cellSize[3];
+    for (auto a = 0; a < 3; a++) {
+        cellSize[a] = (vmax[a] - vmin[a]) / cells;
+        if (!(cellSize[a] > 0.0f))
+            return mesh;
+    }
+
+    // One cell of padding on every side keeps the outside connected. Cell (x, y, z) spans
+    // vmin + (x - 1, y - 1, z - 1) * cellSize to one cell further.
+    enum : std::uint8_t { CELL_INSIDE = 0, CELL_SURFACE, CELL_OUTSIDE };
+    const std::int_fast32_t n = cells + 2;
+    std::vector<std::uint8_t> grid(n * n * n, CELL_INSIDE);
+    auto cellIndex = [n](std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t z) {
+        return (z * n + y) * n + x;
+    };
+
+    // Cells the surface passes through, tested enlarged by a quarter cell on every side
+    // so the faces built from the rest keep that distance from the surface
+    float half[3];
+    for (auto a = 0; a < 3; a++) {
+        half[a] = cellSize[a] * 0.75f;
+    }
+    for (std::int_fast32_t i = 0; i + 2 < indexCount; i += 3) {
+        float tri[3][3];
+        if (!loadTriangle(vertices, vertexCount, indices + i, tri))
+            continue;
+        std::int_fast32_t lo[3], hi[3];
+        for (auto a = 0; a < 3; a++) {
+            float t0 = (std::min({tri[0][a], tri[1][a], tri[2][a]}) - vmin[a]) / cellSize[a];
+            float t1 = (std::max({tri[0][a], tri[1][a], tri[2][a]}) - vmin[a]) / cellSize[a];
+            lo[a] = std::max<std::int_fast32_t>(static_cast<std::int_fast32_t>(t0) - 1, 0) + 1;
+            hi[a] = std::min<std::int_fast32_t>(static_cast<std::int_fast32_t>(t1) + 1,
+                                                cells - 1) + 1;
+        }
+        for (std::int_fast32_t z = lo[2]; z <= hi[2]; z++) {
+            for (std::int_fast32_t y = lo[1]; y <= hi[1]; y++) {
+                for (std::int_fast32_t x = lo[0]; x <= hi[0]; x++) {
+                    std::uint8_t& cell = grid[cellIndex(x, y, z)];
+                    if (cell == CELL_SURFACE)
+                        continue;
+                    const float center[3] = {vmin[0] + (x - 0.5f) * cellSize[0],
+                                             vmin[1] + (y - 0.5f) * cellSize[1],
+                                             vmin[2] + (z - 0.5f) * cellSize[2]};
+                    if (triangleOverlapsBox(center, half, tri))
+                        cell = CELL_SURFACE;
+                }
+            }
+        }
+    }
+
+    // Flood the outside from a padding corner. A mesh with holes floods its inside as
+    // well and yields no occluder.
+    std::vector<std::int_fast32_t> stack{0};
+    grid[0] = CELL_OUTSIDE;
+    while (!stack.empty()) {
+        std::int_fast32_t c = stack.back();
+        stack.pop_back();
+        const std::int_fast32_t x = c % n;
+        const std::int_fast32_t y = (c / n) % n;
+        const std::int_fast32_t z = c / (n * n);
+        const std::int_fast32_t neighbours[6][3] = {{x - 1, y, z}, {x + 1, y, z}, {x, y - 1, z},
+                                                    {x, y + 1, z}, {x, y, z - 1}, {x, y, z + 1}};
+        for (const std::int_fast32_t* p : neighbours) {
+            if (p[0] < 0 || p[1] < 0 || p[2] < 0 || p[0] >= n || p[1] >= n || p[2] >= n)
+                continue;
+            std::int_fast32_t next = cellIndex(p[0], p[1], p[2]);
+            if (grid[next] == CELL_INSIDE) {
+                grid[next] = CELL_OUTSIDE;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    // Cells the surface does not pass through lie wholly inside or outside. Gaps in the
+    // surface narrower than a cell keep the flood out of pockets as well, so a point of
+    // every cell left over must also be inside by the crossings of rays along all three
+    // axes. The rays run off the cell centers, which would hit the edges of axis aligned
+    // quads, and three of them keep a hole in the surface from letting a pocket in.
+    const float rayOffset[3] = {0.5619f, 0.4373f, 0.5281f};
+    std::vector<std::vector<float>> crossings(n * n);
+    for (auto a = 0; a < 3; a++) {
+        const auto u = (a + 1) % 3;
+        const auto v = (a + 2) % 3;
+        for (std::vector<float>& ray : crossings) {
+            ray.clear();
+        }
+        for (std::int_fast32_t i = 0; i + 2 < indexCount; i += 3) {
+            float tri[3][3];
+            if (!loadTriangle(vertices, vertexCount, indices + i, tri))
+                continue;
+            const float* p0 = tri[0];
+            const float* p1 = tri[1];
+            const float* p2 = tri[2];
+            const float area = (p1[u] - p0[u]) * (p2[v] - p0[v]) - (p1[v] - p0[v]) * (p2[u] - p0[u]);
+            if (area == 0.0f)
+                continue;
+            const float u0 = (std::min({p0[u], p1[u], p2[u]}) - vmin[u]) / cellSize[u];
+            const float u1 = (std::max({p0[u], p1[u], p2[u]}) - vmin[u]) / cellSize[u];
+            const float v0 = (std::min({p0[v], p1[v], p2[v]}) - vmin[v]) / cellSize[v];
+            const float v1 = (std::max({p0[v], p1[v], p2[v]}) - vmin[v]) / cellSize[v];
+            const auto cu0 = std::max<std::int_fast32_t>(
+                    static_cast<std::int_fast32_t>(u0 + rayOffset[u]), 1);
+            const auto cu1 = std::min<std::int_fast32_t>(
+                    static_cast<std::int_fast32_t>(u1 + rayOffset[u]), cells);
+            const auto cv0 = std::max<std::int_fast32_t>(
+                    static_cast<std::int_fast32_t>(v0 + rayOffset[v]), 1);
+            const auto cv1 = std::min<std::int_fast32_t>(
+                    static_cast<std::int_fast32_t>(v1 + rayOffset[v]), cells);
+            for (auto cv = cv0; cv <= cv1; cv++) {
+                for (auto cu = cu0; cu <= cu1; cu++) {
+                    const float pu = vmin[u] + (cu - rayOffset[u]) * cellSize[u];
+                    const float pv = vmin[v] + (cv - rayOffset[v]) * cellSize[v];
+                    const float w0 = (p1[u] - pu) * (p2[v] - pv) - (p1[v] - pv) * (p2[u] - pu);
+                    const float w1 = (p2[u] - pu) * (p0[v] - pv) - (p2[v] - pv) * (p0[u] - pu);
+                    const float w2 = area - w0 - w1;
+                    if ((w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) &&
+                        (w0 > 0.0f || w1 > 0.0f || w2 > 0.0f))
+                        continue;
+                    crossings[cv * n + cu].push_back((w0 * p0[a] + w1 * p1[a] + w2 * p2[a]) / area);
+                }
+            }
+        }
+
+        std::int_fast32_t c[3];
+        for (c[v] = 1; c[v] <= cells; c[v]++) {
+            for (c[u] = 1; c[u] <= cells; c[u]++) {
+                std::vector<float>& ray = crossings[c[v] * n + c[u]];
+                std::sort(ray.begin(), ray.end());
+                std::size_t passed = 0;
+                for (c[a] = 1; c[a] <= cells; c[a]++) {
+                    const float position = vmin[a] + (c[a] - 0.5f) * cellSize[a];
+                    while (passed < ray.size() && ray[passed] < position)
+                        passed++;
+                    std::uint8_t& cell = grid[cellIndex(c[0], c[1], c[2])];
+                    if (cell == CELL_INSIDE && passed % 2 == 0)
+                        cell = CELL_OUTSIDE;
+                }
+            }
+        }
+    }
+
+    // Grid corners shared by the faces
+    std::unordered_map<std::uint32_t, std::uint32_t> corners;
+    auto corner = [&](const std::int_fast32_t c[3]) {
+        std::uint32_t key = static_cast<std::uint32_t>((c[2] * (n + 1) + c[1]) * (n + 1) + c[0]);
+        auto found = corners.emplace(key, static_cast<std::uint32_t>(corners.size()));
+        if (found.second) {
+            for (auto a = 0; a < 3; a++) {
+                mesh.positions.push_back(vmin[a] + (c[a] - 1) * cellSize[a]);
+            }
+        }
+        return found.first->second;
+    };
+
+    // Faces between inside cells and the rest, merged into rectangles slice by slice
+    std::vector<std::uint8_t> mask(n * n);
+    for (auto a = 0; a < 3; a++) {
+        const auto u = (a + 1) % 3;
+        const auto v = (a + 2) % 3;
+        for (auto side = 0; side < 2; side++) {
+            for (std::int_fast32_t slice = 1; slice <= cells; slice++) {
+                std::int_fast32_t c[3];
+                c[a] = slice;
+                for (c[v] = 0; c[v] < n; c[v]++) {
+                    for (c[u] = 0; c[u] < n; c[u]++) {
+                        std::int_fast32_t d[3] = {c[0], c[1], c[2]};
+                        d[a] += side ? 1 : -1;
+                        mask[c[v] * n + c[u]] = grid[cellIndex(c[0], c[1], c[2])] == CELL_INSIDE &&
+                                                grid[cellIndex(d[0], d[1], d[2])] != CELL_INSIDE;
+                    }
+                }
+
+                for (std::int_fast32_t j = 0; j < n; j++) {
+                    for (std::int_fast32_t i = 0; i < n; i++) {
+                        if (!mask[j * n + i])
+                            continue;
+                        std::int_fast32_t w = 1;
+                        while (i + w < n && mask[j * n + i + w])
+                            w++;
+                        std::int_fast32_t h = 1;
+                        while (j + h < n &&
+                               std::all_of(&mask[(j + h) * n + i], &mask[(j + h) * n + i + w],
+                                           [](std::uint8_t m) { return m != 0; }))
+                            h++;
+                        for (std::int_fast32_t row = j; row < j + h; row++) {
+                            std::fill(&mask[row * n + i], &mask[row * n + i + w], 0);
+                        }
+
+                        std::uint32_t quad[4];
+                        const std::int_fast32_t offsets[4][2] = {{0, 0}, {w, 0}, {w, h}, {0, h}};
+                        for (auto k = 0; k < 4; k++) {
+                            std::int_fast32_t p[3];
+                            p[a] = slice + side;
+                            p[u] = i + offsets[k][0];
+                            p[v] = j + offsets[k][1];
+                            quad[k] = corner(p);
+                        }
+                        mesh.indices.insert(mesh.indices.end(),
+                                            {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+                    }
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+occlusionBuffer::occlusionBuffer(std::int_fast32_t w, std::int_fast32_t h) :
+    width(simdPadCount(std::max<std::int_fast32_t>(w, 1))),
+    height(std::max<std::int_fast32_t>(h, 1)),
+    triangleCount(0) {
+
+    std::int_fast32_t lw = width;
+    std::int_fast32_t lh = height;
+    while (true) {
+        levels.emplace_back(lw * lh, 1.0f);
+        levelWidth.push_back(lw);
+        levelHeight.push_back(lh);
+        if (lw == 1 && lh == 1)
+            break;
+        lw = (lw + 1) / 2;
+        lh = (lh + 1) / 2;
+    }
+}
+
+occlusionBuffer::~occlusionBuffer() {
+}
+
+void occlusionBuffer::begin(const Mat4x4& m)
+{
+    viewProj = m;
+    occluders.clear();
+    std::fill(levels[0].begin(), levels[0].end(), 1.0f);
+}
+
+void occlusionBuffer::addOccluder(const occluderMesh& mesh, const Mat4x4& model)
+{
+    occluders.push_back(occluder{&mesh, model, 0});
+}
+
+void occlusionBuffer::setupOccluder(const occluder& o)
+{
+    const Mat4x4 m = viewProj * o.model;
+    const std::vector<float>& positions = o.mesh->positions;
+    float* out = &screenVertices[o.firstVertex * 4];
+
+    for (std::size_t i = 0; i < positions.size(); i += 3, out += 4) {
+        const float x = positions[i];
+        const float y = positions[i + 1];
+        const float z = positions[i + 2];
+        const float cx = m(0, 0) * x + m(0, 1) * y + m(0, 2) * z + m(0, 3);
+        const float cy = m(1, 0) * x + m(1, 1) * y + m(1, 2) * z + m(1, 3);
+        const float cz = m(2, 0) * x + m(2, 1) * y + m(2, 2) * z + m(2, 3);
+        const float cw = m(3, 0) * x + m(3, 1) * y + m(3, 2) * z + m(3, 3);
+
+        // Triangles reaching through the near plane are skipped, not clipped,
+        // which can only make the occluders smaller
+        if (cw < OCCLUSION_MIN_W || cz < -cw) {
+            out[3] = 0.0f;
+            continue;
+        }
+        const float invW = 1.0f / cw;
+        out[0] = (cx * invW * 0.5f + 0.5f) * width;
+        out[1] = (cy * invW * 0.5f + 0.5f) * height;
+        out[2] = cz * invW * 0.5f + 0.5f;
+        out[3] = 1.0f;
+    }
+
+    const std::vector<std::uint32_t>& indices = o.mesh->indices;
+    const float* base = &screenVertices[o.firstVertex * 4];
+    triangleSetup* setup = &triangles[o.firstTriangle];
+
+    for (std::size_t t = 0; t + 2 < indices.size(); t += 3, setup++) {
+        setup->minX = 0;
+        setup->maxX = -1;
+
+        const float* v0 = base + indices[t] * 4;
+        const float* v1 = base + indices[t + 1] * 4;
+        const float* v2 = base + indices[t + 2] * 4;
+        if (v0[3] == 0.0f || v1[3] == 0.0f || v2[3] == 0.0f)
+            continue;
+
+        // Both windings are drawn, so make the triangle counter-clockwise
+        float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]);
+        if (area < 0.0f) {
+            std::swap(v1, v2);
+            area = -area;
+        }
+        if (area < 1e-6f)
+            continue;
+
+        // Bounding box clamped to the screen, in float first so far off-screen
+        // vertices cannot overflow the conversion
+        const float boxMinX = std::max(std::min({v0[0], v1[0], v2[0]}), 0.0f);
+        const float boxMaxX = std::min(std::max({v0[0], v1[0], v2[0]}), width - 1.0f);
+        const float boxMinY = std::max(std::min({v0[1], v1[1], v2[1]}), 0.0f);
+        const float boxMaxY = std::min(std::max({v0[1], v1[1], v2[1]}), height - 1.0f);
+        if (boxMinX > boxMaxX || boxMinY > boxMaxY)
+            continue;
+
+        // The edge opposite a vertex gives its barycentric weight
+        const float* v[3] = {v0, v1, v2};
+        for (auto e = 0; e < 3; e++) {
+            const float* p = v[(e + 1) % 3];
+            const float* q = v[(e + 2) % 3];
+            setup->ea[e] = p[1] - q[1];
+            setup->eb[e] = q[0] - p[0];
+            setup->ec[e] = -(setup->ea[e] * p[0] + setup->eb[e] * p[1]);
+        }
+        // Depth plane through v0 from the differences to it. Depths close to the far plane
+        // cancel out in the plain barycentric sum and could land in front of the triangle.
+        const float invArea = 1.0f / area;
+        const float dz1 = v1[2] - v0[2];
+        const float dz2 = v2[2] - v0[2];
+        setup->za = (setup->ea[1] * dz1 + setup->ea[2] * dz2) * invArea;
+        setup->zb = (setup->eb[1] * dz1 + setup->eb[2] * dz2) * invArea;
+        setup->zc = v0[2] - setup->za * v0[0] - setup->zb * v0[1];
+
+        setup->minX = static_cast<std::int32_t>(boxMinX);
+        setup->maxX = static_cast<std::int32_t>(boxMaxX);
+        setup->minY = static_cast<std::int32_t>(boxMinY);
+        setup->maxY = static_cast<std::int32_t>(boxMaxY);
+    }
+}
+
+void occlusionBuffer::rasterizeBand(std::int_fast32_t band)
+{
+    static const float laneOffsets[SIMD_WIDTH] = {0.5f, 1.5f, 2.5f, 3.5f};
+    const simd4f lanes = simdLoad(laneOffsets);
+    const simd4f zero = simdSet1(0.0f);
+    const std::int_fast32_t y0 = band * OCCLUSION_BAND;
+    const std::int_fast32_t y1 = std::min<std::int_fast32_t>(height, y0 + OCCLUSION_BAND) - 1;
+    float* depth = levels[0].data();
+
+    for (std::uint32_t index : bins[band]) {
+        const triangleSetup& t = triangles[index];
+        const std::int_fast32_t minY = std::max<std::int_fast32_t>(t.minY, y0);
+        const std::int_fast32_t maxY = std::min<std::int_fast32_t>(t.maxY, y1);
+
+        const std::int_fast32_t startX =
+            t.minX & ~static_cast<std::int_fast32_t>(SIMD_WIDTH - 1);
+        const simd4f px = simdSet1(static_cast<float>(startX)) + lanes;
+        const simd4f e0Step = simdSet1(t.ea[0] * SIMD_WIDTH);
+        const simd4f e1Step = simdSet1(t.ea[1] * SIMD_WIDTH);
+        const simd4f e2Step = simdSet1(t.ea[2] * SIMD_WIDTH);
+        const simd4f zStep = simdSet1(t.za * SIMD_WIDTH);
+
+        for (std::int_fast32_t y = minY; y <= maxY; y++) {
+            const float fy = y + 0.5f;
+            simd4f e0 = simdMulAdd(simdSet1(t.ea[0]), px, simdSet1(t.eb[0] * fy + t.ec[0]));
+            simd4f e1 = simdMulAdd(simdSet1(t.ea[1]), px, simdSet1(t.eb[1] * fy + t.ec[1]));
+            simd4f e2 = simdMulAdd(simdSet1(t.ea[2]), px, simdSet1(t.eb[2] * fy + t.ec[2]));
+            simd4f z = simdMulAdd(simdSet1(t.za), px, simdSet1(t.zb * fy + t.zc));
+
+            float* row = depth + y * width;
+            for (std::int_fast32_t x = startX; x <= t.maxX; x += SIMD_WIDTH) {
+                simd4f d = simdLoad(row + x);
+                simd4f inside = simdAnd(simdAnd(simdCmpGe(e0, zero), simdCmpGe(e1, zero)),
+                                        simdAnd(simdCmpGe(e2, zero), simdCmpLt(z, d)));
+                simdStore(row + x, simdSelect(inside, z, d));
+                e0 = e0 + e0Step;
+                e1 = e1 + e1Step;
+                e2 = e2 + e2Step;
+                z = z + zStep;
+            }
+        }
+    }
+}
+
+void occlusionBuffer::buildPyramid()
+{
+    for (std::size_t l = 1; l < levels.size(); l++) {
+        const std::vector<float>& src = levels[l - 1];
+        std::vector<float>& dst = levels[l];
+        const std::int_fast32_t sw = levelWidth[l - 1];
+        const std::int_fast32_t sh = levelHeight[l - 1];
+
+        for (std::int_fast32_t y = 0; y < levelHeight[l]; y++) {
+            const float* row0 = &src[std::min(y * 2, sh - 1) * sw];
+            const float* row1 = &src[std::min(y * 2 + 1, sh - 1) * sw];
+            for (std::int_fast32_t x = 0; x < levelWidth[l]; x++) {
+                std::int_fast32_t x0 = std::min(x * 2, sw - 1);
+                std::int_fast32_t x1 = std::min(x * 2 + 1, sw - 1);
+                dst[y * levelWidth[l] + x] =
+                    std::max(std::max(row0[x0], row0[x1]), std::max(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+void occlusionBuffer::render()
+{
+    // Every occluder gets its own range of screen vertices and triangles
+    std::int_fast32_t vertexCount = 0;
+    triangleCount = 0;
+    for (occluder& o : occluders) {
+        o.firstVertex = vertexCount;
+        o.firstTriangle = triangleCount;
+        vertexCount += o.mesh->positions.size() / 3;
+        triangleCount += o.mesh->getTriangleCount();
+    }
+    screenVertices.resize(vertexCount * 4);
+    triangles.resize(triangleCount);
+
+    parallelFor(occluders.size(), 1, [this](std::int_fast32_t begin, std::int_fast32_t end) {
+        for (std::int_fast32_t i = begin; i < end; i++) {
+            setupOccluder(occluders[i]);
+        }
+    });
+
+    const std::int_fast32_t bands = (height + OCCLUSION_BAND - 1) / OCCLUSION_BAND;
+    bins.resize(bands);
+    for (std::vector<std::uint32_t>& bin : bins) {
+        bin.clear();
+    }
+    for (std::size_t i = 0; i < triangles.size(); i++) {
+        const triangleSetup& t = triangles[i];
+        if (t.minX > t.maxX)
+            continue;
+        const std::int_fast32_t lastBand = t.maxY / OCCLUSION_BAND;
+        for (std::int_fast32_t band = t.minY / OCCLUSION_BAND; band <= lastBand; band++) {
+            bins[band].push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    parallelFor(bands, 1, [this](std::int_fast32_t begin, std::int_fast32_t end) {
+        for (std::int_fast32_t band = begin; band < end; band++) {
+            rasterizeBand(band);
+        }
+    });
+
+    buildPyramid();
+}
+
+bool occlusionBuffer::testBox(const float center[3], const float extent[3]) const
+{
+    // The corners are the projected center plus or minus the projected axes
+    float c[4], axes[3][4];
+    for (auto r = 0; r < 4; r++) {
+        c[r] = viewProj(r, 0) * center[0] + viewProj(r, 1) * center[1] +
+               viewProj(r, 2) * center[2] + viewProj(r, 3);
+        for (auto a = 0; a < 3; a++) {
+            axes[a][r] = viewProj(r, a) * extent[a];
+        }
+    }
+
+    float minX = FLT_MAX, maxX = -FLT_MAX;
+    float minY = FLT_MAX, maxY = -FLT_MAX;
+    float minZ = FLT_MAX;
+    for (auto corner = 0; corner < 8; corner++) {
+        float p[4];
+        for (auto r = 0; r < 4; r++) {
+            p[r] = c[r];
+            for (auto a = 0; a < 3; a++) {
+                p[r] += (corner & (1 << a)) ? axes[a][r] : -axes[a][r];
+            }
+        }
+        if (p[3] < OCCLUSION_MIN_W || p[2] < -p[3])
+            return true;
+
+        const float invW = 1.0f / p[3];
+        const float x = (p[0] * invW * 0.5f + 0.5f) * width;
+        const float y = (p[1] * invW * 0.5f + 0.5f) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, p[2] * invW * 0.5f + 0.5f);
+    }
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+        return true;
+
+    const std::int_fast32_t x0 = static_cast<std::int_fast32_t>(std::max(minX, 0.0f));
+    const std::int_fast32_t x1 = static_cast<std::int_fast32_t>(std::min(maxX, width - 1.0f));
+    const std::int_fast32_t y0 = static_cast<std::int_fast32_t>(std::max(minY, 0.0f));
+    const std::int_fast32_t y1 = static_cast<std::int_fast32_t>(std::min(maxY, height - 1.0f));
+
+    // Coarsest level where the rectangle still covers at most 2x2 texels
+    std::size_t level = 0;
+    while (level + 1 < levels.size() &&
+           ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1))
+        level++;
+
+    const std::vector<float>& depth = levels[level];
+    const std::int_fast32_t lw = levelWidth[level];
+    for (std::int_fast32_t y = y0 >> level; y <= (y1 >> level); y++) {
+        for (std::int_fast32_t x = x0 >> level; x <= (x1 >> level); x++) {
+            if (minZ <= depth[y * lw + x])
+                return true;
+        }
+    }
+    return false;
+}
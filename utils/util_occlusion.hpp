@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Software depth rasterizer and hierarchical depth buffer for occlusion culling
+
+#ifndef UTIL_OCCLUSION_H
+#define UTIL_OCCLUSION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util_matrix.hpp"
+#include "util_vector.hpp"
+
+// Simplified triangle mesh used to render occluders, positions are xyz triplets
+struct occluderMesh {
+    std::vector<float> positions;
+    std::vector<std::uint32_t> indices;
+
+    std::int_fast32_t getTriangleCount() const { return indices.size() / 3; }
+};
+
+// Build a conservative occluder from a closed mesh: the mesh is voxelized on a
+// cells^3 grid over its bounds, and the outer faces of the cells that lie fully
+// inside it, merged into rectangles, make up the occluder. It never covers more
+// than the mesh does. Holes in the surface shrink it or leave nothing, and a
+// mesh thinner than about two cells yields no occluder.
+occluderMesh buildOccluderMesh(const packedVertex* vertices, std::int_fast32_t vertexCount,
+                               const std::uint32_t* indices, std::int_fast32_t indexCount,
+                               std::int_fast32_t cells);
+
+// Low resolution depth buffer, cleared to the far plane every frame.
+// Occluders are transformed and set up on the worker pool, binned into bands
+// of rows, and each band is rasterized four pixels at a time by its own job.
+// Once they are all in, a max depth pyramid is built for testBox().
+class occlusionBuffer {
+
+    private:
+        struct occluder {
+            const occluderMesh* mesh;
+            Mat4x4 model;
+            std::int_fast32_t firstVertex;
+            std::int_fast32_t firstTriangle;
+        };
+
+        // Edge functions e = a * x + b * y + c, positive inside, the depth plane
+        // and the pixel bounds. minX > maxX marks a triangle that is not drawn.
+        struct triangleSetup {
+            float ea[3];
+            float eb[3];
+            float ec[3];
+            float za;
+            float zb;
+            float zc;
+            std::int32_t minX;
+            std::int32_t maxX;
+            std::int32_t minY;
+            std::int32_t maxY;
+        };
+
+        const std::int_fast32_t width;
+        const std::int_fast32_t height;
+
+        Mat4x4 viewProj;
+        std::vector<occluder> occluders;
+
+        // Window x, y and depth of every occluder vertex, followed by 1 when the
+        // vertex lies in front of the near plane and 0 otherwise
+        std::vector<float> screenVertices;
+        std::vector<triangleSetup> triangles;
+
+        // Triangles overlapping each band of OCCLUSION_BAND rows
+        std::vector<std::vector<std::uint32_t>> bins;
+
+        // Level 0 is the depth buffer, every further level holds the farthest
+        // depth of 2x2 texels of the one before
+        std::vector<std::vector<float>> levels;
+        std::vector<std::int_fast32_t> levelWidth;
+        std::vector<std::int_fast32_t> levelHeight;
+
+        std::int_fast64_t triangleCount;
+
+        void setupOccluder(const occluder& o);
+        void rasterizeBand(std::int_fast32_t band);
+        void buildPyramid();
+
+    public:
+        // width is rounded up to a multiple of SIMD_WIDTH
+        occlusionBuffer(std::int_fast32_t width, std::int_fast32_t height);
+        ~occlusionBuffer();
+
+        // Start a frame, clears the depth and the occluder list
+        void begin(const Mat4x4& viewProj);
+
+        // The mesh has to stay alive until render() returns
+        void addOccluder(const occluderMesh& mesh, const Mat4x4& model);
+        std::int_fast32_t getOccluderCount()                     { return occluders.size(); }
+
+        void render();
+
+        // False when the box is certainly hidden behind the rendered occluders.
+        // Boxes reaching behind the near plane are always visible. Thread safe.
+        bool testBox(const float center[3], const float extent[3]) const;
+
+        // Occluder triangles rasterized by the last render()
+        std::int_fast64_t getTriangleCount()                     { return triangleCount; }
+
+        std::int_fast32_t getWidth()                             { return width; }
+        std::int_fast32_t getHeight()                            { return height; }
+        const float*      getDepth()                             { return levels[0].data(); }
+};
+
+#endif
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util_parallel.hpp"
+
+namespace {
+
+thread_local bool inParallelJob = false;
+
+class workerPool {
+
+    private:
+        std::vector<std::thread> workers;
+
+        // Serializes jobs submitted from different threads
+        std::mutex submitMutex;
+
+        std::mutex mutex;
+        std::condition_variable wakeCv;
+        std::condition_variable doneCv;
+        bool stop = false;
+
+        // Current job, guarded by mutex except for the atomics
+        const std::function<void(std::int_fast32_t, std::int_fast32_t)>* func = nullptr;
+        std::int_fast32_t count = 0;
+        std::int_fast32_t grain = 1;
+        std::int_fast32_t chunks = 0;
+        std::uint_fast64_t generation = 0;
+        bool jobOpen = false;
+        std::int_fast32_t active = 0;
+        std::atomic<std::int_fast32_t> nextChunk{0};
+        std::atomic<std::int_fast32_t> doneChunks{0};
+
+        void runChunks() {
+            for (;;) {
+                std::int_fast32_t c = nextChunk.fetch_add(1);
+                if (c >= chunks)
+                    break;
+                std::int_fast32_t begin = c * grain;
+                std::int_fast32_t end = std::min(count, begin + grain);
+                (*func)(begin, end);
+                doneChunks.fetch_add(1);
+            }
+        }
+
+        void workerMain() {
+            inParallelJob = true;
+            std::uint_fast64_t seen = 0;
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wakeCv.wait(lock, [&] { return stop || (jobOpen && generation != seen); });
+                    if (stop)
+                        return;
+                    seen = generation;
+                    active++;
+                }
+
+                runChunks();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                active--;
+                if (active == 0 && doneChunks.load() == chunks)
+                    doneCv.notify_all();
+            }
+        }
+
+    public:
+        explicit workerPool(std::int_fast32_t threads) {
+            // The caller is one of the threads
+            for (auto i = 1; i < threads; i++) {
+                workers.emplace_back(&workerPool::workerMain, this);
+            }
+        }
+
+        ~workerPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wakeCv.notify_all();
+            for (auto& t : workers) {
+                t.join();
+            }
+        }
+
+        std::int_fast32_t size() const { return static_cast<std::int_fast32_t>(workers.size()) + 1; }
+
+        void run(std::int_fast32_t n, std::int_fast32_t g,
+                 const std::function<void(std::int_fast32_t, std::int_fast32_t)>& f) {
+            std::lock_guard<std::mutex> submit(submitMutex);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                func = &f;
+                count = n;
+                grain = g;
+                chunks = (n + g - 1) / g;
+                nextChunk.store(0);
+                doneChunks.store(0);
+                generation++;
+                jobOpen = true;
+            }
+            wakeCv.notify_all();
+
+            inParallelJob = true;
+            runChunks();
+            inParallelJob = false;
+
+            // Wait until no worker can still touch this job
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCv.wait(lock, [&] { return doneChunks.load() == chunks && active == 0; });
+            jobOpen = false;
+            func = nullptr;
+        }
+};
+
+std::mutex poolMutex;
+std::unique_ptr<workerPool> pool;
+std::atomic<std::int_fast32_t> requestedThreads{0};
+
+// Threads inside pool->run(), guarded by poolMutex. The pool is only replaced while
+// nobody uses it, so a new thread count takes effect once the running jobs are done.
+std::int_fast32_t poolUsers = 0;
+
+std::int_fast32_t defaultThreadCount()
+{
+    std::int_fast32_t n = static_cast<std::int_fast32_t>(std::thread::hardware_concurrency());
+    return std::max<std::int_fast32_t>(n, 1);
+}
+
+class poolUse {
+
+    public:
+        workerPool* instance;
+
+        poolUse() {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            std::int_fast32_t n = parallelThreadCount();
+            if (!pool || (pool->size() != n && poolUsers == 0))
+                pool.reset(new workerPool(n));
+            poolUsers++;
+            instance = pool.get();
+        }
+
+        ~poolUse() {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            poolUsers--;
+        }
+};
+
+}  // anonymous namespace
+
+std::int_fast32_t parallelThreadCount()
+{
+    std::int_fast32_t n = requestedThreads.load();
+    return n > 0 ? n : defaultThreadCount();
+}
+
+void parallelSetThreadCount(std::int_fast32_t n)
+{
+    requestedThreads.store(std::max<std::int_fast32_t>(n, 0));
+}
+
+void parallelFor(std::int_fast32_t count, std::int_fast32_t grain,
+                 const std::function<void(std::int_fast32_t, std::int_fast32_t)>& func)
+{
+    if (count <= 0)
+        return;
+    grain = std::max<std::int_fast32_t>(grain, 1);
+
+    if (count <= grain || inParallelJob || parallelThreadCount() <= 1) {
+        for (std::int_fast32_t begin = 0; begin < count; begin += grain) {
+            func(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    poolUse use;
+    use.instance->run(count, grain, func);
+}
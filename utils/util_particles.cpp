@@ -0,0 +1,222 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+
+#include "util_parallel.hpp"
+#include "util_particles.hpp"
+#include "util_simd.hpp"
+
+// SIMD groups handled by one parallelFor chunk
+#define PARTICLE_GRAIN 1024
+
+// Softening term so attractors do not blow particles away at close range
+#define ATTRACTOR_EPSILON 0.01f
+
+particlePool::particlePool(std::int_fast32_t n) :
+    capacity(simdPadCount(n)),
+    highWater(0),
+    aliveCount(0),
+    forces{{0.0f, 0.0f, 0.0f}, 0.0f, false, 0.0f, 0.0f},
+    rngState(0x9e3779b9u) {
+
+    posX.assign(capacity, 0.0f);
+    posY.assign(capacity, 0.0f);
+    posZ.assign(capacity, 0.0f);
+    velX.assign(capacity, 0.0f);
+    velY.assign(capacity, 0.0f);
+    velZ.assign(capacity, 0.0f);
+    age.assign(capacity, 0.0f);
+    invLifetime.assign(capacity, 0.0f);
+    vertices.assign(capacity, particleVertex{0.0f, 0.0f, 0.0f, 0.0f});
+
+    // Padding slots beyond n are never handed out
+    freeList.reserve(n);
+    for (auto i = n - 1; i >= 0; i--) {
+        freeList.push_back(i);
+    }
+}
+
+particlePool::~particlePool() {
+}
+
+std::int_fast32_t particlePool::addEmitter(const particleEmitter& e) {
+    emitters.push_back(e);
+    return emitters.size() - 1;
+}
+
+// xorshift32, plenty for spawn jitter
+float particlePool::random(float min, float max) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return min + (max - min) * static_cast<float>(rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+void particlePool::emit(particleEmitter& e, float dt) {
+    e.accumulator += e.rate * dt;
+    std::int_fast32_t n = static_cast<std::int_fast32_t>(e.accumulator);
+    e.accumulator -= n;
+
+    for (auto i = 0; i < n && !freeList.empty(); i++) {
+        std::int_fast32_t p = freeList.back();
+        freeList.pop_back();
+
+        float startAngle = random(0.0f, 6.2831853f);
+        float startRadius = random(0.0f, e.radius);
+        posX[p] = e.position.x + std::sin(startAngle) * startRadius;
+        posY[p] = e.position.y + std::cos(startAngle) * startRadius;
+        posZ[p] = e.position.z;
+
+        float dirAngle = random(0.0f, 6.2831853f);
+        float speed = random(0.0f, e.speed);
+        velX[p] = std::sin(dirAngle) * speed;
+        velY[p] = std::cos(dirAngle) * speed;
+        velZ[p] = 0.0f;
+
+        age[p] = 0.0f;
+        invLifetime[p] = 1.0f / random(e.minLifetime, e.maxLifetime);
+
+        highWater = std::max(highWater, simdPadCount(p + 1));
+        aliveCount++;
+    }
+}
+
+void particlePool::integrate(std::int_fast32_t begin, std::int_fast32_t end, float dt,
+                             std::vector<std::int_fast32_t>& dead) {
+    const simd4f zero = simdSet1(0.0f);
+    const simd4f one = simdSet1(1.0f);
+    const simd4f vdt = simdSet1(dt);
+    const simd4f gx = simdSet1(forces.gravity.x);
+    const simd4f gy = simdSet1(forces.gravity.y);
+    const simd4f gz = simdSet1(forces.gravity.z);
+    const simd4f drag = simdSet1(forces.drag);
+    const simd4f floorY = simdSet1(forces.floor ? forces.floorY : -1e30f);
+    const simd4f restitution = simdSet1(forces.restitution);
+    const simd4f eps = simdSet1(ATTRACTOR_EPSILON);
+
+    for (auto i = begin; i < end; i += SIMD_WIDTH) {
+        simd4f invLife = simdLoad(&invLifetime[i]);
+        simd4f a = simdLoad(&age[i]) + vdt;
+
+        // Dead slots have a zero inverse lifetime, so their life fraction is 1
+        simd4f life = one - a * invLife;
+        simd4f alive = simdAnd(simdCmpLt(zero, invLife), simdCmpLt(zero, life));
+        simd4f died = simdAnd(simdCmpLt(zero, invLife), simdCmpLe(life, zero));
+
+        simd4f px = simdLoad(&posX[i]);
+        simd4f py = simdLoad(&posY[i]);
+        simd4f pz = simdLoad(&posZ[i]);
+        simd4f vx = simdLoad(&velX[i]);
+        simd4f vy = simdLoad(&velY[i]);
+        simd4f vz = simdLoad(&velZ[i]);
+
+        // Acceleration: gravity, linear drag and softened inverse-square attractors
+        simd4f ax = gx - drag * vx;
+        simd4f ay = gy - drag * vy;
+        simd4f az = gz - drag * vz;
+        for (const auto& attr : attractors) {
+            simd4f dx = simdSet1(attr.position.x) - px;
+            simd4f dy = simdSet1(attr.position.y) - py;
+            simd4f dz = simdSet1(attr.position.z) - pz;
+            simd4f r2 = dx * dx + dy * dy + dz * dz + eps;
+            simd4f s = simdSet1(attr.strength) / (r2 * simdSqrt(r2));
+            ax = ax + dx * s;
+            ay = ay + dy * s;
+            az = az + dz * s;
+        }
+
+        // Semi-implicit Euler
+        vx = vx + ax * vdt;
+        vy = vy + ay * vdt;
+        vz = vz + az * vdt;
+        px = px + vx * vdt;
+        py = py + vy * vdt;
+        pz = pz + vz * vdt;
+
+        // Reflect particles moving down through the floor
+        simd4f below = simdCmpLt(py, floorY);
+        py = simdSelect(below, floorY, py);
+        vy = simdSelect(simdAnd(below, simdCmpLt(vy, zero)), -vy * restitution, vy);
+
+        simdStore(&posX[i], simdSelect(alive, px, simdLoad(&posX[i])));
+        simdStore(&posY[i], simdSelect(alive, py, simdLoad(&posY[i])));
+        simdStore(&posZ[i], simdSelect(alive, pz, simdLoad(&posZ[i])));
+        simdStore(&velX[i], simdSelect(alive, vx, simdLoad(&velX[i])));
+        simdStore(&velY[i], simdSelect(alive, vy, simdLoad(&velY[i])));
+        simdStore(&velZ[i], simdSelect(alive, vz, simdLoad(&velZ[i])));
+        simdStore(&age[i], simdSelect(alive, a, zero));
+        simdStore(&invLifetime[i], simdSelect(alive, invLife, zero));
+
+        int diedBits = simdMoveMask(died);
+        for (auto lane = 0; diedBits != 0; lane++, diedBits >>= 1) {
+            if (diedBits & 1)
+                dead.push_back(i + lane);
+        }
+
+        // Emit four vertices at once
+        px = simdLoad(&posX[i]);
+        py = simdLoad(&posY[i]);
+        pz = simdLoad(&posZ[i]);
+        life = simdSelect(alive, life, zero);
+        simdTranspose4(px, py, pz, life);
+        simdStore(&vertices[i + 0].x, px);
+        simdStore(&vertices[i + 1].x, py);
+        simdStore(&vertices[i + 2].x, pz);
+        simdStore(&vertices[i + 3].x, life);
+    }
+}
+
+void particlePool::update(float dt) {
+    for (auto& e : emitters) {
+        emit(e, dt);
+    }
+
+    const std::int_fast32_t groups = highWater / SIMD_WIDTH;
+    const std::int_fast32_t chunks = (groups + PARTICLE_GRAIN - 1) / PARTICLE_GRAIN;
+    if (static_cast<std::int_fast32_t>(expired.size()) < chunks)
+        expired.resize(chunks);
+
+    parallelFor(groups, PARTICLE_GRAIN, [&](std::int_fast32_t begin, std::int_fast32_t end) {
+        auto& dead = expired[begin / PARTICLE_GRAIN];
+        dead.clear();
+        integrate(begin * SIMD_WIDTH, end * SIMD_WIDTH, dt, dead);
+    });
+
+    // Return expired slots, highest first so low indices are reused first
+    for (auto c = chunks - 1; c >= 0; c--) {
+        auto& dead = expired[c];
+        for (auto it = dead.rbegin(); it != dead.rend(); ++it) {
+            freeList.push_back(*it);
+        }
+        aliveCount -= dead.size();
+        dead.clear();
+    }
+}
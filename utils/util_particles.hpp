@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Structure-of-arrays CPU particle pool with emitters and simple forces
+
+#ifndef UTIL_PARTICLES_H
+#define UTIL_PARTICLES_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util_vector.hpp"
+
+struct particleEmitter {
+    vec3 position;
+    float rate;             // Particles per second
+    float radius;           // Spawn disc radius
+    float speed;            // Maximum initial speed
+    float minLifetime;
+    float maxLifetime;
+    float accumulator;      // Fractional particles carried over to the next update
+};
+
+struct particleAttractor {
+    vec3 position;
+    float strength;         // Negative values repel
+};
+
+struct particleForces {
+    vec3 gravity;
+    float drag;             // Linear drag coefficient, 1/s
+    bool floor;             // Bounce on the y = floorY plane
+    float floorY;
+    float restitution;
+};
+
+// Interleaved vertex written for every slot, life is the remaining lifetime
+// fraction in [0, 1] and 0 for dead slots.
+struct particleVertex {
+    float x;
+    float y;
+    float z;
+    float life;
+};
+
+class particlePool {
+
+    private:
+        const std::int_fast32_t capacity;
+
+        // Per-particle state, padded to SIMD_WIDTH
+        std::vector<float> posX;
+        std::vector<float> posY;
+        std::vector<float> posZ;
+        std::vector<float> velX;
+        std::vector<float> velY;
+        std::vector<float> velZ;
+        std::vector<float> age;
+        std::vector<float> invLifetime;
+
+        std::vector<particleVertex> vertices;
+
+        // Free slots, low indices are handed out first so live particles stay packed
+        std::vector<std::int_fast32_t> freeList;
+        // Slots that expired during an update, one list per job chunk
+        std::vector<std::vector<std::int_fast32_t>> expired;
+        std::int_fast32_t highWater;
+        std::int_fast32_t aliveCount;
+
+        std::vector<particleEmitter> emitters;
+        std::vector<particleAttractor> attractors;
+        particleForces forces;
+
+        std::uint32_t rngState;
+
+        float random(float min, float max);
+        void emit(particleEmitter& e, float dt);
+        void integrate(std::int_fast32_t begin, std::int_fast32_t end, float dt,
+                       std::vector<std::int_fast32_t>& dead);
+
+    public:
+        explicit particlePool(std::int_fast32_t capacity);
+        ~particlePool();
+
+        std::int_fast32_t addEmitter(const particleEmitter& e);
+        particleEmitter*  getEmitter(std::int_fast32_t n)        { return &emitters[n]; }
+        std::int_fast32_t getEmitterCount()                      { return emitters.size(); }
+
+        void addAttractor(const particleAttractor& a)            { attractors.push_back(a); }
+        void clearAttractors()                                   { attractors.clear(); }
+        particleForces&   getForces()                            { return forces; }
+
+        // Emit new particles, then integrate and expire every live one across
+        // the worker pool. Vertices are refreshed in the same pass.
+        void update(float dt);
+
+        // Vertex data covers [0, getVertexCount()), dead slots have life 0
+        const particleVertex* getVertices()                      { return &vertices[0]; }
+        std::int_fast32_t     getVertexCount()                   { return highWater; }
+        std::int_fast32_t     getAliveCount()                    { return aliveCount; }
+        std::int_fast32_t     getCapacity()                      { return capacity; }
+};
+
+#endif
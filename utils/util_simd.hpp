@@ -0,0 +1,322 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Minimal 4-wide float SIMD wrapper (SSE2 / NEON / scalar fallback)
+
+#ifndef UTIL_SIMD_H
+#define UTIL_SIMD_H
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTIL_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define UTIL_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define UTIL_SIMD_SCALAR 1
+#include <cstring>
+#endif
+
+// Number of float lanes processed by one simd4f operation
+#define SIMD_WIDTH 4
+
+struct simd4f {
+#if defined(UTIL_SIMD_SSE2)
+    __m128 v;
+#elif defined(UTIL_SIMD_NEON)
+    float32x4_t v;
+#else
+    float v[4];
+#endif
+};
+
+// Round n up to a multiple of SIMD_WIDTH
+inline std::int_fast32_t simdPadCount(std::int_fast32_t n)
+{
+    return (n + SIMD_WIDTH - 1) & ~static_cast<std::int_fast32_t>(SIMD_WIDTH - 1);
+}
+
+#if defined(UTIL_SIMD_SSE2)
+
+inline simd4f simdSet1(float f)                   { return {_mm_set1_ps(f)}; }
+inline simd4f simdLoad(const float* p)            { return {_mm_loadu_ps(p)}; }
+inline void   simdStore(float* p, simd4f a)       { _mm_storeu_ps(p, a.v); }
+inline simd4f operator+(simd4f a, simd4f b)       { return {_mm_add_ps(a.v, b.v)}; }
+inline simd4f operator-(simd4f a, simd4f b)       { return {_mm_sub_ps(a.v, b.v)}; }
+inline simd4f operator*(simd4f a, simd4f b)       { return {_mm_mul_ps(a.v, b.v)}; }
+inline simd4f operator/(simd4f a, simd4f b)       { return {_mm_div_ps(a.v, b.v)}; }
+inline simd4f operator-(simd4f a)                 { return {_mm_xor_ps(a.v, _mm_set1_ps(-0.0f))}; }
+inline simd4f simdMin(simd4f a, simd4f b)         { return {_mm_min_ps(a.v, b.v)}; }
+inline simd4f simdMax(simd4f a, simd4f b)         { return {_mm_max_ps(a.v, b.v)}; }
+inline simd4f simdSqrt(simd4f a)                  { return {_mm_sqrt_ps(a.v)}; }
+
+// Comparisons return all-ones / all-zeros lane masks
+inline simd4f simdCmpGe(simd4f a, simd4f b)       { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline simd4f simdCmpLe(simd4f a, simd4f b)       { return {_mm_cmple_ps(a.v, b.v)}; }
+inline simd4f simdCmpLt(simd4f a, simd4f b)       { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline simd4f simdAnd(simd4f a, simd4f b)         { return {_mm_and_ps(a.v, b.v)}; }
+inline simd4f simdOr(simd4f a, simd4f b)          { return {_mm_or_ps(a.v, b.v)}; }
+
+// mask ? a : b
+inline simd4f simdSelect(simd4f mask, simd4f a, simd4f b)
+{
+    return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+}
+
+// One bit per lane, lane 0 in bit 0
+inline int simdMoveMask(simd4f mask) { return _mm_movemask_ps(mask.v); }
+
+// Round to nearest integer (result kept in float lanes)
+inline simd4f simdRound(simd4f a) { return {_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))}; }
+
+// Lane masks for (int(a) & bit) != 0, a holding integral values
+inline simd4f simdTestBit(simd4f a, int bit)
+{
+    __m128i i = _mm_and_si128(_mm_cvttps_epi32(a.v), _mm_set1_epi32(bit));
+    return {_mm_castsi128_ps(_mm_cmpeq_epi32(i, _mm_set1_epi32(bit)))};
+}
+
+inline void simdTranspose4(simd4f& r0, simd4f& r1, simd4f& r2, simd4f& r3)
+{
+    _MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v);
+}
+
+#elif defined(UTIL_SIMD_NEON)
+
+inline simd4f simdSet1(float f)                   { return {vdupq_n_f32(f)}; }
+inline simd4f simdLoad(const float* p)            { return {vld1q_f32(p)}; }
+inline void   simdStore(float* p, simd4f a)       { vst1q_f32(p, a.v); }
+inline simd4f operator+(simd4f a, simd4f b)       { return {vaddq_f32(a.v, b.v)}; }
+inline simd4f operator-(simd4f a, simd4f b)       { return {vsubq_f32(a.v, b.v)}; }
+inline simd4f operator*(simd4f a, simd4f b)       { return {vmulq_f32(a.v, b.v)}; }
+inline simd4f operator-(simd4f a)                 { return {vnegq_f32(a.v)}; }
+inline simd4f simdMin(simd4f a, simd4f b)         { return {vminq_f32(a.v, b.v)}; }
+inline simd4f simdMax(simd4f a, simd4f b)         { return {vmaxq_f32(a.v, b.v)}; }
+
+inline simd4f operator/(simd4f a, simd4f b)
+{
+#if defined(__aarch64__)
+    return {vdivq_f32(a.v, b.v)};
+#else
+    // Two Newton-Raphson steps on the reciprocal estimate
+    float32x4_t e = vrecpeq_f32(b.v);
+    e = vmulq_f32(e, vrecpsq_f32(b.v, e));
+    e = vmulq_f32(e, vrecpsq_f32(b.v, e));
+    return {vmulq_f32(a.v, e)};
+#endif
+}
+
+inline simd4f simdSqrt(simd4f a)
+{
+#if defined(__aarch64__)
+    return {vsqrtq_f32(a.v)};
+#else
+    // Two Newton-Raphson steps on the reciprocal estimate, sqrt(a) = a * rsqrt(a)
+    float32x4_t e = vrsqrteq_f32(a.v);
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a.v, e), e));
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a.v, e), e));
+    float32x4_t r = vmulq_f32(a.v, e);
+    return {vbslq_f32(vceqq_f32(a.v, vdupq_n_f32(0.0f)), a.v, r)};
+#endif
+}
+
+inline simd4f simdCmpGe(simd4f a, simd4f b) { return {vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v))}; }
+inline simd4f simdCmpLe(simd4f a, simd4f b) { return {vreinterpretq_f32_u32(vcleq_f32(a.v, b.v))}; }
+inline simd4f simdCmpLt(simd4f a, simd4f b) { return {vreinterpretq_f32_u32(vcltq_f32(a.v, b.v))}; }
+
+inline simd4f simdAnd(simd4f a, simd4f b)
+{
+    return {vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))};
+}
+
+inline simd4f simdOr(simd4f a, simd4f b)
+{
+    return {vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))};
+}
+
+inline simd4f simdSelect(simd4f mask, simd4f a, simd4f b)
+{
+    return {vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v)};
+}
+
+inline int simdMoveMask(simd4f mask)
+{
+    static const int32_t kBits[4] = {1, 2, 4, 8};
+    int32x4_t bits = vandq_s32(vreinterpretq_s32_f32(mask.v), vld1q_s32(kBits));
+    int32x2_t sum  = vadd_s32(vget_low_s32(bits), vget_high_s32(bits));
+    return vget_lane_s32(vpadd_s32(sum, sum), 0);
+}
+
+inline simd4f simdRound(simd4f a)
+{
+    // Bias away from zero by 0.5 then truncate
+    uint32x4_t neg  = vcltq_f32(a.v, vdupq_n_f32(0.0f));
+    float32x4_t half = vbslq_f32(neg, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+    return {vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(a.v, half)))};
+}
+
+inline simd4f simdTestBit(simd4f a, int bit)
+{
+    int32x4_t i = vandq_s32(vcvtq_s32_f32(a.v), vdupq_n_s32(bit));
+    return {vreinterpretq_f32_u32(vceqq_s32(i, vdupq_n_s32(bit)))};
+}
+
+inline void simdTranspose4(simd4f& r0, simd4f& r1, simd4f& r2, simd4f& r3)
+{
+    float32x4x2_t t01 = vtrnq_f32(r0.v, r1.v);
+    float32x4x2_t t23 = vtrnq_f32(r2.v, r3.v);
+    r0.v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1.v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2.v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3.v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+#else  // UTIL_SIMD_SCALAR
+
+#define SIMD_SCALAR_OP(expr)           \
+    simd4f r;                          \
+    for (auto i = 0; i < 4; i++) {     \
+        r.v[i] = (expr);               \
+    }                                  \
+    return r;
+
+inline float simdMaskBits(bool b)
+{
+    std::uint32_t u = b ? 0xffffffffu : 0u;
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline bool simdMaskTest(float f)
+{
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u != 0;
+}
+
+// Bitwise and/or on the float bit patterns, as the SIMD instructions do
+inline float simdBitOp(float a, float b, bool orOp)
+{
+    std::uint32_t ua, ub;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    std::uint32_t u = orOp ? (ua | ub) : (ua & ub);
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline simd4f simdSet1(float f)                   { SIMD_SCALAR_OP(f) }
+inline simd4f simdLoad(const float* p)            { SIMD_SCALAR_OP(p[i]) }
+inline void   simdStore(float* p, simd4f a)       { for (auto i = 0; i < 4; i++) p[i] = a.v[i]; }
+inline simd4f operator+(simd4f a, simd4f b)       { SIMD_SCALAR_OP(a.v[i] + b.v[i]) }
+inline simd4f operator-(simd4f a, simd4f b)       { SIMD_SCALAR_OP(a.v[i] - b.v[i]) }
+inline simd4f operator*(simd4f a, simd4f b)       { SIMD_SCALAR_OP(a.v[i] * b.v[i]) }
+inline simd4f operator/(simd4f a, simd4f b)       { SIMD_SCALAR_OP(a.v[i] / b.v[i]) }
+inline simd4f operator-(simd4f a)                 { SIMD_SCALAR_OP(-a.v[i]) }
+inline simd4f simdMin(simd4f a, simd4f b)         { SIMD_SCALAR_OP(std::fmin(a.v[i], b.v[i])) }
+inline simd4f simdMax(simd4f a, simd4f b)         { SIMD_SCALAR_OP(std::fmax(a.v[i], b.v[i])) }
+inline simd4f simdSqrt(simd4f a)                  { SIMD_SCALAR_OP(std::sqrt(a.v[i])) }
+inline simd4f simdCmpGe(simd4f a, simd4f b)       { SIMD_SCALAR_OP(simdMaskBits(a.v[i] >= b.v[i])) }
+inline simd4f simdCmpLe(simd4f a, simd4f b)       { SIMD_SCALAR_OP(simdMaskBits(a.v[i] <= b.v[i])) }
+inline simd4f simdCmpLt(simd4f a, simd4f b)       { SIMD_SCALAR_OP(simdMaskBits(a.v[i] < b.v[i])) }
+inline simd4f simdAnd(simd4f a, simd4f b)         { SIMD_SCALAR_OP(simdBitOp(a.v[i], b.v[i], false)) }
+inline simd4f simdOr(simd4f a, simd4f b)          { SIMD_SCALAR_OP(simdBitOp(a.v[i], b.v[i], true)) }
+inline simd4f simdSelect(simd4f m, simd4f a, simd4f b) { SIMD_SCALAR_OP(simdMaskTest(m.v[i]) ? a.v[i] : b.v[i]) }
+inline simd4f simdRound(simd4f a)                 { SIMD_SCALAR_OP(std::nearbyint(a.v[i])) }
+inline simd4f simdTestBit(simd4f a, int bit)      { SIMD_SCALAR_OP(simdMaskBits((static_cast<int>(a.v[i]) & bit) != 0)) }
+
+inline int simdMoveMask(simd4f m)
+{
+    int r = 0;
+    for (auto i = 0; i < 4; i++) {
+        if (simdMaskTest(m.v[i]))
+            r |= 1 << i;
+    }
+    return r;
+}
+
+inline void simdTranspose4(simd4f& r0, simd4f& r1, simd4f& r2, simd4f& r3)
+{
+    simd4f t[4] = {r0, r1, r2, r3};
+    for (auto i = 0; i < 4; i++) {
+        r0.v[i] = t[i].v[0];
+        r1.v[i] = t[i].v[1];
+        r2.v[i] = t[i].v[2];
+        r3.v[i] = t[i].v[3];
+    }
+}
+
+#undef SIMD_SCALAR_OP
+
+#endif
+
+// a * b + c
+inline simd4f simdMulAdd(simd4f a, simd4f b, simd4f c) { return a * b + c; }
+
+// Polynomial sine and cosine of four angles at once.
+// The argument is reduced to [-pi/4, pi/4] by multiples of pi/2 (Cody-Waite),
+// then evaluated with the Cephes minimax polynomials. Max error is about 2 ulp
+// for |x| < 8192, which covers every angle the samples animate.
+inline void simdSinCos(simd4f x, simd4f& s, simd4f& c)
+{
+    const simd4f q = simdRound(x * simdSet1(0.63661977236758134f)); // 2/pi
+
+    // r = x - q * pi/2, split in three parts to keep precision
+    simd4f r = x - q * simdSet1(1.5703125f);
+    r = r - q * simdSet1(4.837512969970703125e-4f);
+    r = r - q * simdSet1(7.549789948768648e-8f);
+
+    const simd4f z = r * r;
+
+    simd4f ps = simdMulAdd(simdSet1(-1.9515295891e-4f), z, simdSet1(8.3321608736e-3f));
+    ps = simdMulAdd(ps, z, simdSet1(-1.6666654611e-1f));
+    ps = simdMulAdd(ps * z, r, r);
+
+    simd4f pc = simdMulAdd(simdSet1(2.443315711809948e-5f), z, simdSet1(-1.388731625493765e-3f));
+    pc = simdMulAdd(pc, z, simdSet1(4.166664568298827e-2f));
+    pc = simdMulAdd(pc * z, z, simdSet1(1.0f) - simdSet1(0.5f) * z);
+
+    // Quadrant fix-up. Negative q is handled by the two's complement bit pattern.
+    const simd4f swap   = simdTestBit(q, 1);
+    const simd4f negSin = simdTestBit(q, 2);
+    const simd4f negCos = simdTestBit(q + simdSet1(1.0f), 2);
+
+    simd4f sv = simdSelect(swap, pc, ps);
+    simd4f cv = simdSelect(swap, ps, pc);
+    s = simdSelect(negSin, -sv, sv);
+    c = simdSelect(negCos, -cv, cv);
+}
+
+#endif
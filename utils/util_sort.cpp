@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <utility>
+
+#include "util_parallel.hpp"
+#include "util_sort.hpp"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (32 / RADIX_BITS)
+
+// Elements per block, small inputs end up as a single serial block
+#define RADIX_BLOCK 16384
+
+radixSorter::radixSorter() {
+}
+
+radixSorter::~radixSorter() {
+}
+
+void radixSorter::sort(std::uint32_t* keys, std::uint32_t* values, std::int_fast32_t count) {
+    if (count <= 1)
+        return;
+
+    keyTmp.resize(count);
+    valueTmp.resize(count);
+
+    const std::int_fast32_t blocks = (count + RADIX_BLOCK - 1) / RADIX_BLOCK;
+    histograms.resize(blocks * RADIX_BUCKETS);
+
+    std::uint32_t* srcKeys = keys;
+    std::uint32_t* srcValues = values;
+    std::uint32_t* dstKeys = keyTmp.data();
+    std::uint32_t* dstValues = valueTmp.data();
+
+    for (auto pass = 0; pass < RADIX_PASSES; pass++) {
+        const int shift = pass * RADIX_BITS;
+
+        parallelFor(count, RADIX_BLOCK, [&](std::int_fast32_t begin, std::int_fast32_t end) {
+            std::uint32_t* h = &histograms[(begin / RADIX_BLOCK) * RADIX_BUCKETS];
+            std::fill(h, h + RADIX_BUCKETS, 0);
+            for (auto i = begin; i < end; i++) {
+                h[(srcKeys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+        });
+
+        // Exclusive prefix sum, digit-major then block order keeps the sort stable
+        std::uint32_t offset = 0;
+        bool trivial = false;
+        for (auto d = 0; d < RADIX_BUCKETS; d++) {
+            std::uint32_t digitTotal = 0;
+            for (auto b = 0; b < blocks; b++) {
+                std::uint32_t& h = histograms[b * RADIX_BUCKETS + d];
+                std::uint32_t n = h;
+                h = offset;
+                offset += n;
+                digitTotal += n;
+            }
+            if (digitTotal == static_cast<std::uint32_t>(count)) {
+                trivial = true;
+                break;
+            }
+        }
+
+        // Every key has the same digit, this pass would be a plain copy
+        if (trivial)
+            continue;
+
+        parallelFor(count, RADIX_BLOCK, [&](std::int_fast32_t begin, std::int_fast32_t end) {
+            std::uint32_t* h = &histograms[(begin / RADIX_BLOCK) * RADIX_BUCKETS];
+            for (auto i = begin; i < end; i++) {
+                std::uint32_t k = srcKeys[i];
+                std::uint32_t dst = h[(k >> shift) & (RADIX_BUCKETS - 1)]++;
+                dstKeys[dst] = k;
+                dstValues[dst] = srcValues[i];
+            }
+        });
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    // An odd number of scatter passes leaves the result in the scratch buffers
+    if (srcKeys != keys) {
+        std::copy(srcKeys, srcKeys + count, keys);
+        std::copy(srcValues, srcValues + count, values);
+    }
+}
+
+void radixSorter::sortIndices(std::uint32_t* keys, std::int_fast32_t count,
+                              std::vector<std::uint32_t>& indices) {
+    indices.resize(count);
+    for (auto i = 0; i < count; i++) {
+        indices[i] = i;
+    }
+    sort(keys, indices.data(), count);
+}
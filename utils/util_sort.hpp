@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2019 Tatsuya Kobayashi
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//  * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//  * Neither the name of the author nor the names of contributors may
+// be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+// Parallel LSD radix sort on 32-bit keys, used for depth ordering
+
+#ifndef UTIL_SORT_H
+#define UTIL_SORT_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Map a float to a key whose unsigned order matches the float order
+inline std::uint32_t sortKeyFromFloat(float f)
+{
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+class radixSorter {
+
+    private:
+        std::vector<std::uint32_t> keyTmp;
+        std::vector<std::uint32_t> valueTmp;
+
+        // One 256-bucket histogram per block, turned into scatter offsets in place
+        std::vector<std::uint32_t> histograms;
+
+    public:
+        radixSorter();
+        ~radixSorter();
+
+        // Stable ascending sort of keys[0, count), values are permuted alongside.
+        // Blocks of the input are histogrammed and scattered on the worker pool,
+        // digits shared by every key are skipped.
+        void sort(std::uint32_t* keys, std::uint32_t* values, std::int_fast32_t count);
+
+        // Fill indices with 0..count-1 ordered by key, keys are clobbered
+        void sortIndices(std::uint32_t* keys, std::int_fast32_t count,
+                         std::vector<std::uint32_t>& indices);
+};
+
+#endif